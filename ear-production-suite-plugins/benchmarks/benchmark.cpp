@@ -0,0 +1,208 @@
+#include "benchmark.hpp"
+#include "processing_stats.hpp"
+#include <version/eps_version.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <numeric>
+
+namespace ear {
+namespace plugin {
+namespace benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Settings {
+  std::size_t samples;
+  std::chrono::nanoseconds minimumBatchDuration;
+};
+
+Settings settingsFor(const Options& options) {
+  if (options.quick) {
+    return {3, std::chrono::milliseconds(1)};
+  }
+  return {30, std::chrono::milliseconds(10)};
+}
+
+double timeBatch(const std::function<void()>& fn, std::size_t iterations) {
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    fn();
+  }
+  auto end = Clock::now();
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+}
+
+std::string currentTime() {
+  auto now = std::time(nullptr);
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ",
+                std::gmtime(&now));
+  return buffer;
+}
+
+std::string buildType() {
+#ifdef NDEBUG
+  return "release";
+#else
+  return "debug";
+#endif
+}
+
+double realtimeFactor(const Result& result) {
+  if (result.audio.frames == 0 || result.meanNanoseconds <= 0.0) {
+    return 0.0;
+  }
+  return result.audio.frames / result.audio.sampleRate * 1e9 /
+         result.meanNanoseconds;
+}
+
+}  // namespace
+
+std::string fullName(const std::string& name, const Parameters& parameters) {
+  auto full = name;
+  for (auto const& [key, value] : parameters) {
+    full += "/" + key + "=" + value;
+  }
+  return full;
+}
+
+Runner::Runner(Options options) : options_{std::move(options)} {}
+
+bool Runner::selected(const std::string& name) const {
+  return options_.filter.empty() ||
+         name.find(options_.filter) != std::string::npos;
+}
+
+void Runner::run(const std::string& name, Parameters parameters,
+                 const std::function<void()>& fn, AudioWorkload audio) {
+  if (!selected(fullName(name, parameters))) {
+    return;
+  }
+  auto settings = settingsFor(options_);
+
+  // Doubling the batch until it is long enough also warms up caches and any
+  // lazily allocated state
+  std::size_t batchSize = 1;
+  while (timeBatch(fn, batchSize) < settings.minimumBatchDuration.count()) {
+    batchSize *= 2;
+  }
+
+  std::vector<double> perIteration;
+  perIteration.reserve(settings.samples);
+  for (std::size_t sample = 0; sample < settings.samples; ++sample) {
+    perIteration.push_back(timeBatch(fn, batchSize) / batchSize);
+  }
+  std::sort(perIteration.begin(), perIteration.end());
+
+  Result result;
+  result.name = name;
+  result.parameters = std::move(parameters);
+  result.iterations = batchSize * settings.samples;
+  result.audio = audio;
+  result.minNanoseconds = perIteration.front();
+  result.maxNanoseconds = perIteration.back();
+  auto middle = perIteration.size() / 2;
+  result.medianNanoseconds =
+      perIteration.size() % 2
+          ? perIteration[middle]
+          : (perIteration[middle - 1] + perIteration[middle]) / 2.0;
+  result.meanNanoseconds =
+      std::accumulate(perIteration.begin(), perIteration.end(), 0.0) /
+      perIteration.size();
+  double variance = 0.0;
+  for (auto value : perIteration) {
+    variance += (value - result.meanNanoseconds) *
+                (value - result.meanNanoseconds);
+  }
+  result.stddevNanoseconds = std::sqrt(variance / perIteration.size());
+  results_.push_back(std::move(result));
+}
+
+void Runner::skip(const std::string& name, std::string reason) {
+  if (selected(name)) {
+    skipped_.emplace_back(name, std::move(reason));
+  }
+}
+
+void Runner::writeTable(std::ostream& stream) const {
+  auto flags = stream.flags();
+  stream << std::fixed << std::setprecision(3);
+  for (auto const& result : results_) {
+    stream << std::left << std::setw(64)
+           << fullName(result.name, result.parameters) << std::right
+           << std::setw(12) << result.medianNanoseconds / 1000.0 << " us"
+           << " (mean " << result.meanNanoseconds / 1000.0 << ", sd "
+           << result.stddevNanoseconds / 1000.0 << ")";
+    if (auto factor = realtimeFactor(result)) {
+      stream << std::setprecision(1) << "  " << factor << "x realtime"
+             << std::setprecision(3);
+    }
+    stream << "\n";
+  }
+  for (auto const& [name, reason] : skipped_) {
+    stream << std::left << std::setw(64) << name << " skipped: " << reason
+           << "\n";
+  }
+  stream.flags(flags);
+}
+
+void Runner::writeJson(std::ostream& stream) const {
+  auto flags = stream.flags();
+  stream << std::setprecision(6);
+  stream << "{\n\"context\":{\"version\":";
+  writeJsonString(stream, eps::currentVersion());
+  stream << ",\"date\":";
+  writeJsonString(stream, currentTime());
+  stream << ",\"build_type\":";
+  writeJsonString(stream, buildType());
+  stream << ",\"quick\":" << (options_.quick ? "true" : "false") << "},\n";
+
+  stream << "\"benchmarks\":[";
+  for (std::size_t i = 0; i < results_.size(); ++i) {
+    auto const& result = results_[i];
+    stream << (i ? ",\n" : "\n") << "{\"name\":";
+    writeJsonString(stream, fullName(result.name, result.parameters));
+    stream << ",\"benchmark\":";
+    writeJsonString(stream, result.name);
+    stream << ",\"parameters\":{";
+    for (std::size_t p = 0; p < result.parameters.size(); ++p) {
+      stream << (p ? "," : "");
+      writeJsonString(stream, result.parameters[p].first);
+      stream << ":";
+      writeJsonString(stream, result.parameters[p].second);
+    }
+    stream << "},\"iterations\":" << result.iterations
+           << ",\"mean_ns\":" << result.meanNanoseconds
+           << ",\"median_ns\":" << result.medianNanoseconds
+           << ",\"min_ns\":" << result.minNanoseconds
+           << ",\"max_ns\":" << result.maxNanoseconds
+           << ",\"stddev_ns\":" << result.stddevNanoseconds;
+    if (result.audio.frames) {
+      stream << ",\"frames\":" << result.audio.frames
+             << ",\"sample_rate\":" << result.audio.sampleRate
+             << ",\"realtime_factor\":" << realtimeFactor(result);
+    }
+    stream << "}";
+  }
+  stream << "\n],\n\"skipped\":[";
+  for (std::size_t i = 0; i < skipped_.size(); ++i) {
+    stream << (i ? ",\n" : "\n") << "{\"name\":";
+    writeJsonString(stream, skipped_[i].first);
+    stream << ",\"reason\":";
+    writeJsonString(stream, skipped_[i].second);
+    stream << "}";
+  }
+  stream << "\n]\n}\n";
+  stream.flags(flags);
+}
+
+}  // namespace benchmark
+}  // namespace plugin
+}  // namespace ear
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ear {
+namespace plugin {
+namespace benchmark {
+
+using Parameters = std::vector<std::pair<std::string, std::string>>;
+
+struct Options {
+  // Only run benchmarks whose full name contains this
+  std::string filter;
+  // Few, short samples - for checking the suite still runs, not for numbers
+  bool quick{false};
+  // BEAR .tf file; the binaural benchmarks are skipped without one
+  std::string bearDataFile;
+};
+
+// Audio handled by one iteration, so results can be given as a realtime
+// factor (audio duration / processing time)
+struct AudioWorkload {
+  std::size_t frames{0};
+  double sampleRate{48000.0};
+};
+
+struct Result {
+  std::string name;
+  Parameters parameters;
+  std::size_t iterations{0};
+  double meanNanoseconds{0.0};
+  double medianNanoseconds{0.0};
+  double minNanoseconds{0.0};
+  double maxNanoseconds{0.0};
+  double stddevNanoseconds{0.0};
+  AudioWorkload audio;
+};
+
+// Runs each benchmark in batches sized to take a measurable time, and keeps
+// per-iteration statistics over the batches.
+class Runner {
+ public:
+  explicit Runner(Options options);
+
+  const Options& options() const { return options_; }
+
+  // Calls fn once per iteration. Set-up belongs outside fn.
+  void run(const std::string& name, Parameters parameters,
+           const std::function<void()>& fn, AudioWorkload audio = {});
+  void skip(const std::string& name, std::string reason);
+
+  const std::vector<Result>& results() const { return results_; }
+
+  void writeTable(std::ostream& stream) const;
+  // Schema is {"context": {...}, "benchmarks": [...], "skipped": [...]}
+  void writeJson(std::ostream& stream) const;
+
+ private:
+  bool selected(const std::string& fullName) const;
+
+  Options options_;
+  std::vector<Result> results_;
+  std::vector<std::pair<std::string, std::string>> skipped_;
+};
+
+std::string fullName(const std::string& name, const Parameters& parameters);
+
+// Stops the compiler discarding work whose result is otherwise unused
+template <typename T>
+inline void doNotOptimize(T& value) {
+#if defined(_MSC_VER)
+  auto volatile sink = &value;
+  (void)sink;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(&value) : "memory");
+#endif
+}
+
+// One per source file, all called from main
+void runDspBenchmarks(Runner& runner);
+void runMetadataBenchmarks(Runner& runner);
+void runLogBenchmarks(Runner& runner);
+
+}  // namespace benchmark
+}  // namespace plugin
+}  // namespace ear
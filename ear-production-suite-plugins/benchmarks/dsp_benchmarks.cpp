@@ -0,0 +1,310 @@
+#include "benchmark.hpp"
+#include "JuceHeader.h"
+#include "binaural_monitoring_audio_processor.hpp"
+#include "components/level_meter_calculator.hpp"
+#include "monitoring_audio_processor.hpp"
+#include "variable_block_adapter.hpp"
+#include <daw_channel_count.h>
+#include <ear/bs2051.hpp>
+#include <ear/metadata.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+
+template <>
+struct BufferTraits<Eigen::MatrixXf> {
+  using Buffer = Eigen::MatrixXf;
+  using SampleType = float;
+  static Eigen::Index channelCount(const Buffer& b) { return b.cols(); }
+  static Eigen::Index size(const Buffer& b) { return b.rows(); }
+  static const SampleType* getChannel(const Buffer& b, std::size_t n) {
+    return b.col(n).data();
+  }
+  static SampleType* getChannel(Buffer& b, std::size_t n) {
+    return b.col(n).data();
+  }
+};
+
+namespace benchmark {
+
+// Separately allocated channels, as hosts hand them over
+struct ChannelBuffer {
+  ChannelBuffer(std::size_t channelCount, std::size_t frames)
+      : samples(channelCount, std::vector<float>(frames)) {
+    for (auto& channel : samples) {
+      pointers.push_back(channel.data());
+    }
+  }
+  std::vector<std::vector<float>> samples;
+  std::vector<float*> pointers;
+};
+
+}  // namespace benchmark
+
+template <>
+struct BufferTraits<benchmark::ChannelBuffer> {
+  using Buffer = benchmark::ChannelBuffer;
+  using SampleType = float;
+  static Eigen::Index channelCount(const Buffer& b) {
+    return static_cast<Eigen::Index>(b.samples.size());
+  }
+  static Eigen::Index size(const Buffer& b) {
+    return b.samples.empty() ? 0
+                             : static_cast<Eigen::Index>(b.samples[0].size());
+  }
+  static SampleType* getChannel(Buffer& b, std::size_t n) {
+    return b.pointers[n];
+  }
+  static const SampleType* getChannel(const Buffer& b, std::size_t n) {
+    return b.pointers[n];
+  }
+  static SampleType** getChannels(Buffer& b) { return b.pointers.data(); }
+  static SampleType* const* getChannels(const Buffer& b) {
+    return b.pointers.data();
+  }
+};
+
+namespace benchmark {
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+const std::vector<std::string> LAYOUTS{"0+2+0", "0+5+0", "4+5+0", "9+10+3"};
+
+void fillNoise(Eigen::MatrixXf& samples) {
+  samples.setRandom();
+  samples *= 0.5f;
+}
+
+void fillNoise(ChannelBuffer& buffer) {
+  unsigned int state = 1;
+  for (auto& channel : buffer.samples) {
+    for (auto& sample : channel) {
+      state = state * 1664525u + 1013904223u;
+      sample = static_cast<float>(state >> 8) / (1 << 24) - 0.5f;
+    }
+  }
+}
+
+void monitoringProcess(Runner& runner) {
+  const std::size_t inputChannels = MAX_DAW_CHANNELS;
+  for (auto const& layoutName : LAYOUTS) {
+    auto layout = getLayout(layoutName);
+    auto outputChannels = static_cast<Eigen::Index>(layout.channels().size());
+    for (std::size_t blockSize : {64, 256, 512, 1024}) {
+      MonitoringAudioProcessor processor(inputChannels, layout, blockSize);
+      Eigen::MatrixXf in(blockSize, inputChannels);
+      fillNoise(in);
+      Eigen::MatrixXf out(blockSize, outputChannels);
+      GainMatrix direct = GainMatrix::Random(outputChannels, inputChannels);
+      GainMatrix diffuse = GainMatrix::Random(outputChannels, inputChannels);
+      runner.run("monitoring_process",
+                 {{"layout", layoutName},
+                  {"inputs", std::to_string(inputChannels)},
+                  {"block", std::to_string(blockSize)}},
+                 [&]() {
+                   processor.process(in, out, direct, diffuse);
+                   doNotOptimize(out);
+                 },
+                 {blockSize, SAMPLE_RATE});
+    }
+  }
+}
+
+// A 3rd order HOA bed (16 channels) on 22.2, either through the interpolated
+// gain matrix or the static decode
+void monitoringProcessHoa(Runner& runner) {
+  const std::size_t inputChannels = MAX_DAW_CHANNELS;
+  const Eigen::Index hoaChannels = 16;
+  const std::size_t blockSize = 512;
+  auto layout = getLayout("9+10+3");
+  auto outputChannels = static_cast<Eigen::Index>(layout.channels().size());
+  Eigen::MatrixXf in(blockSize, inputChannels);
+  fillNoise(in);
+  Eigen::MatrixXf out(blockSize, outputChannels);
+  GainMatrix decode = GainMatrix::Random(outputChannels, hoaChannels);
+  GainMatrix zeros = GainMatrix::Zero(outputChannels, inputChannels);
+
+  MonitoringAudioProcessor interpolated(inputChannels, layout, blockSize);
+  GainMatrix direct = zeros;
+  direct.leftCols(hoaChannels) = decode;
+  runner.run("monitoring_process_hoa", {{"path", "interpolated"}},
+             [&]() {
+               interpolated.process(in, out, direct, zeros);
+               doNotOptimize(out);
+             },
+             {blockSize, SAMPLE_RATE});
+
+  MonitoringAudioProcessor staticDecode(inputChannels, layout, blockSize);
+  HoaDecodes hoa{{0, std::make_shared<const Eigen::MatrixXf>(decode)}};
+  runner.run("monitoring_process_hoa", {{"path", "static"}},
+             [&]() {
+               staticDecode.process(in, out, zeros, zeros, hoa);
+               doNotOptimize(out);
+             },
+             {blockSize, SAMPLE_RATE});
+}
+
+void variableBlockSizeAdapter(Runner& runner) {
+  const Eigen::Index internalBlockSize = 512;
+  const Eigen::Index channels = 16;
+  // Hosts that don't stick to powers of two, or split blocks at loop points
+  for (Eigen::Index hostBlockSize : {1, 37, 441, 511, 1023, 4097}) {
+    VariableBlockSizeAdapter<float> adapter(
+        internalBlockSize, channels, channels,
+        [](const Eigen::Ref<const Eigen::MatrixXf>& in,
+           Eigen::Ref<Eigen::MatrixXf> out) { out = in; });
+    Eigen::MatrixXf in(hostBlockSize, channels);
+    fillNoise(in);
+    Eigen::MatrixXf out(hostBlockSize, channels);
+    runner.run("variable_block_size_adapter",
+               {{"internal_block", std::to_string(internalBlockSize)},
+                {"host_block", std::to_string(hostBlockSize)},
+                {"channels", std::to_string(channels)}},
+               [&]() {
+                 adapter.process(in, out);
+                 doNotOptimize(out);
+               },
+               {static_cast<std::size_t>(hostBlockSize), SAMPLE_RATE});
+  }
+}
+
+void binauralMonitoring(Runner& runner) {
+  const std::string name = "binaural_monitoring_process";
+  if (runner.options().bearDataFile.empty()) {
+    runner.skip(name, "no --bear-data-file given");
+    return;
+  }
+  const std::size_t blockSize = 512;
+  const std::size_t channels = MAX_DAW_CHANNELS;
+  for (std::size_t objects : {1, 16, 64}) {
+    BinauralMonitoringAudioProcessor processor(
+        channels, channels, channels, static_cast<std::size_t>(SAMPLE_RATE),
+        blockSize, runner.options().bearDataFile);
+    if (!processor.rendererStarted()) {
+      auto status = processor.getBearStatus();
+      runner.skip(name, "BEAR failed to start: " + status.startupErrorDesc +
+                            status.listenerDataSetErrorDesc);
+      return;
+    }
+    processor.updateChannelCounts(objects, 0, 0);
+    processor.setIsPlaying(true);
+
+    ChannelBuffer buffer(channels, blockSize);
+    fillNoise(buffer);
+    // Output is written over the first two channels
+    auto const stereoInput = std::vector<std::vector<float>>(
+        buffer.samples.begin(), buffer.samples.begin() + 2);
+    ObjectsTypeMetadata metadata;
+    std::size_t block = 0;
+    runner.run(name,
+               {{"objects", std::to_string(objects)},
+                {"block", std::to_string(blockSize)}},
+               [&]() {
+                 // Moving sources, as metadata arrives from the input plugins
+                 // every block during playback
+                 ++block;
+                 for (std::size_t object = 0; object < objects; ++object) {
+                   metadata.position = PolarPosition(
+                       std::fmod(block + object * 10.0, 360.0) - 180.0, 0.0,
+                       1.0);
+                   processor.pushBearMetadata(object, &metadata);
+                 }
+                 processor.process(buffer, buffer);
+                 doNotOptimize(buffer.samples[0][0]);
+                 std::copy(stereoInput[0].begin(), stereoInput[0].end(),
+                           buffer.samples[0].begin());
+                 std::copy(stereoInput[1].begin(), stereoInput[1].end(),
+                           buffer.samples[1].begin());
+               },
+               {blockSize, SAMPLE_RATE});
+  }
+}
+
+// 1st order stems of the same format, which BEAR renders as one summed stream
+void binauralMonitoringHoa(Runner& runner) {
+  const std::string name = "binaural_monitoring_process_hoa";
+  if (runner.options().bearDataFile.empty()) {
+    runner.skip(name, "no --bear-data-file given");
+    return;
+  }
+  const std::size_t blockSize = 512;
+  const std::size_t channels = MAX_DAW_CHANNELS;
+  HOATypeMetadata metadata;
+  metadata.orders = {0, 1, 1, 1};
+  metadata.degrees = {0, -1, 0, 1};
+  metadata.normalization = "SN3D";
+  for (std::size_t stems : {1, 4, 16}) {
+    BinauralMonitoringAudioProcessor processor(
+        0, 0, channels, static_cast<std::size_t>(SAMPLE_RATE), blockSize,
+        runner.options().bearDataFile);
+    if (!processor.rendererStarted()) {
+      auto status = processor.getBearStatus();
+      runner.skip(name, "BEAR failed to start: " + status.startupErrorDesc +
+                            status.listenerDataSetErrorDesc);
+      return;
+    }
+    processor.updateChannelCounts(0, 0, metadata.degrees.size());
+    processor.setIsPlaying(true);
+
+    ChannelBuffer buffer(channels, blockSize);
+    fillNoise(buffer);
+    auto const stereoInput = std::vector<std::vector<float>>(
+        buffer.samples.begin(), buffer.samples.begin() + 2);
+    runner.run(name,
+               {{"stems", std::to_string(stems)},
+                {"block", std::to_string(blockSize)}},
+               [&]() {
+                 for (std::size_t stem = 0; stem < stems; ++stem) {
+                   processor.pushBearMetadata(
+                       stem * metadata.degrees.size(), &metadata, stem);
+                 }
+                 processor.process(buffer, buffer);
+                 doNotOptimize(buffer.samples[0][0]);
+                 std::copy(stereoInput[0].begin(), stereoInput[0].end(),
+                           buffer.samples[0].begin());
+                 std::copy(stereoInput[1].begin(), stereoInput[1].end(),
+                           buffer.samples[1].begin());
+               },
+               {blockSize, SAMPLE_RATE});
+  }
+}
+
+void levelMeterCalculator(Runner& runner) {
+  const int blockSize = 512;
+  for (int channels : {2, 16, MAX_DAW_CHANNELS}) {
+    LevelMeterCalculator calculator(channels,
+                                    static_cast<std::size_t>(SAMPLE_RATE));
+    AudioBuffer<float> buffer(channels, blockSize);
+    for (int channel = 0; channel < channels; ++channel) {
+      for (int sample = 0; sample < blockSize; ++sample) {
+        buffer.setSample(channel, sample,
+                         std::sin(0.01f * (sample + channel)) * 0.5f);
+      }
+    }
+    runner.run("level_meter_calculator",
+               {{"channels", std::to_string(channels)},
+                {"block", std::to_string(blockSize)}},
+               [&]() { calculator.process(buffer); },
+               {static_cast<std::size_t>(blockSize), SAMPLE_RATE});
+  }
+}
+
+}  // namespace
+
+void runDspBenchmarks(Runner& runner) {
+  monitoringProcess(runner);
+  monitoringProcessHoa(runner);
+  variableBlockSizeAdapter(runner);
+  binauralMonitoring(runner);
+  binauralMonitoringHoa(runner);
+  levelMeterCalculator(runner);
+}
+
+}  // namespace benchmark
+}  // namespace plugin
+}  // namespace ear
@@ -0,0 +1,49 @@
+#include "benchmark.hpp"
+#include "log.hpp"
+#include "detail/async_log_sink.hpp"
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+#include <memory>
+#include <string>
+
+namespace ear {
+namespace plugin {
+namespace benchmark {
+
+namespace {
+
+// The cost to the logging thread. spdlog formats the payload either way, so
+// the difference from the null sink is the sink's own cost - copying the
+// message to the thread's queue - which should stay under 100 ns for logging
+// to be safe on the audio thread. Once the backend falls behind this includes
+// messages dropped from a full queue, which cost no more.
+void logMessage(Runner& runner) {
+  // Made directly, as createLogger() gives a null sink when logging is
+  // disabled in the build
+  auto async = std::make_shared<spdlog::logger>(
+      "benchmark", std::make_shared<detail::AsyncLogSink>());
+  auto null = std::make_shared<spdlog::logger>(
+      "benchmark", std::make_shared<spdlog::sinks::null_sink_st>());
+  const std::string longText(400, 'x');
+  int block = 0;
+  for (auto const& [sink, logger] :
+       {std::make_pair("async", async), std::make_pair("null", null)}) {
+    logger->set_level(spdlog::level::trace);
+    runner.run("log_message", {{"sink", sink}, {"payload", "short"}},
+               [&, logger = logger]() {
+                 logger->debug("processed block {}", ++block);
+               });
+    runner.run("log_message", {{"sink", sink}, {"payload", "truncated"}},
+               [&, logger = logger]() {
+                 logger->debug("{} {}", longText, ++block);
+               });
+  }
+}
+
+}  // namespace
+
+void runLogBenchmarks(Runner& runner) { logMessage(runner); }
+
+}  // namespace benchmark
+}  // namespace plugin
+}  // namespace ear
@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+  std::cerr
+      << "Usage: " << program << " [options]\n"
+      << "  --json <file>             also write results as JSON ('-' for "
+         "stdout)\n"
+      << "  --filter <text>           only run benchmarks whose name "
+         "contains text\n"
+      << "  --quick                   few short samples, to check the suite "
+         "runs\n"
+      << "  --bear-data-file <file>   BEAR .tf data file for the binaural "
+         "benchmarks\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using namespace ear::plugin::benchmark;
+
+  Options options;
+  std::string jsonPath;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto next = [&]() -> std::string {
+      if (i + 1 == argc) {
+        printUsage(argv[0]);
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--json") {
+      jsonPath = next();
+    } else if (arg == "--filter") {
+      options.filter = next();
+    } else if (arg == "--quick") {
+      options.quick = true;
+    } else if (arg == "--bear-data-file") {
+      options.bearDataFile = next();
+    } else {
+      printUsage(argv[0]);
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  Runner runner(options);
+  try {
+    runDspBenchmarks(runner);
+    runMetadataBenchmarks(runner);
+    runLogBenchmarks(runner);
+  } catch (const std::exception& e) {
+    std::cerr << "benchmark failed: " << e.what() << std::endl;
+    return 1;
+  }
+
+  // With JSON on stdout, keep the table out of the way on stderr
+  auto& tableStream = jsonPath == "-" ? std::cerr : std::cout;
+  runner.writeTable(tableStream);
+  if (jsonPath == "-") {
+    runner.writeJson(std::cout);
+  } else if (!jsonPath.empty()) {
+    std::ofstream file(jsonPath);
+    if (!file.is_open()) {
+      std::cerr << "could not open " << jsonPath << std::endl;
+      return 1;
+    }
+    runner.writeJson(file);
+  }
+  return 0;
+}
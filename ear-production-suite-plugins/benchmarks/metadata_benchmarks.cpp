@@ -0,0 +1,242 @@
+#include "benchmark.hpp"
+#include "communication/common_types.hpp"
+#include "helper/eps_to_ear_metadata_converter.hpp"
+#include "helper/protobuf_utilities.hpp"
+#include "programme_store_adm_serializer.hpp"
+#include "scene_gains_calculator.hpp"
+#include "scene_store.pb.h"
+#include <adm/parse.hpp>
+#include <adm/write.hpp>
+#include <daw_channel_count.h>
+#include <ear/bs2051.hpp>
+#include <helper/adm_template_codec.h>
+#include <sstream>
+#include <string>
+
+namespace ear {
+namespace plugin {
+namespace benchmark {
+
+namespace {
+
+const std::vector<int> ITEM_COUNTS{1, 16, 64, 100};
+// Large sessions are where the export handoff is noticeable
+const std::vector<int> ADM_OBJECT_COUNTS{50, 500};
+
+proto::ObjectsTypeMetadata* newObjectMetadata(int index) {
+  auto metadata = new proto::ObjectsTypeMetadata();
+  metadata->mutable_position()->set_azimuth(-180.0 + (index * 37) % 360);
+  metadata->mutable_position()->set_elevation((index * 13) % 60);
+  metadata->mutable_position()->set_distance(1.0);
+  metadata->set_gain(0.8);
+  metadata->set_width(index % 4 * 10.0);
+  return metadata;
+}
+
+// One mono object per item, as in a typical object-based session
+proto::SceneStore makeSceneStore(int itemCount) {
+  proto::SceneStore store;
+  for (int i = 0; i < itemCount; ++i) {
+    auto id = communication::ConnectionId::generate().string();
+
+    auto item = store.add_monitoring_items();
+    item->set_connection_id(id);
+    item->set_routing(i);
+    item->set_changed(true);
+    item->set_allocated_obj_metadata(newObjectMetadata(i));
+
+    auto available = store.add_all_available_items();
+    available->set_connection_id(id);
+    available->set_routing(i);
+    available->set_name("Object " + std::to_string(i + 1));
+    available->set_colour(0xff00ff00);
+    available->set_input_instance_id(i + 1);
+    available->set_allocated_obj_metadata(newObjectMetadata(i));
+  }
+  return store;
+}
+
+void setChanged(proto::SceneStore& store, bool changed) {
+  for (auto& item : *store.mutable_monitoring_items()) {
+    item.set_changed(changed);
+  }
+}
+
+void sceneGainsCalculator(Runner& runner) {
+  auto layout = getLayout("4+5+0");
+  for (auto itemCount : ITEM_COUNTS) {
+    auto store = makeSceneStore(itemCount);
+    auto items = std::to_string(itemCount);
+
+    // Every item moving, so every item's gains are recalculated
+    SceneGainsCalculator changedCalculator(layout, MAX_DAW_CHANNELS);
+    runner.run("scene_gains_update", {{"items", items}, {"changed", "all"}},
+               [&]() { changedCalculator.update(store); });
+
+    // Just the bookkeeping of a store with nothing to recalculate
+    SceneGainsCalculator unchangedCalculator(layout, MAX_DAW_CHANNELS);
+    unchangedCalculator.update(store);
+    setChanged(store, false);
+    runner.run("scene_gains_update", {{"items", items}, {"changed", "none"}},
+               [&]() { unchangedCalculator.update(store); });
+
+    // The monitoring plugins rebuild both matrices after each update
+    runner.run("scene_gains_matrices", {{"items", items}}, [&]() {
+      auto direct = unchangedCalculator.directGains();
+      auto diffuse = unchangedCalculator.diffuseGains();
+      doNotOptimize(direct);
+      doNotOptimize(diffuse);
+    });
+  }
+}
+
+void sceneStoreCoding(Runner& runner) {
+  for (auto itemCount : ITEM_COUNTS) {
+    auto store = makeSceneStore(itemCount);
+    auto items = std::to_string(itemCount);
+
+    std::string encoded;
+    runner.run("scene_store_encode", {{"items", items}}, [&]() {
+      store.SerializeToString(&encoded);
+      doNotOptimize(encoded);
+    });
+
+    proto::SceneStore decoded;
+    runner.run("scene_store_decode",
+               {{"items", items}, {"bytes", std::to_string(encoded.size())}},
+               [&]() {
+                 decoded.ParseFromString(encoded);
+                 doNotOptimize(decoded);
+               });
+  }
+}
+
+void typeMetadataConversion(Runner& runner) {
+  std::unique_ptr<proto::DirectSpeakersTypeMetadata> bed{
+      proto::convertPackFormatToEpsMetadata(0x0005)};  // 5.1+4H
+  runner.run("ds_conversion", {{"path", "convert"}}, [&]() {
+    auto converted = EpsToEarMetadataConverter::convert(*bed);
+    doNotOptimize(converted);
+  });
+  runner.run("ds_conversion", {{"path", "interned"}}, [&]() {
+    auto converted = EpsToEarMetadataConverter::convertInterned(*bed);
+    doNotOptimize(converted);
+  });
+
+  proto::HoaTypeMetadata hoa;
+  hoa.set_packformatidvalue(0x0003);
+  runner.run("hoa_conversion", {{"path", "convert"}}, [&]() {
+    auto converted = EpsToEarMetadataConverter::convert(hoa);
+    doNotOptimize(converted);
+  });
+  runner.run("hoa_conversion", {{"path", "interned"}}, [&]() {
+    auto converted = EpsToEarMetadataConverter::convertInterned(hoa);
+    doNotOptimize(converted);
+  });
+}
+
+// One programme of mono objects, as the Scene serializes at export
+std::pair<proto::ProgrammeStore, ItemMap> makeAdmStores(int objectCount) {
+  std::pair<proto::ProgrammeStore, ItemMap> stores;
+  auto programme = stores.first.add_programme();
+  programme->set_name("Programme");
+  for (int i = 0; i < objectCount; ++i) {
+    auto id = communication::ConnectionId::generate();
+    auto& item = stores.second[id];
+    item.set_connection_id(id.string());
+    item.set_name("Object " + std::to_string(i + 1));
+    item.set_routing(i % MAX_DAW_CHANNELS);
+    item.set_input_instance_id(i + 1);
+    item.set_allocated_obj_metadata(newObjectMetadata(i));
+    programme->add_element()->mutable_object()->set_connection_id(id.string());
+  }
+  return stores;
+}
+
+std::shared_ptr<adm::Document> makeAdmTemplate(int objectCount) {
+  ProgrammeStoreAdmSerializer serializer;
+  return serializer.serialize(makeAdmStores(objectCount)).first;
+}
+
+// Export-time serialization: a new serializer, then one kept from a previous
+// export with the session unchanged, and with one object renamed each time
+void admSerialize(Runner& runner) {
+  for (auto objectCount : ADM_OBJECT_COUNTS) {
+    auto stores = makeAdmStores(objectCount);
+    auto objects = std::to_string(objectCount);
+
+    runner.run("adm_serialize", {{"session", "new"}, {"objects", objects}},
+               [&]() {
+                 ProgrammeStoreAdmSerializer serializer;
+                 auto result = serializer.serialize(stores);
+                 doNotOptimize(result);
+               });
+
+    ProgrammeStoreAdmSerializer serializer;
+    serializer.serialize(stores);
+    runner.run("adm_serialize", {{"session", "unchanged"}, {"objects", objects}},
+               [&]() {
+                 auto result = serializer.serialize(stores);
+                 doNotOptimize(result);
+               });
+
+    auto& renamed = stores.second.begin()->second;
+    bool toggle = false;
+    runner.run("adm_serialize", {{"session", "one_renamed"}, {"objects", objects}},
+               [&]() {
+                 toggle = !toggle;
+                 renamed.set_name(toggle ? "Renamed" : "Object");
+                 auto result = serializer.serialize(stores);
+                 doNotOptimize(result);
+               });
+  }
+}
+
+// Scene -> extension template handoff at render start: serialize in the
+// Scene, then rebuild the document in the extension
+void admTemplateHandoff(Runner& runner) {
+  for (auto objectCount : ADM_OBJECT_COUNTS) {
+    auto document = makeAdmTemplate(objectCount);
+    auto objects = std::to_string(objectCount);
+
+    std::stringstream xmlStream;
+    adm::writeXml(xmlStream, document);
+    runner.run("adm_template_handoff",
+               {{"format", "xml"},
+                {"objects", objects},
+                {"bytes", std::to_string(xmlStream.str().size())}},
+               [&]() {
+                 std::stringstream out;
+                 adm::writeXml(out, document);
+                 std::istringstream in(out.str());
+                 auto parsed = adm::parseXml(
+                     in, adm::xml::ParserOptions::recursive_node_search);
+                 doNotOptimize(parsed);
+               });
+
+    runner.run("adm_template_handoff",
+               {{"format", "binary"},
+                {"objects", objects},
+                {"bytes",
+                 std::to_string(AdmTemplateCodec::encode(*document).size())}},
+               [&]() {
+                 auto decoded =
+                     AdmTemplateCodec::decode(AdmTemplateCodec::encode(*document));
+                 doNotOptimize(decoded);
+               });
+  }
+}
+
+}  // namespace
+
+void runMetadataBenchmarks(Runner& runner) {
+  sceneGainsCalculator(runner);
+  sceneStoreCoding(runner);
+  typeMetadataConversion(runner);
+  admSerialize(runner);
+  admTemplateHandoff(runner);
+}
+
+}  // namespace benchmark
+}  // namespace plugin
+}  // namespace ear
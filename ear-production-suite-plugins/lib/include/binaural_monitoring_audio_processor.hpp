@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
+#include <optional>
 #include <vector>
 #include <string>
 #include <../src/dynamic_renderer.hpp>
+#include "listener_orientation_track.hpp"
+#include "silence_detector.hpp"
 #include "variable_block_adapter.hpp"
 #include <chrono>
 #include <mutex>
@@ -28,6 +32,11 @@ struct BearStatus {
  * @brief Binaural monitoring plugin dsp implementation
  *
  * This class handles the actual DSP by wrapping BEAR
+ *
+ * Inputs found silent by checkSilence() keep their BEAR channel, so the
+ * channel numbering BEAR was configured with stays stable, but their metadata
+ * is not submitted and BEAR renders nothing for them. BEAR's reverb and
+ * filter tails are let ring out first; see silenceHoldSamples().
  */
 class BinauralMonitoringAudioProcessor {
  public:
@@ -45,6 +54,9 @@ class BinauralMonitoringAudioProcessor {
    * changed - it which case this class can be reconstructed and a glitch in
    * audio is acceptable.
    *
+   * BEAR itself runs at listenerUpdatePeriod(blockSize), several periods to
+   * a block, so the listener's orientation can change within a block.
+   *
    * @param objChannels number of object channels to support
    * @param dsChannels number of directspeakers channels to support
    * @param hoaChannels number of HOA channels to support
@@ -71,10 +83,33 @@ class BinauralMonitoringAudioProcessor {
     doProcess((float**)InTraits::getChannels(in), InTraits::channelCount(in));
   }
 
+  /// Call with the block's input before pushing its metadata
+  template <typename InBuffer>
+  void checkSilence(const InBuffer& in) {
+    using InTraits = BufferTraits<InBuffer>;
+    auto const samples = static_cast<std::size_t>(InTraits::size(in));
+    for (std::size_t channel = 0;
+         channel < static_cast<std::size_t>(InTraits::channelCount(in));
+         ++channel) {
+      silence_.check(channel, InTraits::getChannel(in, channel), samples);
+    }
+  }
+
+  /// Samples an input must stay silent for before it is skipped
+  static std::size_t silenceHoldSamples(std::size_t sampleRate,
+                                        std::size_t blockSize);
+
+  /// Counts since the last call
+  SkipCounts takeSkipCounts();
+
   bool pushBearMetadata(size_t channelNum, ear::ObjectsTypeMetadata* metadata);
   bool pushBearMetadata(size_t channelNum,
-                        ear::DirectSpeakersTypeMetadata* metadata);
-  bool pushBearMetadata(size_t channelNum, ear::HOATypeMetadata* metadata,
+                        const ear::DirectSpeakersTypeMetadata* metadata);
+  /// HOA streams with the same orders and normalization are summed into one
+  /// bus before BEAR, so BEAR renders one stream per HOA format rather than
+  /// one per item. A summed stream keeps the identifier of the first pushed,
+  /// and is only submitted when one of its sources is active.
+  bool pushBearMetadata(size_t channelNum, const ear::HOATypeMetadata* metadata,
                         size_t arbitraryStreamIdentifier);
 
   std::size_t delayInSamples() const;
@@ -83,6 +118,17 @@ class BinauralMonitoringAudioProcessor {
 
   void setListenerOrientation(float quatW, float quatX, float quatY,
                               float quatZ);
+  /// Head tracking to follow, each BEAR period, instead of the orientation
+  /// from setListenerOrientation() while the track has recent samples.
+  /// Processing is the track's consumer. Not owned; may be null.
+  void setListenerOrientationTrack(ListenerOrientationTrack* track) {
+    orientationTrack_ = track;
+  }
+
+  static constexpr std::size_t MAX_LISTENER_UPDATE_PERIOD = 256;
+  /// The largest divisor of the block size up to MAX_LISTENER_UPDATE_PERIOD,
+  /// or the block size if that would make for very short periods
+  static std::size_t listenerUpdatePeriod(std::size_t blockSize);
 
   bool rendererStarted() { return bearRenderer && bearStatus.startupSuccess == SUCCEEDED; }
 
@@ -93,6 +139,11 @@ class BinauralMonitoringAudioProcessor {
 
  private:
   void doProcess(float** channelPointers, size_t maxChannels);
+  void updateListener(ListenerOrientationTrack::Clock::time_point time);
+
+  std::size_t blockSize_;
+  std::size_t period_;
+  ListenerOrientationTrack::Clock::duration periodDuration_;
 
   uint64_t framesProcessed{0};
   bool isPlaying{false};
@@ -103,8 +154,13 @@ class BinauralMonitoringAudioProcessor {
   bear::Listener bearListener;
   BearStatus bearStatus;
 
-  bool listenerQuatsDirty{false};
-  std::array<double, 4> listenerQuats{1.0, 0.0, 0.0, 0.0};
+  // From setListenerOrientation()
+  ListenerOrientation::Quaternion manualOrientation_{1.0, 0.0, 0.0, 0.0};
+  // Last applied, in BEAR's axes
+  std::array<double, 4> bearListenerQuats{1.0, 0.0, 0.0, 0.0};
+
+  ListenerOrientationTrack* orientationTrack_{nullptr};
+  ListenerOrientationSmoother listenerSmoother_;
 
   bear::Time metadataRtime;
   bear::Time metadataDuration;
@@ -115,6 +171,25 @@ class BinauralMonitoringAudioProcessor {
   std::vector<int> dsChannelMappings;
   std::vector<int> hoaChannelMappings;
 
+  SilenceDetector silence_;
+  SkipCounts skipCounts_;
+  bool isActive(size_t startingChannel, size_t channelCount) const;
+
+  // HOA streams pushed this block, by format. Submitted to BEAR in doProcess,
+  // once all sources are known.
+  struct HoaBus {
+    std::vector<int> orders;
+    std::vector<int> degrees;
+    std::string normalization;
+    size_t firstBearChannel;
+    std::vector<size_t> sourceStartingChannels;
+    size_t streamIdentifier;
+    bear::HOAInput input;
+  };
+  std::vector<HoaBus> hoaBuses;
+  // Where buses with more than one source are summed, per BEAR HOA channel
+  std::vector<std::vector<float>> hoaBusBuffers;
+
   // Bear temp buffers - Save redeclaring on each process call
   std::vector<float> reusableZeroedChannel;
   std::vector<float*>
@@ -122,6 +197,11 @@ class BinauralMonitoringAudioProcessor {
   std::vector<float*> bearObjectInputBuffers_RawPointers;
   std::vector<float*> bearDirectSpeakersInputBuffers_RawPointers;
   std::vector<float*> bearHoaInputBuffers_RawPointers;
+  // The above, offset to the BEAR period being processed
+  std::vector<float*> bearPeriodOutputBuffers_RawPointers;
+  std::vector<float*> bearPeriodObjectInputBuffers_RawPointers;
+  std::vector<float*> bearPeriodDirectSpeakersInputBuffers_RawPointers;
+  std::vector<float*> bearPeriodHoaInputBuffers_RawPointers;
 };
 
 }  // namespace plugin
@@ -6,6 +6,7 @@
 #include "ear-plugin-base/export.h"
 #include "scene_gains_calculator.hpp"
 #include "listener_orientation.hpp"
+#include "helper/eps_to_ear_metadata_converter.hpp"
 
 #include <string>
 #include <memory>
@@ -47,14 +48,15 @@ class BinauralMonitoringBackend {
     ear::ObjectsTypeMetadata earMetadata;
   };
 
+  // Interned, so copying these out for each block is cheap
   struct DirectSpeakersEarMetadataAndRouting {
     int startingChannel;
-    std::vector<ear::DirectSpeakersTypeMetadata> earMetadata;
+    InternedDirectSpeakersMetadata earMetadata;
   };
 
   struct HoaEarMetadataAndRouting {
     int startingChannel;
-    ear::HOATypeMetadata earMetadata;
+    InternedHoaMetadata earMetadata;
   };
 
   std::optional<ObjectsEarMetadataAndRouting> getLatestObjectsTypeMetadata(
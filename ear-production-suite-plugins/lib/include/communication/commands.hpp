@@ -148,10 +148,49 @@ class MonitoringConnectionDetailsResponse {
   std::string endpoint_;
 };
 
+/**
+ * @brief Register input plugins in a single request
+ *
+ * Each id is handled as a `NewConnectionMessage` followed by an
+ * `ObjectDetailsMessage`, so an id already in use is replaced by a new one.
+ */
+class RegisterInputsMessage {
+ public:
+  explicit RegisterInputsMessage(std::vector<ConnectionId> connectionIds)
+      : connectionIds_(std::move(connectionIds)),
+        protocolVersion_(CURRENT_PROTOCOL_VERSION) {}
+
+  const std::vector<ConnectionId>& connectionIds() const {
+    return connectionIds_;
+  }
+  uint32_t protocolVersion() const { return protocolVersion_; }
+
+ private:
+  std::vector<ConnectionId> connectionIds_;
+  uint32_t protocolVersion_;
+};
+
+class RegisterInputsResponse {
+ public:
+  RegisterInputsResponse(std::vector<ConnectionId> connectionIds,
+                         const std::string& metadataEndpoint)
+      : connectionIds_(std::move(connectionIds)), endpoint_(metadataEndpoint) {}
+
+  /// The assigned ids, in the order they were requested
+  const std::vector<ConnectionId>& connectionIds() const {
+    return connectionIds_;
+  }
+  std::string metadataEndpoint() const { return endpoint_; }
+
+ private:
+  std::vector<ConnectionId> connectionIds_;
+  std::string endpoint_;
+};
+
 using RequestVariant =
     boost::variant<NewConnectionMessage, CloseConnectionMessage,
                    ObjectDetailsMessage, ItemPropertiesChangedMessage,
-                   MonitoringConnectionDetailsMessage>;
+                   MonitoringConnectionDetailsMessage, RegisterInputsMessage>;
 class Request : public RequestVariant {
  public:
   Request(const RequestVariant& value) : RequestVariant(value) {}
@@ -160,7 +199,7 @@ class Request : public RequestVariant {
 using ResponsePayloadVariant =
     boost::variant<GenericResponse, NewConnectionResponse,
                    CloseConnectionResponse, ConnectionDetailsResponse,
-                   MonitoringConnectionDetailsResponse>;
+                   MonitoringConnectionDetailsResponse, RegisterInputsResponse>;
 
 /**
  * @brief Wraps the response send to a client
@@ -255,6 +294,8 @@ MessageBuffer serialize(const ConnectionDetailsResponse& msg);
 MessageBuffer serialize(const ItemPropertiesChangedMessage& msg);
 MessageBuffer serialize(const MonitoringConnectionDetailsMessage& msg);
 MessageBuffer serialize(const MonitoringConnectionDetailsResponse& msg);
+MessageBuffer serialize(const RegisterInputsMessage& msg);
+MessageBuffer serialize(const RegisterInputsResponse& msg);
 MessageBuffer serializeErrorResponse(ErrorCode errorCode,
                                      const std::string& message);
 
@@ -16,6 +16,7 @@ class DataWrapper {
   void writeAccess(FunctionT&& accessor) {
     std::lock_guard<std::mutex> lock{mutex_};
     data_.set_changed(true);
+    data_.set_continuity_counter(data_.continuity_counter() + 1);
     std::invoke(accessor, &data_);
   }
 
@@ -26,6 +27,19 @@ class DataWrapper {
     return std::invoke(accessor, data);
   }
 
+  // Serializes through writer (e.g. in to shared memory), clearing the
+  // changed flag if it reports success
+  template <typename FunctionT>
+  bool serializeWith(FunctionT&& writer) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto const& data{data_};
+    if (!std::invoke(writer, data)) {
+      return false;
+    }
+    data_.set_changed(false);
+    return true;
+  }
+
   MessageBuffer prepareMessage() {
     std::lock_guard<std::mutex> lock{mutex_};
     MessageBuffer buffer = allocBuffer(data_.ByteSizeLong());
@@ -34,6 +48,22 @@ class DataWrapper {
     return buffer;
   }
 
+  // A message carrying only the connection id and the version of the data,
+  // telling the Scene the input is still there and unchanged
+  MessageBuffer prepareHeartbeat() {
+    proto::InputItemMetadata heartbeat;
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      heartbeat.set_connection_id(data_.connection_id());
+      heartbeat.set_continuity_counter(data_.continuity_counter());
+    }
+    heartbeat.set_changed(false);
+    heartbeat.set_heartbeat(true);
+    MessageBuffer buffer = allocBuffer(heartbeat.ByteSizeLong());
+    heartbeat.SerializeToArray(buffer.data(), buffer.size());
+    return buffer;
+  }
+
  private:
   proto::InputItemMetadata data_;
   std::mutex mutex_;
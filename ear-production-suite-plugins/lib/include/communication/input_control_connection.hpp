@@ -65,6 +65,10 @@ class InputControlConnection {
   void connected();
   void disconnected();
   void handshake(ConnectionId const& id);
+  // One round trip; false if the Scene doesn't support it
+  bool registerInput(std::string& streamEndpoint);
+  // NewConnectionMessage then ObjectDetailsMessage
+  bool requestConnectionAndDetails(std::string& streamEndpoint);
   void disconnect();
   mutable std::mutex stateMutex_;
   std::shared_ptr<spdlog::logger> logger_;
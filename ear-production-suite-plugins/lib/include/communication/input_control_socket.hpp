@@ -19,6 +19,7 @@ EAR_PLUGIN_BASE_EXPORT class InputControlSocket {
   void requestNewConnection(ConnectionId const& id);
   void requestCloseConnection(ConnectionId const& id);
   void requestObjectDetails(ConnectionId const& id);
+  void requestRegisterInputs(std::vector<ConnectionId> const& ids);
 
   [[nodiscard]]
   Response receive();
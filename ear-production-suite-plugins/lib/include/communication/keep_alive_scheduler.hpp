@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ear::plugin::communication {
+
+/**
+ * @brief Runs periodic tasks for many senders from a single thread
+ *
+ * Every `interval` the scheduler calls each registered task in turn, so a
+ * process with hundreds of input plugins has one timer, not one per input.
+ * Tasks are passed a tick count, which they can use to spread occasional
+ * heavier work (e.g. a full resend) across ticks.
+ *
+ * Tasks run without the scheduler's lock held, so a task that blocks only
+ * holds up those after it in the pass, not add() or remove() of others.
+ *
+ * The thread only runs while there are tasks: add() starts it and the remove()
+ * of the last task joins it. So once every sender has gone there's no thread
+ * left for the destructor to join - it may run during static destruction
+ * (e.g. under the Windows loader lock) where joining could deadlock.
+ */
+class KeepAliveScheduler {
+ public:
+  using Task = std::function<void(std::uint64_t tick)>;
+  using TaskId = std::uint64_t;
+
+  explicit KeepAliveScheduler(std::chrono::milliseconds interval);
+  ~KeepAliveScheduler();
+  KeepAliveScheduler(const KeepAliveScheduler&) = delete;
+  KeepAliveScheduler& operator=(const KeepAliveScheduler&) = delete;
+
+  /// The scheduler shared by all MetadataSenders in this module
+  static KeepAliveScheduler& metadataSenders();
+
+  TaskId add(Task task);
+  /// Once this returns the task is not running and won't be called again.
+  /// Waits only for this task, if it is running, or for the thread to exit
+  /// if this was the last task. Must not be called from a task.
+  void remove(TaskId id);
+
+  std::chrono::milliseconds interval() const { return interval_; }
+
+ private:
+  struct Entry {
+    Task task;
+    bool running{false};
+    bool removed{false};
+  };
+
+  void run();
+
+  const std::chrono::milliseconds interval_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  // Signalled when a task finishes, for remove() to wait on
+  std::condition_variable taskDone_;
+  std::map<TaskId, std::shared_ptr<Entry>> tasks_;
+  // The tasks of the current pass, kept to reuse its storage
+  std::vector<std::shared_ptr<Entry>> due_;
+  TaskId nextId_{0};
+  std::uint64_t tick_{0};
+  bool stop_{false};
+  // Cleared by run() as it exits, once it has no tasks left
+  bool threadRunning_{false};
+  std::thread thread_;
+};
+
+}  // namespace ear::plugin::communication
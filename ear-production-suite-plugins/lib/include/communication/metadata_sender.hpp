@@ -3,12 +3,16 @@
 #include <mutex>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 #include "common_types.hpp"
 #include "log.hpp"
 #include "message_buffer.hpp"
 #include "data_wrapper.hpp"
+#include "keep_alive_scheduler.hpp"
+#include "metadata_slot_table.hpp"
 #include "nng-cpp/nng.hpp"
 
 namespace ear::plugin::communication {
@@ -22,21 +26,27 @@ class MetadataSender {
                ConnectionId id);
   ConnectionId connectionId();
   void disconnect();
-  void triggerSend(bool force = false);
+  /// @returns true if metadata was sent (or queued to send)
+  bool triggerSend(bool force = false);
   void logger(std::shared_ptr<spdlog::logger> logger);
  private:
-  void startTimer();
-  void handleTimeout(std::error_code ec);
+  void keepAlive(std::uint64_t tick);
+  void stopKeepAlive();
+  void sendHeartbeat();
+  void openSlot();
+  void closeSlot();
+  bool sendToSlot();
   DataWrapper& data_;
   std::shared_ptr<spdlog::logger> logger_;
   nng::PushSocket socket_;
-  nng::AsyncIO timer_;
   nng::Dialer dialer_;
-  std::mutex timeoutMutex_;
+  // Used in place of the socket when the Scene provides a slot table
+  std::unique_ptr<MetadataSlotTable> slotTable_;
+  std::optional<MetadataSlotTable::SlotHandle> slot_;
   std::mutex sendMutex_;
   ConnectionId connectionId_;
-  std::chrono::system_clock::time_point lastSendTimestamp_;
-  std::chrono::milliseconds maxSendInterval_;
-  std::atomic<bool> timerRunning{false};
+  std::optional<KeepAliveScheduler::TaskId> keepAliveTask_;
+  // Set by every send, so ticks after recent traffic do nothing
+  std::atomic<bool> sentSinceLastTick_{false};
 };
 }
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "common_types.hpp"
+#include "input_item_metadata.pb.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+namespace communication {
+
+/**
+ * @brief Shared memory table of input item metadata, one slot per input
+ *
+ * The Scene creates the table; input plugins open it when they connect,
+ * claim a slot and overwrite it with their serialized `InputItemMetadata`
+ * whenever it changes. Each slot is guarded by a sequence lock, so writers
+ * never wait on the Scene and the Scene never waits on a writer: it scans
+ * the table once per block and picks up every slot written since its last
+ * scan.
+ *
+ * Metadata that doesn't fit in a slot, or inputs that can't get a slot,
+ * still go through the nng metadata socket.
+ */
+class MetadataSlotTable {
+ public:
+  enum class Mode { CREATE, OPEN };
+
+  static constexpr std::size_t SLOT_COUNT = 1024;
+  static constexpr std::size_t PAYLOAD_CAPACITY = 4096;
+
+  /// A claim on a slot; it lapses if the Scene frees the slot
+  struct SlotHandle {
+    std::size_t index;
+    std::uint32_t generation;
+  };
+
+  using Handler =
+      std::function<void(ConnectionId, const proto::InputItemMetadata&)>;
+
+  /**
+   * @param name shared memory object name
+   * @param mode CREATE replaces any table left behind under `name`, OPEN
+   * attaches to an existing one
+   * @throws std::runtime_error if the table can't be created or opened
+   */
+  MetadataSlotTable(const std::string& name, Mode mode);
+  ~MetadataSlotTable();
+  MetadataSlotTable(const MetadataSlotTable&) = delete;
+  MetadataSlotTable& operator=(const MetadataSlotTable&) = delete;
+
+  /// @returns the claimed slot, or nothing if the table is full
+  std::optional<SlotHandle> claim(const ConnectionId& id);
+  /// Does nothing if the claim has lapsed
+  void release(const SlotHandle& slot);
+  /// Frees any slot held by `id`, for inputs that went away without doing so
+  void release(const ConnectionId& id);
+
+  /// @returns false, leaving the slot untouched, if `item` is too large or
+  /// the claim has lapsed
+  bool write(const SlotHandle& slot, const proto::InputItemMetadata& item);
+
+  /**
+   * @brief Calls `handler` for every slot written since the previous call
+   *
+   * Only one instance, the Scene's, should poll a table.
+   */
+  void poll(const Handler& handler);
+
+ private:
+  struct Mapping;
+  std::unique_ptr<Mapping> mapping_;
+  std::vector<std::uint32_t> lastSequences_;
+  std::vector<unsigned char> readBuffer_;
+  proto::InputItemMetadata readItem_;
+};
+
+}  // namespace communication
+}  // namespace plugin
+}  // namespace ear
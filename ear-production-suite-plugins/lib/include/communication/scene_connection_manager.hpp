@@ -65,6 +65,8 @@ class SceneConnectionManager {
       const communication::MonitoringConnectionDetailsMessage&);
   communication::CloseConnectionResponse doHandle(
       const communication::CloseConnectionMessage&);
+  communication::RegisterInputsResponse doHandle(
+      const communication::RegisterInputsMessage&);
   template <typename T>
   communication::Response doHandle(
       const T& /*catch-all-remove-me-later-or-make-an-static-assert*/) {
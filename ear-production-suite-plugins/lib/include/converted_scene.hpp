@@ -0,0 +1,46 @@
+#pragma once
+
+#include "communication/common_types.hpp"
+#include "helper/eps_to_ear_metadata_converter.hpp"
+#include "scene_store.pb.h"
+#include <ear/metadata.hpp>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+
+/// One monitoring item's metadata, converted for libear
+struct ConvertedItem {
+  int routing{-1};
+  /// Converted by the latest update, rather than carried over
+  bool changed{true};
+  std::optional<ObjectsTypeMetadata> objects;
+  /// Shared with other items using the same pack format; null if not set
+  InternedDirectSpeakersMetadata directSpeakers;
+  InternedHoaMetadata hoa;
+};
+
+/**
+ * @brief The Scene's monitoring items converted to libear metadata
+ *
+ * Only items flagged as changed (or not seen before) are converted on each
+ * update, so a scene can be converted once and then shared between gain
+ * calculators for any number of layouts.
+ */
+class ConvertedScene {
+ public:
+  /// @throws std::runtime_error for Binaural or Matrix type items
+  void update(const proto::SceneStore& store);
+
+  const std::map<communication::ConnectionId, ConvertedItem>& items() const {
+    return items_;
+  }
+
+ private:
+  std::map<communication::ConnectionId, ConvertedItem> items_;
+};
+
+}  // namespace plugin
+}  // namespace ear
@@ -0,0 +1,40 @@
+#pragma once
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/null_mutex.h>
+#include <memory>
+
+namespace ear {
+namespace plugin {
+namespace detail {
+
+class LogBackend;
+
+/**
+ * Sink which only copies the already formatted message in to a fixed size
+ * record on the calling thread's queue - no locks, allocations or I/O.
+ *
+ * A LogBackend thread drains the queues of every thread, applies the pattern
+ * and sends the result to the logging server (and the EPS_LOG_FILE file, if
+ * that environment variable is set). If a thread's queue is full the message
+ * is dropped and the backend reports how many were lost, as it does for
+ * messages that found no server listening once one connects.
+ *
+ * Queues come from a pool allocated along with the first logger; the first
+ * message logged from a thread takes one without locking.
+ */
+class AsyncLogSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+ public:
+  AsyncLogSink();
+  ~AsyncLogSink() override;
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+  void flush_() override {}
+
+ private:
+  std::shared_ptr<LogBackend> backend_;
+};
+
+}  // namespace detail
+}  // namespace plugin
+}  // namespace ear
@@ -24,6 +24,10 @@ static const char* SCENE_MASTER_SCENE_STREAM_ENDPOINT =
     "ipc:///tmp/ear-production-suite-sm-scene";
 #endif
 
+// Shared memory, so named without a path on either platform
+static const char* SCENE_MASTER_METADATA_SLOTS =
+    "ear-production-suite-sm-meta-slots";
+
 static const char* MORE_INFO_URL =
     "https://ear-production-suite.ebu.io/";
 }  // namespace detail
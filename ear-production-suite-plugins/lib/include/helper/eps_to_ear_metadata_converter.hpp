@@ -4,11 +4,18 @@
 #include "helper/adm_preset_definitions_helper.h"
 #include <string>
 #include <memory>
+#include <vector>
 #include <adm/detail/id_parser.hpp>
 
 namespace ear {
 namespace plugin {
 
+/// Converted DirectSpeakers or HOA metadata, shared between every item using
+/// the same pack format
+using InternedDirectSpeakersMetadata =
+    std::shared_ptr<const std::vector<ear::DirectSpeakersTypeMetadata>>;
+using InternedHoaMetadata = std::shared_ptr<const ear::HOATypeMetadata>;
+
 struct EpsToEarMetadataConverter {
   static ear::ObjectsTypeMetadata convert(
       const proto::ObjectsTypeMetadata &epsMetadata) {
@@ -66,23 +73,32 @@ struct EpsToEarMetadataConverter {
       earMetadata.orders.resize(cfData.size());
 
       for (int channelNum = 0; channelNum < cfData.size(); channelNum++) {
-        auto bfData =
-            cfData[channelNum]
-                ->channelFormat->getElements<adm::AudioBlockFormatHoa>();
-        int order = bfData[0].get<adm::Order>().get();
-        int degree = bfData[0].get<adm::Degree>().get();
-        earMetadata.degrees[channelNum] = degree;
-        earMetadata.orders[channelNum] = order;
+        // Taken from the first block format when the preset tables were built
+        earMetadata.degrees[channelNum] = cfData[channelNum]->hoaDegree.value_or(0);
+        earMetadata.orders[channelNum] = cfData[channelNum]->hoaOrder.value_or(0);
 
-        if (channelNum == 0) {
-          std::string normalisation = bfData[0].get<adm::Normalization>().get();
-          earMetadata.normalization = normalisation;
+        if (channelNum == 0 && cfData[channelNum]->hoaNormalization) {
+          earMetadata.normalization = *cfData[channelNum]->hoaNormalization;
         }
       }
     }
 
     return earMetadata;
   }
+
+  /**
+   * DirectSpeakers and HOA metadata are fully determined by the pack format,
+   * so each pack format is converted once and the result kept for the
+   * lifetime of the process. Later calls cost a hash lookup.
+   *
+   * DirectSpeakers metadata whose speakers don't match those already
+   * converted for its pack format (e.g. set by hand, not from the preset
+   * definitions) is converted afresh and not kept.
+   */
+  static InternedDirectSpeakersMetadata convertInterned(
+      const proto::DirectSpeakersTypeMetadata &epsMetadata);
+  static InternedHoaMetadata convertInterned(
+      const proto::HoaTypeMetadata &epsMetadata);
 };
 
 }  // namespace plugin
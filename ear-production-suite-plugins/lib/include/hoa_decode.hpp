@@ -0,0 +1,26 @@
+#pragma once
+#include <Eigen/Core>
+#include <memory>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+
+/**
+ * @brief Static decode of one HOA item to a speaker layout
+ *
+ * HOA decode gains only change with the item's order and normalization, so
+ * they are applied as a plain matrix product rather than interpolated per
+ * sample like the gains of other items. Items with the same order and
+ * normalization share one matrix.
+ */
+struct HoaDecode {
+  int inputStartingChannel;
+  /// Output channels x HOA channels
+  std::shared_ptr<const Eigen::MatrixXf> gains;
+};
+
+using HoaDecodes = std::vector<HoaDecode>;
+
+}  // namespace plugin
+}  // namespace ear
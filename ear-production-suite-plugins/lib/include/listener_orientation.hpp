@@ -30,6 +30,8 @@ class ListenerOrientation {
   EAR_PLUGIN_BASE_EXPORT Quaternion getQuaternion();
   EAR_PLUGIN_BASE_EXPORT void setQuaternion(Quaternion q);
 
+  EAR_PLUGIN_BASE_EXPORT static Quaternion toQuaternion(Euler e);
+
   class QuaternionListener {
    public:
     EAR_PLUGIN_BASE_EXPORT QuaternionListener();
@@ -61,7 +63,6 @@ class ListenerOrientation {
   std::optional<Quaternion> quatOutput;
 
   Euler toEuler(Quaternion q, EulerOrder o);
-  Quaternion toQuaternion(Euler e);
 
   std::vector<QuaternionListener*> quatListeners;
   std::vector<EulerListener*> eulerListeners;
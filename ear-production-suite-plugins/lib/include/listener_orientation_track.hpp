@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "listener_orientation.hpp"
+#include "ear-plugin-base/export.h"
+
+namespace ear {
+namespace plugin {
+
+// Timestamped head tracker orientations, handed from the thread receiving
+// them (e.g. the OSC thread) to the audio thread without locks, so the
+// renderer can follow the head between its blocks rather than once per block.
+//
+// One thread pushes and one other thread calls update() and orientationAt().
+// Pushing never blocks or allocates; samples are dropped if the audio thread
+// falls a full ring behind.
+//
+// Orientations are extrapolated from the latest sample and the one before it
+// at least MIN_SAMPLE_INTERVAL older, both to fill in between samples and to
+// make up for latency the tracker is known to have (see setPrediction()).
+// Once no sample has arrived for MAX_EXTRAPOLATION the head has most likely
+// stopped, so the extrapolation eases back to the latest sample over
+// EXTRAPOLATION_DECAY rather than holding its overshoot.
+class ListenerOrientationTrack {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Quaternion = ListenerOrientation::Quaternion;
+
+  // Further than this past the latest sample, the head is assumed to be still
+  static constexpr std::chrono::milliseconds MAX_EXTRAPOLATION{100};
+  // How long the extrapolation then takes to return to the latest sample
+  static constexpr std::chrono::milliseconds EXTRAPOLATION_DECAY{100};
+  // With no samples for this long, the track is ignored
+  static constexpr std::chrono::milliseconds STALE_AFTER{500};
+  // Samples closer together than this give too noisy a velocity to
+  // extrapolate from - e.g. the separate yaw, pitch and roll messages of
+  // some trackers
+  static constexpr std::chrono::milliseconds MIN_SAMPLE_INTERVAL{5};
+
+  EAR_PLUGIN_BASE_EXPORT explicit ListenerOrientationTrack(
+      std::size_t capacity = 256);
+  EAR_PLUGIN_BASE_EXPORT ~ListenerOrientationTrack();
+
+  // Producer thread only
+  EAR_PLUGIN_BASE_EXPORT bool push(Quaternion orientation,
+                                   Clock::time_point received) noexcept;
+
+  // How far ahead of the latest samples to predict. Any thread.
+  EAR_PLUGIN_BASE_EXPORT void setPrediction(
+      std::chrono::microseconds prediction) noexcept;
+  EAR_PLUGIN_BASE_EXPORT std::chrono::microseconds prediction() const noexcept;
+
+  // Consumer thread only. Takes in everything pushed so far.
+  EAR_PLUGIN_BASE_EXPORT void update() noexcept;
+  // Consumer thread only. The orientation expected at `time` plus the
+  // prediction, or nothing if the track is empty or stale at `time`. The
+  // prediction isn't limited by MAX_EXTRAPOLATION, only the time since the
+  // latest sample is.
+  EAR_PLUGIN_BASE_EXPORT std::optional<Quaternion> orientationAt(
+      Clock::time_point time) const noexcept;
+  // Consumer thread only
+  EAR_PLUGIN_BASE_EXPORT std::optional<Clock::time_point> latestReceived()
+      const noexcept;
+
+  // Shortest path from `from` (t = 0) to `to` (t = 1), extrapolating beyond
+  EAR_PLUGIN_BASE_EXPORT static Quaternion slerp(const Quaternion& from,
+                                                 const Quaternion& to,
+                                                 double t) noexcept;
+
+ private:
+  struct Sample {
+    Quaternion orientation;
+    Clock::time_point received;
+  };
+  struct Ring;
+  std::unique_ptr<Ring> ring_;
+  std::atomic<std::int64_t> predictionMicroseconds_{0};
+
+  // The most recent samples taken in, enough to reach back
+  // MIN_SAMPLE_INTERVAL at any likely tracker rate
+  static constexpr std::size_t HISTORY_SIZE = 16;
+  std::array<Sample, HISTORY_SIZE> history_{};
+  std::size_t historyCount_{0};
+  std::size_t newest_{0};
+};
+
+// Smooths the orientation a renderer follows, once per update period.
+//
+// Tracked orientations are eased towards over `trackSeconds`, to hide
+// corrections when a new sample disagrees with what was predicted. When the
+// track stops, the listener eases back to the orientation set by hand over
+// `handBackSeconds` rather than jumping to it; without a track the
+// orientation set by hand applies straight away.
+class ListenerOrientationSmoother {
+ public:
+  using Quaternion = ListenerOrientation::Quaternion;
+
+  EAR_PLUGIN_BASE_EXPORT ListenerOrientationSmoother(double periodSeconds,
+                                                     double trackSeconds,
+                                                     double handBackSeconds);
+
+  // The orientation for the next period
+  EAR_PLUGIN_BASE_EXPORT Quaternion
+  next(const std::optional<Quaternion>& tracked, const Quaternion& manual);
+  // Whether the last orientation came from the track, including handing back
+  bool following() const { return current_.has_value(); }
+
+ private:
+  double trackSmoothing_;
+  double handBackSmoothing_;
+  std::optional<Quaternion> current_;
+};
+
+}  // namespace plugin
+}  // namespace ear
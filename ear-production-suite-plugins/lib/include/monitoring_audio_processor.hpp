@@ -1,4 +1,6 @@
 #pragma once
+#include "hoa_decode.hpp"
+#include "silence_detector.hpp"
 #include "variable_block_adapter.hpp"
 #include "multichannel_convolver.hpp"
 #include "ear/dsp/dsp.hpp"
@@ -19,6 +21,14 @@ using GainMatrix = Eigen::MatrixXf;
  * i.e. given a target gain matrix for the direct and diffuse rendering path
  * plus a set of input samples and a place to store the output,
  * it will generate loudspeaker signals accordingly.
+ *
+ * HOA items are decoded by a separate static matrix each, added to the
+ * direct path without gain interpolation.
+ *
+ * Input channels that are silent for a whole block are left out of the gain
+ * interpolation and HOA decodes. The decorrelation filters run on the
+ * mixed output channels, so no input keeps a tail of its own and inputs are
+ * skipped from their first silent block.
  */
 class MonitoringAudioProcessor {
  public:
@@ -48,14 +58,18 @@ class MonitoringAudioProcessor {
 
   template <typename InBuffer, typename OutBuffer>
   void process(const InBuffer& in, OutBuffer& out, const GainMatrix& direct,
-               const GainMatrix& diffuse) {
+               const GainMatrix& diffuse, const HoaDecodes& hoa = {}) {
     nextDirectGains_ = direct;
     nextDiffuseGains_ = diffuse;
+    hoaDecodes_ = hoa;
     blockAdapter_.process(in, out);
   }
 
   std::size_t delayInSamples() const;
 
+  /// Counts since the last call
+  SkipCounts takeSkipCounts();
+
  private:
   void doBlockedProcess(const Eigen::Ref<const Eigen::MatrixXf>& in,
                         Eigen::Ref<Eigen::MatrixXf> out);
@@ -69,6 +83,14 @@ class MonitoringAudioProcessor {
   GainMatrix currentDiffuseGains_;
   GainMatrix nextDirectGains_;
   GainMatrix nextDiffuseGains_;
+  HoaDecodes hoaDecodes_;
+  SilenceDetector silence_;
+  SkipCounts skipCounts_;
+  // Reused each block, holding only the active inputs
+  std::vector<Eigen::Index> activeInputs_;
+  std::vector<const float*> activeInputPointers_;
+  std::vector<std::vector<float>> currentActiveGains_;
+  std::vector<std::vector<float>> nextActiveGains_;
   MultichannelConvolver convolver_;
 };
 
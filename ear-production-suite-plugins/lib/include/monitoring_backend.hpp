@@ -4,11 +4,12 @@
 #include "scene_store.pb.h"
 #include "log.hpp"
 #include "ear-plugin-base/export.h"
-#include "scene_gains_calculator.hpp"
+#include "multi_layout_gains_calculator.hpp"
 
 #include <string>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ear {
 namespace plugin {
@@ -24,13 +25,17 @@ class MonitoringBackend {
   EAR_PLUGIN_BASE_EXPORT MonitoringBackend(
       ui::MonitoringFrontendBackendConnector*, const Layout& targetLayout,
       int inputChannelCount);
+  /// Renders several layouts from one scene subscription and decode
+  EAR_PLUGIN_BASE_EXPORT MonitoringBackend(
+      ui::MonitoringFrontendBackendConnector*,
+      const std::vector<Layout>& targetLayouts, int inputChannelCount);
   EAR_PLUGIN_BASE_EXPORT ~MonitoringBackend();
   MonitoringBackend(const MonitoringBackend&) = delete;
   MonitoringBackend(MonitoringBackend&&) = delete;
   MonitoringBackend& operator=(MonitoringBackend&&) = delete;
   MonitoringBackend& operator=(const MonitoringBackend&) = delete;
 
-  GainHolder currentGains();
+  GainHolder currentGains(std::size_t layoutIndex = 0);
 
   bool isExporting() { return isExporting_; }
 
@@ -43,9 +48,9 @@ class MonitoringBackend {
 
   std::shared_ptr<spdlog::logger> logger_;
   std::mutex gainsMutex_;
-  GainHolder gains_;
+  std::vector<GainHolder> gains_;
   std::mutex gainsCalculatorMutex_;
-  SceneGainsCalculator gainsCalculator_;
+  MultiLayoutGainsCalculator gainsCalculator_;
   ui::MonitoringFrontendBackendConnector* frontendConnector_;
   std::unique_ptr<communication::MonitoringMetadataReceiver> metadataReceiver_;
   communication::MonitoringControlConnection controlConnection_;
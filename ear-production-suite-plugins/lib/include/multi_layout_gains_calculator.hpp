@@ -0,0 +1,48 @@
+#pragma once
+
+#include "communication/metadata_thread.hpp"
+#include "converted_scene.hpp"
+#include "scene_gains_calculator.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+
+/**
+ * @brief Gains for several speaker layouts from one scene
+ *
+ * Each scene update is converted to libear metadata once, then every
+ * layout's gains are calculated from that in parallel - the first layout on
+ * the calling thread and each further layout on a worker thread of its own.
+ */
+class MultiLayoutGainsCalculator {
+ public:
+  MultiLayoutGainsCalculator(const std::vector<Layout>& outputLayouts,
+                             int inputChannelCount);
+  ~MultiLayoutGainsCalculator();
+  MultiLayoutGainsCalculator(const MultiLayoutGainsCalculator&) = delete;
+  MultiLayoutGainsCalculator& operator=(const MultiLayoutGainsCalculator&) =
+      delete;
+
+  /// Returns once every layout's gains are up to date
+  bool update(const proto::SceneStore& store);
+
+  std::size_t layoutCount() const { return calculators_.size(); }
+  /// Gains as of the last update, in the order the layouts were given
+  const GainHolder& gains(std::size_t layoutIndex) const {
+    return gains_.at(layoutIndex);
+  }
+
+ private:
+  void updateLayout(std::size_t layoutIndex);
+
+  ConvertedScene scene_;
+  std::vector<std::unique_ptr<SceneGainsCalculator>> calculators_;
+  std::vector<GainHolder> gains_;
+  std::vector<std::unique_ptr<MetadataThread>> workers_;
+};
+
+}  // namespace plugin
+}  // namespace ear
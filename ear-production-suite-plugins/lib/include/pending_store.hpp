@@ -4,17 +4,25 @@
 
 #ifndef EAR_PRODUCTION_SUITE_PENDING_STORE_HPP
 #define EAR_PRODUCTION_SUITE_PENDING_STORE_HPP
-#include <map>
 #include "metadata_listener.hpp"
 #include <adm/adm.hpp>
 #include "helper/nng_wrappers.h"
 
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <atomic>
 #include <vector>
+#include <unordered_map>
 
 namespace ear::plugin {
+    /*
+     * Rebuilds the programmes from a saved ADM template once the inputs it
+     * refers to have reconnected. Completes as soon as every expected input
+     * has been seen; the timeout only gives up on inputs which aren't coming
+     * back (e.g, deleted tracks).
+     */
     class PendingStore : public MetadataListener {
     public:
         PendingStore(Metadata& metadata,
@@ -27,20 +35,25 @@ namespace ear::plugin {
         void inputAdded(InputItem const& item, bool autoModeState) override;
         void inputUpdated(InputItem const& item, proto::InputItemMetadata const& oldItem) override;
 
-        void timeout(int msLimit);
+        void timeout(std::chrono::milliseconds limit);
+        void stopTimeout();
         std::thread timeoutThread;
-        std::atomic_bool killThread{ false };
-        std::atomic_int msSinceLastConnection{ 0 };
+        std::mutex timeoutMutex;
+        std::condition_variable timeoutCondition;
+        bool killThread{ false };
+        std::chrono::steady_clock::time_point lastConnection{ std::chrono::steady_clock::now() };
 
         std::mutex finisher;
         std::atomic_bool finished{false};
 
         Metadata& data_;
-        std::multimap<std::pair<adm::AudioObjectId, adm::AudioTrackUidId>, ear::plugin::proto::ProgrammeElement*> pendingElements_;
-        std::vector<PluginToAdmMap> pluginToAdmMaps_;
+        // keyed by AudioObject and AudioTrackUid ID values, see elementKey()
+        std::unordered_map<uint64_t, std::vector<ear::plugin::proto::ProgrammeElement*>> pendingElements_;
+        std::unordered_multimap<uint32_t, PluginToAdmMap> pluginToAdmMaps_; // by inputInstanceId
         ear::plugin::proto::ProgrammeStore pendingStore_;
         void checkAgainstPendingElements(InputItem const& item);
         void finishPendingElementsSearch();
+        void finishPendingElementsSearchLocked();
     };
 } // ear::plugin
 
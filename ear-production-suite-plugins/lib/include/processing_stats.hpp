@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ear-plugin-base/export.h"
+
+namespace ear {
+namespace plugin {
+
+// Timing of the stages of a plugin's processing - e.g. processBlock as a
+// whole, metadata handoff, the renderer - for attributing CPU spikes.
+//
+// Stages are added during construction. After that, each stage must only be
+// recorded from one thread at a time (normally the audio thread), which
+// lets recording get away with relaxed loads and stores - no locks or
+// read-modify-writes. Snapshots and trace dumps are taken from one other
+// thread (normally the message thread).
+//
+// Each duration goes in to a histogram of power-of-two microsecond bins. With
+// tracing enabled, each is also queued as a Chrome trace event (see
+// chrome://tracing or ui.perfetto.dev) until written out.
+class ProcessingStats {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using StageId = std::size_t;
+
+  static constexpr std::size_t MAX_STAGES = 8;
+  // Bin 0 is < 1us, bin n is < 2^n us, the last bin takes everything longer
+  static constexpr std::size_t HISTOGRAM_BINS = 16;
+
+  struct StageSnapshot {
+    std::string name;
+    std::uint64_t count{0};
+    std::uint64_t contentions{0};
+    // Input channel blocks given to the stage, and those it skipped as silent
+    std::uint64_t channelBlocks{0};
+    std::uint64_t skippedChannelBlocks{0};
+    double meanMicroseconds{0.0};
+    // Since the previous snapshot
+    double peakMicroseconds{0.0};
+    std::array<std::uint64_t, HISTOGRAM_BINS> histogram{};
+
+    // Upper bound of the bin holding the given fraction of durations
+    EAR_PLUGIN_BASE_EXPORT double percentileMicroseconds(double fraction) const;
+  };
+
+  EAR_PLUGIN_BASE_EXPORT explicit ProcessingStats(std::string pluginName);
+  EAR_PLUGIN_BASE_EXPORT ~ProcessingStats();
+
+  EAR_PLUGIN_BASE_EXPORT StageId addStage(std::string name);
+
+  EAR_PLUGIN_BASE_EXPORT void record(StageId stage, Clock::time_point start,
+                                     Clock::time_point end) noexcept;
+  // A lock on the stage's path was already held by another thread
+  EAR_PLUGIN_BASE_EXPORT void recordContention(StageId stage) noexcept;
+  EAR_PLUGIN_BASE_EXPORT void recordSkips(StageId stage,
+                                          std::uint64_t channelBlocks,
+                                          std::uint64_t skippedChannelBlocks)
+      noexcept;
+
+  EAR_PLUGIN_BASE_EXPORT std::vector<StageSnapshot> snapshot();
+
+  EAR_PLUGIN_BASE_EXPORT void setTraceEnabled(bool enabled);
+  EAR_PLUGIN_BASE_EXPORT bool traceEnabled() const;
+  // Writes and discards everything queued since the last call
+  EAR_PLUGIN_BASE_EXPORT void writeChromeTrace(std::ostream& stream);
+
+  const std::string& pluginName() const { return pluginName_; }
+
+ private:
+  struct Stage;
+  std::string pluginName_;
+  int traceProcessId_;
+  std::vector<std::unique_ptr<Stage>> stages_;
+  std::atomic<bool> traceEnabled_{false};
+  std::mutex traceSetupMutex_;
+};
+
+// Records the lifetime of the timer against a stage. Does nothing without
+// stats, so plugins can make instrumentation optional.
+class ScopedStageTimer {
+ public:
+  ScopedStageTimer(ProcessingStats* stats, ProcessingStats::StageId stage)
+      : stats_{stats}, stage_{stage} {
+    if (stats_) {
+      start_ = ProcessingStats::Clock::now();
+    }
+  }
+  ~ScopedStageTimer() {
+    if (stats_) {
+      stats_->record(stage_, start_, ProcessingStats::Clock::now());
+    }
+  }
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  ProcessingStats* stats_;
+  ProcessingStats::StageId stage_;
+  ProcessingStats::Clock::time_point start_;
+};
+
+// Writes str as a quoted JSON string, escaping quotes and backslashes
+EAR_PLUGIN_BASE_EXPORT void writeJsonString(std::ostream& stream,
+                                            const std::string& str);
+
+// Locks the mutex, counting a contention against the stage if it had to wait
+template <typename Mutex>
+std::unique_lock<Mutex> lockCountingContention(Mutex& mutex,
+                                               ProcessingStats* stats,
+                                               ProcessingStats::StageId stage) {
+  std::unique_lock<Mutex> lock(mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    if (stats) {
+      stats->recordContention(stage);
+    }
+    lock.lock();
+  }
+  return lock;
+}
+
+}  // namespace plugin
+}  // namespace ear
@@ -7,6 +7,7 @@
 #include <bw64/bw64.hpp>
 #include <vector>
 #include <map>
+#include <string>
 
 namespace ear {
 namespace plugin {
@@ -20,34 +21,66 @@ class ProgrammeStoreAdmSerializer {
      std::shared_ptr<adm::AudioTrackUid> audioTrackUid;
    };
 
+  // The document is kept between calls, and only the items and programmes
+  // which changed since the previous call are rebuilt. It is updated in
+  // place by the next call, so finish with it (or copy it) before then.
   std::pair<std::shared_ptr<adm::Document>, std::vector<PluginMap>> serialize(
     std::pair<proto::ProgrammeStore, ItemMap> stores);
  private:
-  void serializeToggle(std::shared_ptr<adm::AudioProgramme> programme,
+  // The tracks for an input item, and an AudioObject for each set of object
+  // level settings the programmes use it with
+  struct SerializedItem {
+    std::string key;
+    bool usesPresetDefinition{false};
+    std::shared_ptr<adm::AudioPackFormat> packFormat;
+    std::vector<std::shared_ptr<adm::AudioChannelFormat>> channelFormats;
+    std::vector<std::shared_ptr<adm::AudioTrackUid>> trackUids;
+    std::map<std::string, std::shared_ptr<adm::AudioObject>> objects;
+  };
+  struct SerializedProgramme {
+    std::string key;
+    std::shared_ptr<adm::AudioProgramme> programme;
+    std::vector<std::shared_ptr<adm::AudioContent>> contents;
+    // connection id and object, in the order the programme first uses them
+    std::vector<std::pair<communication::ConnectionId,
+                          std::shared_ptr<adm::AudioObject>>> objects;
+    std::vector<std::pair<std::shared_ptr<adm::AudioObject>,
+                          std::shared_ptr<adm::AudioObject>>> complementaries;
+  };
+
+  void reset();
+  std::string programmeKey(proto::Programme const& programme) const;
+  bool removeStaleItems();
+  void removeItem(SerializedItem const& item);
+  void removeProgramme(SerializedProgramme const& programme);
+  bool removeUnusedObjects();
+  void updatePluginMap();
+  void serializeToggle(SerializedProgramme& programme,
                        const proto::Toggle& toggle);
   std::shared_ptr<adm::AudioObject> getToggleDefaultAudioObject(
-      const std::shared_ptr<adm::AudioProgramme>& programme,
+      SerializedProgramme& programme,
       const proto::Toggle& toggle);
-  std::shared_ptr<adm::AudioObject> serializeToggleElement(std::shared_ptr<adm::AudioProgramme> programme,
+  std::shared_ptr<adm::AudioObject> serializeToggleElement(SerializedProgramme& programme,
                                                       const proto::Toggle& toggle,
                                                       int elementIndex);
-  void serializeProgramme(adm::Document& doc,
-                          proto::Programme const& programme);
-  void serializeElement(adm::AudioContent& content,
-                        proto::Object const& object);
-  void createTopLevelObject(adm::AudioContent& content,
-                            proto::InputItemMetadata const& metadata,
-                            proto::Object const& object);
-  bool isAlreadySerialized(proto::Object const& object) const;
+  SerializedProgramme serializeProgramme(proto::Programme const& programme);
+  std::shared_ptr<adm::AudioObject> serializeElement(
+      SerializedProgramme& programme, adm::AudioContent& content,
+      proto::Object const& object);
+  std::shared_ptr<adm::AudioObject> getAudioObject(
+      communication::ConnectionId const& connectionId,
+      proto::InputItemMetadata const& metadata, proto::Object const& object);
+  SerializedItem serializeItem(proto::InputItemMetadata const& metadata,
+                               proto::Object const& object);
 
   proto::ProgrammeStore programmes_;
   std::map<communication::ConnectionId, proto::InputItemMetadata> items_;
   std::shared_ptr<adm::Document> doc;
   std::vector<PluginMap> pluginMap;
-  std::map<std::string, std::shared_ptr<adm::AudioObject>> serializedObjects;
+  std::map<communication::ConnectionId, SerializedItem> serializedItems_;
+  std::vector<SerializedProgramme> serializedProgrammes_;
   void setInteractivity(adm::AudioObject& object, const proto::Object& object1);
   void setImportance(adm::AudioObject& object, const proto::Object& object1);
-  bool isSerializedWithDifferentObjectSettings(const proto::Object& object);
 };
 
 }  // namespace plugin
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "communication/message_buffer.hpp"
+#include "communication/metadata_slot_table.hpp"
 #include "communication/scene_command_receiver.hpp"
 #include "communication/scene_metadata_receiver.hpp"
 #include "communication/scene_connection_manager.hpp"
@@ -8,6 +9,7 @@
 #include "scene_store.hpp"
 #include "log.hpp"
 #include "ear-plugin-base/export.h"
+#include <memory>
 #include <mutex>
 #include <set>
 
@@ -53,6 +55,7 @@ class SceneBackend {
  private:
   void onConnectionEvent(communication::SceneConnectionManager::Event,
                          communication::ConnectionId id);
+  void pollMetadataSlots();
 
   std::mutex mutex_;
   std::shared_ptr<spdlog::logger> logger_;
@@ -64,6 +67,8 @@ class SceneBackend {
   nng::PubSocket metadataSender_;
   communication::SceneCommandReceiver commandReceiver_;
   communication::SceneMetadataReceiver metadataReceiver_;
+  std::mutex metadataSlotsMutex_;
+  std::unique_ptr<communication::MetadataSlotTable> metadataSlots_;
 };
 
 }  // namespace plugin
@@ -4,10 +4,13 @@
 #include <boost/variant.hpp>
 #include "scene_store.pb.h"
 #include "communication/common_types.hpp"
+#include "converted_scene.hpp"
+#include "hoa_decode.hpp"
 #include <ear/ear.hpp>
 #include <Eigen/Eigen>
 #include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ear {
@@ -16,33 +19,47 @@ namespace plugin {
 struct GainHolder {
   Eigen::MatrixXf direct;
   Eigen::MatrixXf diffuse;
+  /// HOA items, which are left out of direct and diffuse
+  HoaDecodes hoa;
 };
 
 struct ItemGains {
   int inputStartingChannel;
   std::vector<std::vector<float>> direct_;
   std::vector<std::vector<float>> diffuse_;
+  std::shared_ptr<const Eigen::MatrixXf> hoaDecode_;
 };
 
 class SceneGainsCalculator {
  public:
   SceneGainsCalculator(Layout outputLayout, int inputChannelCount);
   bool update(const proto::SceneStore &store);
+  /// For a scene converted elsewhere, which must have been updated with
+  /// every store since this calculator last saw it
+  bool update(const ConvertedScene &scene);
   Eigen::MatrixXf directGains();
   Eigen::MatrixXf diffuseGains();
+  HoaDecodes hoaDecodes();
 
  private:
   int totalOutputChannels;
   int totalInputChannels;
 
-  void removeItem(const communication::ConnectionId &itemId);
-  void addOrUpdateItem(const proto::MonitoringItemMetadata &item);
+  void addOrUpdateItem(const communication::ConnectionId &itemId,
+                       const ConvertedItem &item);
+  std::shared_ptr<const Eigen::MatrixXf> hoaDecode(
+      const HOATypeMetadata &metadata);
 
   ear::GainCalculatorObjects objectCalculator_;
   ear::GainCalculatorDirectSpeakers directSpeakersCalculator_;
   ear::GainCalculatorHOA hoaCalculator_;
 
   std::map<communication::ConnectionId, ItemGains> routingCache_;
+  // Keyed by orders, degrees and normalization; the layout is fixed
+  std::map<std::tuple<std::vector<int>, std::vector<int>, std::string>,
+           std::shared_ptr<const Eigen::MatrixXf>>
+      hoaDecodeCache_;
+  ConvertedScene convertedScene_;
 };
 
 }  // namespace plugin
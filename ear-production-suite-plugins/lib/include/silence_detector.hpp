@@ -0,0 +1,53 @@
+#pragma once
+#include <Eigen/Core>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+
+/// How many input channel blocks a renderer was given, and how many of
+/// those it skipped as silent
+struct SkipCounts {
+  std::uint64_t channelBlocks{0};
+  std::uint64_t skippedChannelBlocks{0};
+};
+
+/**
+ * @brief Tracks which input channels are silent, so renderers can skip them
+ *
+ * Each block, a channel's peak (max-abs, vectorised by Eigen) is compared
+ * against a threshold. A channel stays active until it has been at or below
+ * the threshold for more than `holdSamples`, which should cover any tail the
+ * renderer keeps for that channel, so tails ring out before it's skipped.
+ *
+ * Channels are active until first checked.
+ */
+class SilenceDetector {
+ public:
+  SilenceDetector(std::size_t channelCount, std::size_t holdSamples,
+                  float threshold = 0.f);
+
+  void check(std::size_t channel, const float* samples,
+             std::size_t sampleCount);
+  /// One channel per column
+  void check(const Eigen::Ref<const Eigen::MatrixXf>& block);
+
+  bool isActive(std::size_t channel) const {
+    return channel >= silentSamples_.size() ||
+           silentSamples_[channel] <= holdSamples_;
+  }
+
+  std::size_t channelCount() const { return silentSamples_.size(); }
+
+ private:
+  std::size_t holdSamples_;
+  float threshold_;
+  // Since the channel's last block above the threshold, saturating just past
+  // the hold
+  std::vector<std::size_t> silentSamples_;
+};
+
+}  // namespace plugin
+}  // namespace ear
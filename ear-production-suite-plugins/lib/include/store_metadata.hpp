@@ -39,6 +39,9 @@ class Metadata {
   // Input item manipulation
   void setInputItemMetadata(communication::ConnectionId const& connId,
                           proto::InputItemMetadata const& item);
+  // Whether the stored item is at the version a heartbeat reports
+  bool hasInputItemVersion(communication::ConnectionId const& connId,
+                           uint32_t continuityCounter) const;
   void removeInput(communication::ConnectionId const& connId);
 
   // Programme manipulation
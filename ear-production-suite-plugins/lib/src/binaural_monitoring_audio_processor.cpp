@@ -1,18 +1,56 @@
 #include "binaural_monitoring_audio_processor.hpp"
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
 namespace ear {
 namespace plugin {
 
+namespace {
+
+// Head tracking is smoothed over this, to hide corrections when a new sample
+// disagrees with what was predicted
+constexpr double trackSmoothingSeconds = 0.005;
+// When head tracking stops, the listener turns back to the orientation set in
+// the UI over about this long
+constexpr double handBackSeconds = 0.25;
+
+// Periods shorter than this cost BEAR more than they gain
+constexpr std::size_t minListenerUpdatePeriod = 64;
+
+// X and Y need swapping and inverting for BEAR
+std::array<double, 4> toBearQuaternion(double w, double x, double y,
+                                       double z) {
+  return {w, -y, -x, z};
+}
+
+void offsetPointers(const std::vector<float *> &block, size_t count,
+                    size_t offset, std::vector<float *> &period) {
+  for (size_t channel = 0; channel < count; channel++) {
+    period[channel] = block[channel] + offset;
+  }
+}
+
+}  // namespace
+
 BinauralMonitoringAudioProcessor::BinauralMonitoringAudioProcessor(
     std::size_t maxObjChannels, std::size_t maxDsChannels,
     std::size_t maxHoaChannels, std::size_t sampleRate, std::size_t blockSize,
-    std::string dataFilePath) {
+    std::string dataFilePath)
+    : blockSize_{blockSize},
+      period_{listenerUpdatePeriod(blockSize)},
+      listenerSmoother_{static_cast<double>(period_) / sampleRate,
+                        trackSmoothingSeconds, handBackSeconds},
+      silence_(std::max({maxObjChannels, maxDsChannels, maxHoaChannels}),
+               silenceHoldSamples(sampleRate, blockSize)) {
   isPlaying = false;
   framesProcessed = 0;
   metadataRtime = bear::Time{framesProcessed, sampleRate};
   metadataDuration = bear::Time{blockSize, sampleRate};
+  periodDuration_ =
+      std::chrono::duration_cast<ListenerOrientationTrack::Clock::duration>(
+          std::chrono::duration<double>(static_cast<double>(period_) /
+                                        sampleRate));
 
   reusableZeroedChannel = std::vector<float>(blockSize, 0.0);
   bearOutputBuffers_RawPointers = std::vector<float *>(2, nullptr);
@@ -22,12 +60,19 @@ BinauralMonitoringAudioProcessor::BinauralMonitoringAudioProcessor(
       std::vector<float *>(maxDsChannels, reusableZeroedChannel.data());
   bearHoaInputBuffers_RawPointers =
       std::vector<float *>(maxHoaChannels, reusableZeroedChannel.data());
+  bearPeriodOutputBuffers_RawPointers = bearOutputBuffers_RawPointers;
+  bearPeriodObjectInputBuffers_RawPointers = bearObjectInputBuffers_RawPointers;
+  bearPeriodDirectSpeakersInputBuffers_RawPointers =
+      bearDirectSpeakersInputBuffers_RawPointers;
+  bearPeriodHoaInputBuffers_RawPointers = bearHoaInputBuffers_RawPointers;
 
   objChannelMappings.reserve(maxObjChannels);
   dsChannelMappings.reserve(maxDsChannels);
   hoaChannelMappings.reserve(maxHoaChannels);
+  hoaBusBuffers = std::vector<std::vector<float>>(
+      maxHoaChannels, std::vector<float>(blockSize, 0.f));
 
-  bearConfig.set_period_size(blockSize);
+  bearConfig.set_period_size(period_);
   bearConfig.set_sample_rate(sampleRate);
   bearConfig.set_num_objects_channels(0);
   bearConfig.set_num_direct_speakers_channels(0);
@@ -40,7 +85,7 @@ BinauralMonitoringAudioProcessor::BinauralMonitoringAudioProcessor(
   bearStatus.startupConfig = bearConfig;
   try {
     bearRenderer = std::make_shared<bear::DynamicRenderer>(
-        blockSize,
+        period_,
         std::max(std::max(maxObjChannels, maxDsChannels), maxHoaChannels));
     bearRenderer->set_config_blocking(bearConfig);
     bearStatus.startupSuccess = BearStatusStates::SUCCEEDED;
@@ -62,12 +107,9 @@ BinauralMonitoringAudioProcessor::BinauralMonitoringAudioProcessor(
 void BinauralMonitoringAudioProcessor::doProcess(float **channelPointers,
                                                  size_t maxChannels) {
   if (!bearRenderer) return;
-  auto test = listenerQuatsDirty;
-  if (listenerQuatsDirty) {
-    std::lock_guard<std::mutex> lock(bearListenerMutex_);
-    bearListener.set_orientation_quaternion(listenerQuats);
-    bearRenderer->set_listener(bearListener);
-    listenerQuatsDirty = false;
+  auto const blockStart = ListenerOrientationTrack::Clock::now();
+  if (orientationTrack_) {
+    orientationTrack_->update();
   }
 
   // Set buffer pointers
@@ -95,24 +137,78 @@ void BinauralMonitoringAudioProcessor::doProcess(float **channelPointers,
     }
   }
 
+  // Buses with a single source were mapped straight to it above
+  for (auto& bus : hoaBuses) {
+    auto const channelCount = bus.degrees.size();
+    auto const activeSources = std::count_if(
+        bus.sourceStartingChannels.begin(), bus.sourceStartingChannels.end(),
+        [this, channelCount](size_t startingChannel) {
+          return isActive(startingChannel, channelCount);
+        });
+    skipCounts_.channelBlocks +=
+        bus.sourceStartingChannels.size() * channelCount;
+    skipCounts_.skippedChannelBlocks +=
+        (bus.sourceStartingChannels.size() - activeSources) * channelCount;
+    if (activeSources == 0) {
+      continue;
+    }
+    bearRenderer->add_hoa_block(bus.streamIdentifier, bus.input);
+    if (bus.sourceStartingChannels.size() < 2) {
+      continue;
+    }
+    for (size_t busChannel = 0; busChannel < channelCount; busChannel++) {
+      auto& sum = hoaBusBuffers[bus.firstBearChannel + busChannel];
+      std::fill(sum.begin(), sum.end(), 0.f);
+      for (auto startingChannel : bus.sourceStartingChannels) {
+        if (startingChannel + busChannel < maxChannels &&
+            isActive(startingChannel, channelCount)) {
+          auto source = channelPointers[startingChannel + busChannel];
+          for (size_t sample = 0; sample < sum.size(); sample++) {
+            sum[sample] += source[sample];
+          }
+        }
+      }
+      bearHoaInputBuffers_RawPointers[bus.firstBearChannel + busChannel] =
+          sum.data();
+    }
+  }
+
   bearOutputBuffers_RawPointers[0] = channelPointers[0];
   bearOutputBuffers_RawPointers[1] = channelPointers[1];
 
-  // Process
-  bearRenderer->process(
-      objChannelMappings.size(), bearObjectInputBuffers_RawPointers.data(),
-      dsChannelMappings.size(),
-      bearDirectSpeakersInputBuffers_RawPointers.data(),
-      hoaChannelMappings.size(), bearHoaInputBuffers_RawPointers.data(),
-      bearOutputBuffers_RawPointers.data());
+  // Process, a period at a time so the listener can turn within the block.
+  // Metadata spans the whole block, so BEAR interpolates it across periods.
+  for (size_t offset = 0; offset + period_ <= blockSize_; offset += period_) {
+    updateListener(blockStart +
+                   periodDuration_ * static_cast<int>(offset / period_));
+    offsetPointers(bearObjectInputBuffers_RawPointers,
+                   objChannelMappings.size(), offset,
+                   bearPeriodObjectInputBuffers_RawPointers);
+    offsetPointers(bearDirectSpeakersInputBuffers_RawPointers,
+                   dsChannelMappings.size(), offset,
+                   bearPeriodDirectSpeakersInputBuffers_RawPointers);
+    offsetPointers(bearHoaInputBuffers_RawPointers, hoaChannelMappings.size(),
+                   offset, bearPeriodHoaInputBuffers_RawPointers);
+    offsetPointers(bearOutputBuffers_RawPointers, 2, offset,
+                   bearPeriodOutputBuffers_RawPointers);
+    bearRenderer->process(
+        objChannelMappings.size(),
+        bearPeriodObjectInputBuffers_RawPointers.data(),
+        dsChannelMappings.size(),
+        bearPeriodDirectSpeakersInputBuffers_RawPointers.data(),
+        hoaChannelMappings.size(),
+        bearPeriodHoaInputBuffers_RawPointers.data(),
+        bearPeriodOutputBuffers_RawPointers.data());
+  }
 
   // Prepare for next block
-  framesProcessed += bearConfig.get_period_size();
+  framesProcessed += blockSize_;
   metadataRtime.assign(framesProcessed, bearConfig.get_sample_rate());
 
   objChannelMappings.clear();
   dsChannelMappings.clear();
   hoaChannelMappings.clear();
+  hoaBuses.clear();
 
   std::fill(bearObjectInputBuffers_RawPointers.begin(),
             bearObjectInputBuffers_RawPointers.end(),
@@ -125,34 +221,114 @@ void BinauralMonitoringAudioProcessor::doProcess(float **channelPointers,
             reusableZeroedChannel.data());
 }
 
+void BinauralMonitoringAudioProcessor::updateListener(
+    ListenerOrientationTrack::Clock::time_point time) {
+  std::optional<ListenerOrientation::Quaternion> tracked;
+  if (orientationTrack_) {
+    tracked = orientationTrack_->orientationAt(time);
+  }
+  auto orientation = listenerSmoother_.next(tracked, manualOrientation_);
+  auto target = toBearQuaternion(orientation.w, orientation.x, orientation.y,
+                                 orientation.z);
+
+  if (target != bearListenerQuats) {
+    std::lock_guard<std::mutex> lock(bearListenerMutex_);
+    bearListener.set_orientation_quaternion(target);
+    bearRenderer->set_listener(bearListener);
+    bearListenerQuats = target;
+  }
+}
+
+std::size_t BinauralMonitoringAudioProcessor::listenerUpdatePeriod(
+    std::size_t blockSize) {
+  for (std::size_t divisions = 1;
+       blockSize / divisions >= minListenerUpdatePeriod; divisions++) {
+    if (blockSize % divisions == 0 &&
+        blockSize / divisions <= MAX_LISTENER_UPDATE_PERIOD) {
+      return blockSize / divisions;
+    }
+  }
+  return blockSize;
+}
+
+std::size_t BinauralMonitoringAudioProcessor::silenceHoldSamples(
+    std::size_t sampleRate, std::size_t blockSize) {
+  // Half a second covers the tails of BEAR's filters and reverb, plus a block
+  // for any the renderer still has buffered
+  return sampleRate / 2 + blockSize;
+}
+
+SkipCounts BinauralMonitoringAudioProcessor::takeSkipCounts() {
+  auto counts = skipCounts_;
+  skipCounts_ = SkipCounts{};
+  return counts;
+}
+
+bool BinauralMonitoringAudioProcessor::isActive(size_t startingChannel,
+                                                size_t channelCount) const {
+  for (size_t channel = 0; channel < channelCount; channel++) {
+    if (silence_.isActive(startingChannel + channel)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool BinauralMonitoringAudioProcessor::pushBearMetadata(
     size_t channelNum, ear::ObjectsTypeMetadata *metadata) {
+  // The channel is mapped either way, so BEAR's channel numbering holds
+  objChannelMappings.push_back(channelNum);
+  ++skipCounts_.channelBlocks;
+  if (!silence_.isActive(channelNum)) {
+    ++skipCounts_.skippedChannelBlocks;
+    return true;
+  }
   bear::ObjectsInput bearMetadata;
   bearMetadata.rtime = metadataRtime;
   bearMetadata.duration = metadataDuration;
   bearMetadata.type_metadata = *metadata;
-  objChannelMappings.push_back(channelNum);
   return bearRenderer->add_objects_block(objChannelMappings.size() - 1,
                                          bearMetadata);
 }
 
 bool BinauralMonitoringAudioProcessor::pushBearMetadata(
-    size_t channelNum, ear::DirectSpeakersTypeMetadata *metadata) {
+    size_t channelNum, const ear::DirectSpeakersTypeMetadata *metadata) {
+  dsChannelMappings.push_back(channelNum);
+  ++skipCounts_.channelBlocks;
+  if (!silence_.isActive(channelNum)) {
+    ++skipCounts_.skippedChannelBlocks;
+    return true;
+  }
   bear::DirectSpeakersInput bearMetadata;
   bearMetadata.rtime = metadataRtime;
   bearMetadata.duration = metadataDuration;
   bearMetadata.type_metadata = *metadata;
-  dsChannelMappings.push_back(channelNum);
 
   return bearRenderer->add_direct_speakers_block(dsChannelMappings.size() - 1,
                                                  bearMetadata);
 }
 
 bool BinauralMonitoringAudioProcessor::pushBearMetadata(
-    size_t channelNum, ear::HOATypeMetadata *metadata,
+    size_t channelNum, const ear::HOATypeMetadata *metadata,
     size_t arbitraryStreamIdentifier) {
   if (metadata->degrees.size() == 0) return false;
-  bear::HOAInput bearMetadata;
+
+  for (auto& bus : hoaBuses) {
+    if (bus.degrees == metadata->degrees && bus.orders == metadata->orders &&
+        bus.normalization == metadata->normalization) {
+      bus.sourceStartingChannels.push_back(channelNum);
+      return true;
+    }
+  }
+  if (hoaChannelMappings.size() + metadata->degrees.size() >
+      hoaBusBuffers.size()) {
+    return false;
+  }
+  hoaBuses.push_back(HoaBus{metadata->orders, metadata->degrees,
+                            metadata->normalization, hoaChannelMappings.size(),
+                            {channelNum}, arbitraryStreamIdentifier});
+
+  auto& bearMetadata = hoaBuses.back().input;
   bearMetadata.channels.reserve(metadata->degrees.size());
 
   for (int i = 0; i < metadata->degrees.size(); i++) {
@@ -164,7 +340,7 @@ bool BinauralMonitoringAudioProcessor::pushBearMetadata(
   bearMetadata.duration = metadataDuration;
   bearMetadata.type_metadata = *metadata;
 
-  return bearRenderer->add_hoa_block(arbitraryStreamIdentifier, bearMetadata);
+  return true;
 }
 
 std::size_t BinauralMonitoringAudioProcessor::delayInSamples() const {
@@ -174,7 +350,7 @@ std::size_t BinauralMonitoringAudioProcessor::delayInSamples() const {
 bool BinauralMonitoringAudioProcessor::configMatches(std::size_t sampleRate,
                                                      std::size_t blockSize) {
   if (bearConfig.get_sample_rate() != sampleRate) return false;
-  if (bearConfig.get_period_size() != blockSize) return false;
+  if (blockSize_ != blockSize) return false;
   return true;
 }
 
@@ -182,23 +358,8 @@ void BinauralMonitoringAudioProcessor::setListenerOrientation(float quatW,
                                                               float quatX,
                                                               float quatY,
                                                               float quatZ) {
-  // X and Y need swapping and inverting for BEAR
-  if (listenerQuats[0] != quatW) {
-    listenerQuats[0] = quatW;
-    listenerQuatsDirty = true;
-  }
-  if (listenerQuats[1] != -quatY) {
-    listenerQuats[1] = -quatY;
-    listenerQuatsDirty = true;
-  }
-  if (listenerQuats[2] != -quatX) {
-    listenerQuats[2] = -quatX;
-    listenerQuatsDirty = true;
-  }
-  if (listenerQuats[3] != quatZ) {
-    listenerQuats[3] = quatZ;
-    listenerQuatsDirty = true;
-  }
+  // Applied to BEAR at the start of the next period that isn't head tracked
+  manualOrientation_ = {quatW, quatX, quatY, quatZ};
 }
 
 bool BinauralMonitoringAudioProcessor::updateChannelCounts(
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <set>
 
 using std::placeholders::_1;
 using std::placeholders::_2;
@@ -120,7 +121,7 @@ BinauralMonitoringBackend::getLatestDirectSpeakersTypeMetadata(ConnId id) {
       latestDirectSpeakersTypeMetadata, id,
       DirectSpeakersEarMetadataAndRouting{
           epsMD->has_routing() ? epsMD->routing() : -1,
-          EpsToEarMetadataConverter::convert(epsMD->ds_metadata())});
+          EpsToEarMetadataConverter::convertInterned(epsMD->ds_metadata())});
 
   earMD = getValuePointerFromMap<ConnId, DirectSpeakersEarMetadataAndRouting>(
       latestDirectSpeakersTypeMetadata, id);
@@ -155,7 +156,7 @@ BinauralMonitoringBackend::getLatestHoaTypeMetadata(ConnId id) {
       latestHoaTypeMetadata, id,
       HoaEarMetadataAndRouting{
           epsMD->has_routing() ? epsMD->routing() : -1,
-          EpsToEarMetadataConverter::convert(epsMD->hoa_metadata())});
+          EpsToEarMetadataConverter::convertInterned(epsMD->hoa_metadata())});
 
   earMD = getValuePointerFromMap<ConnId, HoaEarMetadataAndRouting>(
       latestHoaTypeMetadata, id);
@@ -210,6 +211,7 @@ void BinauralMonitoringBackend::onSceneReceived(
 
   std::vector<ConnId> availableItemIds;
   availableItemIds.reserve(store.all_available_items_size());
+  std::set<int> hoaPackFormats;
 
   for (const auto& item : store.all_available_items()) {
     if(item.has_connection_id() &&
@@ -222,17 +224,13 @@ void BinauralMonitoringBackend::onSceneReceived(
     if (item.has_obj_metadata()) {
       totalObjChannels++;
     }
-    if (item.has_hoa_metadata()) {
-      auto hoaId = item.hoa_metadata().packformatidvalue();
-      // TODO: May need to revisit later -
-      //       this is a high-frequency call but may be slow to to execute
-      auto pfData =
-          AdmPresetDefinitionsHelper::getSingleton().getPackFormatData(4,
-                                                                       hoaId);
-      if (pfData) {
-        auto cfCount = pfData->relatedChannelFormats.size();
-        totalHoaChannels += cfCount;
-      }
+    // HOA items of the same pack format are summed into one BEAR stream by
+    // the audio processor, so only need channels (one per component) once
+    if (item.has_hoa_metadata() &&
+        hoaPackFormats.insert(item.hoa_metadata().packformatidvalue()).second) {
+      totalHoaChannels +=
+          EpsToEarMetadataConverter::convertInterned(item.hoa_metadata())
+              ->degrees.size();
     }
   }
 
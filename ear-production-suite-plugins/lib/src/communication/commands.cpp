@@ -112,6 +112,28 @@ MessageBuffer serialize(const MonitoringConnectionDetailsResponse& msg) {
   return serialize(response);
 }
 
+MessageBuffer serialize(const RegisterInputsMessage& msg) {
+  proto::CmdRequest request;
+  auto payload = request.MutableExtension(
+      proto::CmdRegisterInputsReq::cmdRegisterInputsReq);
+  for (auto const& connectionId : msg.connectionIds()) {
+    payload->add_connection_id(connectionId.string());
+  }
+  payload->set_protocol_version(msg.protocolVersion());
+  return serialize(request);
+}
+
+MessageBuffer serialize(const RegisterInputsResponse& msg) {
+  proto::CmdResponse response;
+  auto payload = response.MutableExtension(
+      proto::CmdRegisterInputsResp::cmdRegisterInputsResp);
+  for (auto const& connectionId : msg.connectionIds()) {
+    payload->add_connection_id(connectionId.string());
+  }
+  payload->set_metadata_endpoint(msg.metadataEndpoint());
+  return serialize(response);
+}
+
 MessageBuffer serializeErrorResponse(ErrorCode errorCode,
                                      const std::string& message) {
   proto::CmdResponse resp;
@@ -169,6 +191,21 @@ RequestVariant parseRequest(const void* data, int size) {
     auto connectionId = communication::ConnectionId{ext.connection_id()};
     return MonitoringConnectionDetailsMessage(connectionId);
   }
+  if (request.HasExtension(
+          proto::CmdRegisterInputsReq::cmdRegisterInputsReq)) {
+    auto ext = request.GetExtension(
+        proto::CmdRegisterInputsReq::cmdRegisterInputsReq);
+    if (ext.protocol_version() != CURRENT_PROTOCOL_VERSION) {
+      throw std::runtime_error(
+          "Failed to parse request: protocol version mismatch");
+    }
+    std::vector<ConnectionId> connectionIds;
+    connectionIds.reserve(ext.connection_id_size());
+    for (auto const& connectionId : ext.connection_id()) {
+      connectionIds.emplace_back(connectionId);
+    }
+    return RegisterInputsMessage(std::move(connectionIds));
+  }
   throw std::runtime_error("Failed to parse request: unhandled subcommand");
 }
 
@@ -218,6 +255,20 @@ Response parseResponse(const void* data, int size) {
     return Response(payload);
   }
 
+  if (response.HasExtension(
+          proto::CmdRegisterInputsResp::cmdRegisterInputsResp)) {
+    auto ext = response.GetExtension(
+        proto::CmdRegisterInputsResp::cmdRegisterInputsResp);
+    std::vector<ConnectionId> connectionIds;
+    connectionIds.reserve(ext.connection_id_size());
+    for (auto const& connectionId : ext.connection_id()) {
+      connectionIds.emplace_back(connectionId);
+    }
+    auto payload = RegisterInputsResponse(std::move(connectionIds),
+                                          ext.metadata_endpoint());
+    return Response(payload);
+  }
+
   return Response(ErrorCode::MALFORMED_RESPONSE,
                   "Failed to parse response: unhandled subpayload");
 }
@@ -53,49 +53,84 @@ void InputControlConnection::handshake(ConnectionId const& id) {
     connectionId_ = id;
   }
   try {
-    {
-      EAR_LOGGER_TRACE(logger_, "Requesting connection ID ({})",
-                       connectionId_.string());
-      socket_.requestNewConnection(connectionId_);
-      auto reply = socket_.receive();
-      auto payload = reply.payloadAs<NewConnectionResponse>();
-      if (!payload.connectionId().isValid()) {
-        EAR_LOGGER_ERROR(logger_,
-                         "Failed to start new control connection: invalid "
-                         "connection id received");
-        return;
-      }
-
-      connectionId_ = payload.connectionId();
-      EAR_LOGGER_DEBUG(logger_, "Got connection ID {}", connectionId_.string());
+    std::string streamEndpoint;
+    if (!registerInput(streamEndpoint) &&
+        !requestConnectionAndDetails(streamEndpoint)) {
+      return;
     }
-    {
-      EAR_LOGGER_TRACE(logger_, "Sending object connection details");
-      socket_.requestObjectDetails(connectionId_);
-      auto reply = socket_.receive();
-      if (!reply.success()) {
-        EAR_LOGGER_ERROR(logger_, "Failed to start new control connection: {}",
-                         reply.errorDescription());
-        return;
-      }
-      auto payload = reply.payloadAs<ConnectionDetailsResponse>();
-      auto streamEndpoint = payload.metadataEndpoint();
-      EAR_LOGGER_DEBUG(logger_,
-                       "Received {} as target endpoint for metadata streaming",
-                       streamEndpoint);
-      connected_ = true;
-
-      if (connectedCallback_) {
-        connectedCallback_(connectionId_, streamEndpoint);
-      } else {
-          EAR_LOGGER_WARN(logger_, "Connected with {} but no callback provided", connectionId_.string());
-      }
+    EAR_LOGGER_DEBUG(logger_,
+                     "Received {} as target endpoint for metadata streaming",
+                     streamEndpoint);
+    connected_ = true;
+
+    if (connectedCallback_) {
+      connectedCallback_(connectionId_, streamEndpoint);
+    } else {
+        EAR_LOGGER_WARN(logger_, "Connected with {} but no callback provided", connectionId_.string());
     }
   } catch (const std::runtime_error& e) {
     EAR_LOGGER_ERROR(logger_, "Exception during handshake: {}", e.what());
   }
 }
 
+bool InputControlConnection::registerInput(std::string& streamEndpoint) {
+  EAR_LOGGER_TRACE(logger_, "Registering connection ID ({})",
+                   connectionId_.string());
+  socket_.requestRegisterInputs({connectionId_});
+  auto reply = socket_.receive();
+  if (!reply.success()) {
+    // Scenes from before RegisterInputsMessage reject it as unknown
+    EAR_LOGGER_DEBUG(logger_, "Registration not accepted ({}), connecting in two steps",
+                     reply.errorDescription());
+    return false;
+  }
+  auto const& payload = reply.payloadAs<RegisterInputsResponse>();
+  if (payload.connectionIds().size() != 1 ||
+      !payload.connectionIds().front().isValid()) {
+    EAR_LOGGER_ERROR(logger_,
+                     "Failed to register control connection: invalid "
+                     "connection id received");
+    return false;
+  }
+  connectionId_ = payload.connectionIds().front();
+  streamEndpoint = payload.metadataEndpoint();
+  EAR_LOGGER_DEBUG(logger_, "Got connection ID {}", connectionId_.string());
+  return true;
+}
+
+bool InputControlConnection::requestConnectionAndDetails(
+    std::string& streamEndpoint) {
+  {
+    EAR_LOGGER_TRACE(logger_, "Requesting connection ID ({})",
+                     connectionId_.string());
+    socket_.requestNewConnection(connectionId_);
+    auto reply = socket_.receive();
+    auto payload = reply.payloadAs<NewConnectionResponse>();
+    if (!payload.connectionId().isValid()) {
+      EAR_LOGGER_ERROR(logger_,
+                       "Failed to start new control connection: invalid "
+                       "connection id received");
+      return false;
+    }
+
+    connectionId_ = payload.connectionId();
+    EAR_LOGGER_DEBUG(logger_, "Got connection ID {}", connectionId_.string());
+  }
+  {
+    EAR_LOGGER_TRACE(logger_, "Sending object connection details");
+    socket_.requestObjectDetails(connectionId_);
+    auto reply = socket_.receive();
+    if (!reply.success()) {
+      EAR_LOGGER_ERROR(logger_, "Failed to start new control connection: {}",
+                       reply.errorDescription());
+      return false;
+    }
+    auto payload = reply.payloadAs<ConnectionDetailsResponse>();
+    streamEndpoint = payload.metadataEndpoint();
+  }
+  return true;
+}
+
 void InputControlConnection::start(const std::string& endpoint) {
   EAR_LOGGER_INFO(logger_, "Connecting to {}", endpoint);
   socket_.open(endpoint);
@@ -42,6 +42,12 @@ void InputControlSocket::requestObjectDetails(const ConnectionId& id) {
   send(message);
 }
 
+void InputControlSocket::requestRegisterInputs(const std::vector<ConnectionId>& ids) {
+    EAR_LOGGER_TRACE(logger_, "Requesting registration of {} inputs", ids.size());
+  auto message = RegisterInputsMessage{ids};
+  send(message);
+}
+
 void InputControlSocket::requestCloseConnection(const ConnectionId& id) {
     EAR_LOGGER_TRACE(logger_, "Requesting close connection for id {}", id.string());
   auto message = CloseConnectionMessage{id};
@@ -0,0 +1,103 @@
+#include "communication/keep_alive_scheduler.hpp"
+
+namespace ear::plugin::communication {
+
+KeepAliveScheduler::KeepAliveScheduler(std::chrono::milliseconds interval)
+    : interval_{interval} {}
+
+KeepAliveScheduler::~KeepAliveScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+KeepAliveScheduler& KeepAliveScheduler::metadataSenders() {
+  using namespace std::chrono_literals;
+  static KeepAliveScheduler scheduler{250ms};
+  return scheduler;
+}
+
+KeepAliveScheduler::TaskId KeepAliveScheduler::add(Task task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto id = nextId_++;
+  tasks_.emplace(id, std::make_shared<Entry>(Entry{std::move(task)}));
+  if (!threadRunning_) {
+    // Any previous thread has left run(), so this won't wait on the lock
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    threadRunning_ = true;
+    thread_ = std::thread(&KeepAliveScheduler::run, this);
+  }
+  return id;
+}
+
+void KeepAliveScheduler::remove(TaskId id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = tasks_.find(id);
+  if (it == tasks_.end()) {
+    return;
+  }
+  auto entry = it->second;
+  tasks_.erase(it);
+  entry->removed = true;
+  taskDone_.wait(lock, [&entry]() { return !entry->running; });
+  if (!tasks_.empty()) {
+    return;
+  }
+  condition_.notify_all();
+  // Unless add() got in first and the thread carries on
+  taskDone_.wait(lock,
+                 [this]() { return !threadRunning_ || !tasks_.empty(); });
+  if (threadRunning_ || !thread_.joinable()) {
+    return;
+  }
+  auto finished = std::move(thread_);
+  lock.unlock();
+  finished.join();
+}
+
+void KeepAliveScheduler::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto next = std::chrono::steady_clock::now() + interval_;
+  while (!stop_ && !tasks_.empty()) {
+    if (condition_.wait_until(
+            lock, next, [this]() { return stop_ || tasks_.empty(); })) {
+      break;
+    }
+    auto tick = ++tick_;
+    for (auto const& [id, entry] : tasks_) {
+      due_.push_back(entry);
+    }
+    for (auto const& entry : due_) {
+      // Removed earlier in this pass
+      if (entry->removed) {
+        continue;
+      }
+      entry->running = true;
+      lock.unlock();
+      entry->task(tick);
+      lock.lock();
+      entry->running = false;
+      if (entry->removed) {
+        taskDone_.notify_all();
+      }
+    }
+    due_.clear();
+    next += interval_;
+    auto now = std::chrono::steady_clock::now();
+    if (next < now) {
+      // Fell behind (e.g. the machine slept), don't try to catch up
+      next = now + interval_;
+    }
+  }
+  threadRunning_ = false;
+  taskDone_.notify_all();
+}
+
+}  // namespace ear::plugin::communication
@@ -1,27 +1,34 @@
 #include "communication/metadata_sender.hpp"
+#include "detail/constants.hpp"
 namespace ear {
 namespace plugin {
 namespace communication {
 
+namespace {
+// Unchanged inputs send a full copy of their metadata every this many
+// keep-alive ticks, as a safety net should the Scene have missed an update
+constexpr std::uint64_t FULL_REFRESH_TICKS = 20;
+}  // namespace
+
 MetadataSender::MetadataSender(
     DataWrapper& data,
     std::shared_ptr<spdlog::logger> logger)
     : data_{data},
-      logger_{std::move(logger)},
-      maxSendInterval_{std::chrono::milliseconds(250)},
-      lastSendTimestamp_{std::chrono::system_clock::now()} {}
+      logger_{std::move(logger)} {}
 
 MetadataSender::~MetadataSender() {
-  timer_.stop();
-  timer_.wait();
+  stopKeepAlive();
 }
 
 ConnectionId MetadataSender::connectionId() { return connectionId_; }
 
 void MetadataSender::disconnect() {
     EAR_LOGGER_TRACE(logger_, "Disconnecting from metadata endpoint");
-  timer_.cancel();
-  timer_.wait();
+  stopKeepAlive();
+  {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    closeSlot();
+  }
   socket_.asyncCancel();
   socket_.asyncWait();
   dialer_.close();
@@ -29,57 +36,108 @@ void MetadataSender::disconnect() {
   socket_ = nng::PushSocket{};
 }
 
-void MetadataSender::triggerSend(bool force) {
+bool MetadataSender::triggerSend(bool force) {
   std::lock_guard<std::mutex> lock(sendMutex_);
   if(force || data_.readAccess([](auto const& item) {
      return item.changed();
   })) {
+      if (slot_ && sendToSlot()) {
+          return true;
+      }
       socket_.asyncWait();
       if (!connectionId_.isValid()) {
-          return;
+          return false;
       }
       auto msg = data_.prepareMessage();
       socket_.asyncSend(
               msg, [this](std::error_code ec, const nng::Message &ignored) {
                   if (!ec) {
-                      std::lock_guard<std::mutex> lock(timeoutMutex_);
-                      lastSendTimestamp_ = std::chrono::system_clock::now();
+                      sentSinceLastTick_.store(true);
                   } else {
                       // this sets changed flag
                       data_.writeAccess([](auto) {});
                       EAR_LOGGER_WARN(logger_, "Metadata sending failed: {}", ec.message());
                   }
               });
+      return true;
   }
+  return false;
 }
 
-void MetadataSender::startTimer() {
-  using namespace std::chrono_literals;
-  if (maxSendInterval_ > 0ms) {
-    bool expected{false};
-    if (timerRunning.compare_exchange_strong(expected, true)) {
-      timer_.sleep(maxSendInterval_ + 5ms,
-                   std::bind(&MetadataSender::handleTimeout, this,
-                             nng::placeholders::ErrorCode));
-    }
+void MetadataSender::openSlot() {
+  try {
+    slotTable_ = std::make_unique<MetadataSlotTable>(
+        detail::SCENE_MASTER_METADATA_SLOTS, MetadataSlotTable::Mode::OPEN);
+    slot_ = slotTable_->claim(connectionId_);
+  } catch (const std::runtime_error& e) {
+    EAR_LOGGER_INFO(logger_, "No metadata slot table, using socket: {}",
+                    e.what());
+  }
+  if (!slot_) {
+    slotTable_.reset();
   }
 }
 
-void MetadataSender::handleTimeout(std::error_code ec) {
-  timerRunning.store(false);
-  if (!ec) {
-    auto now = std::chrono::system_clock::now();
-    std::chrono::system_clock::duration deltaT{0};
-    {
-      std::lock_guard<std::mutex> lock(timeoutMutex_);
-      deltaT = now - lastSendTimestamp_;
-    }
-    if (deltaT > maxSendInterval_) {
-      triggerSend(true);
-    }
-    startTimer();
+void MetadataSender::closeSlot() {
+  if (slot_) {
+    slotTable_->release(*slot_);
+  }
+  slot_.reset();
+  slotTable_.reset();
+}
+
+bool MetadataSender::sendToSlot() {
+  if (data_.serializeWith([this](auto const& item) {
+        return slotTable_->write(*slot_, item);
+      })) {
+    sentSinceLastTick_.store(true);
+    return true;
+  }
+  // Too large for a slot, or the Scene has freed it. Stay on the socket from
+  // here on, so the Scene can't see updates from the two paths out of order.
+  EAR_LOGGER_INFO(logger_, "Metadata slot unusable, using socket");
+  closeSlot();
+  return false;
+}
+
+void MetadataSender::keepAlive(std::uint64_t tick) {
+  if (sentSinceLastTick_.exchange(false)) {
+    return;
+  }
+  if (tick % FULL_REFRESH_TICKS == 0) {
+    // Also notices a lapsed slot claim, moving this input to the socket
+    triggerSend(true);
+  } else if (!triggerSend()) {
+    // Nothing changed (or failed to send) since the last full copy
+    sendHeartbeat();
   }
 }
+
+void MetadataSender::sendHeartbeat() {
+  std::lock_guard<std::mutex> lock(sendMutex_);
+  // The Scene reads the slot table whenever it likes, so there is nothing to
+  // keep alive there
+  if (slot_ || !connectionId_.isValid()) {
+    return;
+  }
+  socket_.asyncWait();
+  socket_.asyncSend(data_.prepareHeartbeat(),
+                    [this](std::error_code ec, const nng::Message& ignored) {
+                      if (ec) {
+                        EAR_LOGGER_WARN(logger_,
+                                        "Metadata heartbeat failed: {}",
+                                        ec.message());
+                      }
+                    });
+}
+
+void MetadataSender::stopKeepAlive() {
+  if (keepAliveTask_) {
+    KeepAliveScheduler::metadataSenders().remove(*keepAliveTask_);
+    keepAliveTask_.reset();
+  }
+}
+
 void MetadataSender::logger(std::shared_ptr<spdlog::logger> logger) {
   logger_ = std::move(logger);
 }
@@ -95,8 +153,19 @@ void MetadataSender::connect(const std::string& endpoint, ConnectionId id) {
     dialer_ = socket_.createDialer(endpoint.c_str());
     dialer_.start();
     EAR_LOGGER_DEBUG(logger_, "Metadata stream connected", endpoint);
-    startTimer();
   });
+  // Not while holding the data lock, as triggerSend takes the locks the
+  // other way round
+  {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    closeSlot();
+    openSlot();
+  }
+  // Spread full refreshes of the inputs across ticks
+  auto offset = std::hash<std::string>{}(id.string()) % FULL_REFRESH_TICKS;
+  stopKeepAlive();
+  keepAliveTask_ = KeepAliveScheduler::metadataSenders().add(
+      [this, offset](std::uint64_t tick) { keepAlive(tick + offset); });
 }
 }  // namespace communication
 }  // namespace plugin
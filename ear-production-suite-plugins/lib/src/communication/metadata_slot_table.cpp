@@ -0,0 +1,235 @@
+#include "communication/metadata_slot_table.hpp"
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#ifdef WIN32
+#include <boost/interprocess/windows_shared_memory.hpp>
+#else
+#include <boost/interprocess/shared_memory_object.hpp>
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace bip = boost::interprocess;
+
+namespace ear {
+namespace plugin {
+namespace communication {
+
+namespace {
+
+constexpr std::uint32_t TABLE_MAGIC = 0x45505353;  // "EPSS"
+constexpr std::uint32_t TABLE_VERSION = 1;
+constexpr std::uint32_t SLOT_FREE = 0;
+constexpr std::uint32_t SLOT_CLAIMED = 1;
+// A slot found mid-write is re-read this many times before being left for
+// the next scan
+constexpr int READ_ATTEMPTS = 3;
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "Slot table atomics are shared between processes");
+
+struct Slot {
+  std::atomic<std::uint32_t> state;
+  // Bumped before the slot is freed, so a lapsed claim can't touch the
+  // slot's next owner, even while that owner is still claiming it
+  std::atomic<std::uint32_t> generation;
+  // Odd while the slot is being written
+  std::atomic<std::uint32_t> sequence;
+  std::uint32_t size;
+  std::array<std::uint8_t, 16> connectionId;
+  std::array<unsigned char, MetadataSlotTable::PAYLOAD_CAPACITY> payload;
+};
+
+struct Layout {
+  // Set last on creation, so a table still being set up isn't opened
+  std::atomic<std::uint32_t> magic;
+  std::uint32_t version;
+  std::uint32_t slotCount;
+  std::uint32_t payloadCapacity;
+  std::array<Slot, MetadataSlotTable::SLOT_COUNT> slots;
+};
+
+std::array<std::uint8_t, 16> uuidBytes(const ConnectionId& id) {
+  std::array<std::uint8_t, 16> bytes;
+  auto uuid = id.getUuid();
+  std::copy(uuid.begin(), uuid.end(), bytes.begin());
+  return bytes;
+}
+
+}  // namespace
+
+struct MetadataSlotTable::Mapping {
+#ifdef WIN32
+  // Windows removes the memory along with its last handle
+  bip::windows_shared_memory memory;
+#else
+  bip::shared_memory_object memory;
+  std::string removeOnClose;
+#endif
+  bip::mapped_region region;
+  Layout* layout{nullptr};
+};
+
+MetadataSlotTable::MetadataSlotTable(const std::string& name, Mode mode)
+    : mapping_{std::make_unique<Mapping>()},
+      lastSequences_(SLOT_COUNT, 0),
+      readBuffer_(PAYLOAD_CAPACITY) {
+  try {
+    if (mode == Mode::CREATE) {
+#ifdef WIN32
+      mapping_->memory = bip::windows_shared_memory(
+          bip::create_only, name.c_str(), bip::read_write, sizeof(Layout));
+#else
+      // Left behind if a previous Scene crashed
+      bip::shared_memory_object::remove(name.c_str());
+      mapping_->memory = bip::shared_memory_object(
+          bip::create_only, name.c_str(), bip::read_write);
+      mapping_->memory.truncate(sizeof(Layout));
+      mapping_->removeOnClose = name;
+#endif
+      mapping_->region = bip::mapped_region(mapping_->memory, bip::read_write);
+      auto layout = new (mapping_->region.get_address()) Layout{};
+      layout->version = TABLE_VERSION;
+      layout->slotCount = SLOT_COUNT;
+      layout->payloadCapacity = PAYLOAD_CAPACITY;
+      layout->magic.store(TABLE_MAGIC, std::memory_order_release);
+      mapping_->layout = layout;
+    } else {
+#ifdef WIN32
+      mapping_->memory = bip::windows_shared_memory(
+          bip::open_only, name.c_str(), bip::read_write);
+#else
+      mapping_->memory = bip::shared_memory_object(bip::open_only, name.c_str(),
+                                                   bip::read_write);
+#endif
+      mapping_->region = bip::mapped_region(mapping_->memory, bip::read_write);
+      auto layout = static_cast<Layout*>(mapping_->region.get_address());
+      if (mapping_->region.get_size() < sizeof(Layout) ||
+          layout->magic.load(std::memory_order_acquire) != TABLE_MAGIC ||
+          layout->version != TABLE_VERSION ||
+          layout->slotCount != SLOT_COUNT ||
+          layout->payloadCapacity != PAYLOAD_CAPACITY) {
+        throw std::runtime_error("Incompatible metadata slot table " + name);
+      }
+      mapping_->layout = layout;
+    }
+  } catch (const bip::interprocess_exception& e) {
+    throw std::runtime_error("Failed to map metadata slot table " + name +
+                             ": " + e.what());
+  }
+}
+
+MetadataSlotTable::~MetadataSlotTable() {
+#ifndef WIN32
+  if (!mapping_->removeOnClose.empty()) {
+    // Inputs still attached keep their mapping until they reconnect
+    bip::shared_memory_object::remove(mapping_->removeOnClose.c_str());
+  }
+#endif
+}
+
+std::optional<MetadataSlotTable::SlotHandle> MetadataSlotTable::claim(
+    const ConnectionId& id) {
+  auto& slots = mapping_->layout->slots;
+  for (std::size_t i = 0; i < slots.size(); ++i) {
+    auto expected = SLOT_FREE;
+    if (slots[i].state.compare_exchange_strong(expected, SLOT_CLAIMED,
+                                               std::memory_order_acq_rel)) {
+      slots[i].connectionId = uuidBytes(id);
+      return SlotHandle{i,
+                        slots[i].generation.load(std::memory_order_acquire)};
+    }
+  }
+  return std::nullopt;
+}
+
+void MetadataSlotTable::release(const SlotHandle& slot) {
+  auto& target = mapping_->layout->slots.at(slot.index);
+  auto expected = slot.generation;
+  if (target.generation.compare_exchange_strong(expected, slot.generation + 1,
+                                                std::memory_order_acq_rel)) {
+    target.state.store(SLOT_FREE, std::memory_order_release);
+  }
+}
+
+void MetadataSlotTable::release(const ConnectionId& id) {
+  auto bytes = uuidBytes(id);
+  for (auto& slot : mapping_->layout->slots) {
+    if (slot.state.load(std::memory_order_acquire) == SLOT_CLAIMED &&
+        slot.connectionId == bytes) {
+      slot.generation.fetch_add(1, std::memory_order_acq_rel);
+      slot.state.store(SLOT_FREE, std::memory_order_release);
+    }
+  }
+}
+
+bool MetadataSlotTable::write(const SlotHandle& slot,
+                              const proto::InputItemMetadata& item) {
+  auto size = item.ByteSizeLong();
+  auto& target = mapping_->layout->slots.at(slot.index);
+  if (size > PAYLOAD_CAPACITY ||
+      target.state.load(std::memory_order_acquire) != SLOT_CLAIMED ||
+      target.generation.load(std::memory_order_acquire) != slot.generation) {
+    return false;
+  }
+  // Only one write at a time - a lapsed claim may still be writing as the
+  // slot's next owner starts
+  auto sequence = target.sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1u) ||
+      !target.sequence.compare_exchange_strong(sequence, sequence + 1,
+                                               std::memory_order_acq_rel)) {
+    return false;
+  }
+  // The slot may have been released since the checks above
+  if (target.generation.load(std::memory_order_acquire) != slot.generation) {
+    target.sequence.store(sequence, std::memory_order_release);
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  item.SerializeToArray(target.payload.data(), static_cast<int>(size));
+  target.size = static_cast<std::uint32_t>(size);
+  target.sequence.store(sequence + 2, std::memory_order_release);
+  return true;
+}
+
+void MetadataSlotTable::poll(const Handler& handler) {
+  auto& slots = mapping_->layout->slots;
+  for (std::size_t i = 0; i < slots.size(); ++i) {
+    auto& slot = slots[i];
+    if (slot.state.load(std::memory_order_acquire) != SLOT_CLAIMED) {
+      continue;
+    }
+    for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+      auto before = slot.sequence.load(std::memory_order_acquire);
+      if (before == lastSequences_[i]) {
+        break;
+      }
+      if (before & 1u) {
+        continue;
+      }
+      auto size = std::min<std::size_t>(slot.size, PAYLOAD_CAPACITY);
+      std::memcpy(readBuffer_.data(), slot.payload.data(), size);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+
+      lastSequences_[i] = before;
+      if (readItem_.ParseFromArray(readBuffer_.data(),
+                                   static_cast<int>(size)) &&
+          !readItem_.connection_id().empty()) {
+        handler(ConnectionId{readItem_.connection_id()}, readItem_);
+      }
+      break;
+    }
+  }
+}
+
+}  // namespace communication
+}  // namespace plugin
+}  // namespace ear
@@ -91,6 +91,31 @@ SceneConnectionManager::doHandle(
       message.connectionId(), detail::SCENE_MASTER_SCENE_STREAM_ENDPOINT);
 }
 
+communication::RegisterInputsResponse SceneConnectionManager::doHandle(
+    const communication::RegisterInputsMessage& message) {
+  std::vector<communication::ConnectionId> assignedIds;
+  assignedIds.reserve(message.connectionIds().size());
+  try {
+    for (auto const& connectionId : message.connectionIds()) {
+      auto assignedId = inputConnections_.add(
+          communication::ConnectionType::METADATA_INPUT, connectionId);
+      inputConnections_.get(assignedId).state = Connection::ACTIVE;
+      assignedIds.push_back(assignedId);
+    }
+  } catch (const std::runtime_error&) {
+    // All or nothing, so the inputs can fall back to connecting one by one
+    for (auto const& assignedId : assignedIds) {
+      inputConnections_.remove(assignedId);
+    }
+    throw;
+  }
+  for (auto const& assignedId : assignedIds) {
+    notify(Event::INPUT_ADDED, assignedId);
+  }
+  return communication::RegisterInputsResponse(
+      std::move(assignedIds), detail::SCENE_MASTER_METADATA_ENDPOINT);
+}
+
 void SceneConnectionManager::notify(SceneConnectionManager::Event event,
                                     communication::ConnectionId id) const {
   if (callback_) {
@@ -0,0 +1,54 @@
+#include "converted_scene.hpp"
+#include "helper/eps_to_ear_metadata_converter.hpp"
+#include <set>
+#include <stdexcept>
+
+namespace ear {
+namespace plugin {
+
+void ConvertedScene::update(const proto::SceneStore& store) {
+  std::set<communication::ConnectionId> present;
+  for (const auto& item : store.monitoring_items()) {
+    communication::ConnectionId id{item.connection_id()};
+    present.insert(id);
+
+    auto it = items_.find(id);
+    if (it != items_.end() && !item.changed()) {
+      it->second.changed = false;
+      continue;
+    }
+
+    ConvertedItem converted;
+    converted.routing = item.routing();
+    if (item.has_obj_metadata()) {
+      converted.objects =
+          EpsToEarMetadataConverter::convert(item.obj_metadata());
+    }
+    if (item.has_ds_metadata()) {
+      converted.directSpeakers =
+          EpsToEarMetadataConverter::convertInterned(item.ds_metadata());
+    }
+    if (item.has_hoa_metadata()) {
+      converted.hoa =
+          EpsToEarMetadataConverter::convertInterned(item.hoa_metadata());
+    }
+    if (item.has_bin_metadata()) {
+      throw std::runtime_error("received unsupported binaural type metadata");
+    }
+    if (item.has_mtx_metadata()) {
+      throw std::runtime_error("received unsupported Matrix type metadata");
+    }
+    items_[id] = std::move(converted);
+  }
+
+  for (auto it = items_.begin(); it != items_.end();) {
+    if (present.count(it->first) == 0) {
+      it = items_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace plugin
+}  // namespace ear
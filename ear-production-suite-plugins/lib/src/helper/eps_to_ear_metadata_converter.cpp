@@ -0,0 +1,91 @@
+#include "helper/eps_to_ear_metadata_converter.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace ear {
+namespace plugin {
+
+namespace {
+
+// Compares only what convert() uses
+bool sameSpeakers(const proto::DirectSpeakersTypeMetadata &a,
+                  const proto::DirectSpeakersTypeMetadata &b) {
+  if (a.speakers_size() != b.speakers_size()) {
+    return false;
+  }
+  for (int i = 0; i < a.speakers_size(); ++i) {
+    auto const &speakerA = a.speakers(i);
+    auto const &speakerB = b.speakers(i);
+    if (speakerA.is_lfe() != speakerB.is_lfe() ||
+        speakerA.position().azimuth() != speakerB.position().azimuth() ||
+        speakerA.position().elevation() != speakerB.position().elevation() ||
+        speakerA.position().distance() != speakerB.position().distance() ||
+        speakerA.labels_size() != speakerB.labels_size()) {
+      return false;
+    }
+    for (int j = 0; j < speakerA.labels_size(); ++j) {
+      if (speakerA.labels(j) != speakerB.labels(j)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Entries are never removed; there are only as many as there are pack formats
+template <typename Value>
+class InternTable {
+ public:
+  template <typename Make>
+  Value findOrAdd(int packFormatIdValue, Make &&make) {
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      if (auto it = table_.find(packFormatIdValue); it != table_.end()) {
+        return it->second;
+      }
+    }
+    auto value = make();
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return table_.emplace(packFormatIdValue, std::move(value)).first->second;
+  }
+
+ private:
+  std::shared_mutex mutex_;
+  std::unordered_map<int, Value> table_;
+};
+
+struct DirectSpeakersEntry {
+  proto::DirectSpeakersTypeMetadata source;
+  InternedDirectSpeakersMetadata converted;
+};
+
+}  // namespace
+
+InternedDirectSpeakersMetadata EpsToEarMetadataConverter::convertInterned(
+    const proto::DirectSpeakersTypeMetadata &epsMetadata) {
+  static InternTable<std::shared_ptr<const DirectSpeakersEntry>> table;
+  auto entry = table.findOrAdd(epsMetadata.packformatidvalue(), [&]() {
+    return std::make_shared<const DirectSpeakersEntry>(DirectSpeakersEntry{
+        epsMetadata,
+        std::make_shared<const std::vector<ear::DirectSpeakersTypeMetadata>>(
+            convert(epsMetadata))});
+  });
+  if (!sameSpeakers(entry->source, epsMetadata)) {
+    return std::make_shared<const std::vector<ear::DirectSpeakersTypeMetadata>>(
+        convert(epsMetadata));
+  }
+  return entry->converted;
+}
+
+InternedHoaMetadata EpsToEarMetadataConverter::convertInterned(
+    const proto::HoaTypeMetadata &epsMetadata) {
+  static InternTable<InternedHoaMetadata> table;
+  return table.findOrAdd(epsMetadata.packformatidvalue(), [&]() {
+    return std::make_shared<const ear::HOATypeMetadata>(convert(epsMetadata));
+  });
+}
+
+}  // namespace plugin
+}  // namespace ear
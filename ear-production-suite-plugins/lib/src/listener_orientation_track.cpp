@@ -0,0 +1,143 @@
+#include "listener_orientation_track.hpp"
+#include <readerwriterqueue.h>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+
+namespace ear {
+namespace plugin {
+
+struct ListenerOrientationTrack::Ring {
+  explicit Ring(std::size_t capacity) : queue(capacity) {}
+  moodycamel::ReaderWriterQueue<Sample> queue;
+};
+
+ListenerOrientationTrack::ListenerOrientationTrack(std::size_t capacity)
+    : ring_{std::make_unique<Ring>(capacity)} {}
+
+ListenerOrientationTrack::~ListenerOrientationTrack() = default;
+
+bool ListenerOrientationTrack::push(Quaternion orientation,
+                                    Clock::time_point received) noexcept {
+  return ring_->queue.try_enqueue(Sample{orientation, received});
+}
+
+void ListenerOrientationTrack::setPrediction(
+    std::chrono::microseconds prediction) noexcept {
+  predictionMicroseconds_.store(prediction.count(), std::memory_order_relaxed);
+}
+
+std::chrono::microseconds ListenerOrientationTrack::prediction()
+    const noexcept {
+  return std::chrono::microseconds{
+      predictionMicroseconds_.load(std::memory_order_relaxed)};
+}
+
+void ListenerOrientationTrack::update() noexcept {
+  Sample sample;
+  while (ring_->queue.try_dequeue(sample)) {
+    newest_ = (newest_ + 1) % HISTORY_SIZE;
+    history_[newest_] = sample;
+    historyCount_ = std::min(historyCount_ + 1, HISTORY_SIZE);
+  }
+}
+
+std::optional<ListenerOrientationTrack::Quaternion>
+ListenerOrientationTrack::orientationAt(Clock::time_point time) const noexcept {
+  if (historyCount_ == 0) {
+    return std::nullopt;
+  }
+  auto const& latest = history_[newest_];
+  if (time - latest.received > STALE_AFTER) {
+    return std::nullopt;
+  }
+
+  const Sample* previous = nullptr;
+  for (std::size_t age = 1; age < historyCount_; ++age) {
+    auto const& sample =
+        history_[(newest_ + HISTORY_SIZE - age) % HISTORY_SIZE];
+    if (latest.received - sample.received >= MIN_SAMPLE_INTERVAL) {
+      previous = &sample;
+      break;
+    }
+  }
+  // Too long between samples to tell how the head is moving
+  if (!previous || latest.received - previous->received > STALE_AFTER) {
+    return latest.orientation;
+  }
+
+  using Seconds = std::chrono::duration<double>;
+  auto sinceLatest = time - latest.received;
+  auto ahead = Seconds(prediction()).count() +
+               Seconds(std::min<Clock::duration>(sinceLatest,
+                                                 MAX_EXTRAPOLATION))
+                   .count();
+  if (sinceLatest > MAX_EXTRAPOLATION) {
+    auto decay = Seconds(sinceLatest - MAX_EXTRAPOLATION) /
+                 Seconds(EXTRAPOLATION_DECAY);
+    ahead *= std::max(0.0, 1.0 - decay);
+  }
+  auto t = 1.0 + std::max(0.0, ahead) /
+                     Seconds(latest.received - previous->received).count();
+  return slerp(previous->orientation, latest.orientation, t);
+}
+
+std::optional<ListenerOrientationTrack::Clock::time_point>
+ListenerOrientationTrack::latestReceived() const noexcept {
+  if (historyCount_ == 0) {
+    return std::nullopt;
+  }
+  return history_[newest_].received;
+}
+
+ListenerOrientationTrack::Quaternion ListenerOrientationTrack::slerp(
+    const Quaternion& from, const Quaternion& to, double t) noexcept {
+  Eigen::Quaterniond a{from.w, from.x, from.y, from.z};
+  Eigen::Quaterniond b{to.w, to.x, to.y, to.z};
+  // Eigen falls back to a linear blend for near-identical rotations, which
+  // needs normalising once t is outside [0, 1]
+  auto result = a.slerp(t, b).normalized();
+  return Quaternion{result.w(), result.x(), result.y(), result.z()};
+}
+
+namespace {
+
+// Close enough to the orientation set by hand to stop handing back
+constexpr double handedBackDot = 1.0 - 1e-9;
+
+double smoothingFor(double periodSeconds, double seconds) {
+  return 1.0 - std::exp(-periodSeconds / seconds);
+}
+
+}  // namespace
+
+ListenerOrientationSmoother::ListenerOrientationSmoother(double periodSeconds,
+                                                         double trackSeconds,
+                                                         double handBackSeconds)
+    : trackSmoothing_{smoothingFor(periodSeconds, trackSeconds)},
+      handBackSmoothing_{smoothingFor(periodSeconds, handBackSeconds)} {}
+
+ListenerOrientationSmoother::Quaternion ListenerOrientationSmoother::next(
+    const std::optional<Quaternion>& tracked, const Quaternion& manual) {
+  if (tracked) {
+    current_ = current_ ? ListenerOrientationTrack::slerp(*current_, *tracked,
+                                                          trackSmoothing_)
+                        : *tracked;
+    return *current_;
+  }
+  if (!current_) {
+    return manual;
+  }
+  current_ =
+      ListenerOrientationTrack::slerp(*current_, manual, handBackSmoothing_);
+  auto dot = current_->w * manual.w + current_->x * manual.x +
+             current_->y * manual.y + current_->z * manual.z;
+  if (std::abs(dot) > handedBackDot) {
+    current_.reset();
+    return manual;
+  }
+  return *current_;
+}
+
+}  // namespace plugin
+}  // namespace ear
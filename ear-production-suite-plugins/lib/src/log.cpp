@@ -1,11 +1,300 @@
 #include "log.hpp"
-#include "detail/spdl_nng_sink.hpp"
+#include "detail/async_log_sink.hpp"
+#include "detail/log_config.hpp"
+#include "nng-cpp/protocols/push.hpp"
+#include <readerwriterqueue.h>
+#include <spdlog/details/os.h>
 #include <spdlog/logger.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/null_sink.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace ear {
 namespace plugin {
+namespace detail {
+
+namespace {
+
+// Keeps a record within 256 bytes
+constexpr std::size_t LOGGER_NAME_CAPACITY = 48;
+constexpr std::size_t PAYLOAD_CAPACITY = 176;
+constexpr std::size_t RECORDS_PER_THREAD = 256;
+// Threads with a queue at once; messages from any more are dropped
+constexpr std::size_t MAX_LOGGING_THREADS = 64;
+constexpr auto IDLE_POLL_INTERVAL = std::chrono::milliseconds(5);
+
+struct LogRecord {
+  LogRecord() = default;
+  explicit LogRecord(const spdlog::details::log_msg& msg)
+      : time{msg.time},
+        threadId{msg.thread_id},
+        level{msg.level},
+        loggerNameLength{static_cast<std::uint8_t>(
+            std::min(msg.logger_name.size(), LOGGER_NAME_CAPACITY))},
+        payloadLength{static_cast<std::uint8_t>(
+            std::min(msg.payload.size(), PAYLOAD_CAPACITY))},
+        truncated{msg.payload.size() > PAYLOAD_CAPACITY} {
+    std::memcpy(loggerName, msg.logger_name.data(), loggerNameLength);
+    std::memcpy(payload, msg.payload.data(), payloadLength);
+  }
+
+  // A warning from the backend itself
+  static LogRecord notice(const std::string& text) {
+    LogRecord record;
+    record.time = spdlog::log_clock::now();
+    record.level = spdlog::level::warn;
+    record.payloadLength =
+        static_cast<std::uint8_t>(std::min(text.size(), PAYLOAD_CAPACITY));
+    std::memcpy(record.payload, text.data(), record.payloadLength);
+    return record;
+  }
+
+  spdlog::log_clock::time_point time;
+  std::size_t threadId{0};
+  spdlog::level::level_enum level{spdlog::level::off};
+  std::uint8_t loggerNameLength{0};
+  std::uint8_t payloadLength{0};
+  bool truncated{false};
+  char loggerName[LOGGER_NAME_CAPACITY];
+  char payload[PAYLOAD_CAPACITY];
+};
+
+struct ThreadLogQueue {
+  ThreadLogQueue() : records(RECORDS_PER_THREAD) {}
+  moodycamel::ReaderWriterQueue<LogRecord> records;
+  std::atomic<std::uint32_t> dropped{0};
+  // Taken by a thread on its first message, and handed back by the backend
+  // once that thread has exited and everything it logged has been read
+  std::atomic<bool> claimed{false};
+  std::atomic<bool> threadExited{false};
+};
+
+// Every queue is allocated up front, when the first logger is created, so
+// logging never allocates or locks. Queues outlive their thread (until
+// drained) and any one backend, so are kept here rather than by the backend.
+class ThreadLogQueuePool {
+ public:
+  static ThreadLogQueuePool& instance() {
+    static ThreadLogQueuePool pool;
+    return pool;
+  }
+
+  // Nothing if every queue is taken
+  ThreadLogQueue* claim() noexcept {
+    for (auto& queue : queues_) {
+      auto expected = false;
+      if (!queue.claimed.load(std::memory_order_relaxed) &&
+          queue.claimed.compare_exchange_strong(expected, true,
+                                                std::memory_order_acquire)) {
+        return &queue;
+      }
+    }
+    return nullptr;
+  }
+
+  // Backend only
+  std::vector<ThreadLogQueue>& queues() { return queues_; }
+
+  // Messages from threads which found every queue taken
+  std::atomic<std::uint32_t> unqueued{0};
+
+ private:
+  ThreadLogQueuePool() : queues_(MAX_LOGGING_THREADS) {}
+  std::vector<ThreadLogQueue> queues_;
+};
+
+struct ThreadLogQueueHandle {
+  ~ThreadLogQueueHandle() {
+    if (queue) {
+      queue->threadExited.store(true, std::memory_order_release);
+    }
+  }
+  ThreadLogQueue* queue{nullptr};
+};
+
+ThreadLogQueue* threadLogQueue() noexcept {
+  thread_local ThreadLogQueueHandle handle;
+  if (!handle.queue) {
+    handle.queue = ThreadLogQueuePool::instance().claim();
+  }
+  return handle.queue;
+}
+
+}  // namespace
+
+class LogBackend {
+ public:
+  // All sinks in this module share one backend, which stops once the last
+  // logger has gone
+  static std::shared_ptr<LogBackend> get() {
+    static std::mutex mutex;
+    static std::weak_ptr<LogBackend> current;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto backend = current.lock();
+    if (!backend) {
+      backend = std::make_shared<LogBackend>();
+      current = backend;
+    }
+    return backend;
+  }
+
+  LogBackend() {
+    // Allocates the queues here rather than on the first message
+    ThreadLogQueuePool::instance();
+    socket_.dial(DEFAULT_LOG_ENDPOINT, nng::Flags::nonblock);
+    if (auto path = std::getenv("EPS_LOG_FILE")) {
+      file_.open(path, std::ios::out | std::ios::app);
+    }
+    running_ = true;
+    thread_ = std::thread([this]() { run(); });
+  }
+
+  ~LogBackend() {
+    running_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+ private:
+  void run() {
+    while (running_) {
+      if (drain() == 0) {
+        std::this_thread::sleep_for(IDLE_POLL_INTERVAL);
+      }
+    }
+    drain();
+  }
+
+  std::size_t drain() {
+    // A backend may still be finishing as the next one starts, but each queue
+    // must only ever have one reader
+    static std::mutex readerMutex;
+    std::lock_guard<std::mutex> lock(readerMutex);
+    std::size_t written = 0;
+    auto& pool = ThreadLogQueuePool::instance();
+    for (auto& queue : pool.queues()) {
+      if (!queue.claimed.load(std::memory_order_acquire)) {
+        continue;
+      }
+      // Before reading, so everything the thread logged is read below
+      auto threadExited = queue.threadExited.load(std::memory_order_acquire);
+      while (queue.records.try_dequeue(record_)) {
+        write(record_);
+        ++written;
+      }
+      if (auto dropped = queue.dropped.exchange(0)) {
+        write(LogRecord::notice(
+            fmt::format("{} log messages dropped", dropped)));
+      }
+      if (threadExited) {
+        queue.threadExited.store(false, std::memory_order_relaxed);
+        queue.claimed.store(false, std::memory_order_release);
+      }
+    }
+    if (auto unqueued = pool.unqueued.exchange(0)) {
+      write(LogRecord::notice(fmt::format(
+          "{} log messages dropped from threads beyond the first {}",
+          unqueued, MAX_LOGGING_THREADS)));
+    }
+    return written;
+  }
+
+  void write(const LogRecord& record) {
+    format(record);
+    if (file_.is_open()) {
+      file_.write(formatted_.data(), formatted_.size());
+    }
+    if (!send()) {
+      ++unsent_;
+    } else if (unsent_ > 0) {
+      // A server is listening now; tell it what it missed
+      format(LogRecord::notice(fmt::format(
+          "{} earlier log messages weren't sent, as no log server was "
+          "listening",
+          unsent_)));
+      if (send()) {
+        unsent_ = 0;
+      }
+    }
+  }
+
+  void format(const LogRecord& record) {
+    spdlog::details::log_msg msg(
+        spdlog::source_loc{},
+        spdlog::string_view_t(record.loggerName, record.loggerNameLength),
+        record.level,
+        spdlog::string_view_t(record.payload, record.payloadLength));
+    msg.time = record.time;
+    msg.thread_id = record.threadId;
+
+    formatted_.clear();
+    formatter_.format(msg, formatted_);
+    if (record.truncated) {
+      append(" [truncated]");
+    }
+    append(spdlog::details::os::default_eol);
+  }
+
+  bool send() {
+    try {
+      // Nothing is listening most of the time, so never wait for the server.
+      // False if nothing is, or it has fallen behind.
+      return socket_.send(formatted_, nng::Flags::nonblock);
+    } catch (const std::system_error&) {
+      return false;
+    }
+  }
+
+  void append(const char* str) {
+    formatted_.append(str, str + std::strlen(str));
+  }
+
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  nng::PushSocket socket_;
+  std::ofstream file_;
+  // No end of line, so a truncation marker can go before it
+  spdlog::pattern_formatter formatter_{spdlog::pattern_time_type::local, ""};
+  spdlog::memory_buf_t formatted_;
+  LogRecord record_;
+  // Messages lost since a log server last received one
+  std::uint64_t unsent_{0};
+};
+
+AsyncLogSink::AsyncLogSink() : backend_{LogBackend::get()} {}
+
+AsyncLogSink::~AsyncLogSink() = default;
+
+void AsyncLogSink::sink_it_(const spdlog::details::log_msg& msg) {
+  auto queue = threadLogQueue();
+  if (!queue) {
+    ThreadLogQueuePool::instance().unqueued.fetch_add(
+        1, std::memory_order_relaxed);
+  } else if (!queue->records.try_emplace(msg)) {
+    queue->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace detail
+
 std::shared_ptr<spdlog::logger> createLogger(const std::string& name) {
-  auto sink = std::make_shared<detail::NNGSink_mt>();
+#ifdef EPS_ENABLE_LOGGING
+  auto sink = std::make_shared<detail::AsyncLogSink>();
+#else
+  // No backend thread polling for messages which never come
+  auto sink = std::make_shared<spdlog::sinks::null_sink_st>();
+#endif
   return std::make_shared<spdlog::logger>(name, sink);
 }
 }  // namespace plugin
@@ -11,15 +11,22 @@ using std::placeholders::_2;
 namespace ear {
 namespace plugin {
 
-inline std::vector<std::vector<float>> convertToVec(GainMatrix m) {
-  std::vector<std::vector<float>> vec;
-  for (int i = 0; i < m.cols(); ++i) {
-    vec.push_back(
-        std::vector<float>(m.col(i).data(), m.col(i).data() + m.rows()));
+namespace {
+
+// Gains for the given inputs only, per input, as LinearInterpMatrix takes
+// them. Reuses the storage in `gains`.
+void gainsForInputs(const GainMatrix& matrix,
+                    const std::vector<Eigen::Index>& inputs,
+                    std::vector<std::vector<float>>& gains) {
+  gains.resize(inputs.size());
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    auto column = matrix.col(inputs[i]);
+    gains[i].assign(column.data(), column.data() + matrix.rows());
   }
-  return vec;
 }
 
+}  // namespace
+
 MonitoringAudioProcessor::MonitoringAudioProcessor(
     std::size_t inputChannelCount, Layout layout, std::size_t blockSize)
     : inputChannelCount_(inputChannelCount),
@@ -34,7 +41,10 @@ MonitoringAudioProcessor::MonitoringAudioProcessor(
       currentDiffuseGains_(layout.channels().size(), inputChannelCount_),
       nextDirectGains_(layout.channels().size(), inputChannelCount_),
       nextDiffuseGains_(layout.channels().size(), inputChannelCount_),
+      silence_(inputChannelCount, 0),
       convolver_(ear::designDecorrelators<float>(layout), blockSize) {
+  activeInputs_.reserve(inputChannelCount);
+  activeInputPointers_.reserve(inputChannelCount);
   currentDirectGains_.setZero();
   currentDiffuseGains_.setZero();
   nextDirectGains_.setZero();
@@ -45,46 +55,90 @@ std::size_t MonitoringAudioProcessor::delayInSamples() const {
   return blockAdapter_.get_delay() + directPathDelay_.get_delay();
 }
 
+SkipCounts MonitoringAudioProcessor::takeSkipCounts() {
+  auto counts = skipCounts_;
+  skipCounts_ = SkipCounts{};
+  return counts;
+}
+
 void MonitoringAudioProcessor::doBlockedProcess(
     const Eigen::Ref<const Eigen::MatrixXf>& in,
     Eigen::Ref<Eigen::MatrixXf> out) {
   // in -> gain_interp_direct -> buffer_a
+  // buffer_a += in * hoa_decodes
   // buffer_a -> delay_buffer -> out
   // in -> gain_interp_diffuse -> buffer_a
   // buffer_a -> convolvers > buffer_b
   // out += buffer_b
 
-  ear::dsp::PtrAdapterConst in_p(in.cols());
-  in_p.set_eigen(in);
+  silence_.check(in);
+  activeInputs_.clear();
+  activeInputPointers_.clear();
+  for (Eigen::Index input = 0; input < in.cols(); ++input) {
+    if (silence_.isActive(static_cast<std::size_t>(input))) {
+      activeInputs_.push_back(input);
+      activeInputPointers_.push_back(in.col(input).data());
+    }
+  }
+  skipCounts_.channelBlocks += static_cast<std::uint64_t>(in.cols());
+  skipCounts_.skippedChannelBlocks +=
+      static_cast<std::uint64_t>(in.cols()) - activeInputs_.size();
+
   ear::dsp::PtrAdapter out_p(out.cols());
   out_p.set_eigen(out);
   dsp::PtrAdapter bufferA_p(bufferA_.cols());
   bufferA_p.set_eigen(bufferA_);
 
   // Apply gain ramp for direct path
-  std::vector<std::vector<float>> currentDirectGains_v =
-      convertToVec(currentDirectGains_);
-  std::vector<std::vector<float>> nextDirectGains_v =
-      convertToVec(nextDirectGains_);
-
-  dsp::LinearInterpMatrix::apply_interp(
-      in_p.ptrs(), bufferA_p.ptrs(), 0, internalBlockSize_, 0, 0,
-      internalBlockSize_, currentDirectGains_v, nextDirectGains_v);
+  if (activeInputs_.empty()) {
+    bufferA_.setZero();
+  } else {
+    gainsForInputs(currentDirectGains_, activeInputs_, currentActiveGains_);
+    gainsForInputs(nextDirectGains_, activeInputs_, nextActiveGains_);
+    dsp::LinearInterpMatrix::apply_interp(
+        activeInputPointers_.data(), bufferA_p.ptrs(), 0, internalBlockSize_,
+        0, 0, internalBlockSize_, currentActiveGains_, nextActiveGains_);
+  }
   currentDirectGains_ = nextDirectGains_;
 
+  // HOA decodes only change with the item's order, so there is nothing to
+  // interpolate; a block matrix product is enough
+  for (auto const& decode : hoaDecodes_) {
+    auto const& gains = *decode.gains;
+    if (decode.inputStartingChannel < 0 ||
+        decode.inputStartingChannel + gains.cols() > in.cols() ||
+        gains.rows() != bufferA_.cols()) {
+      continue;
+    }
+    bool active = false;
+    for (Eigen::Index channel = 0; channel < gains.cols(); ++channel) {
+      active = active || silence_.isActive(static_cast<std::size_t>(
+                             decode.inputStartingChannel + channel));
+    }
+    if (!active) {
+      continue;
+    }
+    bufferA_.noalias() +=
+        in.middleCols(decode.inputStartingChannel, gains.cols()) *
+        gains.transpose();
+  }
+
   // delay direct path to align with diffuse path
   directPathDelay_.process(internalBlockSize_, bufferA_p.ptrs(), out_p.ptrs());
 
   // apply gain ramp for diffuse path
-  std::vector<std::vector<float>> currentDiffuseGains_v =
-      convertToVec(currentDiffuseGains_);
-  std::vector<std::vector<float>> nextDiffuseGains_v =
-      convertToVec(nextDiffuseGains_);
-  dsp::LinearInterpMatrix::apply_interp(
-      in_p.ptrs(), bufferA_p.ptrs(), 0, internalBlockSize_, 0, 0,
-      internalBlockSize_, currentDiffuseGains_v, nextDiffuseGains_v);
+  if (activeInputs_.empty()) {
+    bufferA_.setZero();
+  } else {
+    gainsForInputs(currentDiffuseGains_, activeInputs_, currentActiveGains_);
+    gainsForInputs(nextDiffuseGains_, activeInputs_, nextActiveGains_);
+    dsp::LinearInterpMatrix::apply_interp(
+        activeInputPointers_.data(), bufferA_p.ptrs(), 0, internalBlockSize_,
+        0, 0, internalBlockSize_, currentActiveGains_, nextActiveGains_);
+  }
   currentDiffuseGains_ = nextDiffuseGains_;
 
+  // The decorrelators run every block, so their tails ring out
   convolver_.process(bufferA_, bufferB_);
   out += bufferB_;
 }
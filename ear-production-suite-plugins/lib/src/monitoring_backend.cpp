@@ -11,7 +11,13 @@ namespace plugin {
 MonitoringBackend::MonitoringBackend(
     ui::MonitoringFrontendBackendConnector* connector,
     const Layout& targetLayout, int inputChannelCount)
-    : gainsCalculator_(targetLayout, inputChannelCount),
+    : MonitoringBackend(connector, std::vector<Layout>{targetLayout},
+                        inputChannelCount) {}
+
+MonitoringBackend::MonitoringBackend(
+    ui::MonitoringFrontendBackendConnector* connector,
+    const std::vector<Layout>& targetLayouts, int inputChannelCount)
+    : gainsCalculator_(targetLayouts, inputChannelCount),
       frontendConnector_(connector),
       controlConnection_() {
   logger_ = createLogger(fmt::format("Monitoring@{}", (const void*)this));
@@ -22,8 +28,9 @@ MonitoringBackend::MonitoringBackend(
   logger_->set_level(spdlog::level::off);
 #endif
 
-  gains_.direct = gainsCalculator_.directGains();
-  gains_.diffuse = gainsCalculator_.diffuseGains();
+  for (std::size_t i = 0; i < gainsCalculator_.layoutCount(); ++i) {
+    gains_.push_back(gainsCalculator_.gains(i));
+  }
   controlConnection_.logger(logger_);
   controlConnection_.onConnectionEstablished(
       std::bind(&MonitoringBackend::onConnection, this, _1, _2));
@@ -52,20 +59,17 @@ void MonitoringBackend::onSceneReceived(const proto::SceneStore& store) {
   updateActiveGains(store);
 }
 
-GainHolder MonitoringBackend::currentGains() {
+GainHolder MonitoringBackend::currentGains(std::size_t layoutIndex) {
   std::lock_guard<std::mutex> lock(gainsMutex_);
-  return gains_;
+  return gains_.at(layoutIndex);
 }
 
 void MonitoringBackend::updateActiveGains(const proto::SceneStore& store) {
-  {
-    std::lock_guard<std::mutex> lock(gainsCalculatorMutex_);
-    gainsCalculator_.update(store);
-  }
-  {
-    std::lock_guard<std::mutex> lock(gainsMutex_);
-    gains_.direct = gainsCalculator_.directGains();
-    gains_.diffuse = gainsCalculator_.diffuseGains();
+  std::lock_guard<std::mutex> calculatorLock(gainsCalculatorMutex_);
+  gainsCalculator_.update(store);
+  std::lock_guard<std::mutex> lock(gainsMutex_);
+  for (std::size_t i = 0; i < gains_.size(); ++i) {
+    gains_[i] = gainsCalculator_.gains(i);
   }
 }
 
@@ -0,0 +1,78 @@
+#include "multi_layout_gains_calculator.hpp"
+#include <exception>
+#include <future>
+
+namespace ear {
+namespace plugin {
+
+MultiLayoutGainsCalculator::MultiLayoutGainsCalculator(
+    const std::vector<Layout>& outputLayouts, int inputChannelCount) {
+  for (auto const& layout : outputLayouts) {
+    calculators_.push_back(
+        std::make_unique<SceneGainsCalculator>(layout, inputChannelCount));
+    gains_.push_back(GainHolder{calculators_.back()->directGains(),
+                                calculators_.back()->diffuseGains(),
+                                calculators_.back()->hoaDecodes()});
+  }
+  for (std::size_t i = 1; i < calculators_.size(); ++i) {
+    workers_.push_back(std::make_unique<MetadataThread>());
+  }
+}
+
+// Workers are stopped before the calculators they use go
+MultiLayoutGainsCalculator::~MultiLayoutGainsCalculator() {
+  workers_.clear();
+}
+
+bool MultiLayoutGainsCalculator::update(const proto::SceneStore& store) {
+  scene_.update(store);
+
+  std::vector<std::future<void>> done;
+  done.reserve(workers_.size());
+  for (std::size_t i = 0; i < workers_.size(); ++i) {
+    auto finished = std::make_shared<std::promise<void>>();
+    done.push_back(finished->get_future());
+    workers_[i]->post([this, i, finished]() {
+      try {
+        updateLayout(i + 1);
+        finished->set_value();
+      } catch (...) {
+        finished->set_exception(std::current_exception());
+      }
+    });
+  }
+  // Every layout finishes before returning, even if one fails, as they all
+  // read the converted scene
+  std::exception_ptr error;
+  try {
+    if (!calculators_.empty()) {
+      updateLayout(0);
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto& layoutDone : done) {
+    try {
+      layoutDone.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return true;
+}
+
+void MultiLayoutGainsCalculator::updateLayout(std::size_t layoutIndex) {
+  auto& calculator = *calculators_[layoutIndex];
+  calculator.update(scene_);
+  gains_[layoutIndex].direct = calculator.directGains();
+  gains_[layoutIndex].diffuse = calculator.diffuseGains();
+  gains_[layoutIndex].hoa = calculator.hoaDecodes();
+}
+
+}  // namespace plugin
+}  // namespace ear
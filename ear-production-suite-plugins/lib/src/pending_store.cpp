@@ -8,42 +8,68 @@
 
 namespace ear {
     namespace plugin {
+        namespace {
+            uint64_t elementKey(uint32_t audioObjectIdVal, uint32_t audioTrackUidVal) {
+              return (static_cast<uint64_t>(audioObjectIdVal) << 32) | audioTrackUidVal;
+            }
+        }
+
         PendingStore::PendingStore(Metadata &metadata,
                                    std::string admStr,
                                    std::vector<PluginToAdmMap> pluginToAdmMaps) : data_(metadata) {
             populateFromAdm(admStr, pluginToAdmMaps);
-            timeoutThread = std::thread(&PendingStore::timeout, this, 3000);
+            timeoutThread = std::thread(&PendingStore::timeout, this, std::chrono::milliseconds(3000));
 
         }
 
         PendingStore::~PendingStore()
         {
-          killThread = true;
+          stopTimeout();
           timeoutThread.join(); // Wait for it to die
         }
 
-        void PendingStore::timeout(int msLimit)
+        void PendingStore::timeout(std::chrono::milliseconds limit)
+        {
+          std::unique_lock<std::mutex> lock(timeoutMutex);
+          // Sleeps until the limit has passed since the last connection, or we're told to stop
+          while(!timeoutCondition.wait_until(lock, lastConnection + limit,
+                                             [this]() { return killThread; })) {
+            if(std::chrono::steady_clock::now() >= lastConnection + limit) {
+              lock.unlock();
+              finishPendingElementsSearch();
+              return;
+            }
+          }
+        }
+
+        void PendingStore::stopTimeout()
         {
-          const int msCheckInterval = 10;
-          while(msSinceLastConnection < msLimit) {
-            if(killThread) return;
-            std::this_thread::sleep_for(std::chrono::milliseconds(msCheckInterval));
-            // Not as accurate as comparing against a start time,
-            // but this methodology used intentionally to perform same iterations even with debug/breaks
-            msSinceLastConnection += msCheckInterval;
-            if(killThread) return;
+          {
+            std::lock_guard<std::mutex> lock(timeoutMutex);
+            killThread = true;
           }
-          finishPendingElementsSearch();
+          timeoutCondition.notify_all();
         }
 
         void PendingStore::populateFromAdm(const std::string &admStr, const std::vector<PluginToAdmMap> &pluginToAdmMaps) {
             auto iss = std::istringstream{std::move(admStr)};
             auto doc = adm::parseXml(iss, adm::xml::ParserOptions::recursive_node_search);
-            pluginToAdmMaps_ = pluginToAdmMaps;
-            pendingElements_ = populateStoreFromAdm(*doc, pendingStore_);
+            pluginToAdmMaps_.clear();
+            pluginToAdmMaps_.reserve(pluginToAdmMaps.size());
+            for(auto const& pluginToAdmMap : pluginToAdmMaps) {
+              if(pluginToAdmMap.inputInstanceId != 0) {
+                pluginToAdmMaps_.emplace(pluginToAdmMap.inputInstanceId, pluginToAdmMap);
+              }
+            }
+            pendingElements_.clear();
+            for(auto const& [ids, element] : populateStoreFromAdm(*doc, pendingStore_)) {
+              auto key = elementKey(ids.first.get<adm::AudioObjectIdValue>().get(),
+                                    ids.second.get<adm::AudioTrackUidIdValue>().get());
+              pendingElements_[key].push_back(element);
+            }
             if (pendingElements_.empty()) {
               // not waiting for anything
-              killThread = true;
+              stopTimeout();
               finishPendingElementsSearch();
             }
         }
@@ -60,41 +86,48 @@ namespace ear {
 
         void PendingStore::checkAgainstPendingElements(InputItem const & item)
         {
-          if(!finished) {
+          if(finished) return;
+          std::lock_guard<std::mutex> lock(finisher);
+          if(finished) return;
+
+          // An input can have several mappings (one per channel, and one per
+          // AudioObject if programmes used it with different settings)
+          auto [first, last] = pluginToAdmMaps_.equal_range(item.data.input_instance_id());
+          bool matched = false;
+          for(auto it = first; it != last; ++it) {
+            auto elements = pendingElements_.find(
+                elementKey(it->second.audioObjectIdVal, it->second.audioTrackUidVal));
+            if(elements != pendingElements_.end()) {
+              for(auto element : elements->second) {
+                element->mutable_object()->set_connection_id(item.data.connection_id());
+              }
+              pendingElements_.erase(elements);
+              matched = true;
+            }
+          }
 
-            auto instanceId = item.data.input_instance_id();
-            auto it = std::find_if(pluginToAdmMaps_.begin(), pluginToAdmMaps_.end(),
-                         [instanceId](PluginToAdmMap& pluginToAdmMap) {
-              if(pluginToAdmMap.inputInstanceId == 0) return false;
-              return pluginToAdmMap.inputInstanceId == instanceId;
-            });
-
-            if(it != pluginToAdmMaps_.end()) {
-              auto ids = std::make_pair(
-                adm::AudioObjectId(adm::AudioObjectIdValue(it->audioObjectIdVal)),
-                adm::AudioTrackUidId(adm::AudioTrackUidIdValue(it->audioTrackUidVal))
-              );
-              auto range = pendingElements_.equal_range(ids);
-              auto matchCount = std::distance(range.first, range.second);
-              if(matchCount > 0) {
-                msSinceLastConnection = 0;
-                for(auto el = range.first; el != range.second; ++el) {
-                  el->second->mutable_object()->set_connection_id(item.data.connection_id());
-                }
-                pendingElements_.erase(range.first, range.second);
-
-                if(pendingElements_.empty()) {
-                  killThread = true;
-                  finishPendingElementsSearch();
-                }
+          if(matched) {
+            if(pendingElements_.empty()) {
+              stopTimeout();
+              finishPendingElementsSearchLocked();
+            } else {
+              {
+                std::lock_guard<std::mutex> timeoutLock(timeoutMutex);
+                lastConnection = std::chrono::steady_clock::now();
               }
+              timeoutCondition.notify_all();
             }
           }
         }
 
         void PendingStore::finishPendingElementsSearch()
         {
-          std::lock_guard lock(finisher);
+          std::lock_guard<std::mutex> lock(finisher);
+          finishPendingElementsSearchLocked();
+        }
+
+        void PendingStore::finishPendingElementsSearchLocked()
+        {
           if(!finished) {
             finished = true;
             // Don't set store if we didn't get any high-level metadata (programmes)
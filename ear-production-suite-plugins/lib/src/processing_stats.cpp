@@ -0,0 +1,240 @@
+#include "processing_stats.hpp"
+#include <readerwriterqueue.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <iomanip>
+#include <thread>
+
+namespace ear {
+namespace plugin {
+
+namespace {
+
+constexpr std::size_t TRACE_EVENTS_PER_STAGE = 4096;
+
+struct TraceEvent {
+  std::int64_t startNanoseconds;
+  std::int64_t durationNanoseconds;
+  std::uint32_t threadId;
+};
+
+using TraceQueue = moodycamel::ReaderWriterQueue<TraceEvent>;
+
+std::uint32_t currentThreadId() {
+  thread_local std::uint32_t id = static_cast<std::uint32_t>(
+      std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  return id;
+}
+
+std::size_t histogramBin(std::int64_t nanoseconds) {
+  auto microseconds = static_cast<std::uint64_t>(nanoseconds / 1000);
+  std::size_t bin = 0;
+  while (microseconds && bin < ProcessingStats::HISTOGRAM_BINS - 1) {
+    microseconds >>= 1;
+    ++bin;
+  }
+  return bin;
+}
+
+// Only one thread writes each counter, so no read-modify-write is needed
+void increment(std::atomic<std::uint64_t>& counter, std::uint64_t amount = 1) {
+  counter.store(counter.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+std::atomic<int> nextTraceProcessId{1};
+
+}  // namespace
+
+void writeJsonString(std::ostream& stream, const std::string& str) {
+  stream << '"';
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      stream << '\\';
+    }
+    stream << c;
+  }
+  stream << '"';
+}
+
+struct ProcessingStats::Stage {
+  std::string name;
+  std::atomic<std::uint64_t> count{0};
+  std::atomic<std::uint64_t> totalNanoseconds{0};
+  std::atomic<std::uint64_t> peakNanoseconds{0};
+  std::atomic<std::uint64_t> contentions{0};
+  std::atomic<std::uint64_t> channelBlocks{0};
+  std::atomic<std::uint64_t> skippedChannelBlocks{0};
+  std::array<std::atomic<std::uint64_t>, HISTOGRAM_BINS> histogram{};
+
+  // Allocated the first time tracing is enabled, then kept until destruction
+  std::unique_ptr<TraceQueue> traceQueue;
+  std::atomic<TraceQueue*> trace{nullptr};
+
+  // Only used by snapshot()
+  std::uint64_t snapshotCount{0};
+  std::uint64_t snapshotTotalNanoseconds{0};
+};
+
+double ProcessingStats::StageSnapshot::percentileMicroseconds(
+    double fraction) const {
+  std::uint64_t total = 0;
+  for (auto binCount : histogram) {
+    total += binCount;
+  }
+  if (total == 0) {
+    return 0.0;
+  }
+  auto target = static_cast<std::uint64_t>(std::ceil(fraction * total));
+  std::uint64_t cumulative = 0;
+  for (std::size_t bin = 0; bin < HISTOGRAM_BINS; ++bin) {
+    cumulative += histogram[bin];
+    if (cumulative >= target) {
+      return std::ldexp(1.0, static_cast<int>(bin));
+    }
+  }
+  return std::ldexp(1.0, HISTOGRAM_BINS - 1);
+}
+
+ProcessingStats::ProcessingStats(std::string pluginName)
+    : pluginName_{std::move(pluginName)},
+      traceProcessId_{nextTraceProcessId++} {
+  stages_.reserve(MAX_STAGES);
+}
+
+ProcessingStats::~ProcessingStats() = default;
+
+ProcessingStats::StageId ProcessingStats::addStage(std::string name) {
+  if (stages_.size() == MAX_STAGES) {
+    throw std::runtime_error("too many processing stats stages");
+  }
+  stages_.push_back(std::make_unique<Stage>());
+  stages_.back()->name = std::move(name);
+  return stages_.size() - 1;
+}
+
+void ProcessingStats::record(StageId stage, Clock::time_point start,
+                             Clock::time_point end) noexcept {
+  if (stage >= stages_.size()) {
+    return;
+  }
+  auto& s = *stages_[stage];
+  auto nanoseconds = std::max<std::int64_t>(
+      0, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+             .count());
+
+  increment(s.count);
+  increment(s.totalNanoseconds, nanoseconds);
+  increment(s.histogram[histogramBin(nanoseconds)]);
+  if (static_cast<std::uint64_t>(nanoseconds) >
+      s.peakNanoseconds.load(std::memory_order_relaxed)) {
+    s.peakNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+  }
+
+  if (traceEnabled_.load(std::memory_order_acquire)) {
+    if (auto queue = s.trace.load(std::memory_order_acquire)) {
+      // Never allocates - events are dropped if nobody writes the trace out
+      queue->try_enqueue(TraceEvent{
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              start.time_since_epoch())
+              .count(),
+          nanoseconds, currentThreadId()});
+    }
+  }
+}
+
+void ProcessingStats::recordContention(StageId stage) noexcept {
+  if (stage < stages_.size()) {
+    increment(stages_[stage]->contentions);
+  }
+}
+
+void ProcessingStats::recordSkips(StageId stage, std::uint64_t channelBlocks,
+                                  std::uint64_t skippedChannelBlocks) noexcept {
+  if (stage < stages_.size()) {
+    increment(stages_[stage]->channelBlocks, channelBlocks);
+    increment(stages_[stage]->skippedChannelBlocks, skippedChannelBlocks);
+  }
+}
+
+std::vector<ProcessingStats::StageSnapshot> ProcessingStats::snapshot() {
+  std::vector<StageSnapshot> snapshots;
+  snapshots.reserve(stages_.size());
+  for (auto& stage : stages_) {
+    StageSnapshot snapshot;
+    snapshot.name = stage->name;
+    snapshot.count = stage->count.load(std::memory_order_relaxed);
+    snapshot.contentions = stage->contentions.load(std::memory_order_relaxed);
+    snapshot.channelBlocks =
+        stage->channelBlocks.load(std::memory_order_relaxed);
+    snapshot.skippedChannelBlocks =
+        stage->skippedChannelBlocks.load(std::memory_order_relaxed);
+    auto totalNanoseconds =
+        stage->totalNanoseconds.load(std::memory_order_relaxed);
+    if (snapshot.count > stage->snapshotCount) {
+      snapshot.meanMicroseconds =
+          (totalNanoseconds - stage->snapshotTotalNanoseconds) / 1000.0 /
+          (snapshot.count - stage->snapshotCount);
+    }
+    stage->snapshotCount = snapshot.count;
+    stage->snapshotTotalNanoseconds = totalNanoseconds;
+    // A peak recorded during the exchange can be lost - good enough for display
+    snapshot.peakMicroseconds = stage->peakNanoseconds.exchange(0) / 1000.0;
+    for (std::size_t bin = 0; bin < HISTOGRAM_BINS; ++bin) {
+      snapshot.histogram[bin] =
+          stage->histogram[bin].load(std::memory_order_relaxed);
+    }
+    snapshots.push_back(std::move(snapshot));
+  }
+  return snapshots;
+}
+
+void ProcessingStats::setTraceEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(traceSetupMutex_);
+  if (enabled) {
+    for (auto& stage : stages_) {
+      if (!stage->traceQueue) {
+        stage->traceQueue = std::make_unique<TraceQueue>(TRACE_EVENTS_PER_STAGE);
+        stage->trace.store(stage->traceQueue.get(), std::memory_order_release);
+      }
+    }
+  }
+  traceEnabled_.store(enabled, std::memory_order_release);
+}
+
+bool ProcessingStats::traceEnabled() const {
+  return traceEnabled_.load(std::memory_order_acquire);
+}
+
+void ProcessingStats::writeChromeTrace(std::ostream& stream) {
+  std::lock_guard<std::mutex> lock(traceSetupMutex_);
+  stream << "{\"traceEvents\":[\n";
+  stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":"
+         << traceProcessId_ << ",\"args\":{\"name\":";
+  writeJsonString(stream, pluginName_);
+  stream << "}}";
+
+  auto flags = stream.flags();
+  stream << std::fixed << std::setprecision(3);
+  for (auto& stage : stages_) {
+    if (!stage->traceQueue) {
+      continue;
+    }
+    TraceEvent event;
+    while (stage->traceQueue->try_dequeue(event)) {
+      stream << ",\n{\"name\":";
+      writeJsonString(stream, stage->name);
+      stream << ",\"cat\":\"dsp\",\"ph\":\"X\",\"pid\":" << traceProcessId_
+             << ",\"tid\":" << event.threadId
+             << ",\"ts\":" << event.startNanoseconds / 1000.0
+             << ",\"dur\":" << event.durationNanoseconds / 1000.0 << "}";
+    }
+  }
+  stream.flags(flags);
+  stream << "\n]}\n";
+}
+
+}  // namespace plugin
+}  // namespace ear
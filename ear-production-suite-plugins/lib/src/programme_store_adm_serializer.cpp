@@ -7,6 +7,8 @@
 #include <adm/utilities/id_assignment.hpp>
 #include <helper/adm_preset_definitions_helper.h>
 #include <utility>
+#include <algorithm>
+#include <set>
 #include <iomanip>
 #include <optional>
 #include <iostream>
@@ -16,94 +18,6 @@ using namespace ear::plugin;
 
 namespace {
 
-constexpr auto const ADM_DEFAULT_AZ = 0.0f;
-constexpr auto const ADM_DEFAULT_EL = 0.0f;
-// constexpr auto const ADM_DEFAULT_D = 0.f;
-constexpr auto const ADM_DEFAULT_GAIN = 1.0f;
-
-template <typename Param>
-using ParameterValueT =
-    std::remove_reference_t<decltype(std::declval<Param>().get())>;
-
-template <typename Param, typename El>
-ParameterValueT<Param> getValueOr(El const& element,
-                                  ParameterValueT<Param> defaultValue) {
-  if (element.template has<Param>()) return element.template get<Param>().get();
-  return defaultValue;
-}
-
-bool approxEqual(float x, float y) { return fabs(x - y) < 0.001; }
-float minAzimuth(ear::plugin::proto::PositionInteractive const& position) {
-  return position.min_az();
-}
-float minAzimuth(adm::PositionInteractionRange const& position) {
-  return getValueOr<adm::AzimuthInteractionMin>(position, ADM_DEFAULT_AZ);
-}
-float maxAzimuth(ear::plugin::proto::PositionInteractive const& position) {
-  return position.min_az();
-}
-float maxAzimuth(adm::PositionInteractionRange const& position) {
-  return getValueOr<adm::AzimuthInteractionMax>(position, ADM_DEFAULT_AZ);
-}
-float minElevation(proto::PositionInteractive const& position) {
-  return position.min_el();
-}
-float minElevation(adm::PositionInteractionRange const& position) {
-  return getValueOr<adm::ElevationInteractionMin>(position, ADM_DEFAULT_EL);
-}
-float maxElevation(proto::PositionInteractive const& position) {
-  return position.max_el();
-}
-float maxElevation(adm::PositionInteractionRange const& position) {
-  return getValueOr<adm::ElevationInteractionMax>(position, ADM_DEFAULT_EL);
-}
-// float minDistance(proto::PositionInteractive const& position) {
-//  return position.min_r();
-//}
-// float minDistance(adm::PositionInteractionRange const& position) {
-//  return getValueOr<adm::DistanceInteractionMin>(position, ADM_DEFAULT_D);
-//}
-// float maxDistance(proto::PositionInteractive const& position) {
-//  return position.max_r();
-//}
-// float maxDistance(adm::PositionInteractionRange const& position) {
-//  return getValueOr<adm::DistanceInteractionMax>(position, ADM_DEFAULT_D);
-//}
-bool operator==(adm::PositionInteractionRange const& lhs,
-                proto::PositionInteractive const& rhs) {
-  return approxEqual(maxElevation(lhs), maxElevation(rhs)) &&
-         approxEqual(minElevation(lhs), minElevation(rhs)) &&
-         //         approxEqual(maxDistance(lhs), maxDistance(rhs)) &&
-         //         approxEqual(minDistance(lhs), minDistance(rhs)) &&
-         approxEqual(maxAzimuth(lhs), maxAzimuth(rhs)) &&
-         approxEqual(minAzimuth(lhs), minAzimuth(rhs));
-}
-bool operator==(proto::PositionInteractive const& lhs,
-                adm::PositionInteractionRange const& rhs) {
-  return rhs == lhs;
-}
-float minGain(proto::GainInteractive const& gain) { return gain.min(); }
-float minGain(adm::GainInteractionRange const& gain) {
-  return static_cast<float>(
-      getValueOr<adm::GainInteractionMin>(gain,
-                                          adm::Gain::fromLinear(ADM_DEFAULT_GAIN)).asLinear());
-}
-float maxGain(proto::GainInteractive const& gain) { return gain.max(); }
-float maxGain(adm::GainInteractionRange const& gain) {
-  return static_cast<float>(
-      getValueOr<adm::GainInteractionMax>(gain,
-                                          adm::Gain::fromLinear(ADM_DEFAULT_GAIN)).asLinear());
-}
-bool operator==(adm::GainInteractionRange const& lhs,
-                proto::GainInteractive const& rhs) {
-  return approxEqual(minGain(lhs), minGain(rhs)) &&
-         approxEqual(maxGain(lhs), maxGain(rhs));
-}
-bool operator==(proto::GainInteractive const& lhs,
-                adm::GainInteractionRange const& rhs) {
-  return rhs == lhs;
-}
-
 struct InteractionStatus {
   bool onOffEnabled{false};
   bool gainEnabled{false};
@@ -122,44 +36,6 @@ InteractionStatus getInteractionStatus(proto::Object const& object) {
               : false};
 }
 
-bool interactionEqual(proto::Object const& object,
-                      adm::AudioObject const& admObject) {
-  auto interactions = getInteractionStatus(object);
-  auto equal =
-      (interactions.enabled() == getValueOr<adm::Interact>(admObject, false));
-  auto admInteractionEnabled = admObject.has<adm::AudioObjectInteraction>();
-  if (interactions.enabled()) {
-    if (!admObject.has<adm::AudioObjectInteraction>()) {
-      return false;
-    }
-    auto const& admInteraction = admObject.get<adm::AudioObjectInteraction>();
-    equal = equal &&
-            (interactions.onOffEnabled ==
-             getValueOr<adm::OnOffInteract>(admInteraction, false)) &&
-            (interactions.gainEnabled ==
-             getValueOr<adm::GainInteract>(admInteraction, false)) &&
-            (interactions.positionEnabled ==
-             getValueOr<adm::PositionInteract>(admInteraction, false));
-    if (equal) {
-      if (interactions.gainEnabled) {
-        auto gainRange = admInteraction.has<adm::GainInteractionRange>()
-                             ? admInteraction.get<adm::GainInteractionRange>()
-                             : adm::GainInteractionRange{};
-        equal = (gainRange == object.interactive_gain());
-      }
-      if (interactions.positionEnabled) {
-        auto positionRange =
-            admInteraction.has<adm::PositionInteractionRange>()
-                ? admInteraction.get<adm::PositionInteractionRange>()
-                : adm::PositionInteractionRange{};
-        equal = equal && positionRange == object.interactive_position();
-      }
-    }
-    return equal;
-  }
-  return !admInteractionEnabled;
-}
-
 std::optional<int> determineImportanceValue(const proto::Object & object) {
   if(object.has_importance()) {
     return std::optional<int>(object.importance());
@@ -170,18 +46,59 @@ std::optional<int> determineImportanceValue(const proto::Object & object) {
   return std::optional<int>();
 }
 
-bool importanceEqual(proto::Object const& object,
-                     adm::AudioObject const& admObject) {
+// The object level settings which need a separate AudioObject for an item
+std::string objectSettingsKey(proto::Object const& object) {
+  std::ostringstream key;
+  key << std::setprecision(9);
+  auto interactions = getInteractionStatus(object);
+  key << interactions.onOffEnabled << interactions.gainEnabled
+      << interactions.positionEnabled;
+  if (interactions.gainEnabled) {
+    auto const& gain = object.interactive_gain();
+    key << "/g" << gain.min() << ',' << gain.max();
+  }
+  if (interactions.positionEnabled) {
+    auto const& position = object.interactive_position();
+    key << "/p" << position.min_az() << ',' << position.max_az() << ','
+        << position.min_el() << ',' << position.max_el();
+  }
   auto importance = determineImportanceValue(object);
-  if(importance.has_value() == admObject.has<adm::Importance>()) {
-    if(importance.has_value()) {
-      auto admObjectImportance = admObject.get<adm::Importance>().get();
-      return importance.value() == admObjectImportance;
-    } else {
-      return true;
+  if (importance.has_value()) {
+    key << "/i" << importance.value();
+  }
+  return key.str();
+}
+
+// The item metadata the ADM tracks are built from, or empty if the item
+// has no type yet (and so is not serialized)
+std::string itemKey(proto::InputItemMetadata const& metadata) {
+  std::string type;
+  if (metadata.has_obj_metadata()) {
+    type = "obj";
+  } else if (metadata.has_ds_metadata()) {
+    type = "ds" + std::to_string(metadata.ds_metadata().packformatidvalue());
+  } else if (metadata.has_hoa_metadata()) {
+    type = "hoa" + std::to_string(metadata.hoa_metadata().packformatidvalue());
+  } else {
+    return {};
+  }
+  return type + '/' + metadata.name();
+}
+
+template <typename Fn>
+void forEachObject(proto::Programme const& programme, Fn fn) {
+  for (auto const& element : programme.element()) {
+    if (element.has_object()) {
+      fn(element.object());
+    }
+    if (element.has_toggle()) {
+      for (auto const& toggleElement : element.toggle().element()) {
+        if (toggleElement.has_object()) {
+          fn(toggleElement.object());
+        }
+      }
     }
   }
-  return false;
 }
 
 bool hasValidDefaultIndex(const proto::Toggle& toggle) {
@@ -215,35 +132,173 @@ adm::SimpleObjectHolder add2076v2SimpleObjectTo(std::shared_ptr<adm::Document> d
 
 }  // namespace
 
-bool ProgrammeStoreAdmSerializer::isAlreadySerialized(
-    const proto::Object& object) const {
-  auto const& connectionId = object.connection_id();
-  auto objectIt = serializedObjects.find(connectionId);
-  if (objectIt != serializedObjects.end()) {
-    auto const& admObject = *(objectIt->second);
-    return importanceEqual(object, admObject) && interactionEqual(object, admObject);
-  }
-  return false;
-}
-
 std::pair<std::shared_ptr<adm::Document>, std::vector<ProgrammeStoreAdmSerializer::PluginMap>>
 ProgrammeStoreAdmSerializer::serialize(std::pair<proto::ProgrammeStore, ItemMap> stores) {
   programmes_ = std::move(stores.first);
   items_ = std::move(stores.second);
+  if (!doc) {
+    reset();
+  }
+  bool changed = removeStaleItems();
+
+  // Keep the programmes up to the first one which changed, then rebuild the
+  // rest so that they stay in order in the document
+  std::size_t unchanged = 0;
+  while (unchanged < serializedProgrammes_.size() &&
+         unchanged < static_cast<std::size_t>(programmes_.programme_size()) &&
+         serializedProgrammes_[unchanged].key ==
+             programmeKey(programmes_.programme(unchanged))) {
+    ++unchanged;
+  }
+  if (unchanged != serializedProgrammes_.size() ||
+      unchanged != static_cast<std::size_t>(programmes_.programme_size())) {
+    changed = true;
+    while (serializedProgrammes_.size() > unchanged) {
+      removeProgramme(serializedProgrammes_.back());
+      serializedProgrammes_.pop_back();
+    }
+    for (auto i = unchanged;
+         i < static_cast<std::size_t>(programmes_.programme_size()); ++i) {
+      serializedProgrammes_.push_back(
+          serializeProgramme(programmes_.programme(i)));
+    }
+    // A rebuilt programme may have removed a link a kept one also made
+    for (auto const& programme : serializedProgrammes_) {
+      for (auto const& [defaultObject, object] : programme.complementaries) {
+        defaultObject->addComplementary(object);
+      }
+    }
+  }
+  changed = removeUnusedObjects() || changed;
+
+  if (changed) {
+    adm::reassignIds(doc); // ADM elms in pluginMap are shared_ptr so will also have the updated ID's
+  }
+  updatePluginMap();
+  return {doc, pluginMap};
+}
+
+void ProgrammeStoreAdmSerializer::reset() {
   doc = adm::Document::create();
   doc->set(adm::Version("ITU-R_BS.2076-2"));
   addCommonDefinitionsTo(doc);
+  serializedItems_.clear();
+  serializedProgrammes_.clear();
+}
+
+std::string ProgrammeStoreAdmSerializer::programmeKey(
+    proto::Programme const& programme) const {
+  auto key = programme.SerializeAsString();
+  forEachObject(programme, [this, &key](proto::Object const& object) {
+    key += '\0';
+    auto metadataIt = items_.find(object.connection_id());
+    if (metadataIt != items_.end()) {
+      key += itemKey(metadataIt->second);
+    }
+  });
+  return key;
+}
+
+bool ProgrammeStoreAdmSerializer::removeStaleItems() {
+  std::set<communication::ConnectionId> referenced;
+  for (auto const& programme : programmes_.programme()) {
+    forEachObject(programme, [&referenced](proto::Object const& object) {
+      referenced.insert(object.connection_id());
+    });
+  }
+
+  bool removed = false;
+  for (auto it = serializedItems_.begin(); it != serializedItems_.end();) {
+    auto metadataIt = items_.find(it->first);
+    if (metadataIt != items_.end() &&
+        itemKey(metadataIt->second) == it->second.key &&
+        referenced.count(it->first)) {
+      ++it;
+      continue;
+    }
+    if (it->second.usesPresetDefinition) {
+      // Preset pack formats can be shared between items (and common
+      // definitions must stay), so start again rather than untangle them
+      reset();
+      return true;
+    }
+    removeItem(it->second);
+    it = serializedItems_.erase(it);
+    removed = true;
+  }
+  return removed;
+}
+
+void ProgrammeStoreAdmSerializer::removeItem(SerializedItem const& item) {
+  for (auto const& [settings, admObject] : item.objects) {
+    doc->remove(admObject);
+  }
+  for (auto const& uid : item.trackUids) {
+    doc->remove(uid);
+  }
+  if (!item.usesPresetDefinition) {
+    doc->remove(item.packFormat);
+    for (auto const& channelFormat : item.channelFormats) {
+      doc->remove(channelFormat);
+    }
+  }
+}
+
+void ProgrammeStoreAdmSerializer::removeProgramme(
+    SerializedProgramme const& programme) {
+  for (auto const& [defaultObject, object] : programme.complementaries) {
+    defaultObject->removeComplementary(object);
+  }
+  for (auto const& content : programme.contents) {
+    doc->remove(content);
+  }
+  doc->remove(programme.programme);
+}
+
+bool ProgrammeStoreAdmSerializer::removeUnusedObjects() {
+  std::set<std::shared_ptr<adm::AudioObject>> used;
+  for (auto const& programme : serializedProgrammes_) {
+    for (auto const& [connectionId, admObject] : programme.objects) {
+      used.insert(admObject);
+    }
+  }
+
+  bool removed = false;
+  for (auto& [connectionId, item] : serializedItems_) {
+    for (auto it = item.objects.begin(); it != item.objects.end();) {
+      if (used.count(it->second)) {
+        ++it;
+      } else {
+        doc->remove(it->second);
+        it = item.objects.erase(it);
+        removed = true;
+      }
+    }
+  }
+  return removed;
+}
+
+void ProgrammeStoreAdmSerializer::updatePluginMap() {
   pluginMap.clear();
-  for (auto& programme : programmes_.programme()) {
-    serializeProgramme(*doc, programme);
+  std::set<std::shared_ptr<adm::AudioObject>> mapped;
+  for (auto const& programme : serializedProgrammes_) {
+    for (auto const& [connectionId, admObject] : programme.objects) {
+      if (!mapped.insert(admObject).second) {
+        continue;
+      }
+      auto const& metadata = items_.find(connectionId)->second;
+      auto const& trackUids = serializedItems_.at(connectionId).trackUids;
+      for (std::size_t i = 0; i < trackUids.size(); ++i) {
+        pluginMap.push_back({metadata.input_instance_id(),
+                             metadata.routing() + static_cast<int32_t>(i),
+                             admObject, trackUids[i]});
+      }
+    }
   }
-  adm::reassignIds(doc); // ADM elms in pluginMap are shared_ptr so will also have the updated ID's
-  return {doc, pluginMap};
 }
 
 void ProgrammeStoreAdmSerializer::serializeToggle(
-    std::shared_ptr<adm::AudioProgramme> programme,
-    const proto::Toggle& toggle) {
+    SerializedProgramme& programme, const proto::Toggle& toggle) {
   std::shared_ptr<adm::AudioObject> defaultObject =
       getToggleDefaultAudioObject(programme, toggle);
   if (defaultObject) {
@@ -253,6 +308,7 @@ void ProgrammeStoreAdmSerializer::serializeToggle(
         auto admObject = serializeToggleElement(programme, toggle, i);
         if (admObject) {
           defaultObject->addComplementary(admObject);
+          programme.complementaries.emplace_back(defaultObject, admObject);
         }
       }
     }
@@ -261,8 +317,7 @@ void ProgrammeStoreAdmSerializer::serializeToggle(
 
 std::shared_ptr<adm::AudioObject>
 ProgrammeStoreAdmSerializer::getToggleDefaultAudioObject(
-    const std::shared_ptr<adm::AudioProgramme>& programme,
-    const proto::Toggle& toggle) {
+    SerializedProgramme& programme, const proto::Toggle& toggle) {
   if (hasValidDefaultIndex(toggle)) {
     return serializeToggleElement(programme, toggle,
                                   toggle.default_element_index());
@@ -272,26 +327,31 @@ ProgrammeStoreAdmSerializer::getToggleDefaultAudioObject(
 
 std::shared_ptr<adm::AudioObject>
 ProgrammeStoreAdmSerializer::serializeToggleElement(
-    std::shared_ptr<adm::AudioProgramme> programme, const proto::Toggle& toggle,
+    SerializedProgramme& programme, const proto::Toggle& toggle,
     int elementIndex) {
   auto const& element = toggle.element(elementIndex);
   if (element.has_object()) {
     auto const& object = element.object();
     if (object.has_connection_id()) {
       auto content = adm::AudioContent::create(adm::AudioContentName{""});
-      programme->addReference(content);
-      serializeElement(*content, object);
-      auto admObject = serializedObjects[object.connection_id()];
-      content->set(
-          adm::AudioContentName{admObject->get<adm::AudioObjectName>().get()});
+      programme.programme->addReference(content);
+      programme.contents.push_back(content);
+      auto admObject = serializeElement(programme, *content, object);
+      if (admObject) {
+        content->set(adm::AudioContentName{
+            admObject->get<adm::AudioObjectName>().get()});
+      }
       return admObject;
     }
   }
   return nullptr;
 }
 
-void ProgrammeStoreAdmSerializer::serializeProgramme(
-    adm::Document& doc, const proto::Programme& programme) {
+ProgrammeStoreAdmSerializer::SerializedProgramme
+ProgrammeStoreAdmSerializer::serializeProgramme(
+    const proto::Programme& programme) {
+  SerializedProgramme serialized;
+  serialized.key = programmeKey(programme);
   auto prog = adm::AudioProgramme::create(
       adm::AudioProgrammeName{programme.name()});
   if(programme.has_language() && !programme.language().empty()) {
@@ -299,111 +359,123 @@ void ProgrammeStoreAdmSerializer::serializeProgramme(
   }
   auto defaultContent =
       adm::AudioContent::create(adm::AudioContentName{programme.name()});
-  doc.add(prog);
+  doc->add(prog);
   prog->addReference(defaultContent);
+  serialized.programme = prog;
+  serialized.contents.push_back(defaultContent);
   for (auto const& element : programme.element()) {
     if (element.has_toggle()) {
-      serializeToggle(prog, element.toggle());
+      serializeToggle(serialized, element.toggle());
     }
     if (element.has_group()) {
       // TODO group handling
     }
     if (element.has_object()) {
-      serializeElement(*defaultContent, element.object());
+      serializeElement(serialized, *defaultContent, element.object());
     }
   }
+  return serialized;
 }
 
-void ProgrammeStoreAdmSerializer::serializeElement(
-    adm::AudioContent& content, const proto::Object& object) {
+std::shared_ptr<adm::AudioObject> ProgrammeStoreAdmSerializer::serializeElement(
+    SerializedProgramme& programme, adm::AudioContent& content,
+    const proto::Object& object) {
   auto metaDataIt = items_.find(object.connection_id());
-  if (metaDataIt != items_.end()) {
-    if (metaDataIt->second.has_obj_metadata() ||
-        metaDataIt->second.has_ds_metadata() ||
-        metaDataIt->second.has_hoa_metadata()) {
-      createTopLevelObject(content, metaDataIt->second, object);
-    }
+  if (metaDataIt == items_.end() || itemKey(metaDataIt->second).empty()) {
+    return nullptr;
+  }
+  auto admObject = getAudioObject(metaDataIt->first, metaDataIt->second, object);
+  content.addReference(admObject);
+  auto& objects = programme.objects;
+  auto const entry = std::make_pair(metaDataIt->first, admObject);
+  if (std::find(objects.begin(), objects.end(), entry) == objects.end()) {
+    objects.push_back(entry);
   }
+  return admObject;
 }
 
-void ProgrammeStoreAdmSerializer::createTopLevelObject(
-    adm::AudioContent& content, const proto::InputItemMetadata& metadata,
-    const proto::Object& object) {
+std::shared_ptr<adm::AudioObject> ProgrammeStoreAdmSerializer::getAudioObject(
+    const communication::ConnectionId& connectionId,
+    const proto::InputItemMetadata& metadata, const proto::Object& object) {
+  auto settings = objectSettingsKey(object);
+
+  auto itemIt = serializedItems_.find(connectionId);
+  if (itemIt == serializedItems_.end()) {
+    // First time we've seen the input
+    auto item = serializeItem(metadata, object);
+    auto admObject = item.objects.begin()->second;
+    serializedItems_.emplace(connectionId, std::move(item));
+    return admObject;
+  }
+  auto& item = itemIt->second;
+  auto objectIt = item.objects.find(settings);
+  if (objectIt != item.objects.end()) {
+    // Already have serialized this input with the same object level settings
+    // (in a different programme, or in a previous call)
+    return objectIt->second;
+  }
+
+  auto admObject =
+      adm::AudioObject::create(adm::AudioObjectName(metadata.name()));
+  admObject->addReference(item.packFormat);
+  for (auto const& uid : item.trackUids) {
+    admObject->addReference(uid);
+  }
+  setInteractivity(*admObject, object);
+  setImportance(*admObject, object);
+  doc->add(admObject);
+  item.objects.emplace(settings, admObject);
+  return admObject;
+}
+
+ProgrammeStoreAdmSerializer::SerializedItem
+ProgrammeStoreAdmSerializer::serializeItem(
+    const proto::InputItemMetadata& metadata, const proto::Object& object) {
   assert(metadata.has_obj_metadata() || metadata.has_ds_metadata() ||
          metadata.has_hoa_metadata());
-  const auto& connectionId = metadata.connection_id();
-
-  if (isAlreadySerialized(object)) {
-    // Already have serialized this object (in a different programme?)
-    content.addReference(serializedObjects[connectionId]);
-  } else if (isSerializedWithDifferentObjectSettings(object)) {
-    // Have serialized this input but have different object level settings
-    auto otherAdmObject =
-        serializedObjects.find(object.connection_id())->second;
-    auto admObject =
-        adm::AudioObject::create(adm::AudioObjectName(metadata.name()));
-    content.addReference(admObject);
-    for (auto& atuid : otherAdmObject->getReferences<adm::AudioTrackUid>()) {
-      admObject->addReference(atuid);
-    }
-    for (auto& pack : otherAdmObject->getReferences<adm::AudioPackFormat>()) {
-      admObject->addReference(pack);
-    }
-    setInteractivity(*admObject, object);
-    setImportance(*admObject, object);
-
-    // Create plugin map entries for new AudioObject (copy other params from existing)
-    int existingPluginMapEntryCount = pluginMap.size();
-    for(int i = 0; i < existingPluginMapEntryCount; ++i) {
-      if(pluginMap[i].audioObject == otherAdmObject) {
-        pluginMap.push_back({ pluginMap[i].inputInstanceId, pluginMap[i].routing, admObject, pluginMap[i].audioTrackUid });
-      }
-    }
+  SerializedItem item;
+  item.key = itemKey(metadata);
+  std::shared_ptr<adm::AudioObject> holderObject;
+
+  if (metadata.has_obj_metadata()) {
+    assert(metadata.routing() <= std::numeric_limits<int16_t>::max());
+    auto objectHolder = add2076v2SimpleObjectTo(doc, metadata.name());
+    holderObject = objectHolder.audioObject;
+    item.packFormat = objectHolder.audioPackFormat;
+    item.channelFormats.push_back(objectHolder.audioChannelFormat);
+    item.trackUids.push_back(objectHolder.audioTrackUid);
 
   } else {
-    // First time we've seen the input
-    if (metadata.has_obj_metadata()) {
-      auto objectHolder = add2076v2SimpleObjectTo(doc, metadata.name());
-      setInteractivity(*objectHolder.audioObject, object);
-      setImportance(*objectHolder.audioObject, object);
-      content.addReference(objectHolder.audioObject);
-      assert(metadata.routing() <= std::numeric_limits<int16_t>::max());
-      serializedObjects[connectionId] = objectHolder.audioObject;
-      pluginMap.push_back({ metadata.input_instance_id(), metadata.routing(), objectHolder.audioObject, objectHolder.audioTrackUid });
-
-    } 
-    else if (metadata.has_hoa_metadata() || metadata.has_ds_metadata()) {
-
-      adm::AudioPackFormatId audioPackFormatID;
-      if (metadata.has_ds_metadata()) {
-        // DS
-        audioPackFormatID = adm::AudioPackFormatId(
-            adm::TypeDefinition::DIRECT_SPEAKERS,
-            adm::AudioPackFormatIdValue(
-                metadata.ds_metadata().packformatidvalue()));
-      } else {
-        // HOA
-        audioPackFormatID = adm::AudioPackFormatId(
-            adm::TypeDefinition::HOA,
-            adm::AudioPackFormatIdValue(
-                metadata.hoa_metadata().packformatidvalue()));
-      }
-
-      auto objectHolder = AdmPresetDefinitionsHelper::getSingleton()
-                               .addPresetDefinitionObjectTo(
-            doc, metadata.name(), audioPackFormatID);
-      setInteractivity(*objectHolder.audioObject, object);
-      setImportance(*objectHolder.audioObject, object);
-      content.addReference(objectHolder.audioObject);
-      for (int i(0); i < objectHolder.channels.size(); ++i) {
-        pluginMap.push_back({metadata.input_instance_id(),
-                             metadata.routing() + i, objectHolder.audioObject,
-                             objectHolder.channels[i].audioTrackUid});
-      }
-      serializedObjects[connectionId] = objectHolder.audioObject;
+    adm::AudioPackFormatId audioPackFormatID;
+    if (metadata.has_ds_metadata()) {
+      // DS
+      audioPackFormatID = adm::AudioPackFormatId(
+          adm::TypeDefinition::DIRECT_SPEAKERS,
+          adm::AudioPackFormatIdValue(
+              metadata.ds_metadata().packformatidvalue()));
+    } else {
+      // HOA
+      audioPackFormatID = adm::AudioPackFormatId(
+          adm::TypeDefinition::HOA,
+          adm::AudioPackFormatIdValue(
+              metadata.hoa_metadata().packformatidvalue()));
+    }
 
-    } 
+    auto objectHolder = AdmPresetDefinitionsHelper::getSingleton()
+                             .addPresetDefinitionObjectTo(
+          doc, metadata.name(), audioPackFormatID);
+    holderObject = objectHolder.audioObject;
+    item.usesPresetDefinition = true;
+    item.packFormat = objectHolder.audioPackFormat;
+    for (auto const& channel : objectHolder.channels) {
+      item.trackUids.push_back(channel.audioTrackUid);
+    }
   }
+
+  setInteractivity(*holderObject, object);
+  setImportance(*holderObject, object);
+  item.objects.emplace(objectSettingsKey(object), holderObject);
+  return item;
 }
 
 void ProgrammeStoreAdmSerializer::setInteractivity(
@@ -446,10 +518,3 @@ void ear::plugin::ProgrammeStoreAdmSerializer::setImportance(adm::AudioObject &
     admObject.unset<adm::Importance>();
   }
 }
-
-bool ProgrammeStoreAdmSerializer::isSerializedWithDifferentObjectSettings(
-    const proto::Object& object) {
-  auto const& connectionId = object.connection_id();
-  auto objectIt = serializedObjects.find(connectionId);
-  return objectIt != serializedObjects.end();
-}
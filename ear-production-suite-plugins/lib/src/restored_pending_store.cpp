@@ -12,14 +12,25 @@ namespace ear::plugin {
                                      const std::pair<proto::ProgrammeStore, ItemMap> &currentStores) {
         store_ = std::move(restored);
         auto const& currentItems = currentStores.second;
+        auto checkObject = [&](proto::Object const& object) {
+            auto id = object.connection_id();
+            assert(communication::ConnectionId{id}.isValid());
+            auto found = currentItems.find(id) != currentItems.end();
+            if(!found) {
+                missingInputs.insert(id);
+            }
+        };
         for(auto const& programme : store_.programme()) {
             for(auto const& item : programme.element()) {
                 if(item.has_object()) {
-                    auto id = item.object().connection_id();
-                    assert(communication::ConnectionId{id}.isValid());
-                    auto found = currentItems.find(id) != currentItems.end();
-                    if(!found) {
-                        missingInputs.insert(id);
+                    checkObject(item.object());
+                }
+                if(item.has_toggle()) {
+                    // wait for the inputs in toggles as well
+                    for(auto const& toggleItem : item.toggle().element()) {
+                        if(toggleItem.has_object()) {
+                            checkObject(toggleItem.object());
+                        }
                     }
                 }
             }
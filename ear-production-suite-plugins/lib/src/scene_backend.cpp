@@ -44,9 +44,26 @@ void SceneBackend::triggerMetadataSend(const proto::SceneStore &store) {
 }
 
 void SceneBackend::triggerMetadataSend() {
+    pollMetadataSlots();
     sceneStore_->triggerSend();
 }
 
+void SceneBackend::pollMetadataSlots() {
+  std::lock_guard<std::mutex> lock(metadataSlotsMutex_);
+  if (!metadataSlots_) {
+    return;
+  }
+  try {
+    metadataSlots_->poll([this](communication::ConnectionId id,
+                                const proto::InputItemMetadata& item) {
+      data_.setInputItemMetadata(id, item);
+    });
+  } catch (const std::runtime_error& e) {
+    EAR_LOGGER_ERROR(logger_, "Failed to dispatch slot metadata: {}",
+                     e.what());
+  }
+}
+
 void SceneBackend::setup() {
   try {
     connectionManager_.setEventHandler(
@@ -86,6 +103,16 @@ void SceneBackend::setup() {
     metadataReceiver_.run(
         detail::SCENE_MASTER_METADATA_ENDPOINT,
         [this](communication::ConnectionId id, proto::InputItemMetadata item) {
+          if (item.heartbeat()) {
+            // Only a version stamp; a stale one is corrected by the input's
+            // next full refresh
+            if (!data_.hasInputItemVersion(id, item.continuity_counter())) {
+              EAR_LOGGER_DEBUG(this->logger_,
+                               "Stale metadata for connection {}",
+                               id.string());
+            }
+            return;
+          }
           EAR_LOGGER_DEBUG(this->logger_,
                            "Received metadata from connection {}", id.string());
             data_.setInputItemMetadata(id, item);
@@ -97,6 +124,20 @@ void SceneBackend::setup() {
     data_.setDuplicateScene(true);
   }
 
+  try {
+    // Inputs fall back to the metadata socket if this isn't available
+    std::lock_guard<std::mutex> lock(metadataSlotsMutex_);
+    if (!metadataSlots_) {
+      metadataSlots_ = std::make_unique<communication::MetadataSlotTable>(
+          detail::SCENE_MASTER_METADATA_SLOTS,
+          communication::MetadataSlotTable::Mode::CREATE);
+    }
+  } catch (const std::runtime_error& e) {
+    EAR_LOGGER_WARN(logger_,
+                    "Scene Master: Failed to create metadata slot table: {}",
+                    e.what());
+  }
+
   try {
     metadataSender_.listen(detail::SCENE_MASTER_SCENE_STREAM_ENDPOINT);
   } catch (const std::runtime_error& e) {
@@ -115,6 +156,12 @@ void SceneBackend::onConnectionEvent(
   } else if (event ==
              communication::SceneConnectionManager::Event::INPUT_REMOVED) {
     EAR_LOGGER_INFO(logger_, "Input {} disconnected", id.string());
+    {
+      std::lock_guard<std::mutex> lock(metadataSlotsMutex_);
+      if (metadataSlots_) {
+        metadataSlots_->release(id);
+      }
+    }
       data_.removeInput(id);
   } else if (event ==
              communication::SceneConnectionManager::Event::MONITORING_ADDED) {
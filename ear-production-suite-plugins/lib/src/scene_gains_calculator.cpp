@@ -1,6 +1,5 @@
 #include "scene_gains_calculator.hpp"
 #include "ear/metadata.hpp"
-#include "helper/eps_to_ear_metadata_converter.hpp"
 #include "helper/container_helpers.hpp"
 #include <algorithm>
 
@@ -52,30 +51,27 @@ SceneGainsCalculator::SceneGainsCalculator(ear::Layout outputLayout,
       totalInputChannels{inputChannelCount} {}
 
 bool SceneGainsCalculator::update(const proto::SceneStore& store) {
-  // First figure out what we need to process updates for
-  std::vector<communication::ConnectionId> cachedIdsChecklist;
-  cachedIdsChecklist.reserve(routingCache_.size());
-  for(auto const&[key, val] : routingCache_) {
-    cachedIdsChecklist.push_back(key);
-  }
-  /// Check-off found items, and also delete changed items from routing cache to be re-evaluated
-  for(const auto& item : store.monitoring_items()) {
-    auto itemId = communication::ConnectionId{ item.connection_id() };
-    cachedIdsChecklist.erase(std::remove(cachedIdsChecklist.begin(), cachedIdsChecklist.end(), itemId), cachedIdsChecklist.end());
-    if(item.changed()) {
-      removeItem(itemId);
+  convertedScene_.update(store);
+  return update(convertedScene_);
+}
+
+bool SceneGainsCalculator::update(const ConvertedScene& scene) {
+  auto const& items = scene.items();
+  /// Delete removed and changed items from routing cache to be re-evaluated
+  for (auto it = routingCache_.begin(); it != routingCache_.end();) {
+    auto item = items.find(it->first);
+    if (item == items.end() || item->second.changed) {
+      it = routingCache_.erase(it);
+    } else {
+      ++it;
     }
   }
-  /// Delete removed items from routing cache  (i.e, those that weren't checked-off and therefore remain in cachedIdsChecklist)
-  for(const auto& itemId : cachedIdsChecklist) {
-    removeItem(itemId);
-  }
 
   // Now get the gain updates we need
-  for(const auto& item : store.monitoring_items()) {
+  for (auto const& [itemId, item] : items) {
     /// If it's not in routingCache_, it's new or changed, so needs re-evaluating
-    if(!mapHasKey(routingCache_, communication::ConnectionId{ item.connection_id() })) {
-      addOrUpdateItem(item);
+    if (!mapHasKey(routingCache_, itemId)) {
+      addOrUpdateItem(itemId, item);
     }
   }
 
@@ -106,55 +102,65 @@ Eigen::MatrixXf SceneGainsCalculator::diffuseGains() {
   return mat;
 }
 
-void SceneGainsCalculator::removeItem(const communication::ConnectionId &itemId)
-{
-  if (mapHasKey(routingCache_, itemId)) {
-    routingCache_.erase(itemId);
+HoaDecodes SceneGainsCalculator::hoaDecodes() {
+  HoaDecodes decodes;
+  for (auto const& [itemId, routing] : routingCache_) {
+    if (routing.hoaDecode_ && routing.inputStartingChannel >= 0 &&
+        (routing.inputStartingChannel + routing.hoaDecode_->cols()) <
+            totalInputChannels) {
+      decodes.push_back({routing.inputStartingChannel, routing.hoaDecode_});
+    }
   }
+  return decodes;
 }
 
-void SceneGainsCalculator::addOrUpdateItem(const proto::MonitoringItemMetadata & item)
-{
-  ItemGains* routing = setInMap(routingCache_, communication::ConnectionId{ item.connection_id() }, {});
+void SceneGainsCalculator::addOrUpdateItem(
+    const communication::ConnectionId& itemId, const ConvertedItem& item) {
+  ItemGains* routing = setInMap(routingCache_, itemId, {});
 
-  if(item.has_ds_metadata()) {
-    auto earMetadata = EpsToEarMetadataConverter::convert(item.ds_metadata());
-    routing->inputStartingChannel = item.routing();
-    int inputChannelCount = static_cast<int>(earMetadata.size());
-    resizeGainTables(*routing, static_cast<int>(earMetadata.size()),
-                     totalOutputChannels);
+  if (item.directSpeakers && !item.directSpeakers->empty()) {
+    routing->inputStartingChannel = item.routing;
+    int inputChannelCount = static_cast<int>(item.directSpeakers->size());
+    resizeGainTables(*routing, inputChannelCount, totalOutputChannels);
     for (int inputChannelCounter = 0; inputChannelCounter < inputChannelCount; inputChannelCounter++) {
       directSpeakersCalculator_.calculate(
-          earMetadata.at(inputChannelCounter),
+          item.directSpeakers->at(inputChannelCounter),
           routing->direct_[inputChannelCounter]);
     }
   }
 
-  if(item.has_obj_metadata()) {
-    auto earMetadata = EpsToEarMetadataConverter::convert(item.obj_metadata());
-    routing->inputStartingChannel = item.routing();
+  if (item.objects) {
+    routing->inputStartingChannel = item.routing;
     resizeGainTables(*routing, 1, totalOutputChannels);
-    objectCalculator_.calculate(earMetadata,
+    objectCalculator_.calculate(*item.objects,
                                 routing->direct_[0],
                                 routing->diffuse_[0]);
   }
 
-  if(item.has_hoa_metadata()) {
-    ear::HOATypeMetadata earMetadata;
-    earMetadata = EpsToEarMetadataConverter::convert(item.hoa_metadata());
-    routing->inputStartingChannel = item.routing();
-    int inputChannelCount = static_cast<int>(earMetadata.degrees.size());
-    resizeGainTables(*routing, inputChannelCount, totalOutputChannels);
-    hoaCalculator_.calculate(earMetadata, routing->direct_);
+  if (item.hoa && !item.hoa->degrees.empty()) {
+    routing->inputStartingChannel = item.routing;
+    routing->hoaDecode_ = hoaDecode(*item.hoa);
   }
+}
 
-  if(item.has_bin_metadata()) {
-    throw std::runtime_error(
-      "received unsupported binaural type metadata");
+std::shared_ptr<const Eigen::MatrixXf> SceneGainsCalculator::hoaDecode(
+    const HOATypeMetadata& metadata) {
+  auto key = std::make_tuple(metadata.orders, metadata.degrees,
+                             metadata.normalization);
+  if (auto it = hoaDecodeCache_.find(key); it != hoaDecodeCache_.end()) {
+    return it->second;
   }
-  if(item.has_mtx_metadata()) {
-    throw std::runtime_error("received unsupported Matrix type metadata");
+  int inputChannelCount = static_cast<int>(metadata.degrees.size());
+  std::vector<std::vector<float>> gains;
+  resize2dVector(gains, inputChannelCount, totalOutputChannels);
+  hoaCalculator_.calculate(metadata, gains);
+  auto decode =
+      std::make_shared<Eigen::MatrixXf>(totalOutputChannels, inputChannelCount);
+  for (int inputChannel = 0; inputChannel < inputChannelCount; ++inputChannel) {
+    decode->col(inputChannel) = Eigen::VectorXf::Map(
+        gains[inputChannel].data(), gains[inputChannel].size());
   }
+  return hoaDecodeCache_.emplace(key, std::move(decode)).first->second;
 }
 
 }  // namespace plugin
@@ -0,0 +1,38 @@
+#include "silence_detector.hpp"
+#include <algorithm>
+
+namespace ear {
+namespace plugin {
+
+SilenceDetector::SilenceDetector(std::size_t channelCount,
+                                 std::size_t holdSamples, float threshold)
+    : holdSamples_{holdSamples},
+      threshold_{threshold},
+      silentSamples_(channelCount, 0) {}
+
+void SilenceDetector::check(std::size_t channel, const float* samples,
+                            std::size_t sampleCount) {
+  if (channel >= silentSamples_.size() || sampleCount == 0) {
+    return;
+  }
+  auto peak = Eigen::Map<const Eigen::ArrayXf>(
+                  samples, static_cast<Eigen::Index>(sampleCount))
+                  .abs()
+                  .maxCoeff();
+  auto& silent = silentSamples_[channel];
+  if (peak > threshold_) {
+    silent = 0;
+  } else {
+    silent = std::min(silent + sampleCount, holdSamples_ + 1);
+  }
+}
+
+void SilenceDetector::check(const Eigen::Ref<const Eigen::MatrixXf>& block) {
+  for (Eigen::Index channel = 0; channel < block.cols(); ++channel) {
+    check(static_cast<std::size_t>(channel), block.col(channel).data(),
+          static_cast<std::size_t>(block.rows()));
+  }
+}
+
+}  // namespace plugin
+}  // namespace ear
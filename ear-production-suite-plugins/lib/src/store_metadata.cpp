@@ -58,6 +58,14 @@ void Metadata::setInputItemMetadata(
     }
 }
 
+bool Metadata::hasInputItemVersion(const communication::ConnectionId& connId,
+                                   uint32_t continuityCounter) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = itemStore_.find(connId);
+    return it != itemStore_.end() &&
+           it->second.continuity_counter() == continuityCounter;
+}
+
 void Metadata::removeInput(const communication::ConnectionId& connId) {
     std::lock_guard<std::mutex> lock(mutex_);
     if(auto it = itemStore_.find(connId); it != itemStore_.end()) {
@@ -30,7 +30,8 @@ EarBinauralMonitoringAudioProcessorEditor::
           String::fromUTF8("Output"))),
       propertiesFileLock_(
           std::make_unique<InterProcessLock>("EPS_preferences")),
-      propertiesFile_(getPropertiesFile(propertiesFileLock_.get())) {
+      propertiesFile_(getPropertiesFile(propertiesFileLock_.get())),
+      processingStatsLabel(p->getProcessingStats()) {
   header_->setText(" Binaural Monitoring");
 
   onBoardingButton_->setButtonText("?");
@@ -67,6 +68,7 @@ EarBinauralMonitoringAudioProcessorEditor::
 
   configureVersionLabel(versionLabel);
   addAndMakeVisible(versionLabel);
+  addAndMakeVisible(processingStatsLabel);
 
   statusLabel = std::make_shared<Label>();
   statusLabel->setColour(juce::Label::textColourId, ear::plugin::ui::EarColours::Version);
@@ -176,6 +178,7 @@ void EarBinauralMonitoringAudioProcessorEditor::resized() {
 
   auto footerArea = area.removeFromTop(30);
   versionLabel.setBounds(footerArea.removeFromRight(150));
+  processingStatsLabel.setBounds(footerArea.removeFromRight(300));
   statusLabel->setBounds(footerArea);
 }
 
@@ -7,6 +7,7 @@
 #include "components/onboarding.hpp"
 #include "components/overlay.hpp"
 #include "components/ear_header.hpp"
+#include "components/processing_stats_label.hpp"
 #include "binaural_monitoring_plugin_processor.hpp"
 #include "headphone_channel_meter.hpp"
 #include "headphone_channel_meter_box.hpp"
@@ -46,6 +47,7 @@ class EarBinauralMonitoringAudioProcessorEditor
   std::unique_ptr<PropertiesFile> propertiesFile_;
 
   Label versionLabel;
+  ear::plugin::ui::ProcessingStatsLabel processingStatsLabel;
 
   // --- Onboarding::Listener
   void endButtonClicked(ear::plugin::ui::Onboarding* onboarding) override;
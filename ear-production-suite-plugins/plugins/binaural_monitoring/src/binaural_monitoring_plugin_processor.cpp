@@ -77,6 +77,7 @@ EarBinauralMonitoringAudioProcessor::EarBinauralMonitoringAudioProcessor()
   addParameter(oscInvertQuatX_ = new ui::NonAutomatedParameter<AudioParameterBool>("oscInvertQuatX", "Invert OSC Quaternion X Values", false));
   addParameter(oscInvertQuatY_ = new ui::NonAutomatedParameter<AudioParameterBool>("oscInvertQuatY", "Invert OSC Quaternion Y Values", false));
   addParameter(oscInvertQuatZ_ = new ui::NonAutomatedParameter<AudioParameterBool>("oscInvertQuatZ", "Invert OSC Quaternion Z Values", false));
+  addParameter(oscPrediction_ = new ui::NonAutomatedParameter<AudioParameterInt>("oscPrediction", "OSC Latency Compensation (ms)", 0, 200, 0));
   /* clang-format on */
 
   static_cast<ui::NonAutomatedParameter<AudioParameterBool>*>(oscEnable_)
@@ -124,6 +125,11 @@ EarBinauralMonitoringAudioProcessor::EarBinauralMonitoringAudioProcessor()
     bypass_->setValueNotifyingHost(bypass_->get());
   };
 
+  static_cast<ui::NonAutomatedParameter<AudioParameterInt>*>(oscPrediction_)
+    ->markPluginStateAsDirty = [this]() {
+    bypass_->setValueNotifyingHost(bypass_->get());
+  };
+
   backend_ = std::make_unique<ear::plugin::BinauralMonitoringBackend>(
       nullptr, MAX_DAW_CHANNELS);
   connector_ =
@@ -143,6 +149,10 @@ EarBinauralMonitoringAudioProcessor::EarBinauralMonitoringAudioProcessor()
   connector_->parameterValueChanged(11, oscInvertQuatY_->get());
   connector_->parameterValueChanged(12, oscInvertQuatZ_->get());
 
+  oscReceiver.setOrientationTrack(orientationTrack_);
+  orientationTrack_->setPrediction(
+      std::chrono::milliseconds(oscPrediction_->get()));
+
   oscReceiver.onReceiveEuler = [this](ListenerOrientation::Euler euler) {
     connector_->setEuler(euler);
   };
@@ -161,6 +171,7 @@ EarBinauralMonitoringAudioProcessor::EarBinauralMonitoringAudioProcessor()
   oscInvertQuatX_->addListener(this);
   oscInvertQuatY_->addListener(this);
   oscInvertQuatZ_->addListener(this);
+  oscPrediction_->addListener(this);
 
   configFileOptions.applicationName = ProjectInfo::projectName;
   configFileOptions.filenameSuffix = ".settings";
@@ -173,7 +184,7 @@ EarBinauralMonitoringAudioProcessor::~EarBinauralMonitoringAudioProcessor() {}
 
 void EarBinauralMonitoringAudioProcessor::parameterValueChanged(
   int parameterIndex, float newValue) {
-  if(parameterIndex >= 4 && parameterIndex <= 12) {
+  if(parameterIndex >= 4 && parameterIndex <= 13) {
     // OSC controls
     if(parameterIndex == 4 || parameterIndex == 5) {
       // OSC Enable || OSC Port
@@ -182,6 +193,10 @@ void EarBinauralMonitoringAudioProcessor::parameterValueChanged(
       } else {
         oscReceiver.disconnect();
       }
+    } else if(parameterIndex == 13) {
+      // Latency compensation
+      orientationTrack_->setPrediction(
+          std::chrono::milliseconds(oscPrediction_->get()));
     } else {
       // Invert control
       oscReceiver.setInverts({
@@ -224,6 +239,7 @@ void EarBinauralMonitoringAudioProcessor::restartBearProcessor(
         std::make_unique<ear::plugin::BinauralMonitoringAudioProcessor>(
             MAX_DAW_CHANNELS, MAX_DAW_CHANNELS, MAX_DAW_CHANNELS, samplerate_,
             blocksize_, dataFilePath);
+    processor_->setListenerOrientationTrack(orientationTrack_.get());
     if (connector_) {
       connector_->setRendererStatus(processor_->getBearStatus());
     }
@@ -244,6 +260,7 @@ bool EarBinauralMonitoringAudioProcessor::readConfigFile() {
     *oscInvertQuatX_ = props.getBoolValue("oscInvertQuatX", false);
     *oscInvertQuatY_ = props.getBoolValue("oscInvertQuatY", false);
     *oscInvertQuatZ_ = props.getBoolValue("oscInvertQuatZ", false);
+    *oscPrediction_ = props.getIntValue("oscPrediction", 0);
     auto selectedDataFile = props.getValue("bearPreferredDataFile");
     if (selectedDataFile.isEmpty()){
       dataFileManager.setSelectedDataFileDefault();
@@ -273,6 +290,7 @@ bool EarBinauralMonitoringAudioProcessor::writeConfigFile()
   props.setValue("oscInvertQuatX", (bool)*oscInvertQuatX_);
   props.setValue("oscInvertQuatY", (bool)*oscInvertQuatY_);
   props.setValue("oscInvertQuatZ", (bool)*oscInvertQuatZ_);
+  props.setValue("oscPrediction", (int)*oscPrediction_);
   if (auto selectedDataFile = dataFileManager.getSelectedDataFileInfo()) {
     props.setValue("bearPreferredDataFile", selectedDataFile->fullPath.getFullPathName());
   }
@@ -338,6 +356,8 @@ bool EarBinauralMonitoringAudioProcessor::isBusesLayoutSupported(
 void EarBinauralMonitoringAudioProcessor::processBlock(
     AudioBuffer<float>& buffer, MidiBuffer&) {
   ScopedNoDenormals noDenormals;
+  ear::plugin::ScopedStageTimer processBlockTimer(&processingStats_,
+                                                  processBlockStage_);
 
   stopTimer();
 
@@ -362,7 +382,8 @@ void EarBinauralMonitoringAudioProcessor::processBlock(
   }
 
   {
-    std::lock_guard<std::mutex> lock(processorMutex_);
+    auto lock = ear::plugin::lockCountingContention(
+        processorMutex_, &processingStats_, processBlockStage_);
 
     // Check BEAR has started - if not, we still want to zero output to make problem obvious
     if (!processor_ || !processor_->rendererStarted()) {
@@ -386,12 +407,15 @@ void EarBinauralMonitoringAudioProcessor::processBlock(
       return;
     }
 
+    auto metadataStart = ear::plugin::ProcessingStats::Clock::now();
+
     // Listener Position
     auto latestQuat = backend_->listenerOrientation->getQuaternion();
     processor_->setListenerOrientation(latestQuat.w, latestQuat.x, latestQuat.y,
                                        latestQuat.z);
 
-    // BEAR Metadata
+    // BEAR Metadata - silent inputs' is held back, so check them first
+    processor_->checkSilence(buffer);
 
     for(auto& connId : objIds) {
       auto md = backend_->getLatestObjectsTypeMetadata(connId);
@@ -403,11 +427,11 @@ void EarBinauralMonitoringAudioProcessor::processBlock(
     for(auto& connId : dsIds) {
       auto md = backend_->getLatestDirectSpeakersTypeMetadata(connId);
       if(md.has_value() && md->startingChannel >= 0) {
-        for(int index = 0; index < md->earMetadata.size(); index++) {
+        for(int index = 0; index < md->earMetadata->size(); index++) {
           processor_->pushBearMetadata(
             md->startingChannel + index,
-            &(md->earMetadata[index]));  // earMetadata is a vector for DS but
-                                         // not for obj or HOA
+            &(*md->earMetadata)[index]);  // earMetadata is a vector for DS
+                                          // but not for obj or HOA
         }
       }
     }
@@ -416,13 +440,29 @@ void EarBinauralMonitoringAudioProcessor::processBlock(
     for(auto& connId : hoaIds) {
       auto md = backend_->getLatestHoaTypeMetadata(connId);
       if(md.has_value() && md->startingChannel >= 0) {
-        processor_->pushBearMetadata(md->startingChannel, &(md->earMetadata),
+        processor_->pushBearMetadata(md->startingChannel,
+                                     md->earMetadata.get(),
                                      streamIdentifier++);
       }
     }
 
+    processingStats_.record(metadataStage_, metadataStart,
+                            ear::plugin::ProcessingStats::Clock::now());
+
     // BEAR audio processing
+    ear::plugin::ScopedStageTimer bearTimer(&processingStats_, bearStage_);
     processor_->process(buffer, buffer);
+    auto skips = processor_->takeSkipCounts();
+    processingStats_.recordSkips(bearStage_, skips.channelBlocks,
+                                 skips.skippedChannelBlocks);
+
+    // The processor took in any new OSC orientations for this block
+    auto received = orientationTrack_->latestReceived();
+    if(received && received != lastRecordedOrientation_) {
+      processingStats_.record(oscToOutputStage_, *received,
+                              ear::plugin::ProcessingStats::Clock::now());
+      lastRecordedOrientation_ = received;
+    }
   }
 
   // Clear unused output channels
@@ -465,6 +505,7 @@ void EarBinauralMonitoringAudioProcessor::getStateInformation(
   xml->setAttribute("oscInvertQuatX", (bool)*oscInvertQuatX_);
   xml->setAttribute("oscInvertQuatY", (bool)*oscInvertQuatY_);
   xml->setAttribute("oscInvertQuatZ", (bool)*oscInvertQuatZ_);
+  xml->setAttribute("oscPrediction", (int)*oscPrediction_);
   copyXmlToBinary(*xml, destData);
 }
 
@@ -506,6 +547,9 @@ void EarBinauralMonitoringAudioProcessor::setStateInformation(const void* data,
         if(xmlState->hasAttribute("oscInvertQuatZ")) {
           *oscInvertQuatZ_ = xmlState->getBoolAttribute("oscInvertQuatZ", false);
         }
+        if(xmlState->hasAttribute("oscPrediction")) {
+          *oscPrediction_ = xmlState->getIntAttribute("oscPrediction", 0);
+        }
       }
     }
   }
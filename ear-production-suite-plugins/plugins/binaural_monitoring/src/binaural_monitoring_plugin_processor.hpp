@@ -8,6 +8,7 @@
 #include <mutex>
 
 #include "components/level_meter_calculator.hpp"
+#include "processing_stats.hpp"
 
 #include "bear_data_files.hpp"
 #include "orientation_osc.hpp"
@@ -68,6 +69,10 @@ class EarBinauralMonitoringAudioProcessor
     return levelMeter_;
   };
 
+  ear::plugin::ProcessingStats* getProcessingStats() {
+    return &processingStats_;
+  }
+
   ear::plugin::ListenerOrientationOscReceiver oscReceiver{};
 
   AudioProcessorParameter* getBypassParameter() { return bypass_; }
@@ -83,6 +88,7 @@ class EarBinauralMonitoringAudioProcessor
   AudioParameterBool* getOscInvertQuatX() { return oscInvertQuatX_; }
   AudioParameterBool* getOscInvertQuatY() { return oscInvertQuatY_; }
   AudioParameterBool* getOscInvertQuatZ() { return oscInvertQuatZ_; }
+  AudioParameterInt* getOscPrediction() { return oscPrediction_; }
 
   ear::plugin::ui::BinauralMonitoringJuceFrontendConnector*
   getFrontendConnector() {
@@ -111,6 +117,7 @@ class EarBinauralMonitoringAudioProcessor
   AudioParameterBool* oscInvertQuatX_;
   AudioParameterBool* oscInvertQuatY_;
   AudioParameterBool* oscInvertQuatZ_;
+  AudioParameterInt* oscPrediction_;
 
   std::unique_ptr<ear::plugin::ui::BinauralMonitoringJuceFrontendConnector>
       connector_;
@@ -118,6 +125,11 @@ class EarBinauralMonitoringAudioProcessor
   std::unique_ptr<ear::plugin::BinauralMonitoringBackend> backend_;
   std::mutex processorMutex_;  // used to prevent access during (re)construction
   std::unique_ptr<ear::plugin::BinauralMonitoringAudioProcessor> processor_;
+  // OSC orientations, for the processor to follow within blocks
+  std::shared_ptr<ear::plugin::ListenerOrientationTrack> orientationTrack_{
+      std::make_shared<ear::plugin::ListenerOrientationTrack>()};
+  std::optional<ear::plugin::ListenerOrientationTrack::Clock::time_point>
+      lastRecordedOrientation_;
   void restartBearProcessor(bool onlyOnConfigChange = false);
 
   int samplerate_{48000};
@@ -132,6 +144,18 @@ class EarBinauralMonitoringAudioProcessor
   ConfigRestoreState configRestoreState{ NOT_RESTORED };
   PropertiesFile::Options configFileOptions;
 
+  ear::plugin::ProcessingStats processingStats_{JucePlugin_Name};
+  const ear::plugin::ProcessingStats::StageId processBlockStage_{
+      processingStats_.addStage("processBlock")};
+  const ear::plugin::ProcessingStats::StageId metadataStage_{
+      processingStats_.addStage("metadata handoff")};
+  const ear::plugin::ProcessingStats::StageId bearStage_{
+      processingStats_.addStage("BEAR process")};
+  // From receiving an OSC orientation to the first block rendered with it.
+  // Motion-to-sound latency, less the tracker's and audio device's own.
+  const ear::plugin::ProcessingStats::StageId oscToOutputStage_{
+      processingStats_.addStage("OSC to output")};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(
       EarBinauralMonitoringAudioProcessor)
 };
@@ -46,6 +46,11 @@ void ListenerOrientationOscReceiver::setInverts(Inversions newInverts)
   if(lastReceivedType == InputType::Quaternion) doQuaternionCallback();
 }
 
+void ListenerOrientationOscReceiver::setOrientationTrack(
+    std::shared_ptr<ListenerOrientationTrack> track) {
+  orientationTrack = std::move(track);
+}
+
 void ListenerOrientationOscReceiver::oscMessageReceived(
     const OSCMessage& message) {
 
@@ -245,36 +250,57 @@ void ListenerOrientationOscReceiver::handleReceiveEuler()
 {
   lastReceivedType = InputType::Euler;
   if(onInputTypeChange) onInputTypeChange(lastReceivedType);
+  pushToTrack(ListenerOrientation::toQuaternion(invertedEuler()));
   doEulerCallback();
 }
 
 void ListenerOrientationOscReceiver::doEulerCallback()
 {
   if(onReceiveEuler) {
-    auto modVals = oscEulerInput;
-    if(invert.yaw) modVals.y = -modVals.y;
-    if(invert.pitch) modVals.p = -modVals.p;
-    if(invert.roll) modVals.r = -modVals.r;
-    onReceiveEuler(modVals);
+    onReceiveEuler(invertedEuler());
   }
 }
 
+ListenerOrientation::Euler ListenerOrientationOscReceiver::invertedEuler() const
+{
+  auto modVals = oscEulerInput;
+  if(invert.yaw) modVals.y = -modVals.y;
+  if(invert.pitch) modVals.p = -modVals.p;
+  if(invert.roll) modVals.r = -modVals.r;
+  return modVals;
+}
+
 void ListenerOrientationOscReceiver::handleReceiveQuaternion()
 {
   lastReceivedType = InputType::Quaternion;
   if(onInputTypeChange) onInputTypeChange(lastReceivedType);
+  pushToTrack(invertedQuaternion());
   doQuaternionCallback();
 }
 
 void ListenerOrientationOscReceiver::doQuaternionCallback()
 {
   if(onReceiveQuaternion) {
-    auto modVals = oscQuatInput;
-    if(invert.quatW) modVals.w = -modVals.w;
-    if(invert.quatX) modVals.x = -modVals.x;
-    if(invert.quatY) modVals.y = -modVals.y;
-    if(invert.quatZ) modVals.z = -modVals.z;
-    onReceiveQuaternion(modVals);
+    onReceiveQuaternion(invertedQuaternion());
+  }
+}
+
+ListenerOrientation::Quaternion ListenerOrientationOscReceiver::invertedQuaternion() const
+{
+  auto modVals = oscQuatInput;
+  if(invert.quatW) modVals.w = -modVals.w;
+  if(invert.quatX) modVals.x = -modVals.x;
+  if(invert.quatY) modVals.y = -modVals.y;
+  if(invert.quatZ) modVals.z = -modVals.z;
+  return modVals;
+}
+
+void ListenerOrientationOscReceiver::pushToTrack(
+    ListenerOrientation::Quaternion quat)
+{
+  // Only ever called on the OSC thread, the track's one producer
+  if(orientationTrack) {
+    orientationTrack->push(quat, ListenerOrientationTrack::Clock::now());
   }
 }
 
@@ -4,6 +4,7 @@
 
 #include <memory>
 #include "listener_orientation.hpp"
+#include "listener_orientation_track.hpp"
 
 namespace ear {
 namespace plugin {
@@ -35,6 +36,9 @@ class ListenerOrientationOscReceiver
   void listenForConnections(uint16_t port);
   void disconnect();
   void setInverts(Inversions newInverts);
+  // Received orientations are also pushed to the track, timestamped, straight
+  // from the OSC thread. Set before listening.
+  void setOrientationTrack(std::shared_ptr<ListenerOrientationTrack> track);
 
   void oscMessageReceived(const OSCMessage& message) override;
   void timerCallback(int timerId) override;
@@ -49,8 +53,11 @@ class ListenerOrientationOscReceiver
 
   void handleReceiveEuler();
   void doEulerCallback();
+  ListenerOrientation::Euler invertedEuler() const;
   void handleReceiveQuaternion();
   void doQuaternionCallback();
+  ListenerOrientation::Quaternion invertedQuaternion() const;
+  void pushToTrack(ListenerOrientation::Quaternion quat);
 
   bool isListening{false};
   uint16_t oscPort{8000};
@@ -60,6 +67,7 @@ class ListenerOrientationOscReceiver
 
   OSCReceiver osc;
   Inversions invert;
+  std::shared_ptr<ListenerOrientationTrack> orientationTrack;
 
   // Have to track this because we can receive one coord at a time,
   //   but they're only useful together
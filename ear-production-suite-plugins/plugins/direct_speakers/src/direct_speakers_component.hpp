@@ -14,6 +14,7 @@
 #include "value_box_metadata.hpp"
 #include "value_box_speaker_layer.hpp"
 #include "components/version_label.hpp"
+#include "components/processing_stats_label.hpp"
 #include <memory>
 
 namespace ear {
@@ -40,6 +41,7 @@ class DirectSpeakersComponent : public Component,
         bottomLayerValueBox(
             std::make_shared<ValueBoxSpeakerLayer>("Bottom Layer")),
         statusBarLabel(std::make_shared<Label>()),
+        processingStatsLabel(p->getProcessingStats()),
         propertiesFileLock(
             std::make_unique<InterProcessLock>("EPS_preferences")),
         propertiesFile(getPropertiesFile(propertiesFileLock.get())) {
@@ -93,6 +95,7 @@ class DirectSpeakersComponent : public Component,
 
     configureVersionLabel(versionLabel);
     addAndMakeVisible(versionLabel);
+    addAndMakeVisible(processingStatsLabel);
   }
 
   ~DirectSpeakersComponent() {}
@@ -111,6 +114,8 @@ class DirectSpeakersComponent : public Component,
     auto headingArea = area.removeFromTop(55);
     auto bottomLabelsArea = area.removeFromBottom(30);
     statusBarLabel->setBounds(bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
+    processingStatsLabel.setBounds(
+        bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
     versionLabel.setBounds(bottomLabelsArea);
     onBoardingButton->setBounds(
         headingArea.removeFromRight(39).removeFromBottom(39));
@@ -153,6 +158,7 @@ class DirectSpeakersComponent : public Component,
   std::shared_ptr<ear::plugin::ui::ValueBoxSpeakerLayer> bottomLayerValueBox;
   std::shared_ptr<Label> statusBarLabel;
   Label versionLabel;
+  ProcessingStatsLabel processingStatsLabel;
 
   std::unique_ptr<InterProcessLock> propertiesFileLock;
   std::unique_ptr<PropertiesFile> propertiesFile;
@@ -110,10 +110,14 @@ bool DirectSpeakersAudioProcessor::isBusesLayoutSupported(
 
 void DirectSpeakersAudioProcessor::processBlock(AudioBuffer<float>& buffer,
                                                 MidiBuffer& midiMessages) {
+  ear::plugin::ScopedStageTimer processBlockTimer(&processingStats_,
+                                                processBlockStage_);
   if(!bypass_->get()) {
     if(getActiveEditor()) {
       levelMeter_->process(buffer);
     }
+    ear::plugin::ScopedStageTimer metadataTimer(&processingStats_,
+                                                metadataStage_);
     backend_->triggerMetadataSend();
   }
 }
@@ -4,6 +4,7 @@
 
 #include "direct_speakers_backend.hpp"
 #include "components/level_meter_calculator.hpp"
+#include "processing_stats.hpp"
 #include "reaper_vst3_interfaces.h"
 #include "components/read_only_audio_parameter_int.hpp"
 #include <daw_channel_count.h>
@@ -66,6 +67,10 @@ class DirectSpeakersAudioProcessor : public AudioProcessor, public VST3ClientExt
     return levelMeter_;
   };
 
+  ear::plugin::ProcessingStats* getProcessingStats() {
+    return &processingStats_;
+  }
+
   ear::plugin::ui::DirectSpeakersJuceFrontendConnector* getFrontendConnector() {
     return connector_.get();
   }
@@ -93,5 +98,11 @@ class DirectSpeakersAudioProcessor : public AudioProcessor, public VST3ClientExt
   int numDawChannels_{MAX_DAW_CHANNELS};
   std::shared_ptr<ear::plugin::LevelMeterCalculator> levelMeter_;
 
+  ear::plugin::ProcessingStats processingStats_{JucePlugin_Name};
+  const ear::plugin::ProcessingStats::StageId processBlockStage_{
+      processingStats_.addStage("processBlock")};
+  const ear::plugin::ProcessingStats::StageId metadataStage_{
+      processingStats_.addStage("metadata handoff")};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DirectSpeakersAudioProcessor)
 };
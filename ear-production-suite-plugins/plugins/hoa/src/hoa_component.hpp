@@ -11,6 +11,7 @@
 #include "value_box_main.hpp"
 #include "value_box_order_display.hpp"
 #include "components/version_label.hpp"
+#include "components/processing_stats_label.hpp"
 
 namespace ear {
 namespace plugin {
@@ -29,6 +30,7 @@ class HoaComponent : public Component,
         orderDisplayValueBox(
             std::make_shared<ValueBoxOrderDisplay>(p, p->getLevelMeter())),
         statusBarLabel(std::make_shared<Label>()),
+        processingStatsLabel(p->getProcessingStats()),
         propertiesFileLock(
             std::make_unique<InterProcessLock>("EPS_preferences")),
         propertiesFile(getPropertiesFile(propertiesFileLock.get())) {
@@ -78,6 +80,7 @@ class HoaComponent : public Component,
 
     configureVersionLabel(versionLabel);
     addAndMakeVisible(versionLabel);
+    addAndMakeVisible(processingStatsLabel);
   }
 
   ~HoaComponent() {}
@@ -95,6 +98,8 @@ class HoaComponent : public Component,
     auto bottomLabelsArea = area.removeFromBottom(30);
     statusBarLabel->setBounds(
         bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
+    processingStatsLabel.setBounds(
+        bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
     versionLabel.setBounds(bottomLabelsArea);
     onBoardingButton->setBounds(
         headingArea.removeFromRight(39).removeFromBottom(39));
@@ -117,6 +122,7 @@ class HoaComponent : public Component,
   std::shared_ptr<ear::plugin::ui::ValueBoxOrderDisplay> orderDisplayValueBox;
   std::shared_ptr<Label> statusBarLabel;
   Label versionLabel;
+  ProcessingStatsLabel processingStatsLabel;
 
   std::unique_ptr<InterProcessLock> propertiesFileLock;
   std::unique_ptr<PropertiesFile> propertiesFile;
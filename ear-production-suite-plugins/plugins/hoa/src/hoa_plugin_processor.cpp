@@ -108,12 +108,16 @@ bool HoaAudioProcessor::isBusesLayoutSupported(
 
 void HoaAudioProcessor::processBlock(AudioBuffer<float>& buffer,
                                      MidiBuffer& midiMessages) {
+  ear::plugin::ScopedStageTimer processBlockTimer(&processingStats_,
+                                                processBlockStage_);
   if(!bypass_->get()) {
     if(getActiveEditor()) {
       levelMeterCalculator_->process(buffer);
     } else {
       levelMeterCalculator_->processForClippingOnly(buffer);
     }
+    ear::plugin::ScopedStageTimer metadataTimer(&processingStats_,
+                                                metadataStage_);
     backend_->triggerMetadataSend();
   }
 }
@@ -5,6 +5,7 @@
 #include "hoa_backend.hpp"
 #include "reaper_vst3_interfaces.h"
 #include "components/read_only_audio_parameter_int.hpp"
+#include "processing_stats.hpp"
 #include <daw_channel_count.h>
 
 namespace ear {
@@ -63,6 +64,10 @@ class HoaAudioProcessor : public AudioProcessor, public VST3ClientExtensions {
     return levelMeterCalculator_;
   };
 
+  ear::plugin::ProcessingStats* getProcessingStats() {
+    return &processingStats_;
+  }
+
   ear::plugin::ui::HoaJuceFrontendConnector* getFrontendConnector() {
     return connector_.get();
   }
@@ -89,5 +94,11 @@ class HoaAudioProcessor : public AudioProcessor, public VST3ClientExtensions {
   int numDawChannels_{MAX_DAW_CHANNELS};
   std::shared_ptr<ear::plugin::LevelMeterCalculator> levelMeterCalculator_;
 
+  ear::plugin::ProcessingStats processingStats_{JucePlugin_Name};
+  const ear::plugin::ProcessingStats::StageId processBlockStage_{
+      processingStats_.addStage("processBlock")};
+  const ear::plugin::ProcessingStats::StageId metadataStage_{
+      processingStats_.addStage("metadata handoff")};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HoaAudioProcessor)
 };
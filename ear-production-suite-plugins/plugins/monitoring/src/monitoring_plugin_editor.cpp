@@ -27,11 +27,12 @@ EarMonitoringAudioProcessorEditor::EarMonitoringAudioProcessorEditor(
           std::make_unique<SpeakerMeterBox>(String::fromUTF8("13–24"))),
       propertiesFileLock_(
           std::make_unique<InterProcessLock>("EPS_preferences")),
-      propertiesFile_(getPropertiesFile(propertiesFileLock_.get())) {
+      propertiesFile_(getPropertiesFile(propertiesFileLock_.get())),
+      processingStatsLabel(p->getProcessingStats()) {
   String headingText = String::fromUTF8(" Monitoring – ");
-  headingText += SPEAKER_LAYOUT_NAME;
+  headingText += String(SPEAKER_LAYOUT_NAME).replace(",", " + ");
   headingText += " (";
-  headingText += SPEAKER_LAYOUT;
+  headingText += String(SPEAKER_LAYOUT).replace(",", " + ");
   headingText += ")";
   header_->setText(headingText.toStdString());
 
@@ -60,16 +61,23 @@ EarMonitoringAudioProcessorEditor::EarMonitoringAudioProcessorEditor(
 
   configureVersionLabel(versionLabel);
   addAndMakeVisible(versionLabel);
+  addAndMakeVisible(processingStatsLabel);
 
   addAndMakeVisible(speakerMeterBoxTop_.get());
   addAndMakeVisible(speakerMeterBoxBottom_.get());
 
-  auto apfid = adm::parseAudioPackFormatId(AUDIO_PACK_FORMAT_ID);
-  auto idValue = apfid.get<adm::AudioPackFormatIdValue>().get();
-  auto typeDef = apfid.get<adm::TypeDescriptor>().get();
-  auto pfData = AdmPresetDefinitionsHelper::getSingleton().getPackFormatData(
-      typeDef, idValue);
-  if (pfData) {
+  // Multi-layout plugins list one pack format per layout, in output order
+  int channel = 0;
+  for (auto const& packFormatId :
+       StringArray::fromTokens(AUDIO_PACK_FORMAT_ID, ",", "")) {
+    auto apfid = adm::parseAudioPackFormatId(packFormatId.trim().toStdString());
+    auto idValue = apfid.get<adm::AudioPackFormatIdValue>().get();
+    auto typeDef = apfid.get<adm::TypeDescriptor>().get();
+    auto pfData = AdmPresetDefinitionsHelper::getSingleton().getPackFormatData(
+        typeDef, idValue);
+    if (!pfData) {
+      continue;
+    }
     for (int i = 0; i < pfData->relatedChannelFormats.size(); ++i) {
       auto cfData = pfData->relatedChannelFormats[i];
       auto spLabel = cfData->legacySpeakerLabel.has_value()
@@ -79,9 +87,11 @@ EarMonitoringAudioProcessorEditor::EarMonitoringAudioProcessorEditor(
                          ? cfData->ituLabel.value()
                          : std::string();
       speakerMeters_.push_back(std::make_unique<SpeakerMeter>(
-          String(i + 1), spLabel, ituLabel));
-      speakerMeters_.back()->getLevelMeter()->setMeter(p->getLevelMeter(), i);
+          String(channel + 1), spLabel, ituLabel));
+      speakerMeters_.back()->getLevelMeter()->setMeter(p->getLevelMeter(),
+                                                       channel);
       addAndMakeVisible(speakerMeters_.back().get());
+      ++channel;
     }
   }
   setSize(735, 655);
@@ -104,6 +114,8 @@ void EarMonitoringAudioProcessorEditor::resized() {
 
   area.removeFromTop(10);
   auto bottomLabelsArea = area.removeFromBottom(30);
+  processingStatsLabel.setBounds(
+      bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
   versionLabel.setBounds(bottomLabelsArea);
 
   auto speakerMeterBoxHeight = area.getHeight() / 2;
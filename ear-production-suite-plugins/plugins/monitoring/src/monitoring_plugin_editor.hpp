@@ -7,6 +7,7 @@
 #include "components/onboarding.hpp"
 #include "components/overlay.hpp"
 #include "components/ear_header.hpp"
+#include "components/processing_stats_label.hpp"
 #include "monitoring_plugin_processor.hpp"
 #include "speaker_meter.hpp"
 #include "speaker_meter_box.hpp"
@@ -38,6 +39,7 @@ class EarMonitoringAudioProcessorEditor
   std::unique_ptr<PropertiesFile> propertiesFile_;
 
   Label versionLabel;
+  ear::plugin::ui::ProcessingStatsLabel processingStatsLabel;
 
   // --- Onboarding::Listener
   void endButtonClicked(ear::plugin::ui::Onboarding* onboarding) override;
@@ -49,10 +49,27 @@ namespace {
   }
 }
 
-ear::Layout const& layout() {
-    static ear::Layout LAYOUT{getLayoutImpl(SPEAKER_LAYOUT)};
-    return LAYOUT;
+// SPEAKER_LAYOUT is a comma separated list for the multi-layout plugins,
+// which render each layout in turn on to consecutive output channels
+std::vector<ear::Layout> const& layouts() {
+  static std::vector<ear::Layout> LAYOUTS = []() {
+    std::vector<ear::Layout> layouts;
+    for (auto const& name :
+         StringArray::fromTokens(SPEAKER_LAYOUT, ",", "")) {
+      layouts.push_back(getLayoutImpl(name.trim().toStdString()));
+    }
+    return layouts;
+  }();
+  return LAYOUTS;
+}
+
+int totalChannelCount(std::vector<ear::Layout> const& layouts) {
+  int channels = 0;
+  for (auto const& layout : layouts) {
+    channels += static_cast<int>(layout.channels().size());
   }
+  return channels;
+}
 }
 
 void EarMonitoringAudioProcessor::setIHostApplication(
@@ -67,7 +84,7 @@ void EarMonitoringAudioProcessor::setIHostApplication(
           false, 0, AudioChannelSet::discreteChannels(numDawChannels_));
       assert(retI && retO);
       backend_ = std::make_unique<ear::plugin::MonitoringBackend>(
-          nullptr, layout(), numDawChannels_);
+          nullptr, layouts(), numDawChannels_);
     }
 }
 
@@ -81,14 +98,13 @@ EarMonitoringAudioProcessor::EarMonitoringAudioProcessor()
               .withOutput("Output",
                           AudioChannelSet::discreteChannels(MAX_DAW_CHANNELS),
                           true)) {
-  auto speakerLayout = layout();
-  numOutputChannels_ = speakerLayout.channels().size();
+  numOutputChannels_ = totalChannelCount(layouts());
   backend_ = std::make_unique<ear::plugin::MonitoringBackend>(
-      nullptr, speakerLayout, numDawChannels_);
+      nullptr, layouts(), numDawChannels_);
   levelMeter_ = std::make_shared<ear::plugin::LevelMeterCalculator>(0, 0);
   ProcessorConfig newConfig{getTotalNumInputChannels(),
                             getTotalNumOutputChannels(), 512,
-                            speakerLayout};
+                            layouts()};
   configureProcessor(newConfig);
 }
 
@@ -129,10 +145,10 @@ void EarMonitoringAudioProcessor::prepareToPlay(double sampleRate,
                                                 int samplesPerBlock) {
   ProcessorConfig newConfig{getTotalNumInputChannels(),
                             getTotalNumOutputChannels(), samplesPerBlock,
-                            layout()};
+                            layouts()};
   configureProcessor(newConfig);
   samplerate_ = sampleRate;
-  levelMeter_->setup(newConfig.layout.channels().size(), sampleRate);
+  levelMeter_->setup(numOutputChannels_, sampleRate);
 }
 
 void EarMonitoringAudioProcessor::releaseResources() {
@@ -156,6 +172,8 @@ bool EarMonitoringAudioProcessor::isBusesLayoutSupported(
 void EarMonitoringAudioProcessor::processBlock(AudioBuffer<float>& buffer,
                                                MidiBuffer&) {
   ScopedNoDenormals noDenormals;
+  ear::plugin::ScopedStageTimer processBlockTimer(&processingStats_,
+                                                  processBlockStage_);
 
   if(backend_->isExporting()) {
     if(getTotalNumOutputChannels() > 0 && getTotalNumInputChannels() > 0) {
@@ -176,9 +194,30 @@ void EarMonitoringAudioProcessor::processBlock(AudioBuffer<float>& buffer,
   }
 
   // Do EAR render
-  auto gains = backend_->currentGains();
-  if (processor_) {
-    processor_->process(buffer, buffer, gains.direct, gains.diffuse);
+  auto const* input = &buffer;
+  if (processors_.size() > 1) {
+    inputCopy_.makeCopyOf(buffer, true);
+    input = &inputCopy_;
+  }
+  int outputOffset = 0;
+  for (std::size_t i = 0; i < processors_.size(); ++i) {
+    auto gainsStart = ear::plugin::ProcessingStats::Clock::now();
+    auto gains = backend_->currentGains(i);
+    processingStats_.record(gainsStage_, gainsStart,
+                            ear::plugin::ProcessingStats::Clock::now());
+    auto outputChannels = static_cast<int>(gains.direct.rows());
+    if (outputOffset + outputChannels > buffer.getNumChannels()) {
+      break;
+    }
+    AudioBuffer<float> output(buffer.getArrayOfWritePointers() + outputOffset,
+                              outputChannels, buffer.getNumSamples());
+    ear::plugin::ScopedStageTimer renderTimer(&processingStats_, renderStage_);
+    processors_[i]->process(*input, output, gains.direct, gains.diffuse,
+                            gains.hoa);
+    auto skips = processors_[i]->takeSkipCounts();
+    processingStats_.recordSkips(renderStage_, skips.channelBlocks,
+                                 skips.skippedChannelBlocks);
+    outputOffset += outputChannels;
   }
 
   if(getActiveEditor()) {
@@ -218,9 +257,16 @@ void EarMonitoringAudioProcessor::setStateInformation(const void* data,
 
 void EarMonitoringAudioProcessor::configureProcessor(
     const ProcessorConfig& config) {
-  if (!processor_ || config != processorConfig_) {
-    processor_ = std::make_unique<ear::plugin::MonitoringAudioProcessor>(
-        config.inputChannels, config.layout, config.blockSize);
+  if (processors_.empty() || config != processorConfig_) {
+    processors_.clear();
+    for (auto const& layout : config.layouts) {
+      processors_.push_back(
+          std::make_unique<ear::plugin::MonitoringAudioProcessor>(
+              config.inputChannels, layout, config.blockSize));
+    }
+    if (processors_.size() > 1) {
+      inputCopy_.setSize(config.inputChannels, config.blockSize);
+    }
     processorConfig_ = config;
   }
 }
@@ -4,8 +4,10 @@
 
 #include <ear/ear.hpp>
 #include <memory>
+#include <vector>
 
 #include "components/level_meter_calculator.hpp"
+#include "processing_stats.hpp"
 #include <daw_channel_count.h>
 
 namespace ear {
@@ -20,14 +22,17 @@ struct ProcessorConfig {
   int inputChannels;
   int outputChannels;
   int blockSize;
-  ear::Layout layout;
+  std::vector<ear::Layout> layouts;
 };
 
 inline bool operator==(ProcessorConfig const& lhs, ProcessorConfig const rhs) {
   auto eq = lhs.inputChannels == rhs.inputChannels &&
             lhs.outputChannels == rhs.outputChannels &&
             lhs.blockSize == rhs.blockSize &&
-            lhs.layout.name() == rhs.layout.name();
+            lhs.layouts.size() == rhs.layouts.size();
+  for (std::size_t i = 0; eq && i < lhs.layouts.size(); ++i) {
+    eq = lhs.layouts[i].name() == rhs.layouts[i].name();
+  }
   return eq;
 }
 inline bool operator!=(ProcessorConfig const& lhs, ProcessorConfig const rhs) {
@@ -72,18 +77,35 @@ class EarMonitoringAudioProcessor : public AudioProcessor,
     return levelMeter_;
   };
 
+  ear::plugin::ProcessingStats* getProcessingStats() {
+    return &processingStats_;
+  }
+
   void setIHostApplication(Steinberg::FUnknown* unknown) override;
 
  private:
   void configureProcessor(const ProcessorConfig& config);
   ProcessorConfig processorConfig_{};
   std::unique_ptr<ear::plugin::MonitoringBackend> backend_;
-  std::unique_ptr<ear::plugin::MonitoringAudioProcessor> processor_;
+  // One per layout, each writing to the output channels after the last
+  std::vector<std::unique_ptr<ear::plugin::MonitoringAudioProcessor>>
+      processors_;
+  // With more than one layout, the input is overwritten by the first
+  // layout's output before the others have read it
+  AudioBuffer<float> inputCopy_;
 
   int samplerate_;
   int numDawChannels_{MAX_DAW_CHANNELS};
   int numOutputChannels_{0};
   std::shared_ptr<ear::plugin::LevelMeterCalculator> levelMeter_;
 
+  ear::plugin::ProcessingStats processingStats_{JucePlugin_Name};
+  const ear::plugin::ProcessingStats::StageId processBlockStage_{
+      processingStats_.addStage("processBlock")};
+  const ear::plugin::ProcessingStats::StageId gainsStage_{
+      processingStats_.addStage("gains handoff")};
+  const ear::plugin::ProcessingStats::StageId renderStage_{
+      processingStats_.addStage("render")};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EarMonitoringAudioProcessor)
 };
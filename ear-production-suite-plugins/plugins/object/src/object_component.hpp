@@ -21,6 +21,7 @@
 #include "value_box_panning.hpp"
 #include "value_box_panning_view.hpp"
 #include "components/version_label.hpp"
+#include "components/processing_stats_label.hpp"
 #include <memory>
 #include <optional>
 
@@ -44,6 +45,7 @@ class ObjectsComponent : public Component,
         extentValueBox(std::make_unique<ValueBoxExtent>()),
         panningViewValueBox(std::make_unique<ValueBoxPanningView>()),
         statusBarLabel(std::make_unique<Label>()),
+        processingStatsLabel(p->getProcessingStats()),
         propertiesFileLock(
             std::make_unique<InterProcessLock>("EPS_preferences")),
         propertiesFile(getPropertiesFile(propertiesFileLock.get())) {
@@ -90,6 +92,7 @@ class ObjectsComponent : public Component,
 
     configureVersionLabel(versionLabel);
     addAndMakeVisible(versionLabel);
+    addAndMakeVisible(processingStatsLabel);
 
     panningViewValueBox->getPannerTopView()->setAzimuth(p->getAzimuth()->get(),
                                                         dontSendNotification);
@@ -143,6 +146,8 @@ class ObjectsComponent : public Component,
     auto headingArea = area.removeFromTop(55);
     auto bottomLabelsArea = area.removeFromBottom(30);
     statusBarLabel->setBounds(bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
+    processingStatsLabel.setBounds(
+        bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
     versionLabel.setBounds(bottomLabelsArea);
     onBoardingButton->setBounds(
         headingArea.removeFromRight(39).removeFromBottom(39));
@@ -188,6 +193,7 @@ class ObjectsComponent : public Component,
   std::unique_ptr<ear::plugin::ui::ValueBoxPanningView> panningViewValueBox;
   std::shared_ptr<Label> statusBarLabel;
   Label versionLabel;
+  ProcessingStatsLabel processingStatsLabel;
 
   std::unique_ptr<InterProcessLock> propertiesFileLock;
   std::unique_ptr<PropertiesFile> propertiesFile;
@@ -135,10 +135,14 @@ bool ObjectsAudioProcessor::isBusesLayoutSupported(
 
 void ObjectsAudioProcessor::processBlock(AudioBuffer<float>& buffer,
                                          MidiBuffer& midiMessages) {
+  ear::plugin::ScopedStageTimer processBlockTimer(&processingStats_,
+                                                processBlockStage_);
   if(!bypass_->get()) {
     if(getActiveEditor()) {
       levelMeter_->process(buffer);
     }
+    ear::plugin::ScopedStageTimer metadataTimer(&processingStats_,
+                                                metadataStage_);
     backend_->triggerMetadataSend();
   }
 }
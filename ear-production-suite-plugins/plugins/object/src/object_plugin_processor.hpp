@@ -4,6 +4,7 @@
 
 #include <memory>
 #include "components/level_meter_calculator.hpp"
+#include "processing_stats.hpp"
 #include "communication/common_types.hpp"
 #include "reaper_vst3_interfaces.h"
 #include "components/read_only_audio_parameter_int.hpp"
@@ -77,6 +78,10 @@ class ObjectsAudioProcessor : public AudioProcessor, public VST3ClientExtensions
     return levelMeter_;
   };
 
+  ear::plugin::ProcessingStats* getProcessingStats() {
+    return &processingStats_;
+  }
+
   ear::plugin::ui::ObjectsJuceFrontendConnector* getFrontendConnector() {
     return connector_.get();
   }
@@ -116,5 +121,11 @@ class ObjectsAudioProcessor : public AudioProcessor, public VST3ClientExtensions
   int numDawChannels_{MAX_DAW_CHANNELS};
   std::shared_ptr<ear::plugin::LevelMeterCalculator> levelMeter_;
 
+  ear::plugin::ProcessingStats processingStats_{JucePlugin_Name};
+  const ear::plugin::ProcessingStats::StageId processBlockStage_{
+      processingStats_.addStage("processBlock")};
+  const ear::plugin::ProcessingStats::StageId metadataStage_{
+      processingStats_.addStage("metadata handoff")};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ObjectsAudioProcessor)
 };
@@ -29,7 +29,8 @@ SceneAudioProcessorEditor::SceneAudioProcessorEditor(SceneAudioProcessor* p)
           std::make_shared<MultipleScenePluginsOverlay>()),
       propertiesFileLock_(
           std::make_unique<InterProcessLock>("EPS_preferences")),
-      propertiesFile_(getPropertiesFile(propertiesFileLock_.get())) {
+      propertiesFile_(getPropertiesFile(propertiesFileLock_.get())),
+      processingStatsLabel(p->getProcessingStats()) {
   header_->setText(" Scene");
 
   onBoardingButton_->setButtonText("?");
@@ -72,6 +73,7 @@ SceneAudioProcessorEditor::SceneAudioProcessorEditor(SceneAudioProcessor* p)
 
   configureVersionLabel(versionLabel);
   addAndMakeVisible(versionLabel);
+  addAndMakeVisible(processingStatsLabel);
 
   p_->metadata().refresh();
 
@@ -100,6 +102,8 @@ void SceneAudioProcessorEditor::resized() {
   header_->setBounds(headingArea);
   area.removeFromTop(10);
   auto bottomLabelsArea = area.removeFromBottom(30);
+  processingStatsLabel.setBounds(
+      bottomLabelsArea.removeFromLeft(bottomLabelsArea.getWidth() / 2));
   versionLabel.setBounds(bottomLabelsArea);
   programmesContainer_->setBounds(area);
 }
@@ -9,6 +9,7 @@
 #include "components/onboarding.hpp"
 #include "components/overlay.hpp"
 #include "components/ear_header.hpp"
+#include "components/processing_stats_label.hpp"
 #include "items_container.hpp"
 #include "auto_mode_overlay.hpp"
 #include "multiple_scene_plugins_overlay.hpp"
@@ -46,6 +47,7 @@ class SceneAudioProcessorEditor
   std::unique_ptr<PropertiesFile> propertiesFile_;
 
   Label versionLabel;
+  ear::plugin::ui::ProcessingStatsLabel processingStatsLabel;
 
   // --- Onboarding::Listener
   void endButtonClicked(ear::plugin::ui::Onboarding* onboarding) override;
@@ -1,6 +1,7 @@
 #include "scene_plugin_processor.hpp"
 #include "scene_plugin_editor.hpp"
 #include <adm/write.hpp>
+#include <helper/adm_template_codec.h>
 #include "programme_store_adm_serializer.hpp"
 #include <programme_store.pb.h>
 #include "scene_backend.hpp"
@@ -132,10 +133,16 @@ bool SceneAudioProcessor::isBusesLayoutSupported(
 
 void SceneAudioProcessor::processBlock(AudioBuffer<float>& buffer,
                                        MidiBuffer& midiMessages) {
-
-  metadataThread_.post([this](){
-    backend_->triggerMetadataSend();
-  });
+  ear::plugin::ScopedStageTimer processBlockTimer(&processingStats_,
+                                                  processBlockStage_);
+
+  {
+    ear::plugin::ScopedStageTimer metadataTimer(&processingStats_,
+                                                metadataStage_);
+    metadataThread_.post([this](){
+      backend_->triggerMetadataSend();
+    });
+  }
   doSampleRateChecks();
 
   if(!sendSamplesToExtension) {
@@ -143,6 +150,7 @@ void SceneAudioProcessor::processBlock(AudioBuffer<float>& buffer,
       levelMeter_->process(buffer);
     }
   } else {
+    ear::plugin::ScopedStageTimer exportTimer(&processingStats_, exportStage_);
     size_t sampleSize = sizeof(float);
     uint8_t numChannels = MAX_DAW_CHANNELS;
     size_t msg_size = buffer.getNumSamples() * numChannels * sampleSize;
@@ -213,13 +221,8 @@ void SceneAudioProcessor::doSampleRateChecks() {
   }
 }
 
-void SceneAudioProcessor::sendAdmMetadata() {
-  ear::plugin::ProgrammeStoreAdmSerializer serializer{};
-  auto [adm, pluginMaps] =
-      serializer.serialize(metadata_.stores());
-
-  std::stringstream ss;
-  adm::writeXml(ss, adm);
+void SceneAudioProcessor::sendAdmMetadata(bool binary) {
+  auto [adm, pluginMaps] = admSerializer_.serialize(metadata_.stores());
 
   std::vector<PluginToAdmMap> pluginToAdmMaps;
   for(int i = 0; i < pluginMaps.size(); ++i) {
@@ -235,6 +238,18 @@ void SceneAudioProcessor::sendAdmMetadata() {
     pluginToAdmMaps.push_back(PluginToAdmMap{aoIdNum, atuIdNum, pluginMaps[i].inputInstanceId, pluginMaps[i].routing});
   }
 
+  if (binary) {
+    try {
+      commandSocket->sendBinaryAdmAndMappings(AdmTemplateCodec::encode(*adm),
+                                              std::move(pluginToAdmMaps));
+      return;
+    } catch (const AdmTemplateCodec::UnsupportedDocument&) {
+      // The extension takes an XML reply to either request
+    }
+  }
+
+  std::stringstream ss;
+  adm::writeXml(ss, adm);
   commandSocket->sendAdmAndMappings(ss.str(), std::move(pluginToAdmMaps));
 }
 
@@ -255,9 +270,11 @@ void SceneAudioProcessor::incomingMessage(std::shared_ptr<NngMsg> msg) {
     stopExport();
     commandSocket->sendResp(cmd);
 
-  } else if (cmd == commandSocket->Command::GetAdmAndMappings) {
-    auto future =
-        std::async(std::launch::async, [this]() { sendAdmMetadata(); });
+  } else if (cmd == commandSocket->Command::GetAdmAndMappings ||
+             cmd == commandSocket->Command::GetBinaryAdmAndMappings) {
+    bool binary = cmd == commandSocket->Command::GetBinaryAdmAndMappings;
+    auto future = std::async(std::launch::async,
+                             [this, binary]() { sendAdmMetadata(binary); });
     future.get();
 
   } else if (cmd == commandSocket->Command::GetConfig) {
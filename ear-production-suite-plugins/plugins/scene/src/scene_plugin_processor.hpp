@@ -4,8 +4,10 @@
 #include "JuceHeader.h"
 #include "helper/nng_wrappers.h"
 #include "store_metadata.hpp"
+#include "programme_store_adm_serializer.hpp"
 #include "components/read_only_audio_parameter_int.hpp"
 #include "components/level_meter_calculator.hpp"
+#include "processing_stats.hpp"
 #include "backend_setup_timer.hpp"
 #include "ui_event_dispatcher.hpp"
 #include "communication/metadata_thread.hpp"
@@ -61,6 +63,10 @@ class SceneAudioProcessor : public AudioProcessor, public VST3ClientExtensions {
     return levelMeter_;
   };
 
+  ear::plugin::ProcessingStats* getProcessingStats() {
+    return &processingStats_;
+  }
+
   void setupBackend();
 
   void setIHostApplication(Steinberg::FUnknown* unknown) override;
@@ -69,7 +75,8 @@ class SceneAudioProcessor : public AudioProcessor, public VST3ClientExtensions {
 
  private:
   void doSampleRateChecks();
-  void sendAdmMetadata();
+  // binary sends the template from AdmTemplateCodec where it can, else XML
+  void sendAdmMetadata(bool binary);
   void recvAdmMetadata(std::string admStr, std::vector<PluginToAdmMap> pluginToAdmMaps);
   void startExport();
   void stopExport();
@@ -79,6 +86,8 @@ class SceneAudioProcessor : public AudioProcessor, public VST3ClientExtensions {
   std::shared_ptr<ear::plugin::PendingStore> pendingStore_;
   std::shared_ptr<ear::plugin::RestoredPendingStore> restoredStore_;
   std::shared_ptr<ear::plugin::AutoModeController> autoModeController_;
+  // Kept between exports so an unchanged session isn't serialized again
+  ear::plugin::ProgrammeStoreAdmSerializer admSerializer_;
 
   ReadOnlyAudioParameterInt* commandPort;
   ReadOnlyAudioParameterInt* samplesPort;
@@ -91,5 +100,13 @@ class SceneAudioProcessor : public AudioProcessor, public VST3ClientExtensions {
   std::shared_ptr<ear::plugin::LevelMeterCalculator> levelMeter_;
   std::unique_ptr<ear::plugin::BackendSetupTimer> backendSetupTimer_;
 
+  ear::plugin::ProcessingStats processingStats_{JucePlugin_Name};
+  const ear::plugin::ProcessingStats::StageId processBlockStage_{
+      processingStats_.addStage("processBlock")};
+  const ear::plugin::ProcessingStats::StageId metadataStage_{
+      processingStats_.addStage("metadata handoff")};
+  const ear::plugin::ProcessingStats::StageId exportStage_{
+      processingStats_.addStage("export samples")};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SceneAudioProcessor)
 };
@@ -0,0 +1,80 @@
+#include <catch2/catch_all.hpp>
+#include <adm/adm.hpp>
+#include <helper/adm_preset_definitions_helper.h>
+
+namespace {
+
+int countChannelFormats(adm::AudioPackFormat const& packFormat) {
+  int count = static_cast<int>(
+      packFormat.getReferences<adm::AudioChannelFormat>().size());
+  for (auto const& subPackFormat :
+       packFormat.getReferences<adm::AudioPackFormat>()) {
+    count += countChannelFormats(*subPackFormat);
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST_CASE("Preset definition tables cover all six type definitions") {
+  auto& helper = AdmPresetDefinitionsHelper::getSingleton();
+  for (int td = 0; td <= 5; ++td) {
+    auto tdData = helper.getTypeDefinitionData(td);
+    REQUIRE(tdData);
+    CHECK(tdData->id == td);
+    CHECK(tdData->typeDescriptor.get() == td);
+  }
+  CHECK_FALSE(helper.getTypeDefinitionData(1)->relatedPackFormats.empty());
+  CHECK_FALSE(helper.getTypeDefinitionData(4)->relatedPackFormats.empty());
+}
+
+TEST_CASE("Preset definition tables match the definitions document") {
+  auto& helper = AdmPresetDefinitionsHelper::getSingleton();
+  for (auto const& tdData : helper.getElementRelationships()) {
+    REQUIRE(tdData);
+    for (auto const& pfData : tdData->relatedPackFormats) {
+      INFO(pfData->fullId);
+      auto packFormat = pfData->getPackFormat();
+      REQUIRE(packFormat);
+      CHECK(adm::formatId(packFormat->get<adm::AudioPackFormatId>()) ==
+            pfData->fullId);
+      CHECK(packFormat->get<adm::AudioPackFormatName>().get() ==
+            pfData->name);
+      CHECK(countChannelFormats(*packFormat) ==
+            static_cast<int>(pfData->relatedChannelFormats.size()));
+
+      for (auto const& cfData : pfData->relatedChannelFormats) {
+        INFO(cfData->fullId);
+        auto channelFormat = cfData->getChannelFormat();
+        REQUIRE(channelFormat);
+        CHECK(adm::formatId(channelFormat->get<adm::AudioChannelFormatId>()) ==
+              cfData->fullId);
+
+        if (tdData->id == adm::TypeDefinition::HOA.get()) {
+          auto blocks = channelFormat->getElements<adm::AudioBlockFormatHoa>();
+          REQUIRE(blocks.size() > 0);
+          CHECK(cfData->hoaOrder == blocks[0].get<adm::Order>().get());
+          CHECK(cfData->hoaDegree == blocks[0].get<adm::Degree>().get());
+          CHECK(cfData->hoaNormalization ==
+                blocks[0].get<adm::Normalization>().get());
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Preset definition tables hold direct speakers positions and labels") {
+  // AP_00010002 is 0+2+0 - L then R
+  auto pfData =
+      AdmPresetDefinitionsHelper::getSingleton().getPackFormatData(1, 2);
+  REQUIRE(pfData);
+  REQUIRE(pfData->relatedChannelFormats.size() == 2);
+  auto left = pfData->relatedChannelFormats[0];
+  CHECK(left->getBestSpeakerLabel() == "L");
+  CHECK(left->azimuth == Catch::Approx(30.f));
+  CHECK_FALSE(left->isLfe);
+  CHECK_FALSE(left->speakerLabels.empty());
+  auto right = pfData->relatedChannelFormats[1];
+  CHECK(right->getBestSpeakerLabel() == "R");
+  CHECK(right->azimuth == Catch::Approx(-30.f));
+}
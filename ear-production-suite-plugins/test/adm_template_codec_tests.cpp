@@ -0,0 +1,214 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <sstream>
+#include <programme_store.pb.h>
+#include <programme_store_adm_serializer.hpp>
+#include <helper/adm_template_codec.h>
+#include <adm/adm.hpp>
+#include <adm/write.hpp>
+
+using namespace ear::plugin;
+using namespace ear::plugin::communication;
+using namespace ear::plugin::proto;
+
+namespace {
+
+std::string toXml(std::shared_ptr<adm::Document> const& doc) {
+  std::stringstream ss;
+  adm::writeXml(ss, doc);
+  return ss.str();
+}
+
+class Scene {
+ public:
+  ConnectionId addObject(std::string const& name, int routing) {
+    auto& item = addItem(name, routing);
+    item.mutable_obj_metadata();
+    return ConnectionId{item.connection_id()};
+  }
+
+  ConnectionId addDirectSpeakers(std::string const& name, int routing,
+                                 int packFormatIdValue) {
+    auto& item = addItem(name, routing);
+    item.mutable_ds_metadata()->set_packformatidvalue(packFormatIdValue);
+    return ConnectionId{item.connection_id()};
+  }
+
+  Programme& addProgramme(std::string const& name) {
+    auto programme = stores_.first.add_programme();
+    programme->set_name(name);
+    return *programme;
+  }
+
+  std::pair<std::shared_ptr<adm::Document>,
+            std::vector<ProgrammeStoreAdmSerializer::PluginMap>>
+  serialize() const {
+    ProgrammeStoreAdmSerializer serializer;
+    return serializer.serialize(stores_);
+  }
+
+ private:
+  InputItemMetadata& addItem(std::string const& name, int routing) {
+    auto id = ConnectionId::generate();
+    auto& item = stores_.second[id];
+    item.set_connection_id(id.string());
+    item.set_name(name);
+    item.set_routing(routing);
+    item.set_input_instance_id(routing + 1);
+    return item;
+  }
+
+  std::pair<ProgrammeStore, ItemMap> stores_;
+};
+
+Object& addObject(Programme& programme, ConnectionId const& id) {
+  auto object = programme.add_element()->mutable_object();
+  object->set_connection_id(id.string());
+  return *object;
+}
+
+}  // namespace
+
+TEST_CASE("ADM template survives binary encoding") {
+  Scene scene;
+  auto dialogue = scene.addObject("Dialogue", 0);
+  auto commentary = scene.addObject("Commentary", 1);
+  auto bed = scene.addDirectSpeakers("Bed", 2, 0x0003);  // 0+5+0
+
+  auto& main = scene.addProgramme("Main");
+  main.set_language("eng");
+  auto& dialogueObject = addObject(main, dialogue);
+  dialogueObject.set_importance(8);
+  dialogueObject.mutable_interactive_on_off()->set_enabled(true);
+  auto gain = dialogueObject.mutable_interactive_gain();
+  gain->set_enabled(true);
+  gain->set_min(0.5f);
+  gain->set_max(2.f);
+  auto position = dialogueObject.mutable_interactive_position();
+  position->set_enabled(true);
+  position->set_min_az(-30.f);
+  position->set_max_az(30.f);
+  position->set_min_el(0.f);
+  position->set_max_el(15.f);
+  addObject(main, bed);
+
+  auto& alternative = scene.addProgramme("Alternative");
+  auto toggle = alternative.add_element()->mutable_toggle();
+  toggle->add_element()->mutable_object()->set_connection_id(
+      dialogue.string());
+  toggle->add_element()->mutable_object()->set_connection_id(
+      commentary.string());
+  toggle->set_default_element_index(0);
+  addObject(alternative, bed);
+
+  auto [original, pluginMaps] = scene.serialize();
+  auto encoded = AdmTemplateCodec::encode(*original);
+  REQUIRE(AdmTemplateCodec::isEncoded(encoded));
+  auto decoded = AdmTemplateCodec::decode(encoded);
+
+  SECTION("same document") {
+    CHECK(toXml(decoded) == toXml(original));
+  }
+
+  SECTION("plugin map IDs still resolve") {
+    REQUIRE(!pluginMaps.empty());
+    for (auto const& pluginMap : pluginMaps) {
+      auto audioObject = decoded->lookup(
+          pluginMap.audioObject->get<adm::AudioObjectId>());
+      REQUIRE(audioObject);
+      CHECK(audioObject->get<adm::AudioObjectName>() ==
+            pluginMap.audioObject->get<adm::AudioObjectName>());
+      CHECK(decoded->lookup(
+          pluginMap.audioTrackUid->get<adm::AudioTrackUidId>()));
+    }
+  }
+
+  SECTION("smaller than XML") {
+    CHECK(encoded.size() < toXml(original).size());
+  }
+}
+
+TEST_CASE("Encoded ADM template rejects bad data") {
+  Scene scene;
+  auto id = scene.addObject("Object", 0);
+  addObject(scene.addProgramme("Programme"), id);
+  auto encoded = AdmTemplateCodec::encode(*scene.serialize().first);
+
+  SECTION("XML is not mistaken for an encoded template") {
+    auto xml = toXml(scene.serialize().first);
+    CHECK_FALSE(AdmTemplateCodec::isEncoded(xml));
+    CHECK_THROWS_AS(AdmTemplateCodec::decode(xml), std::runtime_error);
+  }
+
+  SECTION("truncated data throws") {
+    for (auto size : {encoded.size() - 1, encoded.size() / 2, std::size_t{6}}) {
+      CHECK_THROWS_AS(AdmTemplateCodec::decode(encoded.substr(0, size)),
+                      std::runtime_error);
+    }
+  }
+}
+
+TEST_CASE("Encoded ADM template keeps interaction ranges as libadm holds them") {
+  auto document = adm::Document::create();
+  auto object = adm::AudioObject::create(adm::AudioObjectName("Object"));
+  auto interaction =
+      adm::AudioObjectInteraction{adm::OnOffInteract{false}};
+  interaction.set(adm::GainInteract{true});
+  // Neither is exactly representable as a float
+  interaction.set(adm::GainInteractionRange{
+      adm::GainInteractionMin{adm::Gain::fromLinear(0.1)},
+      adm::GainInteractionMax{adm::Gain::fromDb(3.3)}});
+  object->set(interaction);
+  document->add(object);
+
+  auto decoded = AdmTemplateCodec::decode(AdmTemplateCodec::encode(*document));
+  auto decodedObjects = decoded->getElements<adm::AudioObject>();
+  REQUIRE(decodedObjects.size() == 1);
+  auto range = decodedObjects.front()
+                   ->get<adm::AudioObjectInteraction>()
+                   .get<adm::GainInteractionRange>();
+  auto min = range.get<adm::GainInteractionMin>().get();
+  auto max = range.get<adm::GainInteractionMax>().get();
+  CHECK_FALSE(min.isDb());
+  CHECK(min.asLinear() == 0.1);
+  CHECK(max.isDb());
+  CHECK(max.asDb() == 3.3);
+}
+
+TEST_CASE("Encoded ADM template refuses what it can't carry") {
+  auto document = adm::Document::create();
+  auto object = adm::AudioObject::create(adm::AudioObjectName("Object"));
+  document->add(object);
+
+  SECTION("object timing") {
+    object->set(adm::Start{std::chrono::nanoseconds{1000000000}});
+    CHECK_THROWS_AS(AdmTemplateCodec::encode(*document),
+                    AdmTemplateCodec::UnsupportedDocument);
+    object->unset<adm::Start>();
+    object->set(adm::Duration{std::chrono::nanoseconds{1000000000}});
+    CHECK_THROWS_AS(AdmTemplateCodec::encode(*document),
+                    AdmTemplateCodec::UnsupportedDocument);
+  }
+
+  SECTION("object gain") {
+    object->set(adm::Gain::fromDb(-6.0));
+    CHECK_THROWS_AS(AdmTemplateCodec::encode(*document),
+                    AdmTemplateCodec::UnsupportedDocument);
+  }
+
+  SECTION("block formats of local channel formats") {
+    auto packFormat = adm::AudioPackFormat::create(
+        adm::AudioPackFormatName("Pack"), adm::TypeDefinition::OBJECTS);
+    auto channelFormat = adm::AudioChannelFormat::create(
+        adm::AudioChannelFormatName("Channel"), adm::TypeDefinition::OBJECTS);
+    packFormat->addReference(channelFormat);
+    document->add(packFormat);
+    object->addReference(packFormat);
+    CHECK_NOTHROW(AdmTemplateCodec::encode(*document));
+
+    channelFormat->add(adm::AudioBlockFormatObjects{
+        adm::SphericalPosition{adm::Azimuth{30.0}}});
+    CHECK_THROWS_AS(AdmTemplateCodec::encode(*document),
+                    AdmTemplateCodec::UnsupportedDocument);
+  }
+}
@@ -0,0 +1,183 @@
+#include "binaural_monitoring_audio_processor.hpp"
+#include <catch2/catch_all.hpp>
+#include <ear/metadata.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+namespace test {
+
+// Separately allocated channels, as hosts hand them over
+struct ChannelBuffer {
+  ChannelBuffer(std::size_t channelCount, std::size_t frames)
+      : samples(channelCount, std::vector<float>(frames)) {
+    for (auto& channel : samples) {
+      pointers.push_back(channel.data());
+    }
+  }
+  std::vector<std::vector<float>> samples;
+  std::vector<float*> pointers;
+};
+
+}  // namespace test
+
+template <>
+struct BufferTraits<test::ChannelBuffer> {
+  using Buffer = test::ChannelBuffer;
+  using SampleType = float;
+  static Eigen::Index channelCount(const Buffer& b) {
+    return static_cast<Eigen::Index>(b.samples.size());
+  }
+  static Eigen::Index size(const Buffer& b) {
+    return b.samples.empty() ? 0
+                             : static_cast<Eigen::Index>(b.samples[0].size());
+  }
+  static SampleType* getChannel(Buffer& b, std::size_t n) {
+    return b.pointers[n];
+  }
+  static const SampleType* getChannel(const Buffer& b, std::size_t n) {
+    return b.pointers[n];
+  }
+  static SampleType** getChannels(Buffer& b) { return b.pointers.data(); }
+  static SampleType* const* getChannels(const Buffer& b) {
+    return b.pointers.data();
+  }
+};
+
+}  // namespace plugin
+}  // namespace ear
+
+using namespace ear;
+using namespace ear::plugin;
+
+namespace {
+
+constexpr std::size_t SAMPLE_RATE = 48000;
+constexpr std::size_t BLOCK_SIZE = 512;
+constexpr std::size_t BLOCKS = 8;
+// Room for two 1st order streams
+constexpr std::size_t CHANNELS = 8;
+
+using Stereo = std::vector<std::vector<float>>;
+using Fill = std::function<float(std::size_t channel, std::size_t sample)>;
+
+struct Stream {
+  std::size_t startingChannel;
+  HOATypeMetadata metadata;
+};
+
+HOATypeMetadata firstOrder(std::string const& normalization) {
+  HOATypeMetadata metadata;
+  metadata.orders = {0, 1, 1, 1};
+  metadata.degrees = {0, -1, 0, 1};
+  metadata.normalization = normalization;
+  return metadata;
+}
+
+// A different tone on each channel
+float tone(std::size_t channel, std::size_t sample) {
+  return 0.25f * std::sin(0.01f * static_cast<float>((channel + 1) * sample));
+}
+
+// Pushes `streams` every block, as the plugin does during playback
+Stereo render(std::vector<Stream> const& streams, std::size_t bearHoaChannels,
+              Fill const& fill) {
+  BinauralMonitoringAudioProcessor processor(0, 0, CHANNELS, SAMPLE_RATE,
+                                             BLOCK_SIZE, BEAR_DATA_FILE_PATH);
+  REQUIRE(processor.rendererStarted());
+  processor.updateChannelCounts(0, 0, bearHoaChannels);
+  processor.setIsPlaying(true);
+
+  test::ChannelBuffer buffer(CHANNELS, BLOCK_SIZE);
+  Stereo output(2);
+  for (std::size_t block = 0; block < BLOCKS; ++block) {
+    for (std::size_t channel = 0; channel < CHANNELS; ++channel) {
+      for (std::size_t sample = 0; sample < BLOCK_SIZE; ++sample) {
+        buffer.samples[channel][sample] =
+            fill(channel, block * BLOCK_SIZE + sample);
+      }
+    }
+    processor.checkSilence(buffer);
+    for (std::size_t stream = 0; stream < streams.size(); ++stream) {
+      REQUIRE(processor.pushBearMetadata(streams[stream].startingChannel,
+                                         &streams[stream].metadata, stream));
+    }
+    // Output is written over the first two channels
+    processor.process(buffer, buffer);
+    for (std::size_t channel = 0; channel < 2; ++channel) {
+      output[channel].insert(output[channel].end(),
+                             buffer.samples[channel].begin(),
+                             buffer.samples[channel].end());
+    }
+  }
+  return output;
+}
+
+float peak(Stereo const& signal) {
+  float result = 0.f;
+  for (auto const& channel : signal) {
+    for (auto sample : channel) {
+      result = std::max(result, std::abs(sample));
+    }
+  }
+  return result;
+}
+
+float maxDifference(Stereo const& a, Stereo const& b) {
+  float result = 0.f;
+  for (std::size_t channel = 0; channel < 2; ++channel) {
+    for (std::size_t sample = 0; sample < a[channel].size(); ++sample) {
+      result =
+          std::max(result, std::abs(a[channel][sample] - b[channel][sample]));
+    }
+  }
+  return result;
+}
+
+Stereo add(Stereo a, Stereo const& b) {
+  for (std::size_t channel = 0; channel < 2; ++channel) {
+    for (std::size_t sample = 0; sample < a[channel].size(); ++sample) {
+      a[channel][sample] += b[channel][sample];
+    }
+  }
+  return a;
+}
+
+}  // namespace
+
+TEST_CASE("Binaural HOA streams of the same format render as their sum") {
+  auto sn3d = firstOrder("SN3D");
+  auto separate = render({{0, sn3d}, {4, sn3d}}, 4, tone);
+  auto summed =
+      render({{0, sn3d}}, 4, [](std::size_t channel, std::size_t sample) {
+        return channel < 4 ? tone(channel, sample) + tone(channel + 4, sample)
+                           : 0.f;
+      });
+  REQUIRE(peak(summed) > 1e-3f);
+  CHECK(maxDifference(separate, summed) < 1e-4f * peak(summed));
+}
+
+TEST_CASE("Binaural HOA streams of different formats keep separate buses") {
+  auto sn3d = firstOrder("SN3D");
+  auto n3d = firstOrder("N3D");
+  auto both = render({{0, sn3d}, {4, n3d}}, 8, tone);
+  auto first =
+      render({{0, sn3d}}, 8, [](std::size_t channel, std::size_t sample) {
+        return channel < 4 ? tone(channel, sample) : 0.f;
+      });
+  auto second =
+      render({{4, n3d}}, 8, [](std::size_t channel, std::size_t sample) {
+        return channel >= 4 ? tone(channel, sample) : 0.f;
+      });
+  auto expected = add(first, second);
+  REQUIRE(peak(expected) > 1e-3f);
+  CHECK(maxDifference(both, expected) < 1e-4f * peak(expected));
+
+  // Which it wouldn't if the second were rendered as the first's format
+  auto merged = render({{0, sn3d}, {4, sn3d}}, 8, tone);
+  CHECK(maxDifference(merged, expected) > 1e-2f * peak(expected));
+}
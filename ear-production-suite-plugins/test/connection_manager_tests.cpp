@@ -92,6 +92,58 @@ TEST_CASE("Scene Master Connection Manager - Input plugin") {
   REQUIRE(std::get<1>(notifications[1]) == helloResponse.connectionId());
 }
 
+TEST_CASE("Scene Master Connection Manager - Register inputs") {
+  using namespace ear::plugin;
+  using namespace ear::plugin::communication;
+  SceneConnectionManager manager;
+
+  using Notification = std::tuple<SceneConnectionManager::Event, ConnectionId>;
+  std::vector<Notification> notifications;
+
+  manager.setEventHandler(
+      [&notifications](SceneConnectionManager::Event event, ConnectionId id) {
+        notifications.push_back({event, id});
+      });
+
+  auto restoredId = ConnectionId::generate();
+  RegisterInputsMessage registerRequest{
+      {restoredId, ConnectionId{}, ConnectionId::generate()}};
+  auto registerResponse =
+      manager.handle(registerRequest).payloadAs<RegisterInputsResponse>();
+  auto const& ids = registerResponse.connectionIds();
+  REQUIRE(ids.size() == 3);
+  REQUIRE(ids[0] == restoredId);
+  REQUIRE(ids[1].isValid());
+
+  REQUIRE(notifications.size() == 3);
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    REQUIRE(std::get<0>(notifications[i]) ==
+            SceneConnectionManager::Event::INPUT_ADDED);
+    REQUIRE(std::get<1>(notifications[i]) == ids[i]);
+  }
+
+  SECTION("registered inputs are already configured") {
+    ObjectDetailsMessage detailsRequest{ids[0]};
+    REQUIRE(manager.handle(detailsRequest).errorCode() != ErrorCode::NO_ERROR);
+  }
+
+  SECTION("an id already in use is replaced") {
+    RegisterInputsMessage again{{restoredId}};
+    auto againResponse =
+        manager.handle(again).payloadAs<RegisterInputsResponse>();
+    REQUIRE(againResponse.connectionIds().size() == 1);
+    REQUIRE(againResponse.connectionIds().front() != restoredId);
+  }
+
+  SECTION("registered inputs can close") {
+    CloseConnectionMessage byeRequest{ids[2]};
+    manager.handle(byeRequest).payloadAs<CloseConnectionResponse>();
+    REQUIRE(std::get<0>(notifications.back()) ==
+            SceneConnectionManager::Event::INPUT_REMOVED);
+    REQUIRE(std::get<1>(notifications.back()) == ids[2]);
+  }
+}
+
 TEST_CASE("Scene Master Connection Manager - Monitoring plugin") {
   using namespace ear::plugin;
   using namespace ear::plugin::communication;
@@ -0,0 +1,159 @@
+#include <catch2/catch_all.hpp>
+#include "communication/data_wrapper.hpp"
+#include "communication/keep_alive_scheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace ear::plugin;
+using namespace ear::plugin::communication;
+using namespace std::chrono_literals;
+
+namespace {
+
+template <typename PredicateT>
+bool waitFor(PredicateT&& predicate) {
+  auto deadline = std::chrono::steady_clock::now() + 2s;
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+// Sets the flag as the thread that last called notifyOnExit() exits
+struct ThreadExit {
+  std::atomic<bool>* exited{nullptr};
+  ~ThreadExit() {
+    if (exited) {
+      *exited = true;
+    }
+  }
+};
+
+void notifyOnExit(std::atomic<bool>& exited) {
+  thread_local ThreadExit threadExit;
+  threadExit.exited = &exited;
+}
+
+}  // namespace
+
+TEST_CASE("Keep-alive scheduler runs tasks each tick") {
+  KeepAliveScheduler scheduler{5ms};
+  std::atomic<int> firstCalls{0};
+  std::atomic<int> secondCalls{0};
+  std::atomic<std::uint64_t> lastTick{0};
+  auto first = scheduler.add([&](std::uint64_t tick) {
+    CHECK(tick > lastTick.load());
+    lastTick.store(tick);
+    ++firstCalls;
+  });
+  auto second = scheduler.add([&](std::uint64_t) { ++secondCalls; });
+
+  REQUIRE(waitFor([&]() { return firstCalls >= 3 && secondCalls >= 3; }));
+
+  SECTION("not after removal") {
+    scheduler.remove(first);
+    auto callsAtRemoval = firstCalls.load();
+    auto secondCallsAtRemoval = secondCalls.load();
+    REQUIRE(waitFor([&]() { return secondCalls >= secondCallsAtRemoval + 3; }));
+    CHECK(firstCalls == callsAtRemoval);
+    scheduler.remove(second);
+  }
+
+  SECTION("again after all tasks were removed") {
+    scheduler.remove(first);
+    scheduler.remove(second);
+    std::atomic<int> calls{0};
+    auto third = scheduler.add([&](std::uint64_t) { ++calls; });
+    CHECK(waitFor([&]() { return calls >= 2; }));
+    scheduler.remove(third);
+  }
+}
+
+TEST_CASE("Keep-alive scheduler removes tasks while another is blocked") {
+  KeepAliveScheduler scheduler{5ms};
+  std::atomic<bool> entered{false};
+  std::atomic<bool> released{false};
+  std::atomic<bool> finished{false};
+  auto blocking = scheduler.add([&](std::uint64_t) {
+    if (!entered.exchange(true)) {
+      waitFor([&]() { return released.load(); });
+      finished = true;
+    }
+  });
+  std::atomic<int> calls{0};
+  auto other = scheduler.add([&](std::uint64_t) { ++calls; });
+  REQUIRE(waitFor([&]() { return entered.load(); }));
+
+  scheduler.remove(other);
+  CHECK_FALSE(finished);
+  released = true;
+  scheduler.remove(blocking);
+  CHECK(finished);
+}
+
+TEST_CASE("Keep-alive scheduler thread exits with the last task") {
+  KeepAliveScheduler scheduler{5ms};
+  std::atomic<bool> exited{false};
+  std::atomic<int> calls{0};
+  auto first = scheduler.add([&](std::uint64_t) {
+    notifyOnExit(exited);
+    ++calls;
+  });
+  auto second = scheduler.add([&](std::uint64_t) {});
+  REQUIRE(waitFor([&]() { return calls >= 1; }));
+
+  scheduler.remove(first);
+  CHECK_FALSE(exited);
+  // Joined before remove() returns, leaving the destructor nothing to join
+  scheduler.remove(second);
+  CHECK(exited);
+
+  SECTION("and a new thread starts with the next task") {
+    std::atomic<bool> nextExited{false};
+    std::atomic<int> nextCalls{0};
+    auto next = scheduler.add([&](std::uint64_t) {
+      notifyOnExit(nextExited);
+      ++nextCalls;
+    });
+    REQUIRE(waitFor([&]() { return nextCalls >= 2; }));
+    CHECK_FALSE(nextExited);
+    scheduler.remove(next);
+    CHECK(nextExited);
+  }
+}
+
+TEST_CASE("Heartbeat carries only the item's version") {
+  DataWrapper data{[](proto::InputItemMetadata* item) {
+    item->set_connection_id(ConnectionId::generate().string());
+    item->set_name("A rather long input name, to pad out the metadata");
+    item->mutable_obj_metadata();
+  }};
+  auto full = data.prepareMessage();
+  auto parseBuffer = [](MessageBuffer const& buffer) {
+    proto::InputItemMetadata item;
+    REQUIRE(item.ParseFromArray(buffer.data(), buffer.size()));
+    return item;
+  };
+  auto sent = parseBuffer(full);
+
+  auto heartbeat = parseBuffer(data.prepareHeartbeat());
+  CHECK(heartbeat.heartbeat());
+  CHECK_FALSE(heartbeat.changed());
+  CHECK(heartbeat.connection_id() == sent.connection_id());
+  CHECK(heartbeat.continuity_counter() == sent.continuity_counter());
+  CHECK_FALSE(heartbeat.has_name());
+  CHECK_FALSE(heartbeat.has_obj_metadata());
+  CHECK(data.prepareHeartbeat().size() < full.size());
+
+  SECTION("writes move the version on") {
+    data.writeAccess([](proto::InputItemMetadata* item) {
+      item->set_routing(3);
+    });
+    CHECK(parseBuffer(data.prepareHeartbeat()).continuity_counter() !=
+          sent.continuity_counter());
+  }
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_all.hpp>
+#include "listener_orientation_track.hpp"
+#include <cmath>
+
+using namespace ear::plugin;
+using namespace std::chrono_literals;
+using Quaternion = ListenerOrientationTrack::Quaternion;
+
+namespace {
+
+Quaternion yaw(double degrees) {
+  auto halfRadians = degrees * 3.141592653589793 / 360.0;
+  return Quaternion{std::cos(halfRadians), 0.0, 0.0, std::sin(halfRadians)};
+}
+
+double yawOf(Quaternion const& q) {
+  return 2.0 * std::atan2(q.z, q.w) * 180.0 / 3.141592653589793;
+}
+
+}  // namespace
+
+TEST_CASE("Listener orientation track") {
+  ListenerOrientationTrack track;
+  auto const start = ListenerOrientationTrack::Clock::now();
+
+  SECTION("is empty until samples are taken in") {
+    REQUIRE(track.push(yaw(10.0), start));
+    CHECK_FALSE(track.orientationAt(start).has_value());
+    track.update();
+    REQUIRE(track.orientationAt(start).has_value());
+    CHECK(yawOf(*track.orientationAt(start)) == Catch::Approx(10.0));
+    CHECK(track.latestReceived() == start);
+  }
+
+  SECTION("extrapolates the latest movement") {
+    track.push(yaw(0.0), start);
+    track.push(yaw(10.0), start + 10ms);
+    track.update();
+    CHECK(yawOf(*track.orientationAt(start + 10ms)) == Catch::Approx(10.0));
+    CHECK(yawOf(*track.orientationAt(start + 15ms)) == Catch::Approx(15.0));
+
+    SECTION("only so far, then back to the latest sample") {
+      auto limit = start + 10ms + ListenerOrientationTrack::MAX_EXTRAPOLATION;
+      CHECK(yawOf(*track.orientationAt(limit)) == Catch::Approx(110.0));
+      auto decayed = limit + ListenerOrientationTrack::EXTRAPOLATION_DECAY;
+      CHECK(yawOf(*track.orientationAt(
+                limit + ListenerOrientationTrack::EXTRAPOLATION_DECAY / 2)) ==
+            Catch::Approx(60.0));
+      CHECK(yawOf(*track.orientationAt(decayed)) == Catch::Approx(10.0));
+      CHECK(yawOf(*track.orientationAt(decayed + 50ms)) == Catch::Approx(10.0));
+    }
+
+    SECTION("ahead by the prediction") {
+      track.setPrediction(5ms);
+      CHECK(yawOf(*track.orientationAt(start + 10ms)) == Catch::Approx(15.0));
+    }
+
+    SECTION("ahead by predictions longer than MAX_EXTRAPOLATION") {
+      track.setPrediction(150ms);
+      CHECK(yawOf(*track.orientationAt(start + 10ms)) == Catch::Approx(160.0));
+    }
+
+    SECTION("not from samples too close together") {
+      // e.g. a tracker sending yaw, pitch and roll separately
+      track.push(yaw(12.0), start + 11ms);
+      track.update();
+      // So from 0 at 0ms to 12 at 11ms
+      CHECK(yawOf(*track.orientationAt(start + 22ms)) == Catch::Approx(24.0));
+    }
+  }
+
+  SECTION("is ignored once stale") {
+    track.push(yaw(10.0), start);
+    track.update();
+    CHECK(track.orientationAt(start + ListenerOrientationTrack::STALE_AFTER)
+              .has_value());
+    CHECK_FALSE(track
+                    .orientationAt(start + ListenerOrientationTrack::STALE_AFTER +
+                                   1ms)
+                    .has_value());
+  }
+
+  SECTION("drops samples once the ring is full") {
+    ListenerOrientationTrack small{2};
+    bool allPushed = true;
+    for (int i = 0; i < 16; ++i) {
+      allPushed = small.push(yaw(i), start + i * 10ms) && allPushed;
+    }
+    CHECK_FALSE(allPushed);
+    small.update();
+    CHECK(small.orientationAt(start).has_value());
+  }
+}
+
+TEST_CASE("Listener orientation slerp takes the shortest path") {
+  auto from = yaw(170.0);
+  auto to = yaw(-170.0);
+  // The same rotation as yaw(-170), on the other side of the hypersphere
+  to = Quaternion{-to.w, -to.x, -to.y, -to.z};
+  auto halfway = ListenerOrientationTrack::slerp(from, yaw(-170.0), 0.5);
+  CHECK(std::abs(yawOf(halfway)) == Catch::Approx(180.0));
+  auto flipped = ListenerOrientationTrack::slerp(from, to, 0.5);
+  CHECK(std::abs(yawOf(flipped)) == Catch::Approx(180.0));
+}
+
+TEST_CASE("Listener orientation smoother") {
+  // 5 ms periods, tracking smoothed over 5 ms and handed back over 250 ms
+  ListenerOrientationSmoother smoother{0.005, 0.005, 0.25};
+  auto const manual = yaw(0.0);
+
+  SECTION("applies the manual orientation straight away without a track") {
+    CHECK(yawOf(smoother.next(std::nullopt, manual)) == Catch::Approx(0.0));
+    CHECK(yawOf(smoother.next(std::nullopt, yaw(30.0))) == Catch::Approx(30.0));
+    CHECK_FALSE(smoother.following());
+  }
+
+  SECTION("follows the track, easing in corrections") {
+    CHECK(yawOf(smoother.next(yaw(40.0), manual)) == Catch::Approx(40.0));
+    CHECK(smoother.following());
+    auto corrected = yawOf(smoother.next(yaw(50.0), manual));
+    CHECK(corrected > 40.0);
+    CHECK(corrected < 50.0);
+  }
+
+  SECTION("hands back to the manual orientation gradually") {
+    smoother.next(yaw(90.0), manual);
+    double previous = 90.0;
+    bool gradual = true;
+    int periods = 0;
+    while (smoother.following() && periods < 2000) {
+      auto current = yawOf(smoother.next(std::nullopt, manual));
+      gradual = gradual && current < previous && previous - current < 5.0;
+      previous = current;
+      ++periods;
+    }
+    CHECK(gradual);
+    CHECK_FALSE(smoother.following());
+    CHECK(previous == Catch::Approx(0.0).margin(1e-9));
+    // Several hand-back time constants, not a jump
+    CHECK(periods > 100);
+    CHECK(periods < 2000);
+  }
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_all.hpp>
+#include "detail/async_log_sink.hpp"
+#include <spdlog/logger.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ear::plugin;
+using namespace std::chrono_literals;
+
+namespace {
+
+void setLogFile(const std::string& path) {
+#ifdef _WIN32
+  _putenv_s("EPS_LOG_FILE", path.c_str());
+#else
+  setenv("EPS_LOG_FILE", path.c_str(), 1);
+#endif
+}
+
+// Everything logged by fn, as written to the EPS_LOG_FILE file. The backend
+// stops with the logger, reading all that was queued first.
+std::vector<std::string> logToFile(
+    const std::function<void(spdlog::logger&)>& fn) {
+  auto path =
+      (std::filesystem::temp_directory_path() / "eps_log_tests.log").string();
+  std::remove(path.c_str());
+  setLogFile(path);
+  {
+    auto logger = std::make_shared<spdlog::logger>(
+        "log_tests", std::make_shared<detail::AsyncLogSink>());
+    logger->set_level(spdlog::level::trace);
+    fn(*logger);
+  }
+  setLogFile("");
+
+  std::vector<std::string> lines;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    lines.push_back(line);
+  }
+  file.close();
+  std::remove(path.c_str());
+  return lines;
+}
+
+// Sum of the numbers the backend reports in notices matching pattern
+std::size_t noticed(const std::vector<std::string>& lines,
+                    const std::string& pattern) {
+  std::regex notice("(\\d+) " + pattern);
+  std::size_t total = 0;
+  std::smatch match;
+  for (auto const& line : lines) {
+    if (std::regex_search(line, match, notice)) {
+      total += std::stoul(match[1].str());
+    }
+  }
+  return total;
+}
+
+}  // namespace
+
+TEST_CASE("Async log sink truncates long messages") {
+  auto lines = logToFile([](spdlog::logger& logger) {
+    logger.info("short");
+    logger.info(std::string(300, 'x'));
+  });
+
+  REQUIRE(lines.size() == 2);
+  CHECK_THAT(lines[0], Catch::Matchers::EndsWith("short"));
+  CHECK_THAT(lines[1], Catch::Matchers::EndsWith("x [truncated]"));
+  auto xs = std::count(lines[1].begin(), lines[1].end(), 'x');
+  CHECK(xs > 0);
+  CHECK(xs < 300);
+}
+
+TEST_CASE("Async log sink counts what it drops from full queues") {
+  constexpr std::size_t messages = 100000;
+  auto lines = logToFile([](spdlog::logger& logger) {
+    for (std::size_t i = 0; i < messages; ++i) {
+      logger.info("message {}", i);
+    }
+  });
+
+  std::regex message("message (\\d+)$");
+  std::smatch match;
+  std::size_t delivered = 0;
+  long long last = -1;
+  for (auto const& line : lines) {
+    if (std::regex_search(line, match, message)) {
+      auto number = std::stoll(match[1].str());
+      CHECK(number > last);
+      last = number;
+      ++delivered;
+    }
+  }
+  auto dropped = noticed(lines, "log messages dropped$");
+  CHECK(dropped > 0);
+  CHECK(delivered + dropped == messages);
+}
+
+TEST_CASE("Async log sink hands queues from exited threads to new ones") {
+  // More threads in all than there are queues, but never at once
+  constexpr int batches = 3;
+  constexpr int threadsPerBatch = 40;
+  auto lines = logToFile([](spdlog::logger& logger) {
+    for (int batch = 0; batch < batches; ++batch) {
+      std::vector<std::thread> threads;
+      for (int i = 0; i < threadsPerBatch; ++i) {
+        threads.emplace_back([&logger, batch, i]() {
+          logger.info("thread {} of batch {}", i, batch);
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      // Backend sees the threads have exited
+      std::this_thread::sleep_for(50ms);
+    }
+  });
+
+  auto delivered = std::count_if(
+      lines.begin(), lines.end(), [](const std::string& line) {
+        return line.find("of batch") != std::string::npos;
+      });
+  CHECK(delivered == batches * threadsPerBatch);
+  CHECK(noticed(lines, "log messages dropped from threads beyond") == 0);
+}
@@ -114,6 +114,33 @@ TEST_CASE("MonitoringConnectionDetailsResponse encoding/decoding") {
           "SomeString that describes an nng endpoint");
 }
 
+TEST_CASE("RegisterInputsMessage encoding/decoding") {
+  using namespace ear::plugin::communication;
+  std::vector<ConnectionId> ids{ConnectionId::generate(), ConnectionId{},
+                                ConnectionId::generate()};
+  RegisterInputsMessage msg{ids};
+  auto buffer = serialize(msg);
+
+  auto req = parseRequest(buffer);
+  auto received_msg = boost::get<RegisterInputsMessage>(req);
+  REQUIRE(received_msg.connectionIds() == ids);
+}
+
+TEST_CASE("RegisterInputsResponse encoding/decoding") {
+  using namespace ear::plugin::communication;
+  std::vector<ConnectionId> ids{ConnectionId::generate(),
+                                ConnectionId::generate()};
+  RegisterInputsResponse msg{ids, "SomeString that describes an endpoint"};
+  auto buffer = serialize(msg);
+
+  auto resp = parseResponse(buffer);
+  REQUIRE(resp.errorCode() == ErrorCode::NO_ERROR);
+  auto received_msg = resp.payloadAs<RegisterInputsResponse>();
+  REQUIRE(received_msg.connectionIds() == ids);
+  REQUIRE(received_msg.metadataEndpoint() ==
+          "SomeString that describes an endpoint");
+}
+
 TEST_CASE("ErrorResponse encoding/decoding") {
   using namespace ear::plugin::communication;
   auto buffer = serializeErrorResponse(ErrorCode::UNKOWN_ERROR, "some message");
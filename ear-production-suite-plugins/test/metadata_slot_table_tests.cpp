@@ -0,0 +1,201 @@
+#include <catch2/catch_all.hpp>
+#include "communication/metadata_slot_table.hpp"
+#include <atomic>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+
+using namespace ear::plugin;
+using namespace ear::plugin::communication;
+
+namespace {
+
+// Not the Scene's table, so tests can run alongside a session
+const std::string TABLE_NAME = "ear-production-suite-test-meta-slots";
+
+proto::InputItemMetadata makeItem(const ConnectionId& id, int routing) {
+  proto::InputItemMetadata item;
+  item.set_connection_id(id.string());
+  item.set_routing(routing);
+  item.set_name("Object " + std::to_string(routing));
+  item.set_changed(true);
+  return item;
+}
+
+std::map<std::string, int> pollRoutings(MetadataSlotTable& table) {
+  std::map<std::string, int> routings;
+  table.poll([&](ConnectionId id, const proto::InputItemMetadata& item) {
+    CHECK(id.string() == item.connection_id());
+    routings[item.connection_id()] = item.routing();
+  });
+  return routings;
+}
+
+}  // namespace
+
+TEST_CASE("Metadata slot table delivers each write once") {
+  MetadataSlotTable scene(TABLE_NAME, MetadataSlotTable::Mode::CREATE);
+  MetadataSlotTable input(TABLE_NAME, MetadataSlotTable::Mode::OPEN);
+
+  auto first = ConnectionId::generate();
+  auto second = ConnectionId::generate();
+  auto firstSlot = input.claim(first);
+  auto secondSlot = input.claim(second);
+  REQUIRE(firstSlot);
+  REQUIRE(secondSlot);
+  REQUIRE(firstSlot->index != secondSlot->index);
+
+  SECTION("claimed slots aren't reported until written") {
+    CHECK(pollRoutings(scene).empty());
+  }
+
+  SECTION("only slots written since the last poll are reported") {
+    REQUIRE(input.write(*firstSlot, makeItem(first, 1)));
+    REQUIRE(input.write(*secondSlot, makeItem(second, 2)));
+    auto routings = pollRoutings(scene);
+    REQUIRE(routings.size() == 2);
+    CHECK(routings[first.string()] == 1);
+    CHECK(routings[second.string()] == 2);
+
+    CHECK(pollRoutings(scene).empty());
+
+    REQUIRE(input.write(*firstSlot, makeItem(first, 3)));
+    REQUIRE(input.write(*firstSlot, makeItem(first, 4)));
+    routings = pollRoutings(scene);
+    REQUIRE(routings.size() == 1);
+    CHECK(routings[first.string()] == 4);
+  }
+
+  SECTION("released slots are skipped and can be claimed again") {
+    REQUIRE(input.write(*firstSlot, makeItem(first, 1)));
+    scene.release(first);
+    CHECK(pollRoutings(scene).empty());
+    auto reclaimed = input.claim(ConnectionId::generate());
+    REQUIRE(reclaimed);
+    CHECK(reclaimed->index == firstSlot->index);
+
+    SECTION("by a new owner the old claim can't touch") {
+      CHECK_FALSE(input.write(*firstSlot, makeItem(first, 2)));
+      input.release(*firstSlot);
+      CHECK(input.write(*reclaimed, makeItem(first, 3)));
+    }
+  }
+
+  SECTION("a claim released by its owner lapses once the slot is reclaimed") {
+    input.release(*firstSlot);
+    CHECK_FALSE(input.write(*firstSlot, makeItem(first, 1)));
+    auto next = ConnectionId::generate();
+    auto reclaimed = input.claim(next);
+    REQUIRE(reclaimed);
+    REQUIRE(reclaimed->index == firstSlot->index);
+    CHECK(reclaimed->generation != firstSlot->generation);
+
+    CHECK_FALSE(input.write(*firstSlot, makeItem(first, 2)));
+    input.release(*firstSlot);
+    REQUIRE(input.write(*reclaimed, makeItem(next, 3)));
+    auto routings = pollRoutings(scene);
+    REQUIRE(routings.size() == 1);
+    CHECK(routings[next.string()] == 3);
+  }
+
+  SECTION("oversized metadata is refused") {
+    auto item = makeItem(first, 1);
+    item.set_name(std::string(MetadataSlotTable::PAYLOAD_CAPACITY, 'x'));
+    CHECK_FALSE(input.write(*firstSlot, item));
+    CHECK(pollRoutings(scene).empty());
+  }
+}
+
+TEST_CASE("Metadata slot table is full after SLOT_COUNT claims") {
+  MetadataSlotTable table(TABLE_NAME, MetadataSlotTable::Mode::CREATE);
+  std::optional<MetadataSlotTable::SlotHandle> first;
+  for (std::size_t i = 0; i < MetadataSlotTable::SLOT_COUNT; ++i) {
+    auto slot = table.claim(ConnectionId::generate());
+    REQUIRE(slot);
+    if (!first) first = slot;
+  }
+  CHECK_FALSE(table.claim(ConnectionId::generate()));
+  table.release(*first);
+  auto reclaimed = table.claim(ConnectionId::generate());
+  REQUIRE(reclaimed);
+  CHECK(reclaimed->index == first->index);
+}
+
+TEST_CASE("Metadata slot table can't be opened before it's created") {
+  {
+    MetadataSlotTable table(TABLE_NAME, MetadataSlotTable::Mode::CREATE);
+  }
+  REQUIRE_THROWS_AS(
+      MetadataSlotTable(TABLE_NAME, MetadataSlotTable::Mode::OPEN),
+      std::runtime_error);
+}
+
+TEST_CASE("Metadata slot table reads are never torn") {
+  MetadataSlotTable scene(TABLE_NAME, MetadataSlotTable::Mode::CREATE);
+  MetadataSlotTable input(TABLE_NAME, MetadataSlotTable::Mode::OPEN);
+  auto id = ConnectionId::generate();
+  auto slot = input.claim(id);
+  REQUIRE(slot);
+
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    for (int routing = 0; routing < 20000; ++routing) {
+      auto item = makeItem(id, routing);
+      // Name and routing always agree in a complete write
+      input.write(*slot, item);
+    }
+    done = true;
+  });
+
+  int lastRouting = -1;
+  bool consistent = true;
+  while (!done) {
+    scene.poll([&](ConnectionId, const proto::InputItemMetadata& item) {
+      consistent = consistent &&
+                   item.name() == "Object " + std::to_string(item.routing()) &&
+                   item.routing() > lastRouting;
+      lastRouting = item.routing();
+    });
+  }
+  writer.join();
+  CHECK(consistent);
+}
+
+TEST_CASE("Metadata slot table writes to one slot never interleave") {
+  MetadataSlotTable scene(TABLE_NAME, MetadataSlotTable::Mode::CREATE);
+  MetadataSlotTable input(TABLE_NAME, MetadataSlotTable::Mode::OPEN);
+  auto id = ConnectionId::generate();
+  auto slot = input.claim(id);
+  REQUIRE(slot);
+
+  // As a lapsed claim still writing would, alongside the slot's next owner
+  std::atomic<int> running{2};
+  std::atomic<int> written{0};
+  auto writeFrom = [&](int firstRouting) {
+    for (int routing = firstRouting; routing < 20000; routing += 2) {
+      if (input.write(*slot, makeItem(id, routing))) {
+        ++written;
+      }
+    }
+    --running;
+  };
+  std::thread even(writeFrom, 0);
+  std::thread odd(writeFrom, 1);
+
+  bool consistent = true;
+  while (running > 0) {
+    scene.poll([&](ConnectionId, const proto::InputItemMetadata& item) {
+      consistent = consistent &&
+                   item.name() == "Object " + std::to_string(item.routing());
+    });
+  }
+  even.join();
+  odd.join();
+  CHECK(consistent);
+  CHECK(written > 0);
+  // Nothing left mid-write
+  CHECK(input.write(*slot, makeItem(id, 1)));
+  auto routings = pollRoutings(scene);
+  CHECK(routings[id.string()] == 1);
+}
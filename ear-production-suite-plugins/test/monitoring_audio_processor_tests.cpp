@@ -71,6 +71,47 @@ TEST_CASE("direct_path") {
   REQUIRE(out.isApprox(expectedOutput));
 }
 
+TEST_CASE("hoa_path") {
+  auto layout = ear::getLayout("0+5+0").withoutLfe();
+  std::size_t blockSize = 10;
+  ear::plugin::MonitoringAudioProcessor processor(3, layout, blockSize);
+
+  using Buffer = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+
+  Buffer in(processor.delayInSamples() + blockSize, 3);
+  in.setZero();
+  in(Eigen::all, 1).setConstant(.5);
+  in(Eigen::all, 2).setConstant(1.f);
+
+  Buffer out(processor.delayInSamples() + blockSize, 5);
+  out.setZero();
+
+  ear::plugin::GainMatrix gainDirect = Eigen::MatrixXf::Zero(5, 3);
+  ear::plugin::GainMatrix gainDiffuse = Eigen::MatrixXf::Zero(5, 3);
+
+  auto decode = std::make_shared<Eigen::MatrixXf>(Eigen::MatrixXf::Zero(5, 2));
+  (*decode)(0, 0) = 1.f;
+  (*decode)(1, 0) = 2.f;
+  (*decode)(1, 1) = 0.5f;
+  (*decode)(2, 1) = 1.f;
+  (*decode)(4, 1) = 0.25f;
+  ear::plugin::HoaDecodes hoa{{1, decode}};
+
+  // Static gains, so no ramp in from the first block
+  Buffer expectedOutput(processor.delayInSamples() + blockSize,
+                        layout.channels().size());
+  expectedOutput.setZero();
+  auto targetSignalIndizes = Eigen::seqN(processor.delayInSamples(), blockSize);
+  expectedOutput(targetSignalIndizes, 0).setConstant(0.5f);
+  expectedOutput(targetSignalIndizes, 1).setConstant(1.5f);
+  expectedOutput(targetSignalIndizes, 2).setConstant(1.f);
+  expectedOutput(targetSignalIndizes, 4).setConstant(0.25f);
+
+  processor.process(in, out, gainDirect, gainDiffuse, hoa);
+
+  REQUIRE(out.isApprox(expectedOutput));
+}
+
 std::vector<std::unique_ptr<ear::dsp::block_convolver::BlockConvolver>>
 makeConvolvers(const ear::Layout& layout, std::size_t blockSize) {
   auto decorrelators = ear::designDecorrelators(layout);
@@ -154,3 +195,44 @@ TEST_CASE("diffuse_path") {
 
   CHECK_THAT(out, IsApprox(expectedOutput));
 }
+
+TEST_CASE("silent_inputs") {
+  auto layout = ear::getLayout("0+5+0").withoutLfe();
+  std::size_t blockSize = 10;
+  ear::plugin::MonitoringAudioProcessor processor(2, layout, blockSize);
+
+  using Buffer = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+
+  // Input 1 is routed, but silent
+  Buffer in(processor.delayInSamples() + blockSize, 2);
+  in.setZero();
+  in(Eigen::all, 0).setConstant(.5);
+
+  Buffer out(processor.delayInSamples() + blockSize, 5);
+  out.setZero();
+
+  ear::plugin::GainMatrix gainDirect = Eigen::MatrixXf::Zero(5, 2);
+  ear::plugin::GainMatrix gainDiffuse = Eigen::MatrixXf::Zero(5, 2);
+  gainDirect(0, 0) = 1.f;
+  gainDirect(1, 0) = 2.f;
+  gainDirect(1, 1) = 0.5f;
+  gainDirect(2, 1) = 1.f;
+
+  Buffer expectedOutput(processor.delayInSamples() + blockSize,
+                        layout.channels().size());
+  expectedOutput.setZero();
+  auto targetSignalIndizes = Eigen::seqN(processor.delayInSamples(), blockSize);
+  expectedOutput(targetSignalIndizes, 0) << 0, 0.05, 0.1, 0.15, 0.2, 0.25, 0.3,
+      0.35, 0.4, 0.45;
+  expectedOutput(targetSignalIndizes, 1) << 0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6,
+      0.7, 0.8, 0.9;
+
+  processor.process(in, out, gainDirect, gainDiffuse);
+
+  REQUIRE(out.isApprox(expectedOutput));
+  auto skips = processor.takeSkipCounts();
+  // Input 1 every block, input 0 only while the adapter's delay is filling
+  CHECK(skips.skippedChannelBlocks * 2 >= skips.channelBlocks);
+  CHECK(skips.skippedChannelBlocks < skips.channelBlocks);
+  CHECK(processor.takeSkipCounts().channelBlocks == 0);
+}
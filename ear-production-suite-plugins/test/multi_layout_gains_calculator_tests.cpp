@@ -0,0 +1,111 @@
+#include "scene_store.pb.h"
+#include "multi_layout_gains_calculator.hpp"
+#include "scene_gains_calculator.hpp"
+#include "helper/protobuf_utilities.hpp"
+#include "eigen_catch2.hpp"
+#include <ear/bs2051.hpp>
+#include <catch2/catch_all.hpp>
+#include <daw_channel_count.h>
+
+using namespace ear::plugin;
+
+const int INPUT_CHANNELS = MAX_DAW_CHANNELS;
+
+namespace {
+void addObject(proto::SceneStore& store, int routing, float azimuth) {
+  auto item = store.add_monitoring_items();
+  item->set_connection_id(communication::ConnectionId::generate().string());
+  item->set_routing(routing);
+  item->set_changed(true);
+  auto obj = item->mutable_obj_metadata();
+  obj->mutable_position()->set_azimuth(azimuth);
+  obj->mutable_position()->set_elevation(10.0);
+  obj->mutable_position()->set_distance(1.0);
+  obj->set_gain(0.7);
+}
+
+void addDirectSpeakers(proto::SceneStore& store, int routing) {
+  auto item = store.add_monitoring_items();
+  item->set_connection_id(communication::ConnectionId::generate().string());
+  item->set_routing(routing);
+  item->set_changed(true);
+  // AP_00010002 = 0+2+0
+  item->set_allocated_ds_metadata(proto::convertPackFormatToEpsMetadata(0x0002));
+}
+}  // namespace
+
+TEST_CASE("multi-layout gains match a calculator per layout") {
+  std::vector<ear::Layout> layouts{ear::getLayout("4+7+0"),
+                                   ear::getLayout("0+5+0"),
+                                   ear::getLayout("0+2+0")};
+  MultiLayoutGainsCalculator calculator(layouts, INPUT_CHANNELS);
+  std::vector<std::unique_ptr<SceneGainsCalculator>> references;
+  for (auto const& layout : layouts) {
+    references.push_back(
+        std::make_unique<SceneGainsCalculator>(layout, INPUT_CHANNELS));
+  }
+
+  auto checkAllLayouts = [&]() {
+    REQUIRE(calculator.layoutCount() == layouts.size());
+    for (std::size_t i = 0; i < layouts.size(); ++i) {
+      CHECK(calculator.gains(i).direct.rows() ==
+            static_cast<Eigen::Index>(layouts[i].channels().size()));
+      CHECK_THAT(calculator.gains(i).direct,
+                 IsApprox(references[i]->directGains()));
+      CHECK_THAT(calculator.gains(i).diffuse,
+                 IsApprox(references[i]->diffuseGains()));
+    }
+  };
+
+  auto updateAll = [&](proto::SceneStore const& store) {
+    calculator.update(store);
+    for (auto& reference : references) {
+      reference->update(store);
+    }
+  };
+
+  SECTION("initial condition") {
+    for (std::size_t i = 0; i < layouts.size(); ++i) {
+      REQUIRE(calculator.gains(i).direct.isZero());
+      REQUIRE(calculator.gains(i).diffuse.isZero());
+    }
+  }
+
+  proto::SceneStore store;
+  addObject(store, 0, 20.f);
+  addObject(store, 1, -110.f);
+  addDirectSpeakers(store, 4);
+
+  SECTION("new items") {
+    updateAll(store);
+    checkAllLayouts();
+  }
+
+  SECTION("changed and unchanged items") {
+    updateAll(store);
+    for (auto& item : *store.mutable_monitoring_items()) {
+      item.set_changed(false);
+    }
+    auto moved = store.mutable_monitoring_items(1);
+    moved->set_changed(true);
+    moved->mutable_obj_metadata()->mutable_position()->set_azimuth(45.0);
+    updateAll(store);
+    checkAllLayouts();
+  }
+
+  SECTION("removed item") {
+    updateAll(store);
+    store.mutable_monitoring_items()->DeleteSubrange(0, 1);
+    updateAll(store);
+    checkAllLayouts();
+  }
+
+  SECTION("empty store silences every layout") {
+    updateAll(store);
+    updateAll(proto::SceneStore{});
+    for (std::size_t i = 0; i < layouts.size(); ++i) {
+      REQUIRE(calculator.gains(i).direct.isZero());
+      REQUIRE(calculator.gains(i).diffuse.isZero());
+    }
+  }
+}
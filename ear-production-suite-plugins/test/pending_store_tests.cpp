@@ -0,0 +1,240 @@
+#include <catch2/catch_all.hpp>
+#include "pending_store.hpp"
+#include "programme_store_adm_serializer.hpp"
+#include "restored_pending_store.hpp"
+#include "store_metadata.hpp"
+#include <adm/write.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ear::plugin;
+using namespace ear::plugin::communication;
+using namespace ear::plugin::proto;
+
+namespace {
+
+// Listeners are run later, as the plugins' dispatchers do - never while
+// Metadata holds its lock
+class EventQueue {
+ public:
+  void push(std::function<void()> event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(std::move(event));
+  }
+
+  void run() {
+    while (true) {
+      std::vector<std::function<void()>> events;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events.swap(events_);
+      }
+      if (events.empty()) {
+        return;
+      }
+      for (auto& event : events) {
+        event();
+      }
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::function<void()>> events_;
+};
+
+class QueuedDispatcher : public EventDispatcher {
+ public:
+  explicit QueuedDispatcher(std::shared_ptr<EventQueue> queue)
+      : queue_{std::move(queue)} {}
+
+ protected:
+  void doDispatch(std::function<void()> event) override {
+    queue_->push(std::move(event));
+  }
+
+ private:
+  std::shared_ptr<EventQueue> queue_;
+};
+
+InputItemMetadata objectItem(std::string const& name,
+                             uint32_t inputInstanceId) {
+  InputItemMetadata item;
+  item.set_connection_id(ConnectionId::generate().string());
+  item.set_name(name);
+  item.set_routing(static_cast<int>(inputInstanceId) - 1);
+  item.set_input_instance_id(inputInstanceId);
+  item.mutable_obj_metadata();
+  return item;
+}
+
+// The same input, back with a new connection after the project reloads
+InputItemMetadata reconnected(InputItemMetadata item) {
+  item.set_connection_id(ConnectionId::generate().string());
+  return item;
+}
+
+Object& addObject(Programme& programme, InputItemMetadata const& item) {
+  auto object = programme.add_element()->mutable_object();
+  object->set_connection_id(item.connection_id());
+  return *object;
+}
+
+// What the Scene sends the extension to store with the project
+class SavedScene {
+ public:
+  void addInput(InputItemMetadata const& item) {
+    stores_.second[ConnectionId{item.connection_id()}] = item;
+  }
+
+  Programme& addProgramme(std::string const& name) {
+    auto programme = stores_.first.add_programme();
+    programme->set_name(name);
+    return *programme;
+  }
+
+  std::pair<std::string, std::vector<PluginToAdmMap>> serialize() const {
+    ProgrammeStoreAdmSerializer serializer;
+    auto [document, pluginMaps] = serializer.serialize(stores_);
+    std::stringstream xml;
+    adm::writeXml(xml, document);
+    std::vector<PluginToAdmMap> pluginToAdmMaps;
+    for (auto const& pluginMap : pluginMaps) {
+      pluginToAdmMaps.push_back(PluginToAdmMap{
+          pluginMap.audioObject->get<adm::AudioObjectId>()
+              .get<adm::AudioObjectIdValue>()
+              .get(),
+          pluginMap.audioTrackUid->get<adm::AudioTrackUidId>()
+              .get<adm::AudioTrackUidIdValue>()
+              .get(),
+          pluginMap.inputInstanceId, pluginMap.routing});
+    }
+    return {xml.str(), pluginToAdmMaps};
+  }
+
+ private:
+  std::pair<ProgrammeStore, ItemMap> stores_;
+};
+
+struct Session {
+  void connect(InputItemMetadata const& item) {
+    metadata.setInputItemMetadata(ConnectionId{item.connection_id()}, item);
+    events->run();
+  }
+
+  std::optional<Programme> programme(std::string const& name) const {
+    for (auto const& programme : metadata.stores().first.programme()) {
+      if (programme.name() == name) {
+        return programme;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::shared_ptr<EventQueue> events{std::make_shared<EventQueue>()};
+  Metadata metadata{std::make_unique<QueuedDispatcher>(events),
+                    std::make_unique<QueuedDispatcher>(events)};
+};
+
+std::size_t mapsFor(std::vector<PluginToAdmMap> const& pluginToAdmMaps,
+                    uint32_t inputInstanceId) {
+  return std::count_if(pluginToAdmMaps.begin(), pluginToAdmMaps.end(),
+                       [inputInstanceId](PluginToAdmMap const& pluginMap) {
+                         return pluginMap.inputInstanceId == inputInstanceId;
+                       });
+}
+
+}  // namespace
+
+TEST_CASE("Pending store fills in every AudioObject made from an input") {
+  auto dialogue = objectItem("Dialogue", 1);
+  SavedScene saved;
+  saved.addInput(dialogue);
+  // Different importance, so an AudioObject each
+  addObject(saved.addProgramme("Main"), dialogue).set_importance(8);
+  addObject(saved.addProgramme("Alternative"), dialogue).set_importance(3);
+  auto [xml, pluginToAdmMaps] = saved.serialize();
+  REQUIRE(mapsFor(pluginToAdmMaps, 1) == 2);
+
+  Session session;
+  auto pending =
+      std::make_shared<PendingStore>(session.metadata, xml, pluginToAdmMaps);
+  session.metadata.addBackendListener(pending);
+  auto dialogueNow = reconnected(dialogue);
+  session.connect(dialogueNow);
+
+  for (auto const& [name, importance] :
+       {std::pair<std::string, int>{"Main", 8}, {"Alternative", 3}}) {
+    auto programme = session.programme(name);
+    REQUIRE(programme);
+    REQUIRE(programme->element_size() == 1);
+    CHECK(programme->element(0).object().connection_id() ==
+          dialogueNow.connection_id());
+    CHECK(programme->element(0).object().importance() == importance);
+  }
+}
+
+TEST_CASE("Pending store completes as soon as the last input reconnects") {
+  auto dialogue = objectItem("Dialogue", 1);
+  auto music = objectItem("Music", 2);
+  SavedScene saved;
+  saved.addInput(dialogue);
+  saved.addInput(music);
+  auto& main = saved.addProgramme("Main");
+  addObject(main, dialogue);
+  addObject(main, music);
+  auto [xml, pluginToAdmMaps] = saved.serialize();
+
+  Session session;
+  auto pending =
+      std::make_shared<PendingStore>(session.metadata, xml, pluginToAdmMaps);
+  session.metadata.addBackendListener(pending);
+
+  session.connect(reconnected(dialogue));
+  CHECK_FALSE(session.programme("Main"));
+
+  // Well within the timeout, which only gives up on inputs that never return
+  auto musicNow = reconnected(music);
+  session.connect(musicNow);
+  auto programme = session.programme("Main");
+  REQUIRE(programme);
+  REQUIRE(programme->element_size() == 2);
+  CHECK(programme->element(1).object().connection_id() ==
+        musicNow.connection_id());
+}
+
+TEST_CASE("Restored store waits for inputs only found in toggles") {
+  auto dialogue = objectItem("Dialogue", 1);
+  auto commentary = objectItem("Commentary", 2);
+  ProgrammeStore restored;
+  auto main = restored.add_programme();
+  main->set_name("Main");
+  auto toggle = main->add_element()->mutable_toggle();
+  toggle->add_element()->mutable_object()->set_connection_id(
+      dialogue.connection_id());
+  toggle->add_element()->mutable_object()->set_connection_id(
+      commentary.connection_id());
+  toggle->set_default_element_index(0);
+
+  Session session;
+  auto pending = std::make_shared<RestoredPendingStore>(session.metadata);
+  session.metadata.addUIListener(pending);
+  pending->start(restored, session.metadata.stores());
+  CHECK_FALSE(session.programme("Main"));
+
+  session.connect(dialogue);
+  CHECK_FALSE(session.programme("Main"));
+
+  session.connect(commentary);
+  auto programme = session.programme("Main");
+  REQUIRE(programme);
+  REQUIRE(programme->element_size() == 1);
+  CHECK(programme->element(0).toggle().element_size() == 2);
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch_all.hpp>
+#include "processing_stats.hpp"
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace ear::plugin;
+using namespace std::chrono_literals;
+
+TEST_CASE("Processing stats accumulate per stage") {
+  ProcessingStats stats("test plugin");
+  auto first = stats.addStage("first");
+  auto second = stats.addStage("second");
+  auto start = ProcessingStats::Clock::now();
+
+  stats.record(first, start, start + 10us);
+  stats.record(first, start, start + 30us);
+  stats.record(second, start, start + 500ns);
+
+  auto snapshot = stats.snapshot();
+  REQUIRE(snapshot.size() == 2);
+  CHECK(snapshot[0].name == "first");
+  CHECK(snapshot[0].count == 2);
+  CHECK(snapshot[0].meanMicroseconds == Catch::Approx(20.0));
+  CHECK(snapshot[0].peakMicroseconds == Catch::Approx(30.0));
+  // 10us is in [8, 16), 30us in [16, 32)
+  CHECK(snapshot[0].histogram[4] == 1);
+  CHECK(snapshot[0].histogram[5] == 1);
+  CHECK(snapshot[0].percentileMicroseconds(0.5) == Catch::Approx(16.0));
+  CHECK(snapshot[0].percentileMicroseconds(0.99) == Catch::Approx(32.0));
+  CHECK(snapshot[1].histogram[0] == 1);
+
+  SECTION("mean and peak are since the previous snapshot") {
+    stats.record(first, start, start + 4us);
+    auto next = stats.snapshot();
+    CHECK(next[0].count == 3);
+    CHECK(next[0].meanMicroseconds == Catch::Approx(4.0));
+    CHECK(next[0].peakMicroseconds == Catch::Approx(4.0));
+    CHECK(next[1].meanMicroseconds == 0.0);
+  }
+}
+
+TEST_CASE("Processing stats count lock contention") {
+  ProcessingStats stats("test plugin");
+  auto stage = stats.addStage("stage");
+  std::mutex mutex;
+
+  { auto lock = lockCountingContention(mutex, &stats, stage); }
+  CHECK(stats.snapshot()[0].contentions == 0);
+
+  mutex.lock();
+  std::thread other([&]() {
+    auto lock = lockCountingContention(mutex, &stats, stage);
+  });
+  // The other thread can only finish once it has found the mutex held
+  while (stats.snapshot()[0].contentions == 0) {
+    std::this_thread::yield();
+  }
+  mutex.unlock();
+  other.join();
+  CHECK(stats.snapshot()[0].contentions == 1);
+}
+
+TEST_CASE("Processing stats count skipped channel blocks") {
+  ProcessingStats stats("test plugin");
+  auto stage = stats.addStage("stage");
+
+  stats.recordSkips(stage, 64, 60);
+  stats.recordSkips(stage, 64, 4);
+  auto snapshot = stats.snapshot();
+  CHECK(snapshot[0].channelBlocks == 128);
+  CHECK(snapshot[0].skippedChannelBlocks == 64);
+  CHECK(snapshot[0].count == 0);
+}
+
+TEST_CASE("Processing stats write Chrome traces only while enabled") {
+  ProcessingStats stats("test \"plugin\"");
+  auto stage = stats.addStage("stage");
+  auto start = ProcessingStats::Clock::now();
+
+  stats.record(stage, start, start + 1ms);
+  stats.setTraceEnabled(true);
+  stats.record(stage, start, start + 2ms);
+  stats.setTraceEnabled(false);
+  stats.record(stage, start, start + 3ms);
+
+  std::ostringstream trace;
+  stats.writeChromeTrace(trace);
+  auto json = trace.str();
+  CHECK(json.find("\"traceEvents\"") != std::string::npos);
+  CHECK(json.find("test \\\"plugin\\\"") != std::string::npos);
+  CHECK(json.find("\"dur\":2000.000") != std::string::npos);
+  CHECK(json.find("\"dur\":1000.000") == std::string::npos);
+  CHECK(json.find("\"dur\":3000.000") == std::string::npos);
+
+  SECTION("events are written once") {
+    std::ostringstream again;
+    stats.writeChromeTrace(again);
+    CHECK(again.str().find("\"dur\"") == std::string::npos);
+  }
+}
+
+TEST_CASE("JSON strings escape quotes and backslashes") {
+  std::ostringstream json;
+  writeJsonString(json, "a \"quoted\" C:\\path");
+  CHECK(json.str() == "\"a \\\"quoted\\\" C:\\\\path\"");
+}
@@ -4,6 +4,7 @@
 #include <scene_store.pb.h>
 #include <programme_store_adm_serializer.hpp>
 #include <adm/common_definitions.hpp>
+#include <adm/write.hpp>
 #include <helper/adm_preset_definitions_helper.h>
 #include <algorithm>
 #include <functional>
@@ -21,6 +22,22 @@ int numberOf(adm::Document const& doc) {
   return doc.getElements<T>().size();
 }
 
+std::string toXml(std::shared_ptr<adm::Document> const& doc) {
+  std::stringstream ss;
+  adm::writeXml(ss, doc);
+  return ss.str();
+}
+
+std::shared_ptr<adm::AudioObject> objectNamed(adm::Document& doc,
+                                              std::string const& name) {
+  for (auto const& object : doc.getElements<adm::AudioObject>()) {
+    if (object->get<adm::AudioObjectName>().get() == name) {
+      return object;
+    }
+  }
+  return nullptr;
+}
+
 template<typename T>
 int numberOfUncommon(adm::Document const& doc) {
   auto static commonDoc = adm::getCommonDefinitions();
@@ -508,3 +525,84 @@ TEST_CASE("On_Off interactive") {
   }
 }
 
+TEST_CASE("Serializing again with the same serializer") {
+  Metadata metadata{std::make_unique<EventDispatcher>(), std::make_unique<EventDispatcher>()};
+  auto dialogue = ConnectionId::generate();
+  auto commentary = ConnectionId::generate();
+  auto effects = ConnectionId::generate();
+  auto bed = ConnectionId::generate();
+  metadata.setInputItemMetadata(dialogue, simpleObjectItem(dialogue, "Dialogue", 0));
+  metadata.setInputItemMetadata(commentary, simpleObjectItem(commentary, "Commentary", 1));
+  metadata.setInputItemMetadata(effects, simpleObjectItem(effects, "Effects", 2));
+  metadata.setInputItemMetadata(bed, simpleDsItem(bed, "Bed", 3, 0x0002));
+
+  auto main = ProgrammeBuilder{}
+      .withName("Main")
+      .withObject(dialogue)
+      .withObject(effects)
+      .withObject(bed);
+  auto alternative = ProgrammeBuilder{}
+      .withName("Alternative")
+      .withToggle(ToggleBuilder{}.withDefaultItem(dialogue).withItem(commentary))
+      .withObject(bed);
+  metadata.setStore(StoreBuilder{}.withProgramme(main).withProgramme(alternative));
+
+  ProgrammeStoreAdmSerializer serializer;
+  auto first = serializer.serialize(metadata.stores());
+  auto const firstXml = toXml(first.first);
+  auto const firstPluginMapSize = first.second.size();
+  auto const dialogueObject = objectNamed(*first.first, "Dialogue");
+  REQUIRE(dialogueObject);
+
+  auto requireSameAsFresh = [&](auto const& result) {
+    auto fresh = ProgrammeStoreAdmSerializer{}.serialize(metadata.stores());
+    auto const& doc = *result.first;
+    REQUIRE(numberOf<adm::AudioProgramme>(doc) == numberOf<adm::AudioProgramme>(*fresh.first));
+    REQUIRE(numberOf<adm::AudioContent>(doc) == numberOf<adm::AudioContent>(*fresh.first));
+    REQUIRE(numberOf<adm::AudioObject>(doc) == numberOf<adm::AudioObject>(*fresh.first));
+    REQUIRE(numberOf<adm::AudioTrackUid>(doc) == numberOf<adm::AudioTrackUid>(*fresh.first));
+    REQUIRE(numberOf<adm::AudioPackFormat>(doc) == numberOf<adm::AudioPackFormat>(*fresh.first));
+    REQUIRE(numberOf<adm::AudioChannelFormat>(doc) == numberOf<adm::AudioChannelFormat>(*fresh.first));
+    REQUIRE(result.second.size() == fresh.second.size());
+    for (auto const& entry : result.second) {
+      REQUIRE(doc.lookup(entry.audioObject->template get<adm::AudioObjectId>()) == entry.audioObject);
+      REQUIRE(doc.lookup(entry.audioTrackUid->template get<adm::AudioTrackUidId>()) == entry.audioTrackUid);
+    }
+  };
+
+  SECTION("unchanged session gives the same document") {
+    auto second = serializer.serialize(metadata.stores());
+    REQUIRE(toXml(second.first) == firstXml);
+    REQUIRE(second.second.size() == firstPluginMapSize);
+    REQUIRE(objectNamed(*second.first, "Dialogue") == dialogueObject);
+  }
+
+  SECTION("renamed input is rebuilt, others are reused") {
+    metadata.setInputItemMetadata(commentary, simpleObjectItem(commentary, "Description", 1));
+    auto second = serializer.serialize(metadata.stores());
+    requireSameAsFresh(second);
+    REQUIRE_FALSE(objectNamed(*second.first, "Commentary"));
+    auto description = objectNamed(*second.first, "Description");
+    REQUIRE(description);
+    REQUIRE(objectNamed(*second.first, "Dialogue") == dialogueObject);
+    auto complementary = dialogueObject->getComplementaryObjects();
+    REQUIRE(complementary.size() == 1);
+    REQUIRE(complementary.front() == description);
+  }
+
+  SECTION("removed input leaves nothing behind") {
+    metadata.removeInput(effects);
+    auto second = serializer.serialize(metadata.stores());
+    requireSameAsFresh(second);
+    REQUIRE_FALSE(objectNamed(*second.first, "Effects"));
+    REQUIRE(objectNamed(*second.first, "Dialogue") == dialogueObject);
+  }
+
+  SECTION("changed DirectSpeakers layout") {
+    metadata.setInputItemMetadata(bed, simpleDsItem(bed, "Bed", 3, 0x0003));
+    auto second = serializer.serialize(metadata.stores());
+    requireSameAsFresh(second);
+    // AP_00010003 is 0+5+0: 5.1, six channels
+    REQUIRE(numberOf<adm::AudioTrackUid>(*second.first) == 3 + 6);
+  }
+}
@@ -5,6 +5,7 @@
 #include <ear/bs2051.hpp>
 #include <catch2/catch_all.hpp>
 #include <daw_channel_count.h>
+#include <set>
 
 using namespace ear::plugin;
 
@@ -357,3 +358,94 @@ TEST_CASE("scene gain calculation (DirectSpeakers)") {
     CHECK_THAT(directGains, IsApprox(expectedDirect));
   }
 }
+
+TEST_CASE("interned metadata conversion") {
+  std::unique_ptr<proto::DirectSpeakersTypeMetadata> bed{
+      proto::convertPackFormatToEpsMetadata(0x0005)};  // AP_00010005 = 5.1+4H
+  auto interned = EpsToEarMetadataConverter::convertInterned(*bed);
+  REQUIRE(interned);
+  auto expected = EpsToEarMetadataConverter::convert(*bed);
+  REQUIRE(interned->size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    CHECK(interned->at(i).speakerLabels == expected[i].speakerLabels);
+    CHECK(interned->at(i).audioPackFormatID == expected[i].audioPackFormatID);
+  }
+
+  SECTION("same pack format is shared") {
+    std::unique_ptr<proto::DirectSpeakersTypeMetadata> otherBed{
+        proto::convertPackFormatToEpsMetadata(0x0005)};
+    CHECK(EpsToEarMetadataConverter::convertInterned(*otherBed) == interned);
+  }
+
+  SECTION("edited speakers are not mistaken for the pack format's") {
+    bed->mutable_speakers(0)->set_labels(0, "M+045");
+    auto edited = EpsToEarMetadataConverter::convertInterned(*bed);
+    CHECK(edited != interned);
+    CHECK(edited->at(0).speakerLabels ==
+          std::vector<std::string>{"M+045"});
+    CHECK(EpsToEarMetadataConverter::convertInterned(*bed) != edited);
+  }
+
+  SECTION("HOA") {
+    proto::HoaTypeMetadata hoa;
+    hoa.set_packformatidvalue(0x0001);
+    auto internedHoa = EpsToEarMetadataConverter::convertInterned(hoa);
+    REQUIRE(internedHoa);
+    CHECK(internedHoa->degrees ==
+          EpsToEarMetadataConverter::convert(hoa).degrees);
+    CHECK(EpsToEarMetadataConverter::convertInterned(hoa) == internedHoa);
+  }
+}
+
+TEST_CASE("scene gain calculation (HOA)") {
+  proto::SceneStore store;
+  proto::HoaTypeMetadata hoa;
+  hoa.set_packformatidvalue(0x0001);
+  auto earMetadata = EpsToEarMetadataConverter::convert(hoa);
+  REQUIRE(!earMetadata.degrees.empty());
+  auto channels = static_cast<int>(earMetadata.degrees.size());
+
+  auto layout = ear::getLayout("0+5+0");
+  ear::GainCalculatorHOA referenceCalculator(layout);
+  std::vector<std::vector<float>> expected(
+      channels, std::vector<float>(layout.channels().size(), 0.f));
+  referenceCalculator.calculate(earMetadata, expected);
+
+  ear::plugin::SceneGainsCalculator calculator(layout, INPUT_CHANNELS);
+
+  for (int routing : {1, 1 + channels}) {
+    auto item = store.add_monitoring_items();
+    item->set_connection_id(communication::ConnectionId::generate().string());
+    item->set_routing(routing);
+    item->set_changed(true);
+    *item->mutable_hoa_metadata() = hoa;
+  }
+  calculator.update(store);
+
+  SECTION("left out of the interpolated gains") {
+    CHECK(calculator.directGains().isZero());
+    CHECK(calculator.diffuseGains().isZero());
+  }
+
+  SECTION("decoded by one shared matrix") {
+    auto decodes = calculator.hoaDecodes();
+    REQUIRE(decodes.size() == 2);
+    CHECK(decodes[0].gains == decodes[1].gains);
+    std::set<int> startingChannels{decodes[0].inputStartingChannel,
+                                   decodes[1].inputStartingChannel};
+    CHECK(startingChannels == std::set<int>{1, 1 + channels});
+
+    Eigen::MatrixXf expectedGains(layout.channels().size(), channels);
+    for (int channel = 0; channel < channels; ++channel) {
+      expectedGains.col(channel) = Eigen::VectorXf::Map(
+          expected[channel].data(), expected[channel].size());
+    }
+    CHECK_THAT(*decodes[0].gains, IsApprox(expectedGains));
+  }
+
+  SECTION("removed with the item") {
+    store.clear_monitoring_items();
+    calculator.update(store);
+    CHECK(calculator.hoaDecodes().empty());
+  }
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch_all.hpp>
+#include "silence_detector.hpp"
+#include <Eigen/Core>
+
+using namespace ear::plugin;
+
+TEST_CASE("Silence detector skips channels once their hold has passed") {
+  std::size_t const blockSize = 8;
+  Eigen::MatrixXf block = Eigen::MatrixXf::Zero(blockSize, 2);
+  block(3, 1) = -0.5f;
+
+  SECTION("without a hold, from the first silent block") {
+    SilenceDetector silence(2, 0);
+    CHECK(silence.isActive(0));
+    CHECK(silence.isActive(1));
+    silence.check(block);
+    CHECK_FALSE(silence.isActive(0));
+    CHECK(silence.isActive(1));
+  }
+
+  SECTION("with a hold, once it has been exceeded") {
+    SilenceDetector silence(2, 2 * blockSize);
+    silence.check(block);
+    silence.check(block);
+    CHECK(silence.isActive(0));
+    silence.check(block);
+    CHECK_FALSE(silence.isActive(0));
+    CHECK(silence.isActive(1));
+  }
+
+  SECTION("active again as soon as there is signal") {
+    SilenceDetector silence(2, blockSize);
+    for (int i = 0; i < 4; ++i) {
+      silence.check(block);
+    }
+    REQUIRE_FALSE(silence.isActive(0));
+    block(blockSize - 1, 0) = 1e-3f;
+    silence.check(block);
+    CHECK(silence.isActive(0));
+  }
+
+  SECTION("below the threshold counts as silent") {
+    SilenceDetector silence(2, 0, 1.f);
+    silence.check(block);
+    CHECK_FALSE(silence.isActive(1));
+  }
+
+  SECTION("channels it doesn't track are always active") {
+    SilenceDetector silence(1, 0);
+    silence.check(block);
+    CHECK_FALSE(silence.isActive(0));
+    CHECK(silence.isActive(1));
+  }
+}
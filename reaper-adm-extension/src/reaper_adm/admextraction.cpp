@@ -1,3 +1,5 @@
+#include <cmath>
+#include <limits>
 #include <adm_coord_conv/adm_coord_conv.hpp>
 #include "admextraction.h"
 
@@ -121,6 +123,67 @@ std::vector<admplug::AutomationPoint> admplug::detail::simplify(const std::vecto
     return filtered;
 }
 
+std::vector<admplug::AutomationPoint> admplug::detail::simplify(const std::vector<admplug::AutomationPoint> &points, double tolerance, bool wrapping)
+{
+    if(points.size() < 3 || tolerance <= 0.0) {
+        return points;
+    }
+
+    // Unwrap values so a segment crossing the wrap point is a straight line
+    std::vector<double> values;
+    values.reserve(points.size());
+    values.push_back(points.front().value());
+    for(std::size_t i = 1; i < points.size(); ++i) {
+        double delta = points[i].value() - points[i - 1].value();
+        if(wrapping) {
+            if(delta > 0.5) delta -= 1.0;
+            if(delta < -0.5) delta += 1.0;
+        }
+        values.push_back(values.back() + delta);
+    }
+
+    // Sweep forward from an anchor, narrowing the range of slopes which keep every skipped point within tolerance.
+    // When the next point can't be reached within that range, the previous point becomes the new anchor.
+    std::vector<AutomationPoint> filtered;
+    filtered.push_back(points.front());
+    std::size_t anchor = 0;
+    double minSlope = -std::numeric_limits<double>::infinity();
+    double maxSlope = std::numeric_limits<double>::infinity();
+
+    for(std::size_t i = 1; i < points.size(); ++i) {
+        double dt = points[i].effectiveTime() - points[anchor].effectiveTime();
+        double dv = values[i] - values[anchor];
+        if(i != anchor + 1) {
+            double slope = dv / dt;
+            bool withinTolerance = dt > 0.0 && slope >= minSlope && slope <= maxSlope;
+            bool samePathWhenWrapped = !wrapping || std::abs(dv) < 0.5;
+            if(!withinTolerance || !samePathWhenWrapped) {
+                anchor = i - 1;
+                filtered.push_back(points[anchor]);
+                minSlope = -std::numeric_limits<double>::infinity();
+                maxSlope = std::numeric_limits<double>::infinity();
+                dt = points[i].effectiveTime() - points[anchor].effectiveTime();
+                dv = values[i] - values[anchor];
+            }
+        }
+        if(dt <= 0.0) {
+            // Discontinuity - both points at this time must be kept
+            anchor = i;
+            filtered.push_back(points[anchor]);
+            minSlope = -std::numeric_limits<double>::infinity();
+            maxSlope = std::numeric_limits<double>::infinity();
+            continue;
+        }
+        minSlope = std::max(minSlope, (dv - tolerance) / dt);
+        maxSlope = std::min(maxSlope, (dv + tolerance) / dt);
+    }
+
+    if(anchor != points.size() - 1) {
+        filtered.push_back(points.back());
+    }
+    return filtered;
+}
+
 void admplug::detail::fixEffectiveTimeOverlaps(std::vector<AutomationPoint> &points)
 {
     // This function assumes points are already sorted by start time
@@ -4,6 +4,7 @@
 #include <adm/elements.hpp>
 #include "automationpoint.h"
 #include "automationenvelope.h"
+#include "envelopecreator.h"
 #include "parameter.h"
 
 namespace {
@@ -270,18 +271,28 @@ std::optional<AutomationPoint> getSphericalPoint(Parameter const& param, adm::Au
 }
 
 std::vector<AutomationPoint> simplify(std::vector<AutomationPoint> const& points);
+/**
+ * Removes points which lie within tolerance of the straight line between the points kept either side of them.
+ * Single pass, O(n). When wrapping is set, values are treated as circular over 0-1 (as WrappingEnvelope does)
+ * and no segment is allowed to span more than half the range, so the envelope still takes the same path.
+ */
+std::vector<AutomationPoint> simplify(std::vector<AutomationPoint> const& points, double tolerance, bool wrapping);
 void fixEffectiveTimeOverlaps(std::vector<AutomationPoint> &points);
 
 template<typename ParameterT, typename AutomatableT>
 void applyAutomation(std::vector<AutomationPoint> points,
                      double startTime,
                      const ParameterT &parameter,
-                     const AutomatableT &automatable)
+                     const AutomatableT &automatable,
+                     double simplificationTolerance = 0.0)
 {
     if(!points.empty()) {
         std::sort(points.begin(), points.end(), pointsTimeSorter); // fixEffectiveTimeOverlaps and simplify assumes the points are ordered by time, so do it
         fixEffectiveTimeOverlaps(points);
         points = simplify(points);
+        if(simplificationTolerance > 0.0) {
+            points = simplify(points, simplificationTolerance, DefaultEnvelopeCreator::isWrappedParam(parameter.admParameter()));
+        }
 
         parameter.set(automatable, points.front().value());
 
@@ -6,6 +6,8 @@
 #include "projectelements.h"
 #include "projecttree.h"
 #include "admmetadata.h"
+#include "admreferenceindex.h"
+#include "importfilecache.h"
 #include <boost/variant/static_visitor.hpp>
 #include <adm/document.hpp>
 #include <adm/elements.hpp>
@@ -116,24 +118,14 @@ namespace {
 
     };
 
-  template <typename ExistingT, typename NewT>
-  std::vector<std::shared_ptr<NewT const>> getElementsIfNo(std::shared_ptr<adm::Document const> doc) {
-      auto possibleParents = doc->getElements<ExistingT>();
-      auto possibleElements = doc->getElements<NewT>();
-      std::vector<std::shared_ptr<NewT const>> orphanedElements(possibleElements.size());
-
-      auto it = std::copy_if(possibleElements.begin(), possibleElements.end(), orphanedElements.begin(),
-                  [&possibleParents](auto e) {
-                      for(auto const& p : possibleParents) {
-                          auto children = p->template getReferences<NewT>();
-                          for(auto const& c : children) {
-                              if(c == e) return false;
-                          }
-                      }
-                      return true;
-                  });
-      orphanedElements.resize(std::distance(orphanedElements.begin(), it));
-
+  template <typename NewT, typename HasParentFn>
+  std::vector<std::shared_ptr<NewT const>> getElementsIfNo(std::shared_ptr<adm::Document const> doc, HasParentFn hasParent) {
+      std::vector<std::shared_ptr<NewT const>> orphanedElements;
+      for(auto const& element : doc->getElements<NewT>()) {
+          if(!hasParent(*element)) {
+              orphanedElements.push_back(element);
+          }
+      }
       return orphanedElements;
   }
 
@@ -187,30 +179,32 @@ void ADMImporter::parse() {
     auto& broadcast = *context.broadcast;
     broadcast.setStatus(ImportStatus::PARSING_METADATA);
     try {
-        metadata = std::make_shared<ADMMetaData>(fileName);
+        // One reader for the session - chunks are parsed once and the audio is extracted through the same handle
+        std::shared_ptr<bw64::Bw64Reader> file = ImportFileCache::getInstance().take(fileName);
+        metadata = std::make_shared<ADMMetaData>(file, fileName);
         checkMetadataPresent(*metadata);
         auto admDoc = metadata->adm();
+        // Built once and shared with the project tree, which asks for element parents throughout
+        auto referenceIndex = std::make_shared<AdmReferenceIndex const>(admDoc);
         programmes = std::vector<std::shared_ptr<adm::AudioProgramme const>>(admDoc->getElements<adm::AudioProgramme>().begin(), admDoc->getElements<adm::AudioProgramme>().end());
-        contents = getElementsIfNo<adm::AudioProgramme, adm::AudioContent>(admDoc);
-        auto objectsWithNoParentContent = getElementsIfNo<adm::AudioContent, adm::AudioObject>(admDoc);
-        auto objectsWithNoParentObject = getElementsIfNo<adm::AudioObject, adm::AudioObject>(admDoc);
-        objects.clear();
-        for(auto object : objectsWithNoParentContent) {
-            if(contains(objectsWithNoParentObject, object)) {
-                objects.push_back(object);
-            }
-        }
+        contents = getElementsIfNo<adm::AudioContent>(admDoc, [&referenceIndex](adm::AudioContent const& content) {
+            return !referenceIndex->parentProgrammes(content).empty();
+        });
+        objects = getElementsIfNo<adm::AudioObject>(admDoc, [&referenceIndex](adm::AudioObject const& object) {
+            return !referenceIndex->parentContents(object).empty() || !referenceIndex->parentObjects(object).empty();
+        });
         // TODO - We don't do anything with this at the moment. Intention was to import in to session anyway but without an AudioObject plugin.
         //uids = getElementsIfNo<adm::AudioObject, adm::AudioTrackUid>(admDoc);
         auto tracer = adm::detail::GenericRouteTracer<adm::Route, FullDepthViaUIDStrategy>();
         sourceCreator = std::make_shared<PCMSourceCreator>(std::make_unique<PCMGroupRegistry>(),
-                                                           std::make_unique<Bw64PCMReader>(fileName),
+                                                           std::make_unique<Bw64PCMReader>(file),
                                                            std::make_unique<RoutingWriterFactory>(),
                                                            *metadata);
-        project = std::make_unique<ProjectTree>(std::make_unique<NodeCreator>(sourceCreator, originalMediaItem),
+        project = std::make_unique<ProjectTree>(std::make_unique<NodeCreator>(sourceCreator, originalMediaItem, context.settings),
                                                 sourceCreator,
                                                 std::make_unique<ProjectNode>(std::make_unique<ImportElement>(originalMediaItem)),
-                                                this->context.broadcast);
+                                                this->context.broadcast,
+                                                referenceIndex);
         applyRoutes(programmes, tracer, *project);
         applyRoutes(contents, tracer, *project);
         applyRoutes(objects, tracer, *project);
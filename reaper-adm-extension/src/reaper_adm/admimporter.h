@@ -14,12 +14,14 @@ class ProjectTree;
 class PluginSuite;
 class ImportListener;
 class ImportReporter;
+struct ImportSettings;
 
 struct ImportContext {
     std::shared_ptr<ImportListener> broadcast;
     std::shared_ptr<ImportReporter> import;
     std::shared_ptr<PluginSuite> pluginSuite;
     ReaperAPI const& api;
+    std::shared_ptr<ImportSettings const> settings;
 };
 
 class ADMImporter
@@ -7,6 +7,7 @@ namespace adm {
 }
 
 namespace bw64 {
+  class Bw64Reader;
   class ChnaChunk;
   class AxmlChunk;
 }
@@ -26,6 +27,8 @@ class ADMMetaData : public IADMMetaData
 {
 public:
     ADMMetaData(std::string fileName);
+    // Uses chunks already read by reader, rather than opening the file again
+    ADMMetaData(std::shared_ptr<bw64::Bw64Reader> reader, std::string fileName);
     std::shared_ptr<const bw64::ChnaChunk> chna() const override;
     std::shared_ptr<const bw64::AxmlChunk> axml() const override;
     std::shared_ptr<const adm::Document> adm() const override;
@@ -36,7 +39,7 @@ private:
     std::shared_ptr<bw64::AxmlChunk> axmlChunk;
     std::shared_ptr<adm::Document> document;
     std::string name;
-    void parseMetadata();
+    void parseMetadata(bw64::Bw64Reader& reader);
     void completeUidReferences();
 };
 
@@ -0,0 +1,57 @@
+#include "admreferenceindex.h"
+#include <adm/document.hpp>
+#include <adm/elements.hpp>
+#include <cassert>
+
+using namespace admplug;
+
+namespace {
+
+template<typename ParentT, typename ChildT, typename MapT>
+void addReverseReferences(adm::Document const& doc, MapT& parentsByChild) {
+    for(auto const& parent : doc.getElements<ParentT>()) {
+        for(auto const& child : parent->template getReferences<ChildT>()) {
+            parentsByChild[child.get()].push_back(parent);
+        }
+    }
+}
+
+}
+
+AdmReferenceIndex::AdmReferenceIndex(std::shared_ptr<adm::Document const> doc) : document{ doc }
+{
+    assert(doc);
+    numProgrammes = doc->getElements<adm::AudioProgramme>().size();
+    addReverseReferences<adm::AudioProgramme, adm::AudioContent>(*doc, programmesByContent);
+    addReverseReferences<adm::AudioContent, adm::AudioObject>(*doc, contentsByObject);
+    addReverseReferences<adm::AudioObject, adm::AudioObject>(*doc, objectsByObject);
+}
+
+template<typename ParentT>
+std::vector<std::shared_ptr<ParentT const>> const& AdmReferenceIndex::parentsIn(ParentMap<ParentT> const& parents, void const* child)
+{
+    static std::vector<std::shared_ptr<ParentT const>> const noParents;
+    auto it = parents.find(child);
+    return it == parents.end() ? noParents : it->second;
+}
+
+bool AdmReferenceIndex::indexes(adm::Document const& doc) const
+{
+    auto indexedDoc = document.lock();
+    return indexedDoc.get() == &doc;
+}
+
+std::vector<std::shared_ptr<adm::AudioProgramme const>> const& AdmReferenceIndex::parentProgrammes(adm::AudioContent const& content) const
+{
+    return parentsIn(programmesByContent, &content);
+}
+
+std::vector<std::shared_ptr<adm::AudioContent const>> const& AdmReferenceIndex::parentContents(adm::AudioObject const& object) const
+{
+    return parentsIn(contentsByObject, &object);
+}
+
+std::vector<std::shared_ptr<adm::AudioObject const>> const& AdmReferenceIndex::parentObjects(adm::AudioObject const& object) const
+{
+    return parentsIn(objectsByObject, &object);
+}
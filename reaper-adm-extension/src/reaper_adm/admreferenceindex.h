@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace adm {
+  class Document;
+  class AudioProgramme;
+  class AudioContent;
+  class AudioObject;
+}
+
+namespace admplug {
+
+class AdmReferenceIndex
+{
+    /*
+    Reverse (child to parent) references for an ADM document.
+    libadm only holds references from parent to child, so finding what refers to an element means
+     scanning every possible parent in the document. The import asks that for most elements it visits,
+     so the index is built once per import, in a single pass, and the tree building looks parents up here instead.
+    The document must not be modified while the index is in use.
+    */
+public:
+    explicit AdmReferenceIndex(std::shared_ptr<adm::Document const> document);
+
+    bool indexes(adm::Document const& document) const;
+
+    std::size_t programmeCount() const { return numProgrammes; }
+    std::vector<std::shared_ptr<adm::AudioProgramme const>> const& parentProgrammes(adm::AudioContent const& content) const;
+    std::vector<std::shared_ptr<adm::AudioContent const>> const& parentContents(adm::AudioObject const& object) const;
+    std::vector<std::shared_ptr<adm::AudioObject const>> const& parentObjects(adm::AudioObject const& object) const;
+
+private:
+    template<typename ParentT>
+    using ParentMap = std::unordered_map<void const*, std::vector<std::shared_ptr<ParentT const>>>;
+
+    template<typename ParentT>
+    static std::vector<std::shared_ptr<ParentT const>> const& parentsIn(ParentMap<ParentT> const& parents, void const* child);
+
+    std::weak_ptr<adm::Document const> document;
+    std::size_t numProgrammes{ 0 };
+    ParentMap<adm::AudioProgramme> programmesByContent;
+    ParentMap<adm::AudioContent> contentsByObject;
+    ParentMap<adm::AudioObject> objectsByObject;
+};
+
+}
@@ -1,13 +1,30 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
 #include "automationenvelope.h"
 
+#define NEW_ENVELOPE_CHUNK_BUFFER_SIZE 4096 // A new envelope should only be about 100 bytes
+
 namespace {
 std::chrono::nanoseconds nsMultiply(std::chrono::nanoseconds const &ns, double const multiplier) {
     double asDouble = (double)ns.count() * multiplier;
     long long asLongLong = asDouble + 0.5; // correct rounding
     return std::chrono::nanoseconds(asLongLong);
 }
+
+struct ChunkPoint {
+    double time;
+    std::string line;
+};
+
+std::string pointLine(double time, double value) {
+    char line[64];
+    std::snprintf(line, sizeof(line), "PT %.12f %.12f 0", time, value);
+    return std::string(line);
+}
 }
 
 using namespace admplug;
@@ -31,6 +48,85 @@ void DefinedStartEnvelope::createPoints()
 }
 
 void DefinedStartEnvelope::createPoints(double pointsOffset)
+{
+    if(points.empty()) {
+        // Nothing to add, but the envelope is still left sorted, as the per-point path always did
+        api.Envelope_SortPoints(trackEnvelope);
+        return;
+    }
+
+    // Long imports generate hundreds of thousands of points per envelope,
+    //  so write them all as one state chunk rather than one API call per point.
+    if(!createPointsAsStateChunk(pointsOffset)) {
+        createPointsIndividually(pointsOffset);
+    }
+}
+
+bool DefinedStartEnvelope::createPointsAsStateChunk(double pointsOffset)
+{
+    char chunk[NEW_ENVELOPE_CHUNK_BUFFER_SIZE];
+    chunk[0] = '\0';
+    bool getRes = api.GetEnvelopeStateChunk(trackEnvelope, chunk, NEW_ENVELOPE_CHUNK_BUFFER_SIZE, false);
+    if(!getRes) return false;
+
+    double earliestPointOnTimeline{ -1.0 };
+    for(auto& point : points) {
+        double pointOnTimeline = point.effectiveTime() + pointsOffset;
+        if (earliestPointOnTimeline < 0.0 || pointOnTimeline < earliestPointOnTimeline) {
+            earliestPointOnTimeline = pointOnTimeline;
+        }
+    }
+
+    std::vector<ChunkPoint> chunkPoints;
+    chunkPoints.reserve(points.size() + 1);
+
+    std::istringstream chunkSs(chunk);
+    std::string line;
+    bool chunkComplete = false; // Set when we find the end of the chunk so we know we read it all.
+    std::string opChunk;
+
+    while(std::getline(chunkSs, line)) {
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        if(line.rfind(">", 0) == 0) {
+            chunkComplete = true;
+            break;
+        }
+        if(line.rfind("PT ", 0) == 0) {
+            // Existing points (i.e, Reapers auto-inserted point) before our first point are dropped,
+            //  matching the DeleteEnvelopePointRange behaviour of the per-point path
+            double existingTime = std::strtod(line.c_str() + 3, nullptr);
+            if(earliestPointOnTimeline > 0.0 && existingTime >= 0.0 && existingTime < earliestPointOnTimeline) {
+                continue;
+            }
+            chunkPoints.push_back({ existingTime, line });
+            continue;
+        }
+        opChunk.append(line);
+        opChunk.append("\n");
+    }
+
+    if(!chunkComplete) return false;
+
+    for(auto& point : points) {
+        double pointOnTimeline = point.effectiveTime() + pointsOffset;
+        chunkPoints.push_back({ pointOnTimeline, pointLine(pointOnTimeline, point.value()) });
+    }
+
+    std::stable_sort(chunkPoints.begin(), chunkPoints.end(), [](ChunkPoint const& a, ChunkPoint const& b) {
+        return a.time < b.time;
+    });
+
+    opChunk.reserve(opChunk.size() + (chunkPoints.size() * 40) + 2);
+    for(auto const& chunkPoint : chunkPoints) {
+        opChunk.append(chunkPoint.line);
+        opChunk.append("\n");
+    }
+    opChunk.append(">\n");
+
+    return api.SetEnvelopeStateChunk(trackEnvelope, opChunk.c_str(), false);
+}
+
+void DefinedStartEnvelope::createPointsIndividually(double pointsOffset)
 {
     double earliestPointOnTimeline{ -1.0 };
     double pointOnTimeline{ 0.0 };
@@ -27,6 +27,9 @@ public:
     void createPoints(double pointsOffset) override;
     std::vector<AutomationPoint>& getPoints();
 private:
+    // Returns false if the envelope state could not be read or written, in which case nothing was changed
+    bool createPointsAsStateChunk(double pointsOffset);
+    void createPointsIndividually(double pointsOffset);
     std::vector<AutomationPoint> points;
     TrackEnvelope* trackEnvelope;
     ReaperAPI const& api;
@@ -1,4 +1,7 @@
 #include "communicators.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 CommunicatorBase::CommunicatorBase(int samplesPort, int commandPort) : samplesPort{ samplesPort }, commandPort{ commandPort }
 {
@@ -7,6 +10,7 @@ CommunicatorBase::CommunicatorBase(int samplesPort, int commandPort) : samplesPo
 
 CommunicatorBase::~CommunicatorBase()
 {
+    stopReceiving();
     endSocket();
 }
 
@@ -33,7 +37,9 @@ void CommunicatorBase::endSocket() {
 
 void CommunicatorBase::setRenderingState(bool state) {
     if(renderingState == state) return;
-    commandSocket.doCommand(state? commandSocket.Command::StartRender : commandSocket.Command::StopRender);
+    if(commandSocket.isSocketOpen()) {
+        commandSocket.doCommand(state? commandSocket.Command::StartRender : commandSocket.Command::StopRender);
+    }
     renderingState = state;
 }
 
@@ -42,6 +48,10 @@ bool CommunicatorBase::nextFrameAvailable() {
     if (latestBlockMessage == nullptr || latestBlockMessage->atSeqReadEnd()) {
         // Need next block
         latestBlockMessage.reset();
+        // Blocks left in the ring after receiving stopped still come before anything on the socket
+        if (receivedBlocks.pop(latestBlockMessage) || receiving) {
+            return latestBlockMessage != nullptr;
+        }
         latestBlockMessage = samplesSocket.receiveBlock();
         if (!latestBlockMessage->success() || latestBlockMessage->getSize() <= 0) {
             assert(latestBlockMessage->getResult() == NNG_EAGAIN || latestBlockMessage->getResult() == NNG_ETIMEDOUT);
@@ -66,6 +76,114 @@ bool CommunicatorBase::copyNextFrame(float* buf, bool bypassAvailabilityCheck) {
     }
 }
 
+void CommunicatorBase::startReceiving() {
+    if(receiving || samplesPort <= 0) return;
+    // Anything still queued is from a previous render
+    std::shared_ptr<TypedNngMsg<float>> staleBlock;
+    while(receivedBlocks.pop(staleBlock)) {
+        staleBlock.reset();
+    }
+    stats.blocksReceived = 0;
+    stats.framesReceived = 0;
+    stats.timeouts = 0;
+    stats.ringFullWaits = 0;
+    stats.underruns = 0;
+    underrunning = false;
+    receiving = true;
+    receiveThread = std::thread(&CommunicatorBase::receiveLoop, this, getReportedChannelCount());
+}
+
+void CommunicatorBase::stopReceiving() {
+    if(!receiving) return;
+    receiving = false; // receiveLoop checks this at least every receive timeout
+    if(receiveThread.joinable()) receiveThread.join();
+}
+
+void CommunicatorBase::receiveLoop(int channels) {
+    while(receiving) {
+        auto block = samplesSocket.receiveBlock();
+        if(!block->success() || block->getSize() <= 0) {
+            assert(block->getResult() == NNG_EAGAIN || block->getResult() == NNG_ETIMEDOUT || block->getResult() == NNG_ECLOSED);
+            // Once the render has ended, nothing more is expected - waiting isn't a timeout
+            if(stats.blocksReceived > 0 && renderingState) stats.timeouts++;
+            continue;
+        }
+        stats.blocksReceived++;
+        if(channels > 0) stats.framesReceived += block->getDataCount() / channels;
+
+        // Never drop audio - wait for the sink to make room
+        bool waited = false;
+        while(!receivedBlocks.push(block)) {
+            if(!receiving) return;
+            waited = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if(waited) stats.ringFullWaits++;
+    }
+}
+
+int CommunicatorBase::availableFrames() {
+    auto channels = getReportedChannelCount();
+    if(channels == 0) return 0;
+    // When not receiving in the background, this waits on the socket for a block
+    if(!receiving && !nextFrameAvailable()) return 0;
+
+    size_t samples = latestBlockMessage ? latestBlockMessage->getRemainingDataCount() : 0;
+    receivedBlocks.forEachQueued([&samples](std::shared_ptr<TypedNngMsg<float>>& block) {
+        samples += block->getDataCount();
+    });
+    return static_cast<int>(samples / channels);
+}
+
+void CommunicatorBase::reportUnderrun() {
+    if(underrunning) return;
+    underrunning = true;
+    stats.underruns++;
+}
+
+bool CommunicatorBase::copyFrames(float* buf, int frameCount, int frameStride) {
+    auto channels = getReportedChannelCount();
+    if(channels == 0) return false;
+    underrunning = false;
+
+    while(frameCount > 0) {
+        if(!nextFrameAvailable()) {
+            // Caller should have checked availableFrames first
+            assert(false);
+            return false;
+        }
+        auto framesInBlock = static_cast<int>(latestBlockMessage->getRemainingDataCount() / channels);
+        if(framesInBlock == 0) {
+            // Partial frame - should never occur, but skip it rather than spin
+            latestBlockMessage->advanceSeqReadPos(static_cast<int>(latestBlockMessage->getRemainingDataCount()));
+            continue;
+        }
+        auto framesToCopy = std::min(framesInBlock, frameCount);
+        auto src = latestBlockMessage->getSeqReadPointer();
+        if(frameStride == channels) {
+            memcpy(buf, src, sizeof(float) * channels * framesToCopy);
+        } else {
+            for(int frame = 0; frame < framesToCopy; ++frame) {
+                memcpy(buf + (frame * frameStride), src + (frame * channels), sizeof(float) * channels);
+            }
+        }
+        latestBlockMessage->advanceSeqReadPos(framesToCopy * channels);
+        buf += framesToCopy * frameStride;
+        frameCount -= framesToCopy;
+    }
+    return true;
+}
+
+ReceiveStats CommunicatorBase::getReceiveStats() const {
+    ReceiveStats current;
+    current.blocksReceived = stats.blocksReceived;
+    current.framesReceived = stats.framesReceived;
+    current.timeouts = stats.timeouts;
+    current.ringFullWaits = stats.ringFullWaits;
+    current.underruns = stats.underruns;
+    return current;
+}
+
 CommunicatorRegistry & CommunicatorRegistry::getInstance()
 {
     static CommunicatorRegistry instance; // Guaranteed to be destroyed, Instantiated on first use.
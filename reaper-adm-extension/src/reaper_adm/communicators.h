@@ -1,6 +1,68 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
 #include "helper/nng_wrappers.h"
 
+template <typename T>
+class BlockRing
+{
+    /*
+    Lock-free ring for handing items from one producer thread to one consumer thread.
+    push() must only be called by the producer, everything else only by the consumer.
+    */
+public:
+    explicit BlockRing(std::size_t capacity) : slots(capacity + 1) {} // One slot always empty so full and empty differ
+
+    bool push(T item) {
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        auto next = increment(write);
+        if(next == readIndex.load(std::memory_order_acquire)) return false;
+        slots[write] = std::move(item);
+        writeIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        auto read = readIndex.load(std::memory_order_relaxed);
+        if(read == writeIndex.load(std::memory_order_acquire)) return false;
+        item = std::move(slots[read]);
+        slots[read] = T{};
+        readIndex.store(increment(read), std::memory_order_release);
+        return true;
+    }
+
+    template <typename Fn>
+    void forEachQueued(Fn&& fn) {
+        auto write = writeIndex.load(std::memory_order_acquire);
+        for(auto read = readIndex.load(std::memory_order_relaxed); read != write; read = increment(read)) {
+            fn(slots[read]);
+        }
+    }
+
+    std::size_t size() const {
+        auto write = writeIndex.load(std::memory_order_acquire);
+        auto read = readIndex.load(std::memory_order_acquire);
+        return (write + slots.size() - read) % slots.size();
+    }
+
+private:
+    std::size_t increment(std::size_t index) const { return (index + 1) % slots.size(); }
+
+    std::vector<T> slots;
+    std::atomic<std::size_t> readIndex{ 0 };
+    std::atomic<std::size_t> writeIndex{ 0 };
+};
+
+struct ReceiveStats {
+    uint64_t blocksReceived{ 0 };
+    uint64_t framesReceived{ 0 };
+    uint64_t timeouts{ 0 };      // Receive timeouts after the first block arrived, until the render ended
+    uint64_t ringFullWaits{ 0 }; // Times the receive thread had to wait for the sink to catch up
+    uint64_t underruns{ 0 };     // Times this source ran dry when the others had frames, once per stall
+};
+
 class CommunicatorBase
 {
 public:
@@ -15,6 +77,18 @@ public:
     virtual bool nextFrameAvailable();
     virtual bool copyNextFrame(float* buf, bool bypassAvailabilityCheck = false);
 
+    // Receive sample blocks on a background thread in to a ring, so a slow socket doesn't hold up other sources.
+    // Whilst receiving, nextFrameAvailable/copyNextFrame take blocks from the ring rather than the socket.
+    void startReceiving();
+    void stopReceiving();
+    // Frames which can be copied right now without waiting
+    int availableFrames();
+    // Copies whole frames of getReportedChannelCount() samples, frameStride samples apart in buf
+    bool copyFrames(float* buf, int frameCount, int frameStride);
+    // Called each time the sink finds this source dry; only the first call of a stall counts
+    void reportUnderrun();
+    ReceiveStats getReceiveStats() const;
+
     virtual int getReportedSampleRate() { return 0; }
     virtual int getReportedChannelCount() { return 0; }
 
@@ -27,12 +101,30 @@ protected:
 
     int commandPort;
     int samplesPort;
-    bool renderingState{ false };
+    std::atomic<bool> renderingState{ false }; // Read by the receive thread
 
     SamplesReceiver samplesSocket;
     CommandSender commandSocket;
 
     std::shared_ptr<TypedNngMsg<float>> latestBlockMessage;
+
+private:
+    // Takes the channel count up front, as derived classes may be gone before the thread is stopped
+    void receiveLoop(int channels);
+
+    static constexpr std::size_t receivedBlocksCapacity{ 256 };
+    BlockRing<std::shared_ptr<TypedNngMsg<float>>> receivedBlocks{ receivedBlocksCapacity };
+    std::thread receiveThread;
+    std::atomic<bool> receiving{ false };
+    bool underrunning{ false }; // Sink thread only
+
+    struct {
+        std::atomic<uint64_t> blocksReceived{ 0 };
+        std::atomic<uint64_t> framesReceived{ 0 };
+        std::atomic<uint64_t> timeouts{ 0 };
+        std::atomic<uint64_t> ringFullWaits{ 0 };
+        std::atomic<uint64_t> underruns{ 0 };
+    } stats;
 };
 
 class CommunicatorRegistry
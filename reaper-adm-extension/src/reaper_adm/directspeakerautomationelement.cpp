@@ -34,8 +34,9 @@ std::optional<AutomationPoint> getPoint(Parameter const& param, adm::AudioBlockF
 }
 }
 
-DirectSpeakersAutomationElement::DirectSpeakersAutomationElement(ADMChannel channel, std::shared_ptr<TrackElement> track, std::shared_ptr<TakeElement> take) :
-    admChannel{ std::move(channel) }
+DirectSpeakersAutomationElement::DirectSpeakersAutomationElement(ADMChannel channel, std::shared_ptr<TrackElement> track, std::shared_ptr<TakeElement> take, std::shared_ptr<ImportSettings const> settings) :
+    admChannel{ std::move(channel) },
+    settings{ std::move(settings) }
 {
     parentTake_ = take;
     parentTrack_ = track;
@@ -87,12 +88,12 @@ int DirectSpeakersAutomationElement::channelIndex() const
 
 void DirectSpeakersAutomationElement::apply(const PluginParameter &parameter, const Plugin &plugin) const
 {
-    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, plugin);
+    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, plugin, simplificationTolerance());
 }
 
 void DirectSpeakersAutomationElement::apply(const TrackParameter &parameter, const Track &track) const
 {
-    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, track);
+    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, track, simplificationTolerance());
 }
 
 std::vector<adm::ElementConstVariant> DirectSpeakersAutomationElement::getAdmElements() const
@@ -118,3 +119,9 @@ ADMChannel admplug::DirectSpeakersAutomationElement::channel() const
 {
     return admChannel;
 }
+
+double DirectSpeakersAutomationElement::simplificationTolerance() const
+{
+    if(!settings) return 0.0;
+    return automationSimplificationTolerance(settings->automationSimplification);
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "projectelements.h"
+#include "importsettings.h"
 #include "automationpoint.h"
 
 namespace admplug {
@@ -9,7 +10,7 @@ class Parameter;
 class DirectSpeakersAutomationElement : public DirectSpeakersAutomation
 {
 public:
-    DirectSpeakersAutomationElement(ADMChannel admChannel, std::shared_ptr<TrackElement> parentTrack, std::shared_ptr<TakeElement> parentTake = nullptr);
+    DirectSpeakersAutomationElement(ADMChannel admChannel, std::shared_ptr<TrackElement> parentTrack, std::shared_ptr<TakeElement> parentTake = nullptr, std::shared_ptr<ImportSettings const> settings = nullptr);
     void createProjectElements(PluginSuite &pluginSuite, const ReaperAPI &api) override;
     adm::BlockFormatsConstRange<adm::AudioBlockFormatDirectSpeakers> blocks() const override;
     double startTime() const override;
@@ -22,7 +23,9 @@ public:
 private:
     std::vector<adm::ElementConstVariant> getAdmElements() const override;
     std::vector<AutomationPoint> pointsFor(const Parameter &parameter) const;
+    double simplificationTolerance() const;
     ADMChannel admChannel;
+    std::shared_ptr<ImportSettings const> settings;
 };
 
 }
@@ -1,5 +1,6 @@
 #include "exportaction_admsource-admvst.h"
 
+#include "exportaction_projectindex.h"
 #include "pluginregistry.h"
 #include <version/eps_version.h>
 #include <helper/adm_preset_definitions_helper.h>
@@ -9,6 +10,8 @@
 #include <adm/write.hpp>
 #include <adm/common_definitions.hpp>
 #include <optional>
+#include <algorithm>
+#include <stdexcept>
 
 namespace {
 std::vector<adm::TypeDescriptor> getAdmTypeDefinitionsExcluding(adm::TypeDescriptor exclude) {
@@ -22,7 +25,7 @@ std::vector<adm::TypeDescriptor> getAdmTypeDefinitionsExcluding(adm::TypeDescrip
 }
 }
 
-AdmVstExportSources::AdmVstExportSources(ReaperAPI const& api) : IExportSources(api)
+AdmVstExportSources::AdmVstExportSources(ReaperAPI const& api, ExportProjectIndex const& projectIndex) : IExportSources(api)
 {
 	admDocument = adm::Document::create();
 	admDocument->set(adm::Version("ITU-R_BS.2076-2"));
@@ -33,41 +36,31 @@ AdmVstExportSources::AdmVstExportSources(ReaperAPI const& api) : IExportSources(
 	admDocument->add(admProgramme);
 	admProgramme->addReference(admContent);
 
-	MediaTrack* trk;
-	int numTracks = api.CountTracks(nullptr);
+	for (auto const& location : projectIndex.getFxLocationsFor(*AdmVst::getVstNameStr())) {
+		auto trk = location.track;
+		auto admExportVst = std::make_shared<AdmVst>(trk, location.fxIndex, api);
+		allAdmVsts.push_back(admExportVst);
 
-	for (int trackNum = 0; trackNum < numTracks; trackNum++) {
+		if (AdmVst::isCandidateForExport(admExportVst)) {
 
-		trk = api.GetTrack(nullptr, trackNum);
-		if (trk) {
-
-			auto fxPosVec = AdmVst::trackAdmVstIndexes(api, trk);
-			for (int fxPos : fxPosVec) {
-				auto admExportVst = std::make_shared<AdmVst>(trk, fxPos, api);
-				allAdmVsts.push_back(admExportVst);
-
-				if (AdmVst::isCandidateForExport(admExportVst)) {
-
-					char aoName[100];
-					std::string aoNameStr = "Audio Object";
-					if (api.GetTrackName(trk, aoName, 100)) {
-						aoNameStr = aoName;
-					}
-
-					auto bounds = api.getTrackAudioBounds(trk, true); // True = ignore before zero - we don't do sub-zero bounds
+			char aoName[100];
+			std::string aoNameStr = "Audio Object";
+			if (api.GetTrackName(trk, aoName, 100)) {
+				aoNameStr = aoName;
+			}
 
-					auto audioObject = adm::AudioObject::create(adm::AudioObjectName(aoNameStr));
-					if (bounds.has_value()) {
-						audioObject->set(adm::Start{ toNs((*bounds).first) });
-						audioObject->set(adm::Duration{ toNs((*bounds).second - (*bounds).first) });
-					}
+			auto bounds = api.getTrackAudioBounds(trk, true); // True = ignore before zero - we don't do sub-zero bounds
 
-					admContent->addReference(audioObject);
-					// Construction generates ADM
-					auto candidate = std::make_shared<AdmVstExporter>(admExportVst, admContent, audioObject, api);
-					candidatesForExport.push_back(candidate);
-				}
+			auto audioObject = adm::AudioObject::create(adm::AudioObjectName(aoNameStr));
+			if (bounds.has_value()) {
+				audioObject->set(adm::Start{ toNs((*bounds).first) });
+				audioObject->set(adm::Duration{ toNs((*bounds).second - (*bounds).first) });
 			}
+
+			admContent->addReference(audioObject);
+			// Construction generates ADM
+			auto candidate = std::make_shared<AdmVstExporter>(admExportVst, admContent, audioObject, api);
+			candidatesForExport.push_back(candidate);
 		}
 	}
 
@@ -191,7 +184,15 @@ int AdmVstExportSources::getTotalExportChannels()
 void AdmVstExportSources::setRenderInProgress(bool state)
 {
 	for (auto& candidate : candidatesForExport) {
-		candidate->setRenderInProgressState(true);
+		candidate->setRenderInProgressState(state);
+		// Each source receives on its own thread so one slow socket doesn't stall the rest
+		if (auto communicator = candidate->getCommunicator()) {
+			if (state) {
+				communicator->startReceiving();
+			} else {
+				communicator->stopReceiving();
+			}
+		}
 	}
 }
 
@@ -222,6 +223,67 @@ bool AdmVstExportSources::writeNextFrameTo(float* bufferWritePointer, bool skipF
 	return true;
 }
 
+int AdmVstExportSources::writeNextFramesTo(float* bufferWritePointer, int maxFrames, int frameStride)
+{
+	// Only as many frames as every source has ready
+	int frames = maxFrames;
+	bool anySourceReady = false;
+	std::vector<int> availableFrames;
+	availableFrames.reserve(candidatesForExport.size());
+	for (auto& candidate : candidatesForExport) {
+		auto communicator = candidate->getCommunicator();
+		if (!communicator) return 0;
+		int available = communicator->getReportedChannelCount() > 0 ? communicator->availableFrames() : maxFrames;
+		availableFrames.push_back(available);
+		frames = std::min(frames, available);
+		if (available > 0) anySourceReady = true;
+	}
+
+	if (frames <= 0) {
+		if (anySourceReady) {
+			for (std::size_t i = 0; i < candidatesForExport.size(); ++i) {
+				if (availableFrames[i] == 0) candidatesForExport[i]->getCommunicator()->reportUnderrun();
+			}
+		}
+		return 0;
+	}
+
+	for (auto& candidate : candidatesForExport) {
+		auto communicator = candidate->getCommunicator();
+		if (communicator->getReportedChannelCount() > 0) {
+			if (!communicator->copyFrames(bufferWritePointer, frames, frameStride)) {
+				throw std::runtime_error("copyFrames failed");
+			}
+			bufferWritePointer += communicator->getReportedChannelCount();
+		}
+	}
+	return frames;
+}
+
+std::vector<std::string> AdmVstExportSources::generateRenderReportStrings()
+{
+	std::vector<std::string> reportStrings;
+	for (auto& candidate : candidatesForExport) {
+		auto communicator = candidate->getCommunicator();
+		if (!communicator) continue;
+		auto stats = communicator->getReceiveStats();
+		if (stats.timeouts == 0 && stats.underruns == 0) continue;
+
+		std::string op = "\"";
+		auto audioObject = candidate->getAudioObject();
+		op.append(audioObject ? audioObject->get<adm::AudioObjectName>().get() : std::string("Unknown"));
+		op.append("\": received ");
+		op.append(std::to_string(stats.framesReceived));
+		op.append(" frames, ");
+		op.append(std::to_string(stats.timeouts));
+		op.append(" receive timeouts, ");
+		op.append(std::to_string(stats.underruns));
+		op.append(" underruns");
+		reportStrings.push_back(op);
+	}
+	return reportStrings;
+}
+
 std::shared_ptr<bw64::AxmlChunk> AdmVstExportSources::getAxmlChunk()
 {
 	std::stringstream xmlStream;
@@ -362,7 +424,7 @@ void AdmVstExporter::newAdmPresetDefinitionReference(ReaperAPI const& api)
 			specificCfIdValue = channelFormatIdValue;
 
 		auto holder = presets.setupPresetDefinitionObject(parentDocument, audioObject,
-			pfData->packFormat->get<adm::AudioPackFormatId>(), specificCfIdValue);
+			adm::parseAudioPackFormatId(pfData->fullId), specificCfIdValue);
 
 		audioPackFormat = holder.audioPackFormat;
 
@@ -11,6 +11,8 @@
 
 #include <memory>
 
+class ExportProjectIndex;
+
 typedef struct {
     std::shared_ptr<adm::AudioChannelFormat> audioChannelFormat;
     std::shared_ptr<adm::AudioStreamFormat> audioStreamFormat;
@@ -103,7 +105,7 @@ class AdmVstExportSources : public IExportSources
     A container for handling ADM sources provided by ADM Export Source VSTs
     */
 public:
-    AdmVstExportSources(ReaperAPI const&api);
+    AdmVstExportSources(ReaperAPI const&api, ExportProjectIndex const& projectIndex);
     ~AdmVstExportSources() {}
 
     bool documentRequiresProgrammeTitles() override { return true; }
@@ -118,6 +120,7 @@ public:
     void setRenderInProgress(bool state) override;
     bool isFrameAvailable() override;
     bool writeNextFrameTo(float* bufferWritePointer, bool skipFrameAvailableCheck = false) override;
+    int writeNextFramesTo(float* bufferWritePointer, int maxFrames, int frameStride) override;
 
     std::shared_ptr<bw64::AxmlChunk> getAxmlChunk() override;
     std::shared_ptr<bw64::ChnaChunk> getChnaChunk() override;
@@ -126,6 +129,7 @@ public:
     std::vector<std::string> generateExportInfoStrings() override { return infoStrings; }
     std::vector<std::string> generateExportErrorStrings() override { return errorStrings; }
     std::vector<std::string> generateExportWarningStrings() override { return warningStrings; }
+    std::vector<std::string> generateRenderReportStrings() override;
 
     std::string getExportSourcesName() override {
         return std::string("ADM Export Source VSTs");
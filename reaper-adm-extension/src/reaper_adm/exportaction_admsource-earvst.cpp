@@ -1,9 +1,11 @@
 #include "exportaction_admsource-earvst.h"
 
+#include "exportaction_projectindex.h"
 #include "pluginregistry.h"
 #include "pluginsuite_ear.h"
 #include <version/eps_version.h>
 #include <helper/adm_preset_definitions_helper.h>
+#include <helper/adm_template_codec.h>
 #include <speaker_setups.hpp>
 
 #include <adm/write.hpp>
@@ -11,37 +13,30 @@
 #include <adm/parse.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #include <daw_channel_count.h>
 
 using namespace admplug;
 
-EarVstExportSources::EarVstExportSources(ReaperAPI const & api) : IExportSources(api)
+EarVstExportSources::EarVstExportSources(ReaperAPI const & api, ExportProjectIndex const& projectIndex, AdmExportFormat format) : IExportSources(api), format{ format }
 {
-    MediaTrack *trk;
-    int numTracks = api.CountTracks(nullptr);
+    for(auto const& location : projectIndex.getFxLocationsFor(*EarSceneMasterVst::getVstNameStr())) {
+        auto earSceneMasterVst = std::make_shared<EarSceneMasterVst>(location.track, location.fxIndex, api);
+        auto comms = earSceneMasterVst->getCommunicator(true);
+        if(comms) comms->updateInfo();
 
-    for (int trackNum = 0; trackNum < numTracks; trackNum++) {
-
-        trk = api.GetTrack(nullptr, trackNum);
-        if (trk) {
-
-            auto fxPosVec = EarSceneMasterVst::trackEarSceneMasterVstIndexes(api, trk);
-            for(int fxPos : fxPosVec) {
-                auto earSceneMasterVst = std::make_shared<EarSceneMasterVst>(trk, fxPos, api);
-                auto comms = earSceneMasterVst->getCommunicator(true);
-                if(comms) comms->updateInfo();
-
-                allEarSceneMasterVsts.push_back(earSceneMasterVst);
-                if(EarSceneMasterVst::isCandidateForExport(earSceneMasterVst)) {
-                    if(!chosenCandidateForExport) {
-                        chosenCandidateForExport = earSceneMasterVst;
-                        generateAdmAndChna(api);
-                    }
-                    candidatesForExport.push_back(earSceneMasterVst);
-                }
+        allEarSceneMasterVsts.push_back(earSceneMasterVst);
+        if(EarSceneMasterVst::isCandidateForExport(earSceneMasterVst)) {
+            if(!chosenCandidateForExport) {
+                chosenCandidateForExport = earSceneMasterVst;
+                generateAdmAndChna(api, projectIndex);
             }
+            candidatesForExport.push_back(earSceneMasterVst);
         }
     }
 
@@ -100,14 +95,16 @@ bool EarVstExportSources::writeNextFrameTo(float * bufferWritePointer, bool skip
     return true;
 }
 
-void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
+void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api, ExportProjectIndex const& projectIndex)
 {
     using namespace adm;
 
     // Get ADM template in to admDocument
-    std::istringstream sstr(chosenCandidateForExport->getAdmTemplateStr());
     try {
-        admDocument = adm::parseXml(sstr, adm::xml::ParserOptions::recursive_node_search); // Shouldn't need recursive here, but doesn't harm to do it anyway
+        admDocument = chosenCandidateForExport->getAdmTemplate();
+        if(!admDocument) {
+            throw std::runtime_error("No connection to the Scene plugin");
+        }
     } catch(std::exception &e) {
         std::string str = "Failed to parse ADM template: \"";
         str += e.what();
@@ -116,18 +113,20 @@ void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
         return;
     }
 
+    auto channelMappings = chosenCandidateForExport->getChannelMappings();
+
     // Any track UID that won't be written should be removed
-    std::vector<uint32_t> audioTrackUidIdsInChannelMappings;
-    for(auto const& channelMapping : chosenCandidateForExport->getChannelMappings()) {
+    std::unordered_set<uint32_t> mappedAudioTrackUids;
+    for(auto const& channelMapping : channelMappings) {
         for(auto const& plugin : channelMapping.plugins) {
-            audioTrackUidIdsInChannelMappings.push_back(plugin.audioTrackUidVal);
+            mappedAudioTrackUids.insert(plugin.audioTrackUidVal);
         }
     }
     auto docAudioTrackUids = admDocument->getElements<adm::AudioTrackUid>();
     std::vector<std::shared_ptr<adm::AudioTrackUid>> missingList;
     for(auto docAudioTrackUid : docAudioTrackUids) {
         uint32_t idValue = docAudioTrackUid->get<adm::AudioTrackUidId>().get<adm::AudioTrackUidIdValue>().get();
-        if(std::find(audioTrackUidIdsInChannelMappings.begin(), audioTrackUidIdsInChannelMappings.end(), idValue) == audioTrackUidIdsInChannelMappings.end()) {
+        if(mappedAudioTrackUids.count(idValue) == 0) {
             missingList.push_back(docAudioTrackUid);
         }
     }
@@ -146,7 +145,7 @@ void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
     // Create CHNA chunk
     std::vector<bw64::AudioId> audioIds;
 
-    for(auto const& channelMapping : chosenCandidateForExport->getChannelMappings()) {
+    for(auto const& channelMapping : channelMappings) {
         for(auto const& plugin : channelMapping.plugins) {
             auto admElements = getAdmElementsFor(plugin);
             assert(admElements.has_value());
@@ -174,10 +173,14 @@ void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
     chnaChunk = std::make_shared<bw64::ChnaChunk>(bw64::ChnaChunk(audioIds));
 
     //Populate rest of ADM template (admDocument) here with AudioBlockFormats
+    // This is done in two phases;
+    //  - Gather everything we need from REAPER on this (main) thread
+    //  - Generate the blocks from that data in parallel, since this is where the bulk of the time goes
+    // Results are added to the document in channel mapping order so the output is deterministic
 
     std::shared_ptr<admplug::PluginSuite> pluginSuite = std::make_shared<EARPluginSuite>();
+    std::vector<BlockGenerationJob> jobs;
 
-    auto channelMappings = chosenCandidateForExport->getChannelMappings();
     for(auto const& channelMapping : channelMappings) {
         for(auto const& plugin : channelMapping.plugins) {
 
@@ -186,7 +189,7 @@ void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
 
             // Find the associated plugin
 
-            auto feedingPlugins = getEarInputPluginsWithInputInstanceId(plugin.inputInstanceId, api);
+            auto feedingPlugins = projectIndex.getEarInputPluginsWithInputInstanceId(plugin.inputInstanceId);
             if(feedingPlugins.size() == 0) {
                 std::string msg("Unable to find Input plugin with instance ID ");
                 msg += std::to_string(plugin.inputInstanceId);
@@ -231,42 +234,7 @@ void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
             if (!isPresetDef) {
                 if (isObjectType) {
                     // Need to generate BFs
-                    auto cumulatedPointData = CumulatedPointData(start, start + duration);
-
-                    // Get all values for all parameters, whether automated or not.
-                    for (int admParameterIndex = 0; admParameterIndex != (int)AdmParameter::NONE; admParameterIndex++) {
-                        auto admParameter = (AdmParameter)admParameterIndex;
-                        auto param = pluginSuite->getParameterFor(admParameter);
-                        auto env = getEnvelopeFor(pluginSuite, pluginInst.get(), admParameter, api);
-
-                        if (getEnvelopeBypassed(env, api)) {
-                            // We have an envelope, but it is bypassed
-                            auto val = getValueFor(pluginSuite, pluginInst.get(), admParameter, api);
-                            auto newErrors = cumulatedPointData.useConstantValueForParameter(admParameter, *val);
-                            for (auto& newError : newErrors) {
-                                warningStrings.push_back(newError.what());
-                            }
-
-                        } else if (param && env) {
-                            // We have an envelope for this ADM parameter
-                            auto newErrors = cumulatedPointData.useEnvelopeDataForParameter(*env, *param, admParameter, api);
-                            for (auto& newError : newErrors) {
-                                warningStrings.push_back(newError.what());
-                            }
-
-                        } else if (auto val = getValueFor(pluginSuite, pluginInst.get(), admParameter, api)) {
-                            // We do not have an envelope for this ADM parameter but the plugin suite CAN provide a fixed value for it
-                            // NOTE that this will include parameters NOT relevant to the current audioObject type, but these are ignored during block creation.
-                            auto newErrors = cumulatedPointData.useConstantValueForParameter(admParameter, *val);
-                            for (auto& newError : newErrors) {
-                                warningStrings.push_back(newError.what());
-                            }
-                        }
-                    }
-
-                    auto blocks = cumulatedPointData.generateAudioBlockFormatObjects(pluginSuite, pluginInst.get(), api);
-                    for (auto& block : *blocks) admElements->audioChannelFormat->add(*block);
-
+                    jobs.push_back(snapshotBlockGenerationJob(pluginSuite, pluginInst.get(), admElements->audioChannelFormat, start, duration, api));
                 }
                 else {
                     warningStrings.push_back("Currently only supporting Preset Definitions for non-Objects types");
@@ -275,6 +243,31 @@ void EarVstExportSources::generateAdmAndChna(ReaperAPI const& api)
         }
     }
 
+    if(format == AdmExportFormat::SERIAL_ADM) {
+        // Blocks are generated a frame at a time whilst rendering, off the main thread.
+        // Anything which needs REAPER to evaluate has to be done now, in full.
+        for(auto& job : jobs) {
+            if(job.requiresMainThread) generateBlocks(job);
+            for(auto& warning : job.warnings) {
+                warningStrings.push_back(warning);
+            }
+            job.warnings.clear();
+        }
+        serialAdmJobs = std::move(jobs);
+        return; // No AXML chunk - the metadata is written as S-ADM frames
+    }
+
+    generateBlocks(jobs);
+
+    for(auto& job : jobs) {
+        for(auto& warning : job.warnings) {
+            warningStrings.push_back(warning);
+        }
+        for(auto& block : job.blocks) {
+            job.audioChannelFormat->add(*block);
+        }
+    }
+
     // Create AXML Chunk
     std::stringstream xmlStream;
     adm::writeXml(xmlStream, admDocument);
@@ -357,6 +350,178 @@ std::optional<EarVstExportSources::AdmElements> EarVstExportSources::getAdmEleme
 
 }
 
+EarVstExportSources::BlockGenerationJob EarVstExportSources::snapshotBlockGenerationJob(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, std::shared_ptr<adm::AudioChannelFormat> audioChannelFormat, std::chrono::nanoseconds start, std::chrono::nanoseconds duration, ReaperAPI const& api)
+{
+    BlockGenerationJob job;
+    job.audioChannelFormat = audioChannelFormat;
+    job.start = start;
+    job.duration = duration;
+    job.useSphericalCoordinates = pluginSuite->pluginUsesSphericalCoordinates(pluginInst);
+
+    // Get all values for all parameters, whether automated or not.
+    for (int admParameterIndex = 0; admParameterIndex != (int)AdmParameter::NONE; admParameterIndex++) {
+        auto admParameter = (AdmParameter)admParameterIndex;
+        auto param = pluginSuite->getParameterFor(admParameter);
+        auto env = getEnvelopeFor(pluginSuite, pluginInst, admParameter, api);
+
+        if (getEnvelopeBypassed(env, api)) {
+            // We have an envelope, but it is bypassed
+            job.parameters.push_back({ admParameter, param, nullptr, getValueFor(pluginSuite, pluginInst, admParameter, api) });
+
+        } else if (param && env) {
+            // We have an envelope for this ADM parameter
+            std::shared_ptr<EnvelopeDataSource> envelopeData = EnvelopeSnapshot::capture(*env, api);
+            if(!envelopeData) {
+                // Can't evaluate this envelope without REAPER - the job will have to run on this thread
+                envelopeData = std::make_shared<ReaperEnvelopeDataSource>(*env, api);
+                job.requiresMainThread = true;
+            }
+            job.parameters.push_back({ admParameter, param, envelopeData, std::optional<double>() });
+
+        } else if (auto val = getValueFor(pluginSuite, pluginInst, admParameter, api)) {
+            // We do not have an envelope for this ADM parameter but the plugin suite CAN provide a fixed value for it
+            // NOTE that this will include parameters NOT relevant to the current audioObject type, but these are ignored during block creation.
+            job.parameters.push_back({ admParameter, param, nullptr, val });
+        }
+    }
+
+    return job;
+}
+
+void EarVstExportSources::generateBlocks(BlockGenerationJob& job)
+{
+    auto cumulatedPointData = CumulatedPointData(job.start, job.start + job.duration);
+
+    for (auto& parameter : job.parameters) {
+        std::vector<AdmAuthoringError> newErrors;
+        if (parameter.envelope) {
+            newErrors = cumulatedPointData.useEnvelopeDataForParameter(parameter.envelope, *parameter.parameter, parameter.admParameter);
+        } else if (parameter.constantValue) {
+            newErrors = cumulatedPointData.useConstantValueForParameter(parameter.admParameter, *parameter.constantValue);
+        }
+        for (auto& newError : newErrors) {
+            job.warnings.push_back(newError.what());
+        }
+    }
+
+    auto blocks = cumulatedPointData.generateAudioBlockFormatObjects(job.useSphericalCoordinates);
+    if (blocks) job.blocks = std::move(*blocks);
+}
+
+void EarVstExportSources::generateBlocks(std::vector<BlockGenerationJob>& jobs)
+{
+    std::vector<BlockGenerationJob*> parallelJobs;
+    std::vector<BlockGenerationJob*> mainThreadJobs;
+    for (auto& job : jobs) {
+        if (job.requiresMainThread) {
+            mainThreadJobs.push_back(&job);
+        } else {
+            parallelJobs.push_back(&job);
+        }
+    }
+
+    // Workers pull jobs from a shared index. Each job only writes to itself, so the order of completion doesn't matter.
+    std::atomic<std::size_t> nextJob{ 0 };
+    auto worker = [&parallelJobs, &nextJob]() {
+        for (auto i = nextJob++; i < parallelJobs.size(); i = nextJob++) {
+            generateBlocks(*parallelJobs[i]);
+        }
+    };
+
+    std::size_t workerCount = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), parallelJobs.size());
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::async(std::launch::async, worker));
+    }
+
+    // Anything needing the REAPER API is done here while the workers get on with the rest
+    for (auto job : mainThreadJobs) {
+        generateBlocks(*job);
+    }
+
+    for (auto& w : workers) {
+        w.get();
+    }
+}
+
+EarVstExportSources::BlockGenerationJob EarVstExportSources::sliceBlockGenerationJob(BlockGenerationJob const& job, std::chrono::nanoseconds from, std::chrono::nanoseconds to)
+{
+    BlockGenerationJob slice;
+    slice.audioChannelFormat = job.audioChannelFormat;
+    slice.start = from;
+    slice.duration = to - from;
+    slice.useSphericalCoordinates = job.useSphericalCoordinates;
+
+    for(auto const& parameter : job.parameters) {
+        auto slicedParameter = parameter;
+        if(auto snapshot = std::dynamic_pointer_cast<EnvelopeSnapshot>(parameter.envelope)) {
+            slicedParameter.envelope = snapshot->slice(fromNs(from), fromNs(to));
+        }
+        slice.parameters.push_back(slicedParameter);
+    }
+
+    return slice;
+}
+
+void EarVstExportSources::writeSerialAdmFrameTo(std::ostream& os, std::chrono::nanoseconds start, std::chrono::nanoseconds duration)
+{
+    auto end = start + duration;
+
+    std::vector<BlockGenerationJob> frameJobs;
+    std::vector<std::chrono::nanoseconds> rtimeOffsets; // Sliced blocks are timed from the frame, not the object
+    std::vector<std::shared_ptr<adm::AudioChannelFormat>> populatedChannelFormats;
+
+    for(auto const& job : serialAdmJobs) {
+        auto jobEnd = job.start + job.duration;
+        auto windowStart = std::max(start, job.start);
+        auto windowEnd = std::min(end, jobEnd);
+        if(windowStart >= windowEnd) continue;
+
+        if(job.requiresMainThread) {
+            // Generated in full before the render - take the blocks active during this frame
+            for(auto const& block : job.blocks) {
+                auto blockStart = job.start + block->get<adm::Rtime>().get().asNanoseconds();
+                auto blockEnd = blockStart + block->get<adm::Duration>().get().asNanoseconds();
+                if(blockStart < windowEnd && (blockEnd > windowStart || blockStart >= windowStart)) {
+                    job.audioChannelFormat->add(*block);
+                }
+            }
+            populatedChannelFormats.push_back(job.audioChannelFormat);
+        } else {
+            frameJobs.push_back(sliceBlockGenerationJob(job, windowStart, windowEnd));
+            rtimeOffsets.push_back(windowStart - job.start);
+        }
+    }
+
+    generateBlocks(frameJobs);
+
+    for(std::size_t i = 0; i < frameJobs.size(); ++i) {
+        auto& frameJob = frameJobs[i];
+        for(auto& block : frameJob.blocks) {
+            auto rtime = block->get<adm::Rtime>().get().asNanoseconds();
+            block->set(adm::Rtime(rtime + rtimeOffsets[i]));
+            frameJob.audioChannelFormat->add(*block);
+        }
+        populatedChannelFormats.push_back(frameJob.audioChannelFormat);
+    }
+
+    std::stringstream xmlStream;
+    adm::writeXml(xmlStream, admDocument);
+
+    // Blocks only live for the frame, so memory use doesn't grow with programme length
+    for(auto& audioChannelFormat : populatedChannelFormats) {
+        audioChannelFormat->clearAudioBlockFormats();
+    }
+
+    // S-ADM frames carry the audioFormatExtended element directly, without the ebuCoreMain wrapper
+    auto xmlStr = xmlStream.str();
+    auto afeStart = xmlStr.find("<audioFormatExtended");
+    std::string const afeEndTag{ "</audioFormatExtended>" };
+    auto afeEnd = xmlStr.rfind(afeEndTag);
+    if(afeStart == std::string::npos || afeEnd == std::string::npos) return;
+    os.write(xmlStr.data() + afeStart, afeEnd + afeEndTag.size() - afeStart);
+}
+
 TrackEnvelope* EarVstExportSources::getEnvelopeFor(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance * pluginInst, AdmParameter admParameter, ReaperAPI const & api)
 {
     MediaTrack* track = pluginInst->getTrackInstance().get();
@@ -402,25 +567,6 @@ bool EarVstExportSources::getEnvelopeBypassed(TrackEnvelope* env, ReaperAPI cons
     return envBypassed;
 }
 
-std::vector<std::shared_ptr<PluginInstance>> EarVstExportSources::getEarInputPluginsWithInputInstanceId(uint32_t inputInstanceId, ReaperAPI const& api)
-{
-    std::vector<std::shared_ptr<PluginInstance>> insts;
-
-    for(int trackNum = 0; trackNum < api.CountTracks(0); trackNum++) {
-        auto trk = api.GetTrack(0, trackNum);
-        for(int vstPos = 0; vstPos < api.TrackFX_GetCount(trk); vstPos++) {
-            if(EarInputVst::isInputPlugin(api, trk, vstPos)) {
-                auto pluginInst = std::make_shared<EarInputVst>(trk, vstPos, api);
-
-                if(pluginInst->getInputInstanceId() == inputInstanceId) {
-                    insts.push_back(std::make_shared<PluginInstance>(trk, vstPos, api));
-                }
-            }
-        }
-    }
-    return insts;
-}
-
 //EarInputVst
 
 std::string EarInputVst::directSpeakersVstName = admplug::EARPluginSuite::DIRECTSPEAKERS_METADATA_PLUGIN_NAME;
@@ -620,10 +766,10 @@ int EarSceneMasterVst::getChannelCount()
     return communicator->getReportedChannelCount();
 }
 
-std::string EarSceneMasterVst::getAdmTemplateStr()
+std::shared_ptr<adm::Document> EarSceneMasterVst::getAdmTemplate()
 {
-    if(!isCommunicatorPresent() && !obtainCommunicator()) return "";
-    return communicator->getAdmTemplateStr();
+    if(!isCommunicatorPresent() && !obtainCommunicator()) return nullptr;
+    return communicator->getAdmTemplate();
 }
 
 std::vector<EarVstCommunicator::ChannelMapping> EarSceneMasterVst::getChannelMappings()
@@ -731,10 +877,28 @@ void EarVstCommunicator::infoExchange()
     memcpy(&sampleRate, (char*)resp->getBufferPointer() + 1, 4);
 }
 
+std::shared_ptr<adm::Document> EarVstCommunicator::getAdmTemplate()
+{
+    if(AdmTemplateCodec::isEncoded(admStr)) {
+        return AdmTemplateCodec::decode(admStr);
+    }
+    std::istringstream sstr(admStr);
+    return adm::parseXml(sstr, adm::xml::ParserOptions::recursive_node_search); // Shouldn't need recursive here, but doesn't harm to do it anyway
+}
+
 void EarVstCommunicator::admAndMappingExchange()
 {
-    auto resp = commandSocket.doCommand(commandSocket.Command::GetAdmAndMappings);
+    // The binary template saves writing and re-parsing XML for every render
+    auto resp = commandSocket.doCommand(commandSocket.Command::GetBinaryAdmAndMappings);
     assert(resp->success());
+    uint8_t respCmd = 0;
+    memcpy(&respCmd, resp->getBufferPointer(), sizeof(uint8_t));
+    if(respCmd != commandSocket.Command::GetBinaryAdmAndMappingsResp &&
+       respCmd != commandSocket.Command::GetAdmAndMappingsResp) {
+        // Scene plugin predates the binary template, and just echoed the command
+        resp = commandSocket.doCommand(commandSocket.Command::GetAdmAndMappings);
+        assert(resp->success());
+    }
 
     std::string admStrRecv;
     std::vector<PluginToAdmMap> pluginToAdmMaps;
@@ -15,6 +15,8 @@
 
 using namespace admplug;
 
+class ExportProjectIndex;
+
 class EarVstCommunicator : public CommunicatorBase
 {
 public:
@@ -34,7 +36,8 @@ public:
 
 	int getReportedSampleRate() override { return sampleRate; }
 	int getReportedChannelCount() override { return channelMappings.size(); }
-	std::string getAdmTemplateStr() { return admStr; }
+	// A fresh document each call, as the caller adds to it
+	std::shared_ptr<adm::Document> getAdmTemplate();
 	std::vector<ChannelMapping> getChannelMappings() { return channelMappings; }
 
 	void sendAdm(std::string originalAdmStr, std::vector<PluginToAdmMap> pluginToAdmMaps);
@@ -43,6 +46,7 @@ private:
 	void infoExchange();
 	void admAndMappingExchange();
 
+	// From AdmTemplateCodec, or XML from Scene plugins without it
 	std::string admStr;
 	std::vector<ChannelMapping> channelMappings;
 
@@ -105,7 +109,7 @@ public:
 
 	int getSampleRate();
 	int getChannelCount();
-	std::string getAdmTemplateStr();
+	std::shared_ptr<adm::Document> getAdmTemplate();
 	std::vector<EarVstCommunicator::ChannelMapping> getChannelMappings();
 	bool getRenderInProgressState();
 	void setRenderInProgressState(bool state);
@@ -141,7 +145,7 @@ class EarVstExportSources : public IExportSources
 	A container for handling ADM sources provided by EAR SceneMaster VSTs
 	*/
 public:
-	EarVstExportSources(ReaperAPI const& api);
+	EarVstExportSources(ReaperAPI const& api, ExportProjectIndex const& projectIndex, AdmExportFormat format = AdmExportFormat::BW64_AXML);
 	~EarVstExportSources() {};
 
 	bool documentRequiresProgrammeTitles() override { return false; }
@@ -161,6 +165,9 @@ public:
 	std::shared_ptr<bw64::ChnaChunk> getChnaChunk() override { return chnaChunk; }
 	std::shared_ptr<adm::Document> getAdmDocument() override { return admDocument; }
 
+	bool supportsSerialAdm() override { return format == AdmExportFormat::SERIAL_ADM && admDocument != nullptr; }
+	void writeSerialAdmFrameTo(std::ostream& os, std::chrono::nanoseconds start, std::chrono::nanoseconds duration) override;
+
 	std::vector<std::string> generateExportInfoStrings() override { return infoStrings; }
 	std::vector<std::string> generateExportErrorStrings() override { return errorStrings; }
 	std::vector<std::string> generateExportWarningStrings() override { return warningStrings; }
@@ -170,7 +177,7 @@ public:
 	}
 
 private:
-	void generateAdmAndChna(ReaperAPI const& api);
+	void generateAdmAndChna(ReaperAPI const& api, ExportProjectIndex const& projectIndex);
 
 	struct AdmElements {
 		adm::TypeDescriptor typeDescriptor;
@@ -182,6 +189,30 @@ private:
 	};
 	std::optional<AdmElements> getAdmElementsFor(const PluginToAdmMap& plugin);
 
+	struct ParameterSnapshot {
+		AdmParameter admParameter;
+		Parameter* parameter;
+		std::shared_ptr<EnvelopeDataSource> envelope;
+		std::optional<double> constantValue;
+	};
+	struct BlockGenerationJob {
+		std::shared_ptr<adm::AudioChannelFormat> audioChannelFormat;
+		std::chrono::nanoseconds start;
+		std::chrono::nanoseconds duration;
+		bool useSphericalCoordinates{ true };
+		bool requiresMainThread{ false }; // Set if any envelope could not be snapshotted
+		std::vector<ParameterSnapshot> parameters;
+		// Outputs
+		std::vector<std::string> warnings;
+		std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>> blocks;
+	};
+	BlockGenerationJob snapshotBlockGenerationJob(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, std::shared_ptr<adm::AudioChannelFormat> audioChannelFormat, std::chrono::nanoseconds start, std::chrono::nanoseconds duration, ReaperAPI const& api);
+	static void generateBlocks(BlockGenerationJob& job);
+	static void generateBlocks(std::vector<BlockGenerationJob>& jobs);
+	static BlockGenerationJob sliceBlockGenerationJob(BlockGenerationJob const& job, std::chrono::nanoseconds from, std::chrono::nanoseconds to);
+
+	AdmExportFormat format;
+	std::vector<BlockGenerationJob> serialAdmJobs; // Held until the render so blocks can be generated a frame at a time
 	std::shared_ptr<adm::Document> admDocument;
 	std::shared_ptr<bw64::ChnaChunk> chnaChunk;
 	std::shared_ptr<bw64::AxmlChunk> axmlChunk;
@@ -193,7 +224,6 @@ private:
 	std::vector<std::string> warningStrings;
 
 	// New methods that might need a seperate handler
-	std::vector<std::shared_ptr<PluginInstance>> getEarInputPluginsWithInputInstanceId(uint32_t inputInstanceId, ReaperAPI const& api);
 	TrackEnvelope* getEnvelopeFor(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, AdmParameter admParameter, ReaperAPI const& api);
 	std::optional<double> getValueFor(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, AdmParameter admParameter, ReaperAPI const& api);
 	bool getEnvelopeBypassed(TrackEnvelope* env, ReaperAPI const& api);
@@ -3,12 +3,15 @@
 
 #include "exportaction_admsource-admvst.h"
 #include "exportaction_admsource-earvst.h"
+#include "exportaction_projectindex.h"
 
-void AdmExportHandler::repopulate(ReaperAPI const & api)
+void AdmExportHandler::repopulate(ReaperAPI const & api, AdmExportFormat format)
 {
     // Resets and reconstructs admExportVstSources and earSceneMasterVstSources
-    admExportVstSources = std::make_shared<AdmVstExportSources>(api);
-    earSceneMasterVstSources = std::make_shared<EarVstExportSources>(api);
+    // Both are populated from the same single scan of the project
+    ExportProjectIndex projectIndex(api);
+    admExportVstSources = std::make_shared<AdmVstExportSources>(api, projectIndex);
+    earSceneMasterVstSources = std::make_shared<EarVstExportSources>(api, projectIndex, format);
 }
 
 IExportSources * AdmExportHandler::getAdmExportSources()
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <chrono>
+#include <ostream>
 #include <sstream>
 #include <iomanip>
 
@@ -21,6 +23,20 @@ std::string intToHex( T i )
 
 using namespace admplug;
 
+enum class AdmExportFormat {
+    BW64_AXML = 0,  // Whole programme of metadata in the axml chunk
+    SERIAL_ADM = 1  // BS.2125 frames written alongside the audio as the render progresses
+};
+
+// The sink config REAPER stores for us is the FOURCC followed by two reserved fields, then the export format
+constexpr int ADM_EXPORT_FORMAT_CFG_INDEX{ 3 };
+
+inline AdmExportFormat admExportFormatFromCfg(const void *cfg, int cfg_l) {
+    if (!cfg || cfg_l < (int)((ADM_EXPORT_FORMAT_CFG_INDEX + 1) * sizeof(int))) return AdmExportFormat::BW64_AXML;
+    auto format = ((const int *)cfg)[ADM_EXPORT_FORMAT_CFG_INDEX];
+    return format == (int)AdmExportFormat::SERIAL_ADM ? AdmExportFormat::SERIAL_ADM : AdmExportFormat::BW64_AXML;
+}
+
 class AdmVstExportSources;
 class EarVstExportSources;
 
@@ -46,14 +62,31 @@ public:
     virtual void setRenderInProgress(bool state) = 0;
     virtual bool isFrameAvailable() = 0;
     virtual bool writeNextFrameTo(float* bufferWritePointer, bool skipFrameAvailableCheck = false) = 0;
+    // Writes up to maxFrames frames, frameStride samples apart, and returns how many were written.
+    // Sources which can gather frames in bulk should override this.
+    virtual int writeNextFramesTo(float* bufferWritePointer, int maxFrames, int frameStride) {
+        int framesWritten = 0;
+        while (framesWritten < maxFrames && isFrameAvailable()) {
+            if (!writeNextFrameTo(bufferWritePointer, true)) break;
+            bufferWritePointer += frameStride;
+            framesWritten++;
+        }
+        return framesWritten;
+    }
 
     virtual std::shared_ptr<bw64::AxmlChunk> getAxmlChunk() = 0;
     virtual std::shared_ptr<bw64::ChnaChunk> getChnaChunk() = 0;
     virtual std::shared_ptr<adm::Document> getAdmDocument() = 0; // Required access prior to stringifying so that programme name and content name can be updtaed
 
+    // Serial ADM - sources which can generate their metadata a frame at a time rather than up front
+    virtual bool supportsSerialAdm() { return false; }
+    // Writes the audioFormatExtended element for the frame. Called from the S-ADM writer thread, never concurrently.
+    virtual void writeSerialAdmFrameTo(std::ostream& os, std::chrono::nanoseconds start, std::chrono::nanoseconds duration) {}
+
     virtual std::vector<std::string> generateExportInfoStrings() = 0; // Processing Info
     virtual std::vector<std::string> generateExportErrorStrings() = 0; // Errors occurred during processing
     virtual std::vector<std::string> generateExportWarningStrings() = 0; // Warnings generated during processing
+    virtual std::vector<std::string> generateRenderReportStrings() { return {}; } // Per-source problems seen whilst receiving audio
 
     virtual std::string getExportSourcesName() {
         return std::string("Unknown Export Sources");
@@ -72,7 +105,7 @@ public:
     AdmExportHandler() {}
     ~AdmExportHandler() {}
 
-    void repopulate(ReaperAPI const&api);
+    void repopulate(ReaperAPI const&api, AdmExportFormat format = AdmExportFormat::BW64_AXML);
 
     IExportSources* getAdmExportSources();
 
@@ -450,6 +450,11 @@ WDL_DLGRET RenderDialogState::wavecfgDlgProc(HWND hwndDlg, UINT uMsg, WPARAM wPa
     {
         // this is called when the dialog is initialized
         startedPrepareDialogControls = false;
+        if (lParam) {
+            auto cfgParams = (const void **)lParam;
+            exportFormat = admExportFormatFromCfg(cfgParams[0], *((const int *)cfgParams[1]));
+        }
+        setCheckboxState(GetDlgItem(hwndDlg, IDC_SERIAL_ADM), exportFormat == AdmExportFormat::SERIAL_ADM);
         return 0;
     }
 
@@ -528,6 +533,9 @@ WDL_DLGRET RenderDialogState::wavecfgDlgProc(HWND hwndDlg, UINT uMsg, WPARAM wPa
             // Repopulate ADM info
             startPreparingRenderControls(hwndDlg);
         }
+        if (notificationType == BN_CLICKED && controlId == IDC_SERIAL_ADM) {
+            exportFormat = getCheckboxState(GetDlgItem(hwndDlg, IDC_SERIAL_ADM)) ? AdmExportFormat::SERIAL_ADM : AdmExportFormat::BW64_AXML;
+        }
         return 0;
     }
 
@@ -541,6 +549,7 @@ WDL_DLGRET RenderDialogState::wavecfgDlgProc(HWND hwndDlg, UINT uMsg, WPARAM wPa
             ((int *)lParam)[0] = ExportManager::ExportInfo.SINK_FOURCC;
             ((int *)(((unsigned char *)lParam) + 4))[0] = REAPER_MAKELEINT(0);
             ((float *)(((unsigned char *)lParam) + 4))[1] = 0.f;
+            ((int *)lParam)[ADM_EXPORT_FORMAT_CFG_INDEX] = (int)exportFormat;
 
         }
         return 0;
@@ -59,6 +59,7 @@ private:
     bool sampleRateControlSetError{false};
     bool channelsControlSetError{false};
     bool normalisationOptionsEnabled{false};
+    AdmExportFormat exportFormat{ AdmExportFormat::BW64_AXML };
 
     std::string sampleRateLastOption{};
     std::string channelsLastOption{};
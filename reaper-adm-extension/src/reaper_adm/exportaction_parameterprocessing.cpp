@@ -2,12 +2,14 @@
 #include "envelopecreator.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 
 #define CURVE_APPROXIMATION_STEP_MS 100
 #define CURVE_APPROXIMATION_DEVIATION_THRESHOLD 0.05
 #define VALUE_TOLERANCE 0.00001 // Value has to be within 0.001% of target to be considered the same
+#define ENVELOPE_CHUNK_BUFFER_SIZE 512000 // enough for about 12000 automation points
 
 namespace {
     bool valueWithinTolerance(double actual, double target, double range = 1.0) {
@@ -28,7 +30,129 @@ CumulatedPointData::CumulatedPointData(std::chrono::nanoseconds regionStart, std
     pointsData.insert({ endPoint, std::map<AdmParameter, std::vector<double>>() });
 }
 
+ReaperEnvelopeDataSource::ReaperEnvelopeDataSource(TrackEnvelope& envelope, ReaperAPI const& api) : envelope{ &envelope }, api{ api }
+{
+}
+
+int ReaperEnvelopeDataSource::getScalingMode() const
+{
+    return api.GetEnvelopeScalingMode(envelope);
+}
+
+std::optional<std::string> ReaperEnvelopeDataSource::getStateChunk() const
+{
+    api.Envelope_SortPoints(envelope); // Means the stored non-linear points will be presorted
+    std::vector<char> chunk(ENVELOPE_CHUNK_BUFFER_SIZE, '\0');
+    if(!api.GetEnvelopeStateChunk(envelope, chunk.data(), ENVELOPE_CHUNK_BUFFER_SIZE, false)) {
+        return std::optional<std::string>();
+    }
+    return std::string(chunk.data());
+}
+
+double ReaperEnvelopeDataSource::evaluate(double time) const
+{
+    double envValAtTime;
+    api.Envelope_Evaluate(envelope, time, 0, 0, &envValAtTime, nullptr, nullptr, nullptr);
+    return api.ScaleFromEnvelopeMode(api.GetEnvelopeScalingMode(envelope), envValAtTime);
+}
+
+std::shared_ptr<EnvelopeSnapshot> EnvelopeSnapshot::capture(TrackEnvelope& envelope, ReaperAPI const& api)
+{
+    ReaperEnvelopeDataSource liveEnvelope(envelope, api);
+    auto stateChunk = liveEnvelope.getStateChunk();
+    if(!stateChunk) return nullptr;
+
+    std::shared_ptr<EnvelopeSnapshot> snapshot(new EnvelopeSnapshot());
+    snapshot->scalingMode = liveEnvelope.getScalingMode();
+    if(snapshot->scalingMode != 0) return nullptr; // Scaled envelopes are never linear
+
+    std::istringstream chunkSs(*stateChunk);
+    std::string line;
+    while(std::getline(chunkSs, line)) {
+        if(line.rfind("PT", 0) != 0) continue;
+        std::istringstream pointSs(line.substr(2));
+        Point point{ 0.0, 0.0, EnvelopeShape::Linear };
+        if(!(pointSs >> point.time >> point.value)) return nullptr;
+        if(!(pointSs >> point.shape)) point.shape = EnvelopeShape::Linear;
+        if(point.shape != EnvelopeShape::Linear && point.shape != EnvelopeShape::Square) {
+            // Curve shapes need REAPER to evaluate them
+            return nullptr;
+        }
+        snapshot->points.push_back(point);
+    }
+    if(snapshot->points.empty()) {
+        // REAPER evaluates an envelope without points to its unautomated value, so hold that throughout
+        snapshot->points.push_back({ 0.0, liveEnvelope.evaluate(0.0), EnvelopeShape::Linear });
+    }
+
+    snapshot->stateChunk = std::move(*stateChunk);
+    return snapshot;
+}
+
+double EnvelopeSnapshot::evaluate(double time) const
+{
+    assert(!points.empty());
+    if(time <= points.front().time) return points.front().value;
+
+    // Last point at or before time - envelope holds its value after the final point
+    auto next = std::upper_bound(points.begin(), points.end(), time,
+                                 [](double t, Point const& point) { return t < point.time; });
+    auto const& prev = *(next - 1);
+    if(next == points.end() || prev.shape == EnvelopeShape::Square) return prev.value;
+
+    double progression = (time - prev.time) / (next->time - prev.time);
+    return prev.value + ((next->value - prev.value) * progression);
+}
+
+std::shared_ptr<EnvelopeSnapshot> EnvelopeSnapshot::slice(double from, double to) const
+{
+    std::shared_ptr<EnvelopeSnapshot> snapshot(new EnvelopeSnapshot());
+    snapshot->scalingMode = scalingMode;
+
+    auto byTime = [](Point const& point, double t) { return point.time < t; };
+    auto first = std::lower_bound(points.begin(), points.end(), from, byTime);
+    auto last = std::lower_bound(first, points.end(), to, byTime);
+
+    // Start point takes the shape of whichever point we're part way through so square holds carry over
+    int startShape = EnvelopeShape::Linear;
+    auto after = std::upper_bound(points.begin(), points.end(), from,
+                                  [](double t, Point const& point) { return t < point.time; });
+    if(after != points.begin()) startShape = (after - 1)->shape;
+    snapshot->points.push_back({ from, evaluate(from), startShape });
+
+    for(auto it = first; it != last; ++it) {
+        if(it->time > from) snapshot->points.push_back(*it);
+    }
+
+    // Points exactly at the end belong to the next slice - finish on the value leading in to them.
+    // A square hold becomes a linear ramp between equal values, otherwise the hold would be seen as a jump at the end.
+    auto& lastInSlice = snapshot->points.back();
+    double endValue = evaluate(to);
+    if(lastInSlice.shape == EnvelopeShape::Square) {
+        lastInSlice.shape = EnvelopeShape::Linear;
+        endValue = lastInSlice.value;
+    } else if(last != points.end() && last->time == to) {
+        endValue = last->value;
+    }
+    snapshot->points.push_back({ to, endValue, EnvelopeShape::Linear });
+
+    std::ostringstream chunkSs;
+    chunkSs.precision(17);
+    for(auto const& point : snapshot->points) {
+        chunkSs << "PT " << point.time << " " << point.value << " " << point.shape << "\n";
+    }
+    chunkSs << ">\n";
+    snapshot->stateChunk = chunkSs.str();
+
+    return snapshot;
+}
+
 std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(TrackEnvelope& envelope, Parameter& parameter, AdmParameter admParameter, ReaperAPI const & api)
+{
+    return useEnvelopeDataForParameter(std::make_shared<ReaperEnvelopeDataSource>(envelope, api), parameter, admParameter);
+}
+
+std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(std::shared_ptr<EnvelopeDataSource> envelope, Parameter& parameter, AdmParameter admParameter)
 {
     // This function reads and parses the envelope state chunks.
     // As well as point time and value, the state chunk includes shape data.
@@ -48,7 +172,7 @@ std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(T
     PT 12 0.5 0
     >
     */
-    int envelopeScalingMode = api.GetEnvelopeScalingMode(&envelope);
+    int envelopeScalingMode = envelope->getScalingMode();
     std::vector<AdmAuthoringError> errors;
 
     if(admDataSources.count(admParameter) > 0) {
@@ -61,17 +185,14 @@ std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(T
         errors.push_back(AdmAuthoringError("Attempting to assign an envelope as a data source to an ADM parameter which already has parameter data."));
         return errors;
     }
-    api.Envelope_SortPoints(&envelope); // Means the stored non-linear points will be presorted
-
     // Grab values from points data in state chunk
-    char chunk[512000]; // enough for about 12000 automation points
-    bool res = api.GetEnvelopeStateChunk(&envelope, chunk, 512000, false);
-    if(!res) {
+    auto chunk = envelope->getStateChunk();
+    if(!chunk) {
         assert(false);
         errors.push_back(AdmAuthoringError("Could not get data for envelope to use as ADM parameter data source."));
         return errors;
     }
-    std::istringstream chunkSs(chunk);
+    std::istringstream chunkSs(*chunk);
     std::string line;
     bool chunkComplete = false; // Set when we find the end of the chunk so we know we read it all.
 
@@ -153,7 +274,7 @@ std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(T
     // Fill in non-linear points
     for( auto const& [admParameter, admDataSource] : admDataSources )
     {
-        approximateNonLinearCurves(admParameter, api);
+        approximateNonLinearCurves(admParameter);
     }
 
     if(DefaultEnvelopeCreator::isWrappedParam(admParameter)) {
@@ -174,9 +295,7 @@ std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(T
                 double period = endTime - startTime;
                 if(change >= 0.5 && period > 0.001) {
                     double midTime = (period / 2.0) + startTime;
-                    double envValAtTime;
-                    api.Envelope_Evaluate(&envelope, midTime, 0, 0, &envValAtTime, nullptr, nullptr, nullptr);
-                    double normValAtTime = api.ScaleFromEnvelopeMode(envelopeScalingMode, envValAtTime);
+                    double normValAtTime = envelope->evaluate(midTime);
                     newPointData(midTime, admParameter, parameter.reverseMap(normValAtTime));
                     newDataPoints++;
                 }
@@ -185,7 +304,7 @@ std::vector<AdmAuthoringError> CumulatedPointData::useEnvelopeDataForParameter(T
     }
 
     // Register it
-    admDataSources.insert(std::make_pair(admParameter, AdmDataSource{ &envelope, &parameter, nonLinearRegions }));
+    admDataSources.insert(std::make_pair(admParameter, AdmDataSource{ envelope, &parameter, nonLinearRegions }));
 
     return errors;
 }
@@ -291,30 +410,30 @@ std::vector<double> CumulatedPointData::getSortedTimesOfValuesForParameter(AdmPa
     return times; // Map is inherently sorted, so vector is sorted
 }
 
-void CumulatedPointData::finaliseSphericalPositionParameters(ReaperAPI const& api)
+void CumulatedPointData::finaliseSphericalPositionParameters()
 {
     // Ensure we have positional parameters on all data points
-    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_AZIMUTH, 0.0, api);
-    ensureFinalPointPresent(AdmParameter::OBJECT_AZIMUTH, api);
-    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_ELEVATION, 0.0, api);
-    ensureFinalPointPresent(AdmParameter::OBJECT_ELEVATION, api);
-    createValuesForParameterAtAllPointTimes(AdmParameter::SPEAKER_AZIMUTH, 0.0, api);
-    ensureFinalPointPresent(AdmParameter::SPEAKER_AZIMUTH, api);
-    createValuesForParameterAtAllPointTimes(AdmParameter::SPEAKER_ELEVATION, 0.0, api);
-    ensureFinalPointPresent(AdmParameter::SPEAKER_ELEVATION, api);
+    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_AZIMUTH, 0.0);
+    ensureFinalPointPresent(AdmParameter::OBJECT_AZIMUTH);
+    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_ELEVATION, 0.0);
+    ensureFinalPointPresent(AdmParameter::OBJECT_ELEVATION);
+    createValuesForParameterAtAllPointTimes(AdmParameter::SPEAKER_AZIMUTH, 0.0);
+    ensureFinalPointPresent(AdmParameter::SPEAKER_AZIMUTH);
+    createValuesForParameterAtAllPointTimes(AdmParameter::SPEAKER_ELEVATION, 0.0);
+    ensureFinalPointPresent(AdmParameter::SPEAKER_ELEVATION);
 }
 
-void CumulatedPointData::finaliseCartesianPositionParameters(ReaperAPI const & api)
+void CumulatedPointData::finaliseCartesianPositionParameters()
 {
     // Ensure we have positional parameters on all data points
-    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_X, 0.0, api);
-    ensureFinalPointPresent(AdmParameter::OBJECT_X, api);
-    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_Y, 0.0, api);
-    ensureFinalPointPresent(AdmParameter::OBJECT_Y, api);
+    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_X, 0.0);
+    ensureFinalPointPresent(AdmParameter::OBJECT_X);
+    createValuesForParameterAtAllPointTimes(AdmParameter::OBJECT_Y, 0.0);
+    ensureFinalPointPresent(AdmParameter::OBJECT_Y);
     // Note that there are no cartesian parameters for DirectSpeakers in BS.2076-2
 }
 
-void CumulatedPointData::finaliseOtherParameters(ReaperAPI const & api)
+void CumulatedPointData::finaliseOtherParameters()
 {
     // Iterate through existing params at all times.
     // If any parameter is evaluated to not default, we should create a value here
@@ -323,14 +442,14 @@ void CumulatedPointData::finaliseOtherParameters(ReaperAPI const & api)
         auto admParameterDefaultVal = getAdmParameterDefault(admParameter);
 
         if(admParameterDefaultVal.has_value()) {
-            createValuesForParameterAtAllPointTimes(admParameter, *admParameterDefaultVal, api, false);
+            createValuesForParameterAtAllPointTimes(admParameter, *admParameterDefaultVal, false);
         }
 
-        ensureFinalPointPresent(admParameter, api);
+        ensureFinalPointPresent(admParameter);
     }
 }
 
-int CumulatedPointData::approximateNonLinearCurves(AdmParameter admParameter, ReaperAPI const & api)
+int CumulatedPointData::approximateNonLinearCurves(AdmParameter admParameter)
 {
     auto admDataSourcesIt = admDataSources.find(admParameter);
     if(admDataSourcesIt == admDataSources.end()) return 0;
@@ -344,10 +463,7 @@ int CumulatedPointData::approximateNonLinearCurves(AdmParameter admParameter, Re
         for(auto& time : getSortedPointTimes()) {
             if(time <= region.first) continue;
             if(time >= region.second) break;
-            double envValAtTime;
-            api.Envelope_Evaluate(admDataSource->envelope, time, 0, 0, &envValAtTime, nullptr, nullptr, nullptr);
-            int envelopeScalingMode = api.GetEnvelopeScalingMode(admDataSource->envelope);
-            double normValAtTime = api.ScaleFromEnvelopeMode(envelopeScalingMode, envValAtTime);
+            double normValAtTime = admDataSource->envelope->evaluate(time);
             newPointData(time, admParameter, admDataSource->parameter->reverseMap(normValAtTime));
         }
 
@@ -361,10 +477,7 @@ int CumulatedPointData::approximateNonLinearCurves(AdmParameter admParameter, Re
             double pointTime = (timeInMs / 1000.0);
             if(pointTime > region.second) break;
 
-            double envValAtTime;
-            api.Envelope_Evaluate(admDataSource->envelope, pointTime, 0, 0, &envValAtTime, nullptr, nullptr, nullptr);
-            int envelopeScalingMode = api.GetEnvelopeScalingMode(admDataSource->envelope);
-            double realValAtTime = api.ScaleFromEnvelopeMode(envelopeScalingMode, envValAtTime);
+            double realValAtTime = admDataSource->envelope->evaluate(pointTime);
 
             auto impliedValAtTime = getAdmImpliedValueForParameterAtTime(pointTime, admParameter, admDataSource->parameter);
             assert(impliedValAtTime.has_value()); // This should definitely return a value - we're bound by 2 known points.
@@ -452,15 +565,19 @@ std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>>> Cumula
 {
     // Use spherical if no plug-in suite/instance provided, or determine from plug-in suite
     bool useSph = !pluginSuite || !pluginInst || pluginSuite->pluginUsesSphericalCoordinates(pluginInst); // Use spherical if no plug-in suite provided, or determine from plug-in suite
+    return generateAudioBlockFormatObjects(useSph);
+}
 
+std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>>> CumulatedPointData::generateAudioBlockFormatObjects(bool useSph)
+{
     // Fill in missing parameter values so that all blocks will have position data (mandatory)
     if(useSph) {
-        finaliseSphericalPositionParameters(api);
+        finaliseSphericalPositionParameters();
     } else {
-        finaliseCartesianPositionParameters(api);
+        finaliseCartesianPositionParameters();
     }
     // Fill in other parameters at all point times if they don't equate to the default
-    finaliseOtherParameters(api);
+    finaliseOtherParameters();
 
     // Now create the blocks
     std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>> blocks;
@@ -570,7 +687,7 @@ std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>>> Cumula
     return std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>>>(blocks);
 }
 
-void CumulatedPointData::createValuesForParameterAtAllPointTimes(AdmParameter admParameter, double defaultVal, ReaperAPI const & api, bool createEvenIfAlreadyDefault)
+void CumulatedPointData::createValuesForParameterAtAllPointTimes(AdmParameter admParameter, double defaultVal, bool createEvenIfAlreadyDefault)
 {
     auto allTimes = getSortedPointTimes();
     int newDataPoints = 0;
@@ -579,14 +696,11 @@ void CumulatedPointData::createValuesForParameterAtAllPointTimes(AdmParameter ad
     if(admDataSourcesIt != admDataSources.end()) {
         // We have an envelope we can refer to to get the true interpolated value
         auto env = admDataSourcesIt->second.envelope;
-        int envelopeScalingMode = api.GetEnvelopeScalingMode(env);
         auto param = admDataSourcesIt->second.parameter;
         for(auto& time : allTimes) {
             if(getValuesForParameterAtTime(time, admParameter).size() == 0) {
                 // Need to create a value for this parameter at this time
-                double envValAtTime;
-                api.Envelope_Evaluate(env, time, 0, 0, &envValAtTime, nullptr, nullptr, nullptr);
-                double realValAtTime = api.ScaleFromEnvelopeMode(envelopeScalingMode, envValAtTime);
+                double realValAtTime = env->evaluate(time);
                 auto convValAtTime = param->reverseMap(realValAtTime);
                 if(createEvenIfAlreadyDefault || !valueWithinTolerance(convValAtTime, defaultVal)) {
                     newPointData(time, admParameter, convValAtTime);
@@ -629,7 +743,7 @@ void CumulatedPointData::createValuesForParameterAtAllPointTimes(AdmParameter ad
     return;
 }
 
-void CumulatedPointData::ensureFinalPointPresent(AdmParameter admParameter, ReaperAPI const & api)
+void CumulatedPointData::ensureFinalPointPresent(AdmParameter admParameter)
 {
     // We have to do this due to REAPER's "hold" behaviour after a last envelope point
     // Conversely, ADM would return to default values
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 #include <optional>
 #include <adm/adm.hpp>
@@ -22,6 +24,71 @@ inline double fromNs(std::chrono::nanoseconds ns) {
 
 using namespace admplug;
 
+class EnvelopeDataSource
+{
+    /*
+    Provides the data CumulatedPointData needs from an envelope.
+    Implementations either query REAPER directly (main thread only)
+     or hold a snapshot which can be used from any thread.
+    */
+public:
+    virtual ~EnvelopeDataSource() = default;
+
+    virtual int getScalingMode() const = 0;
+    // Returns the state chunk with points sorted, or nothing if it could not be retrieved
+    virtual std::optional<std::string> getStateChunk() const = 0;
+    // Returns the envelope value at time, already scaled from the envelope mode
+    virtual double evaluate(double time) const = 0;
+};
+
+class ReaperEnvelopeDataSource : public EnvelopeDataSource
+{
+public:
+    ReaperEnvelopeDataSource(TrackEnvelope& envelope, ReaperAPI const& api);
+    ~ReaperEnvelopeDataSource() override = default;
+
+    int getScalingMode() const override;
+    std::optional<std::string> getStateChunk() const override;
+    double evaluate(double time) const override;
+
+private:
+    TrackEnvelope* envelope;
+    ReaperAPI const& api;
+};
+
+class EnvelopeSnapshot : public EnvelopeDataSource
+{
+    /*
+    A copy of an envelope's state taken on the main thread.
+    Evaluation is done without the REAPER API, so only envelopes we can evaluate exactly
+     (linear/square shapes, no scaling) can be snapshotted - capture() returns nullptr otherwise.
+    */
+public:
+    static std::shared_ptr<EnvelopeSnapshot> capture(TrackEnvelope& envelope, ReaperAPI const& api);
+    ~EnvelopeSnapshot() override = default;
+
+    // Returns a snapshot holding only the points between from and to, with points added at each end
+    //  so it evaluates the same as this one within that range. Used to generate blocks a frame at a time.
+    std::shared_ptr<EnvelopeSnapshot> slice(double from, double to) const;
+
+    int getScalingMode() const override { return scalingMode; }
+    std::optional<std::string> getStateChunk() const override { return stateChunk; }
+    double evaluate(double time) const override;
+
+private:
+    EnvelopeSnapshot() = default;
+
+    struct Point {
+        double time;
+        double value;
+        int shape;
+    };
+
+    int scalingMode{ 0 };
+    std::string stateChunk;
+    std::vector<Point> points;
+};
+
 class CumulatedPointData
 {
 public:
@@ -29,6 +96,7 @@ public:
     ~CumulatedPointData() {};
 
     std::vector<AdmAuthoringError> useEnvelopeDataForParameter(TrackEnvelope& envelope, Parameter& parameter, AdmParameter admParameter, ReaperAPI const& api);
+    std::vector<AdmAuthoringError> useEnvelopeDataForParameter(std::shared_ptr<EnvelopeDataSource> envelope, Parameter& parameter, AdmParameter admParameter);
     std::vector<AdmAuthoringError> useConstantValueForParameter(AdmParameter admParameter, double value);
 
     std::vector<double> getSortedPointTimes();
@@ -36,15 +104,17 @@ public:
     std::vector<AdmParameter> getParametersAtTime(double time);
     std::vector<double> getValuesForParameterAtTime(double time, AdmParameter admParameter);
     std::vector<double> getSortedTimesOfValuesForParameter(AdmParameter admParameter);
-    void finaliseSphericalPositionParameters(ReaperAPI const& api);
-    void finaliseCartesianPositionParameters(ReaperAPI const& api);
-    void finaliseOtherParameters(ReaperAPI const& api);
+    void finaliseSphericalPositionParameters();
+    void finaliseCartesianPositionParameters();
+    void finaliseOtherParameters();
     std::optional<double> getAdmImpliedValueForParameterAtTime(double time, AdmParameter admParameter, Parameter* parameter);
     bool haveEnvelopeFor(AdmParameter admParameter);
     bool haveDataFor(AdmParameter admParameter);
     bool multipleValuesForSingleParameterAtTime(double time);
 
     std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>>> generateAudioBlockFormatObjects(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, ReaperAPI const& api);
+    // Does not touch the REAPER API, so can be called off the main thread if all envelopes are snapshots
+    std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatObjects>>> generateAudioBlockFormatObjects(bool useSphericalCoordinates);
     std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatDirectSpeakers>>> generateAudioBlockFormatDirectSpeakers(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, ReaperAPI const& api);
     std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatBinaural>>> generateAudioBlockFormatBinaural(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, ReaperAPI const& api);
     std::optional<std::vector<std::shared_ptr<adm::AudioBlockFormatMatrix>>> generateAudioBlockFormatMatrix(std::shared_ptr<admplug::PluginSuite> pluginSuite, PluginInstance* pluginInst, ReaperAPI const& api);
@@ -52,7 +122,7 @@ public:
 
 private:
     struct AdmDataSource {
-        TrackEnvelope* envelope;
+        std::shared_ptr<EnvelopeDataSource> envelope;
         Parameter* parameter;
         std::vector<std::pair<double, double>> nonLinearRegions;
     };
@@ -61,9 +131,9 @@ private:
     std::map<double, std::map<AdmParameter, std::vector<double>>> pointsData;
 
     void newPointData(double time, AdmParameter admParameter, double value);
-    void createValuesForParameterAtAllPointTimes(AdmParameter admParameter, double defaultVal, ReaperAPI const& api, bool createEvenIfAlreadyDefault = true);
-    void ensureFinalPointPresent(AdmParameter admParameter, ReaperAPI const& api);
-    int approximateNonLinearCurves(AdmParameter admParameter, ReaperAPI const& api);
+    void createValuesForParameterAtAllPointTimes(AdmParameter admParameter, double defaultVal, bool createEvenIfAlreadyDefault = true);
+    void ensureFinalPointPresent(AdmParameter admParameter);
+    int approximateNonLinearCurves(AdmParameter admParameter);
 
     std::chrono::nanoseconds regionStart;
     std::chrono::nanoseconds regionEnd;
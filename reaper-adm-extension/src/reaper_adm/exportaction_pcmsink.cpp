@@ -33,8 +33,9 @@ PCM_sink_adm::PCM_sink_adm(std::shared_ptr<ReaperAPI> api, const char *fn, void
     double st = this->GetStartTime(); // TODO: is this used for bounds?
 
     // (re)Scan VSTs and states
+    auto exportFormat = admExportFormatFromCfg(cfgdata, cfgdata_l);
     admExportHandler = std::make_shared<AdmExportHandler>();
-    admExportHandler->repopulate(*api);
+    admExportHandler->repopulate(*api, exportFormat);
 
     auto admExportSources = admExportHandler->getAdmExportSources();
 
@@ -104,8 +105,26 @@ PCM_sink_adm::PCM_sink_adm(std::shared_ptr<ReaperAPI> api, const char *fn, void
 
     // Start writing
     auto chna = admExportSources->getChnaChunk();
-    auto axml = admExportSources->getAxmlChunk();
-    writer = bw64::writeFile(admFilename, totalChannels, sRate, 24, chna, axml);
+    if(exportFormat == AdmExportFormat::SERIAL_ADM && admExportSources->supportsSerialAdm()) {
+        // Metadata is written a frame at a time as the audio comes in, so the BW64 only carries the CHNA
+        serialAdmWriter = std::make_unique<SerialAdmWriter>(SerialAdmWriter::fileNameFor(admFilenameStr), admExportSources, chna);
+        if(!serialAdmWriter->isOpen()) {
+            std::string msg("Error: Unable to open \"");
+            msg.append(serialAdmWriter->getFileName());
+            msg.append("\" for writing S-ADM frames.\r\nCan not continue with render.");
+            api->ShowMessageBox(msg.c_str(), "S-ADM", 0);
+            serialAdmWriter.reset();
+            abortRender();
+            return;
+        }
+        writer = bw64::writeFile(admFilename, totalChannels, sRate, 24, chna, nullptr);
+    } else {
+        if(exportFormat == AdmExportFormat::SERIAL_ADM) {
+            api->ShowMessageBox("The current export sources can not generate S-ADM frames.\r\nADM metadata will be written to the BW64 file instead.", "S-ADM", 0);
+        }
+        auto axml = admExportSources->getAxmlChunk();
+        writer = bw64::writeFile(admFilename, totalChannels, sRate, 24, chna, axml);
+    }
 
     // Start Renders
     admExportSources->setRenderInProgress(true);
@@ -120,9 +139,8 @@ PCM_sink_adm::~PCM_sink_adm()
         int loopLimit = 40; // 40*50ms = 2s - if they've not got through the queue by then, they're probably not coming!
         while (actualFramesWritten < expectedFramesWritten && loopCounter < loopLimit) {
 
-            while(int frameCount = processNextFrames(expectedFramesWritten) > 0) {
-                actualFramesWritten += frameCount;
-            }
+            // processNextFrames advances actualFramesWritten itself
+            while(processNextFrames(expectedFramesWritten) > 0) continue;
             if(actualFramesWritten == expectedFramesWritten) break;
 
             Sleep(50); // Give NNG I/O thread chance to work it's queue
@@ -140,9 +158,20 @@ PCM_sink_adm::~PCM_sink_adm()
             msg += "Expected ";
             msg += std::to_string(expectedFramesWritten);
             msg += " frames.";
+            auto reportStrings = admExportHandler->getAdmExportSources()->generateRenderReportStrings();
+            for (auto const& reportString : reportStrings) {
+                msg += "\r\n";
+                msg += reportString;
+            }
             api->ShowMessageBox(msg.c_str(), "Render", 0);
         }
 
+        if (serialAdmWriter) {
+            // Waits for the remaining frames - everything up to the last complete frame should already be written
+            serialAdmWriter->finish(framesToNs(actualFramesWritten));
+            serialAdmWriter.reset();
+        }
+
         writer.reset();
     }
 
@@ -204,28 +233,32 @@ int PCM_sink_adm::processNextFrames(uint64_t toMaxFrame){
     float *bufferWritePos = aggregatedBlockBufferStart;
     size_t sampleSize = sizeof(float);
     int framesWrittenToBlockBuffer = 0;
-    int frameWriteLimit = (int)aggregatedBlockBufferSize;
+    int frameWriteLimit = (int)aggregatedBlockBufferFrameCount;
 
     if (toMaxFrame > 0) {
         frameWriteLimit = (int)min(frameWriteLimit, toMaxFrame - actualFramesWritten); // Shouldn't ever be negative, but the loop below would catch that anyway.
     }
 
-    while (framesWrittenToBlockBuffer < frameWriteLimit && nextFrameReady()) {
-        auto writeSuccess = admExportHandler->getAdmExportSources()->writeNextFrameTo(bufferWritePos, true); // true = skip frame availability check - we've already done it
-        assert(writeSuccess);
-        bufferWritePos += totalChannels;
-        framesWrittenToBlockBuffer++;
+    if (frameWriteLimit > 0) {
+        framesWrittenToBlockBuffer = admExportHandler->getAdmExportSources()->writeNextFramesTo(bufferWritePos, frameWriteLimit, totalChannels);
     }
 
     if (framesWrittenToBlockBuffer > 0) {
         writer->write(aggregatedBlockBufferStart, framesWrittenToBlockBuffer);
         actualFramesWritten += framesWrittenToBlockBuffer;
+        if (serialAdmWriter) {
+            serialAdmWriter->audioWrittenUntil(framesToNs(actualFramesWritten));
+        }
     }
 
     return framesWrittenToBlockBuffer;
 }
 
 
+std::chrono::nanoseconds PCM_sink_adm::framesToNs(uint64_t frames) {
+    return std::chrono::nanoseconds((frames * 1000000000ull) / sRate);
+}
+
 bool PCM_sink_adm::nextFrameReady() {
     return admExportHandler->getAdmExportSources()->isFrameAvailable();
 }
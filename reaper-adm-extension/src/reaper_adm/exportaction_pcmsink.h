@@ -5,6 +5,7 @@
 #include "reaperapi.h"
 #include "reaper_plugin.h"
 #include "exportaction_admsourcescontainer.h"
+#include "exportaction_sadmwriter.h"
 
 using namespace admplug;
 
@@ -36,12 +37,14 @@ private:
     int totalChannels;
 
     std::shared_ptr<AdmExportHandler> admExportHandler;
+    std::unique_ptr<SerialAdmWriter> serialAdmWriter; // Only in S-ADM mode. Declared after admExportHandler as it uses its sources.
 
     uint64_t expectedFramesWritten{ 0 };
     uint64_t actualFramesWritten{ 0 };
 
     void abortRender();
     int processNextFrames(uint64_t toMaxFrame);
+    std::chrono::nanoseconds framesToNs(uint64_t frames);
     bool nextFrameReady();
 
     std::vector<float> aggregatedBlockBuffer; // predefined to prevent reserving memory on every call to process a block
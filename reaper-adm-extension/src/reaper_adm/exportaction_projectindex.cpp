@@ -0,0 +1,44 @@
+#include "exportaction_projectindex.h"
+#include "exportaction_admsource-earvst.h"
+
+ExportProjectIndex::ExportProjectIndex(ReaperAPI const& api) : api{ api }
+{
+    int numTracks = api.CountTracks(nullptr);
+    for (int trackNum = 0; trackNum < numTracks; trackNum++) {
+        auto trk = api.GetTrack(nullptr, trackNum);
+        if (!trk) continue;
+
+        auto trackFxNames = api.TrackFX_GetActualFXNames(trk);
+        for (int fxIndex = 0; fxIndex < trackFxNames.size(); fxIndex++) {
+            auto& fxName = trackFxNames[fxIndex];
+            api.CleanFXName(fxName);
+            fxByName[fxName].push_back(FxLocation{ trk, fxIndex });
+
+            if (EarInputVst::isInputPlugin(fxName)) {
+                EarInputVst inputVst(trk, fxIndex, api);
+                auto inputInstanceId = static_cast<uint32_t>(inputVst.getInputInstanceId());
+                earInputPluginsByInstanceId[inputInstanceId].push_back(FxLocation{ trk, fxIndex });
+            }
+        }
+    }
+}
+
+std::vector<ExportProjectIndex::FxLocation> const& ExportProjectIndex::getFxLocationsFor(std::string const& fxName) const
+{
+    static const std::vector<FxLocation> none;
+    auto it = fxByName.find(fxName);
+    if (it == fxByName.end()) return none;
+    return it->second;
+}
+
+std::vector<std::shared_ptr<PluginInstance>> ExportProjectIndex::getEarInputPluginsWithInputInstanceId(uint32_t inputInstanceId) const
+{
+    std::vector<std::shared_ptr<PluginInstance>> insts;
+    auto it = earInputPluginsByInstanceId.find(inputInstanceId);
+    if (it != earInputPluginsByInstanceId.end()) {
+        for (auto const& location : it->second) {
+            insts.push_back(std::make_shared<PluginInstance>(location.track, location.fxIndex, api));
+        }
+    }
+    return insts;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "reaperapi.h"
+#include "plugin.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace admplug;
+
+class ExportProjectIndex
+{
+    /*
+    Single pass over every track and FX slot in the project, done once per export validation/render.
+    Export sources query this instead of rescanning the project for each plugin they need to find.
+    */
+public:
+    ExportProjectIndex(ReaperAPI const& api);
+    ~ExportProjectIndex() {}
+
+    struct FxLocation {
+        MediaTrack* track;
+        int fxIndex;
+    };
+
+    // FX with the given (cleaned) name, in project order
+    std::vector<FxLocation> const& getFxLocationsFor(std::string const& fxName) const;
+
+    // EAR input plugins (Object, DirectSpeakers, HOA) with the given input instance ID
+    std::vector<std::shared_ptr<PluginInstance>> getEarInputPluginsWithInputInstanceId(uint32_t inputInstanceId) const;
+
+private:
+    ReaperAPI const& api;
+    std::unordered_map<std::string, std::vector<FxLocation>> fxByName;
+    std::unordered_map<uint32_t, std::vector<FxLocation>> earInputPluginsByInstanceId;
+};
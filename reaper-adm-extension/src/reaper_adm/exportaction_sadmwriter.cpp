@@ -0,0 +1,161 @@
+#include "exportaction_sadmwriter.h"
+#include "exportaction_admsourcescontainer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace {
+    constexpr char const* FRAME_SEQUENCE_ELEMENT{ "frameSequence" };
+}
+
+SerialAdmWriter::SerialAdmWriter(std::string const& fileName, IExportSources* sources, std::shared_ptr<bw64::ChnaChunk> chna, std::chrono::nanoseconds frameDuration) :
+    fileName{ fileName },
+    file{ fileName, std::ios::out | std::ios::trunc },
+    sources{ sources },
+    transportTrackFormat{ formatTransportTrackFormat(chna) },
+    frameDuration{ frameDuration }
+{
+    if(isOpen() && sources && frameDuration > std::chrono::nanoseconds::zero()) {
+        file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        file << "<" << FRAME_SEQUENCE_ELEMENT << ">\n";
+        worker = std::thread(&SerialAdmWriter::run, this);
+    }
+}
+
+SerialAdmWriter::~SerialAdmWriter()
+{
+    if(worker.joinable()) {
+        // Not finished properly (render abandoned) - write what the audio covered
+        finish(frameDuration * static_cast<int64_t>(framesRequested));
+    }
+}
+
+void SerialAdmWriter::audioWrittenUntil(std::chrono::nanoseconds time)
+{
+    uint64_t completeFrames = time / frameDuration;
+    std::lock_guard<std::mutex> lock(mutex);
+    if(completeFrames > framesRequested) {
+        framesRequested = completeFrames;
+        framesRequestedCondition.notify_one();
+    }
+}
+
+void SerialAdmWriter::finish(std::chrono::nanoseconds programmeDuration)
+{
+    if(!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t totalFrames = (programmeDuration + frameDuration - std::chrono::nanoseconds(1)) / frameDuration;
+        framesRequested = std::max<uint64_t>(totalFrames, 1);
+        programmeEnd = programmeDuration;
+        finishing = true;
+        framesRequestedCondition.notify_one();
+    }
+    worker.join();
+    file << "</" << FRAME_SEQUENCE_ELEMENT << ">\n";
+    file.flush();
+}
+
+void SerialAdmWriter::run()
+{
+    uint64_t nextFrame = 0;
+    while(true) {
+        uint64_t requested;
+        std::chrono::nanoseconds end;
+        bool lastRequest;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            framesRequestedCondition.wait(lock, [this, nextFrame]() { return framesRequested > nextFrame || finishing; });
+            requested = framesRequested;
+            end = programmeEnd;
+            lastRequest = finishing;
+        }
+
+        for(; nextFrame < requested; ++nextFrame) {
+            auto start = frameDuration * static_cast<int64_t>(nextFrame);
+            auto duration = std::min(frameDuration, end - start);
+            writeFrame(nextFrame, start, duration);
+            framesWritten = nextFrame + 1;
+        }
+
+        if(lastRequest) return;
+    }
+}
+
+void SerialAdmWriter::writeFrame(uint64_t frameIndex, std::chrono::nanoseconds start, std::chrono::nanoseconds duration)
+{
+    file << "<frame version=\"ITU-R_BS.2125-1\">\n";
+    file << "<frameHeader>\n";
+    file << "<frameFormat frameFormatID=\"" << formatFrameFormatId(frameIndex) << "\"";
+    file << " start=\"" << formatTime(start) << "\"";
+    file << " duration=\"" << formatTime(duration) << "\"";
+    file << " type=\"full\" timeReference=\"total\"/>\n";
+    file << transportTrackFormat;
+    file << "</frameHeader>\n";
+    sources->writeSerialAdmFrameTo(file, start, duration);
+    file << "\n</frame>\n";
+}
+
+std::string SerialAdmWriter::fileNameFor(std::string const& bw64FileName)
+{
+    auto extensionPos = bw64FileName.find_last_of('.');
+    auto separatorPos = bw64FileName.find_last_of("/\\");
+    if(extensionPos == std::string::npos || (separatorPos != std::string::npos && extensionPos < separatorPos)) {
+        return bw64FileName + ".sadm.xml";
+    }
+    return bw64FileName.substr(0, extensionPos) + ".sadm.xml";
+}
+
+std::string SerialAdmWriter::formatTime(std::chrono::nanoseconds time)
+{
+    // ADM time format - hh:mm:ss.zzzzz
+    auto hours = std::chrono::duration_cast<std::chrono::hours>(time);
+    time -= hours;
+    auto minutes = std::chrono::duration_cast<std::chrono::minutes>(time);
+    time -= minutes;
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(time);
+    time -= seconds;
+    auto fraction = time.count() / 10000;
+
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(2) << hours.count() << ":"
+       << std::setw(2) << minutes.count() << ":"
+       << std::setw(2) << seconds.count() << "."
+       << std::setw(5) << fraction;
+    return ss.str();
+}
+
+std::string SerialAdmWriter::formatFrameFormatId(uint64_t frameIndex)
+{
+    // Frame numbers start at 1
+    std::stringstream ss;
+    ss << "FF_" << std::setfill('0') << std::setw(11) << std::hex << (frameIndex + 1);
+    return ss.str();
+}
+
+std::string SerialAdmWriter::formatTransportTrackFormat(std::shared_ptr<bw64::ChnaChunk> chna)
+{
+    std::map<uint16_t, std::vector<std::string>> uidsByTrack;
+    std::size_t uidCount = 0;
+    if(chna) {
+        for(auto const& audioId : chna->audioIds()) {
+            uidsByTrack[audioId.trackIndex()].push_back(audioId.uid());
+            uidCount++;
+        }
+    }
+
+    std::stringstream ss;
+    ss << "<transportTrackFormat transportID=\"TP_0001\" numIDs=\"" << uidCount << "\" numTracks=\"" << uidsByTrack.size() << "\">\n";
+    for(auto const& [trackIndex, uids] : uidsByTrack) {
+        ss << "<audioTrack trackID=\"" << trackIndex << "\">\n";
+        for(auto const& uid : uids) {
+            ss << "<audioTrackUIDRef>" << uid << "</audioTrackUIDRef>\n";
+        }
+        ss << "</audioTrack>\n";
+    }
+    ss << "</transportTrackFormat>\n";
+    return ss.str();
+}
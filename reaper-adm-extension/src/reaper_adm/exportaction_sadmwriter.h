@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include <bw64/bw64.hpp>
+
+class IExportSources;
+
+constexpr std::chrono::milliseconds SERIAL_ADM_FRAME_DURATION{ 1000 };
+
+class SerialAdmWriter
+{
+    /*
+    Writes BS.2125 Serial ADM frames to a file alongside the BW64 as the render progresses.
+    Each frame is "full" type, holding all the metadata for its time span, so memory use is bounded by the
+     frame duration rather than the length of the programme.
+    The frames are written in order within a single frameSequence root element, so the file is one XML document.
+    Frames are generated on a worker thread once the audio they cover has been written.
+    */
+public:
+    SerialAdmWriter(std::string const& fileName, IExportSources* sources, std::shared_ptr<bw64::ChnaChunk> chna, std::chrono::nanoseconds frameDuration = SERIAL_ADM_FRAME_DURATION);
+    ~SerialAdmWriter();
+
+    bool isOpen() const { return file.is_open(); }
+    std::string getFileName() const { return fileName; }
+    uint64_t getFramesWritten() const { return framesWritten; }
+
+    // Frames which end before this time are queued for the worker
+    void audioWrittenUntil(std::chrono::nanoseconds time);
+    // Writes the remaining frames, the last one cut short at the end of the programme, and stops the worker
+    void finish(std::chrono::nanoseconds programmeDuration);
+
+    // Sidecar file name for a BW64 file name, e.g, "mix.wav" -> "mix.sadm.xml"
+    static std::string fileNameFor(std::string const& bw64FileName);
+    static std::string formatTime(std::chrono::nanoseconds time);
+    static std::string formatFrameFormatId(uint64_t frameIndex);
+    static std::string formatTransportTrackFormat(std::shared_ptr<bw64::ChnaChunk> chna);
+
+private:
+    void run();
+    void writeFrame(uint64_t frameIndex, std::chrono::nanoseconds start, std::chrono::nanoseconds duration);
+
+    std::string fileName;
+    std::ofstream file;
+    IExportSources* sources;
+    std::string transportTrackFormat; // Same in every frame, so only formatted once
+    std::chrono::nanoseconds frameDuration;
+
+    std::mutex mutex;
+    std::condition_variable framesRequestedCondition;
+    uint64_t framesRequested{ 0 };
+    std::chrono::nanoseconds programmeEnd{ std::chrono::nanoseconds::max() };
+    bool finishing{ false };
+
+    std::atomic<uint64_t> framesWritten{ 0 };
+    std::thread worker;
+};
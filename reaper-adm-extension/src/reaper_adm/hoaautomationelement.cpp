@@ -14,7 +14,7 @@ std::optional<AutomationPoint> getPoint(Parameter const& param, adm::AudioBlockF
 }
 }
 
-HoaAutomationElement::HoaAutomationElement(ADMChannel channel, std::shared_ptr<TrackElement> track, std::shared_ptr<TakeElement> take) : admChannel{std::move(channel)}
+HoaAutomationElement::HoaAutomationElement(ADMChannel channel, std::shared_ptr<TrackElement> track, std::shared_ptr<TakeElement> take, std::shared_ptr<ImportSettings const> settings) : admChannel{std::move(channel)}, settings{std::move(settings)}
 
 {
     parentTake_ = take;
@@ -58,11 +58,11 @@ int getBlockOrder(adm::AudioBlockFormatHoa block) {
 }
 
 void HoaAutomationElement::apply(const PluginParameter &parameter, const Plugin &plugin) const {
-    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, plugin);
+    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, plugin, simplificationTolerance());
 }
 
 void HoaAutomationElement::apply(const TrackParameter &parameter, const Track &track) const {
-    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, track);
+    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, track, simplificationTolerance());
 }
 
 std::vector<AutomationPoint> HoaAutomationElement::pointsFor(Parameter const& parameter) const {
@@ -97,4 +97,10 @@ int HoaAutomationElement::channelIndex() const
         return static_cast<int>(location - chans.cbegin());
     }
     return -1;
-}
\ No newline at end of file
+}
+
+double HoaAutomationElement::simplificationTolerance() const
+{
+    if(!settings) return 0.0;
+    return automationSimplificationTolerance(settings->automationSimplification);
+}
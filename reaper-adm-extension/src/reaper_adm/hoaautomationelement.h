@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "projectelements.h"
+#include "importsettings.h"
 #include "automationpoint.h"
 #include "admchannel.h"
 
@@ -10,7 +11,7 @@ class Parameter;
 
 class HoaAutomationElement : public HoaAutomation {
 public:
-    HoaAutomationElement(ADMChannel admChannel, std::shared_ptr<TrackElement> parentTrack, std::shared_ptr<TakeElement> parentTake = nullptr);
+    HoaAutomationElement(ADMChannel admChannel, std::shared_ptr<TrackElement> parentTrack, std::shared_ptr<TakeElement> parentTake = nullptr, std::shared_ptr<ImportSettings const> settings = nullptr);
     void createProjectElements(PluginSuite &pluginSuite, const ReaperAPI &api) override;
     adm::BlockFormatsConstRange<adm::AudioBlockFormatHoa> blocks() const override;
     double startTime() const override;
@@ -24,7 +25,9 @@ private:
     std::vector<adm::ElementConstVariant> getAdmElements() const override;
     std::shared_ptr<TakeElement> parent;
     std::vector<AutomationPoint> pointsFor(const Parameter &parameter) const;
+    double simplificationTolerance() const;
     ADMChannel admChannel;
+    std::shared_ptr<ImportSettings const> settings;
 };
 
 }
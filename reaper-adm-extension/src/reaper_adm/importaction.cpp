@@ -4,6 +4,7 @@
 #include "progress/importprogress.h"
 #include "progress/importdialog.h"
 #include "bw64/bw64.hpp"
+#include "importfilecache.h"
 #include "admvstcontrol.h"
 #include <array>
 
@@ -11,6 +12,7 @@ using namespace admplug;
 
 ImportAction::ImportAction(REAPER_PLUGIN_HINSTANCE hInstance, HWND main, std::shared_ptr<PluginSuite> suite) :
     pluginSuite{suite},
+    importSettings{std::make_shared<ImportSettings>()},
     hInstance{ hInstance }, main{main}
 {
 }
@@ -42,11 +44,11 @@ void ImportAction::performImport(MediaItem* fromMediaItem, std::string fileName,
 
     auto importer = std::make_unique<ADMImporter>(fromMediaItem,
                                                   fileName,
-                                                  ImportContext{broadcast, progress, pluginSuite, api},
+                                                  ImportContext{broadcast, progress, pluginSuite, api, importSettings},
                                                   projectPath);
     auto importExecutor = std::make_shared<ThreadedImport>(std::move(importer));
     // construction is for side effects - cleans up after itself when window closed
-    new ReaperDialogBox(main, hInstance, progress, importExecutor);
+    new ReaperDialogBox(main, hInstance, progress, importExecutor, importSettings);
 }
 
 PCM_source* ImportAction::getSourceFromMediaItem(MediaItem* mediaItem, const ReaperAPI& api) {
@@ -89,41 +91,36 @@ bool admplug::ImportAction::canMediaExplode_QuickCheck(const ReaperAPI & api, Me
     return canMediaExplode_QuickCheck(api, getFilenameFromMediaItem(mediaItem, api), errOut);
 }
 
-bool admplug::ImportAction::canMediaExplode_QuickCheck(const ReaperAPI & api, std::string mediaFile, std::string* errOut)
+bool admplug::ImportAction::canMediaExplode_QuickCheck(const ReaperAPI & api, std::string mediaFile, std::string* errOut, bool keepForImport)
 {
+    std::string err;
     try {
-        auto bw64File = bw64::readFile(mediaFile);
-        bool chnaMissing{ false };
-        bool axmlMissing{ false };
-        if (!bw64File->chnaChunk()) chnaMissing = true;
-        if (!bw64File->axmlChunk()) axmlMissing = true;
+        // Not cached otherwise - the context menu checks files it usually won't import
+        auto bw64File = keepForImport ? ImportFileCache::getInstance().open(mediaFile) : bw64::readFile(mediaFile);
+        bool chnaMissing{ !bw64File->chnaChunk() };
+        bool axmlMissing{ !bw64File->axmlChunk() };
         if (chnaMissing && axmlMissing) {
-            if (errOut) {
-                *errOut = "No CHNA or AXML chunk found.";
-            }
-            return false;
-        }
-        if (chnaMissing) {
-            if (errOut) {
-                *errOut = "No CHNA chunk found.";
-            }
-            return false;
-        }
-        if (axmlMissing) {
-            if (errOut) {
-                *errOut = "No AXML chunk found.";
-            }
-            return false;
+            err = "No CHNA or AXML chunk found.";
+        } else if (chnaMissing) {
+            err = "No CHNA chunk found.";
+        } else if (axmlMissing) {
+            err = "No AXML chunk found.";
         }
     }
     catch (const std::runtime_error& e) {
         // Probably not RIFF/BW64/RF64 or not WAVE.
-        if(errOut) {
-            *errOut = e.what();
-        }
-        return false;
+        err = e.what();
+    }
+    if (err.empty()) {
+        return true;
+    }
+    if (keepForImport) {
+        ImportFileCache::getInstance().clear();
+    }
+    if (errOut) {
+        *errOut = err;
     }
-    return true;
+    return false;
 }
 
 
@@ -8,6 +8,7 @@
 #include "admmetadata.h"
 #include "pluginsuite.h"
 #include "reaperhost.h"
+#include "importsettings.h"
 #include "progress/importlistener.h"
 
 namespace admplug {
@@ -20,10 +21,12 @@ public:
     void import(MediaItem* source, const ReaperAPI& api);
 
     static bool canMediaExplode_QuickCheck(const ReaperAPI& api, MediaItem* mediaItem, std::string* errOut = nullptr);
-    static bool canMediaExplode_QuickCheck(const ReaperAPI& api, std::string mediaFile, std::string* errOut = nullptr);
+    // keepForImport holds the opened file in ImportFileCache, for an import made straight after a successful check
+    static bool canMediaExplode_QuickCheck(const ReaperAPI& api, std::string mediaFile, std::string* errOut = nullptr, bool keepForImport = false);
 
 private:
     std::shared_ptr<PluginSuite> pluginSuite;
+    std::shared_ptr<ImportSettings> importSettings; // Kept between imports so the last choices are remembered
     REAPER_PLUGIN_HINSTANCE hInstance;
     static PCM_source* getSourceFromMediaItem(MediaItem* mediaItem, const ReaperAPI& api);
     static std::string getFilenameFromMediaItem(MediaItem* mediaItem, const ReaperAPI& api);
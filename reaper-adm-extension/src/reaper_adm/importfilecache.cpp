@@ -0,0 +1,63 @@
+#include "importfilecache.h"
+#include <bw64/bw64.hpp>
+#include <system_error>
+
+using namespace admplug;
+
+namespace {
+std::filesystem::file_time_type lastWriteTime(std::string const& fileName) {
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(std::filesystem::u8path(fileName), ec);
+    return ec ? std::filesystem::file_time_type::min() : writeTime;
+}
+}
+
+ImportFileCache& ImportFileCache::getInstance()
+{
+    static ImportFileCache instance;
+    return instance;
+}
+
+std::shared_ptr<bw64::Bw64Reader> ImportFileCache::open(std::string const& fileName)
+{
+    auto writeTime = lastWriteTime(fileName);
+    std::lock_guard<std::mutex> lock(mutex);
+    if(auto reader = cachedReaderFor(fileName, writeTime)) {
+        return reader;
+    }
+
+    cachedReader.reset(); // Release the previous file before opening another
+    std::shared_ptr<bw64::Bw64Reader> reader = bw64::readFile(fileName);
+    cachedFileName = fileName;
+    cachedWriteTime = writeTime;
+    cachedReader = reader;
+    return reader;
+}
+
+std::shared_ptr<bw64::Bw64Reader> ImportFileCache::take(std::string const& fileName)
+{
+    auto writeTime = lastWriteTime(fileName);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto reader = cachedReaderFor(fileName, writeTime);
+    cachedReader.reset();
+    cachedFileName.clear();
+    if(reader) {
+        return reader;
+    }
+    return bw64::readFile(fileName);
+}
+
+void ImportFileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    cachedReader.reset();
+    cachedFileName.clear();
+}
+
+std::shared_ptr<bw64::Bw64Reader> ImportFileCache::cachedReaderFor(std::string const& fileName, std::filesystem::file_time_type writeTime)
+{
+    if(cachedReader && cachedFileName == fileName && cachedWriteTime == writeTime) {
+        return cachedReader;
+    }
+    return nullptr;
+}
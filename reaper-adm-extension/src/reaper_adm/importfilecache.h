@@ -0,0 +1,42 @@
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace bw64 {
+  class Bw64Reader;
+}
+
+namespace admplug {
+
+class ImportFileCache
+{
+    /*
+    Holds on to the BW64 reader opened when a file is checked just before importing it,
+     so the import can use the same handle and already parsed chunks
+     rather than opening and scanning the file again.
+    Only the most recently checked file is kept, and only until it is taken for import or cleared.
+    Checks which may not be followed by an import shouldn't use the cache, as it keeps the file open.
+    */
+public:
+    static ImportFileCache& getInstance();
+
+    // Returns the cached reader if it is for this file and the file hasn't changed since, otherwise opens and caches it
+    std::shared_ptr<bw64::Bw64Reader> open(std::string const& fileName);
+    // As open(), but the reader is removed from the cache - it's the caller's to read audio from
+    std::shared_ptr<bw64::Bw64Reader> take(std::string const& fileName);
+    // Releases the cached reader, for a checked file that won't be imported
+    void clear();
+
+private:
+    ImportFileCache() = default;
+    std::shared_ptr<bw64::Bw64Reader> cachedReaderFor(std::string const& fileName, std::filesystem::file_time_type writeTime);
+
+    std::mutex mutex;
+    std::string cachedFileName;
+    std::filesystem::file_time_type cachedWriteTime;
+    std::shared_ptr<bw64::Bw64Reader> cachedReader;
+};
+
+}
@@ -0,0 +1,24 @@
+#include "importsettings.h"
+
+using namespace admplug;
+
+std::vector<AutomationSimplificationOption> const& admplug::automationSimplificationOptions()
+{
+    static std::vector<AutomationSimplificationOption> const options{
+        {AutomationSimplification::REPEATED_VALUES, "Remove repeated values only", 0.0},
+        {AutomationSimplification::FINE,            "Fine (0.05% tolerance)",      0.0005},
+        {AutomationSimplification::MEDIUM,          "Medium (0.2% tolerance)",     0.002},
+        {AutomationSimplification::COARSE,          "Coarse (1% tolerance)",       0.01}
+    };
+    return options;
+}
+
+double admplug::automationSimplificationTolerance(AutomationSimplification simplification)
+{
+    for(auto const& option : automationSimplificationOptions()) {
+        if(option.simplification == simplification) {
+            return option.tolerance;
+        }
+    }
+    return 0.0;
+}
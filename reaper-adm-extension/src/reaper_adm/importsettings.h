@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace admplug {
+
+enum class AutomationSimplification {
+    REPEATED_VALUES,
+    FINE,
+    MEDIUM,
+    COARSE
+};
+
+struct AutomationSimplificationOption {
+    AutomationSimplification simplification;
+    std::string name;
+    double tolerance; // Maximum deviation from the original automation, in normalised (0-1) parameter value
+};
+
+std::vector<AutomationSimplificationOption> const& automationSimplificationOptions();
+double automationSimplificationTolerance(AutomationSimplification simplification);
+
+/**
+ * @brief The ImportSettings struct
+ * User choices for an import which affect how REAPER elements are created.
+ */
+struct ImportSettings {
+    AutomationSimplification automationSimplification{ AutomationSimplification::REPEATED_VALUES };
+};
+
+}
@@ -10,9 +10,10 @@
 
 using namespace admplug;
 
-NodeCreator::NodeCreator(std::shared_ptr<IPCMSourceCreator> pcmCreator, MediaItem* fromMediaItem) :
+NodeCreator::NodeCreator(std::shared_ptr<IPCMSourceCreator> pcmCreator, MediaItem* fromMediaItem, std::shared_ptr<ImportSettings const> settings) :
     pcmCreator{std::move(pcmCreator)},
-    originalMediaItem{ fromMediaItem }
+    originalMediaItem{ fromMediaItem },
+    settings{ std::move(settings) }
 {
 }
 
@@ -62,14 +63,14 @@ std::shared_ptr<ProjectNode> admplug::NodeCreator::createAutomationNode(ADMChann
     auto channelFormat = channel.channelFormat();
     if(channelFormat) {
         if(!channelFormat->getElements<adm::AudioBlockFormatDirectSpeakers>().empty()) {
-            return std::make_shared<ProjectNode>(std::make_unique<DirectSpeakersAutomationElement>(channel, parentTrack, parentTake));
+            return std::make_shared<ProjectNode>(std::make_unique<DirectSpeakersAutomationElement>(channel, parentTrack, parentTake, settings));
         }
         if(!channelFormat->getElements<adm::AudioBlockFormatHoa>().empty()) {
-            return std::make_shared<ProjectNode>(std::make_unique<HoaAutomationElement>(channel, parentTrack, parentTake));
+            return std::make_shared<ProjectNode>(std::make_unique<HoaAutomationElement>(channel, parentTrack, parentTake, settings));
         }
     }
 
     // if no blocks default to object track
-    return std::make_shared<ProjectNode>(std::make_unique<ObjectAutomationElement>(channel, parentTrack, parentTake));
+    return std::make_shared<ProjectNode>(std::make_unique<ObjectAutomationElement>(channel, parentTrack, parentTake, settings));
 
 }
@@ -4,6 +4,7 @@
 #include <adm/element_variant.hpp>
 #include "reaperapi.h"
 #include "admchannel.h"
+#include "importsettings.h"
 
 namespace admplug {
 
@@ -53,7 +54,7 @@ public:
 
 class NodeCreator : public NodeFactory {
 public:
-    NodeCreator(std::shared_ptr<IPCMSourceCreator> pcmCreator, MediaItem* fromMediaItem = nullptr);
+    NodeCreator(std::shared_ptr<IPCMSourceCreator> pcmCreator, MediaItem* fromMediaItem = nullptr, std::shared_ptr<ImportSettings const> settings = nullptr);
     NodeCreator(NodeFactory const& other) = delete;
     NodeCreator& operator=(NodeFactory const& other) = delete;
     std::shared_ptr<ProjectNode> createObjectTrackNode(std::shared_ptr<const adm::AudioObject> representedAudioObject, std::shared_ptr<const adm::AudioTrackUid> representedAudioTrackUid, std::vector<adm::ElementConstVariant> elements, std::shared_ptr<TrackElement> parentGroupTrack) override;
@@ -69,6 +70,7 @@ public:
 private:
     std::shared_ptr<IPCMSourceCreator> pcmCreator;
     MediaItem* originalMediaItem;
+    std::shared_ptr<ImportSettings const> settings;
     int currentGroup{0};
 
 };
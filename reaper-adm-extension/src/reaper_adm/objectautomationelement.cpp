@@ -60,8 +60,10 @@ std::optional<AutomationPoint> getPoint(Parameter const& param, adm::AudioBlockF
 
 ObjectAutomationElement::ObjectAutomationElement(ADMChannel admChannel,
                                                 std::shared_ptr<TrackElement> track,
-                                                std::shared_ptr<TakeElement> take) :
-    admChannel{std::move(admChannel)}
+                                                std::shared_ptr<TakeElement> take,
+                                                std::shared_ptr<ImportSettings const> settings) :
+    admChannel{std::move(admChannel)},
+    settings{std::move(settings)}
 {
     parentTake_ = take;
     parentTrack_ = track;
@@ -184,9 +186,15 @@ void setPoint(AutomationPoint const& point, Parameter& parameter, AutomatableT&
 }
 
 void admplug::ObjectAutomationElement::apply(const PluginParameter& parameter, const Plugin& plugin) const {
-    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, plugin);
+    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, plugin, simplificationTolerance());
 }
 
 void admplug::ObjectAutomationElement::apply(const TrackParameter& parameter, const Track& track) const {
-    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, track);
+    detail::applyAutomation(pointsFor(parameter), startTime(), parameter, track, simplificationTolerance());
+}
+
+double admplug::ObjectAutomationElement::simplificationTolerance() const
+{
+    if(!settings) return 0.0;
+    return automationSimplificationTolerance(settings->automationSimplification);
 }
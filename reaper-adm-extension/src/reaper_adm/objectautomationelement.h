@@ -1,5 +1,6 @@
 #pragma once
 #include "projectelements.h"
+#include "importsettings.h"
 #include "admchannel.h"
 #include "automationpoint.h"
 
@@ -13,7 +14,7 @@ class Track;
 
 class ObjectAutomationElement : public ObjectAutomation {
 public:
-    ObjectAutomationElement(ADMChannel channel, std::shared_ptr<TrackElement> parentTrack, std::shared_ptr<TakeElement> parentTake = nullptr);
+    ObjectAutomationElement(ADMChannel channel, std::shared_ptr<TrackElement> parentTrack, std::shared_ptr<TakeElement> parentTake = nullptr, std::shared_ptr<ImportSettings const> settings = nullptr);
     void createProjectElements(PluginSuite &pluginSuite, const ReaperAPI &api) override;
     adm::BlockFormatsConstRange<adm::AudioBlockFormatObjects> blocks() const override;
     double startTime() const override;
@@ -24,6 +25,8 @@ public:
 private:
     std::vector<adm::ElementConstVariant> getAdmElements() const override;
     std::vector<AutomationPoint> pointsFor(const Parameter &parameter) const;
+    double simplificationTolerance() const;
     ADMChannel admChannel;
+    std::shared_ptr<ImportSettings const> settings;
 };
 }
@@ -18,9 +18,12 @@ namespace {
   constexpr std::size_t DEFAULT_BLOCK_SIZE{4096};
 }
 
-Bw64PCMReader::Bw64PCMReader(std::string fileName) : blockSize{DEFAULT_BLOCK_SIZE}
+Bw64PCMReader::Bw64PCMReader(std::string fileName) : Bw64PCMReader(std::shared_ptr<bw64::Bw64Reader>(bw64::readFile(fileName)))
+{
+}
+
+Bw64PCMReader::Bw64PCMReader(std::shared_ptr<bw64::Bw64Reader> reader) : reader{std::move(reader)}, blockSize{DEFAULT_BLOCK_SIZE}
 {
-    reader = bw64::readFile(fileName);
 }
 
 Bw64PCMReader::~Bw64PCMReader() = default;
@@ -22,11 +22,12 @@ class Bw64PCMReader : public PCMReader
 {
 public:
     Bw64PCMReader(std::string fileName);
+    explicit Bw64PCMReader(std::shared_ptr<bw64::Bw64Reader> reader);
     ~Bw64PCMReader();
     std::shared_ptr<IPCMBlock> read() override;
     std::size_t totalFrames() override;
 private:
-    std::unique_ptr<bw64::Bw64Reader> reader;
+    std::shared_ptr<bw64::Bw64Reader> reader;
     std::size_t blockSize;
 };
 
@@ -297,7 +297,7 @@ extern "C" {
             if(api.GetUserFileNameForRead(filename, "ADM BW64 File to Open", "wav")) {
                 filenameStr = std::string(filename);
                 std::string errOut;
-                if(ImportAction::canMediaExplode_QuickCheck(api, filenameStr, &errOut)) {
+                if(ImportAction::canMediaExplode_QuickCheck(api, filenameStr, &errOut, true)) {
                     importer.import(filenameStr, api);
                 } else {
                     std::string errMsg{ "Error: This file can not be imported.\n\nResponse: " };
@@ -347,7 +347,7 @@ extern "C" {
         if (api.GetUserFileNameForRead(filename, "ADM BW64 File to Import", "wav")) {
             filenameStr = std::string(filename);
             std::string errOut;
-            if(ImportAction::canMediaExplode_QuickCheck(api, filenameStr), &errOut) {
+            if(ImportAction::canMediaExplode_QuickCheck(api, filenameStr, &errOut, true)) {
                 importer.import(filenameStr, api);
             } else {
                 std::string errMsg{ "Error: This file can not be imported.\n\nResponse: " };
@@ -568,19 +568,11 @@ void admplug::EARPluginCallbackHandler::reset()
 
 bool admplug::EARPluginCallbackHandler::waitForPluginResponse(uint16_t maxMs)
 {
-    std::chrono::milliseconds dur(maxMs);
-    auto start = std::chrono::system_clock::now();
-    auto end = start + dur;
-    const std::chrono::milliseconds intervalMs(10);
-
-    while((std::chrono::system_clock::now() + intervalMs) < end) {
-        std::this_thread::sleep_for(intervalMs);
-        std::lock_guard<std::mutex> lock(activeCallbackMutex);
-        if(activeCallback.has_value()) {
-            return true;
-        }
-    }
-    return false;
+    // The plugin usually registers during instantiation, in which case this returns immediately
+    std::unique_lock<std::mutex> lock(activeCallbackMutex);
+    return callbackRegistered.wait_for(lock, std::chrono::milliseconds(maxMs), [this]() {
+        return activeCallback.has_value();
+    });
 }
 
 bool admplug::EARPluginCallbackHandler::sendData(std::string const & xmlState)
@@ -595,8 +587,11 @@ bool admplug::EARPluginCallbackHandler::sendData(std::string const & xmlState)
 
 void admplug::EARPluginCallbackHandler::setPluginCallback(std::function<void(std::string const&)> callback)
 {
-    std::lock_guard<std::mutex> lock(activeCallbackMutex);
-    activeCallback = callback;
+    {
+        std::lock_guard<std::mutex> lock(activeCallbackMutex);
+        activeCallback = callback;
+    }
+    callbackRegistered.notify_all();
 }
 
 admplug::EARPluginCallbackHandler::EARPluginCallbackHandler()
@@ -623,23 +618,17 @@ std::shared_ptr<EARPluginInstanceIdProvider> admplug::EARPluginInstanceIdProvide
 
 void admplug::EARPluginInstanceIdProvider::expectRequest()
 {
+    std::lock_guard<std::mutex> lock(lastProvidedIdMutex);
     awaitingRequest = true;
 }
 
 bool admplug::EARPluginInstanceIdProvider::waitForRequest(uint16_t maxMs)
 {
-    std::chrono::milliseconds dur(maxMs);
-    auto start = std::chrono::system_clock::now();
-    auto end = start + dur;
-    const std::chrono::milliseconds intervalMs(10);
-
-    while((std::chrono::system_clock::now() + intervalMs) < end) {
-        std::this_thread::sleep_for(intervalMs);
-        if(!awaitingRequest) {
-            return true;
-        }
-    }
-    return false;
+    // The plugin usually requests its ID during instantiation, in which case this returns immediately
+    std::unique_lock<std::mutex> lock(lastProvidedIdMutex);
+    return requestReceived.wait_for(lock, std::chrono::milliseconds(maxMs), [this]() {
+        return !awaitingRequest;
+    });
 }
 
 std::optional<uint32_t> admplug::EARPluginInstanceIdProvider::getLastProvidedId()
@@ -648,20 +637,29 @@ std::optional<uint32_t> admplug::EARPluginInstanceIdProvider::getLastProvidedId(
     return lastProvidedId;
 }
 
-uint32_t admplug::EARPluginInstanceIdProvider::getNextAvailableId()
+uint32_t admplug::EARPluginInstanceIdProvider::nextId() const
 {
-    std::lock_guard<std::mutex> lock(lastProvidedIdMutex);
     if(lastProvidedId.has_value()) {
         return lastProvidedId.value() + 1;
     }
     return 1; // Start at ID 1 - makes it easier to spot unset IDs (val would be 0)
 }
 
-uint32_t admplug::EARPluginInstanceIdProvider::provideId()
+uint32_t admplug::EARPluginInstanceIdProvider::getNextAvailableId()
 {
-    auto id = getNextAvailableId();
     std::lock_guard<std::mutex> lock(lastProvidedIdMutex);
-    lastProvidedId = id;
-    awaitingRequest = false;
+    return nextId();
+}
+
+uint32_t admplug::EARPluginInstanceIdProvider::provideId()
+{
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(lastProvidedIdMutex);
+        id = nextId();
+        lastProvidedId = id;
+        awaitingRequest = false;
+    }
+    requestReceived.notify_all();
     return id;
 }
@@ -5,6 +5,7 @@
 #include <map>
 #include <optional>
 #include <mutex>
+#include <condition_variable>
 #include <functional>
 #include "pluginsuite.h"
 #include "projectelements.h"
@@ -31,8 +32,11 @@ public:
     uint32_t provideId();
 
 private:
+    // Caller must hold lastProvidedIdMutex
+    uint32_t nextId() const;
 
     std::mutex lastProvidedIdMutex;
+    std::condition_variable requestReceived;
     std::optional<uint32_t> lastProvidedId;
     bool awaitingRequest{ false };
 
@@ -56,6 +60,7 @@ public:
 private:
 
     std::mutex activeCallbackMutex;
+    std::condition_variable callbackRegistered;
     std::optional<std::function<void(std::string const&)>> activeCallback;
 };
 
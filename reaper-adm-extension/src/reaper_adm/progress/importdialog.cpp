@@ -15,6 +15,9 @@ using namespace admplug;
 #ifndef HIWORD
 #define HIWORD(l)           ((WORD)((((DWORD_PTR)(l)) >> 16) & 0xffff))
 #endif
+#ifndef LOWORD
+#define LOWORD(l)           ((WORD)(((DWORD_PTR)(l)) & 0xffff))
+#endif
 
 namespace {
 
@@ -23,19 +26,20 @@ struct DialogControls {
     std::optional<std::string> status;
     std::string buttonText;
     bool buttonEnabled;
+    bool simplificationEnabled; // Only read when REAPER elements are created, so can be changed until then
 };
 
 auto noChange = std::optional<std::string>{};
 std::map<ImportStatus, DialogControls> const dialogControlStates{
-    {ImportStatus::INIT,                        {noChange, noChange, "Cancel", false}},
-    {ImportStatus::STARTING,                    {noChange, noChange, "Cancel", true}},
-    {ImportStatus::PARSING_METADATA,            {noChange, "Parsing ADM metadata...", "Cancel", true}},
-    {ImportStatus::EXTRACTING_AUDIO,            {noChange, "Extracting audio", "Cancel", true}},
-    {ImportStatus::AUDIO_READY,                 {noChange, "Audio imported. Creating REAPER elements...", "Cancel", false}},
-    {ImportStatus::CREATING_REAPER_ELEMENTS,    {noChange, noChange, "Cancel", false}},
-    {ImportStatus::COMPLETE,                    {"Import Complete", "", "OK", true}},
-    {ImportStatus::CANCELLED,                   {"Import Cancelled. Tidying up...", "", "Cancel", false}},
-    {ImportStatus::ERROR_OCCURRED,              {"Import Failed", noChange, "OK", true}}
+    {ImportStatus::INIT,                        {noChange, noChange, "Cancel", false, true}},
+    {ImportStatus::STARTING,                    {noChange, noChange, "Cancel", true, true}},
+    {ImportStatus::PARSING_METADATA,            {noChange, "Parsing ADM metadata...", "Cancel", true, true}},
+    {ImportStatus::EXTRACTING_AUDIO,            {noChange, "Extracting audio", "Cancel", true, true}},
+    {ImportStatus::AUDIO_READY,                 {noChange, "Audio imported. Creating REAPER elements...", "Cancel", false, false}},
+    {ImportStatus::CREATING_REAPER_ELEMENTS,    {noChange, noChange, "Cancel", false, false}},
+    {ImportStatus::COMPLETE,                    {"Import Complete", "", "OK", true, false}},
+    {ImportStatus::CANCELLED,                   {"Import Cancelled. Tidying up...", "", "Cancel", false, false}},
+    {ImportStatus::ERROR_OCCURRED,              {"Import Failed", noChange, "OK", true, false}}
 };
 }
 
@@ -72,9 +76,11 @@ WDL_DLGRET dlgProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM lParam) {
 ReaperDialogBox::ReaperDialogBox(HWND main,
                                  REAPER_PLUGIN_HINSTANCE instance,
                                  std::shared_ptr<ImportProgress> parent,
-                                 std::shared_ptr<ImportExecutor> exec) :
+                                 std::shared_ptr<ImportExecutor> exec,
+                                 std::shared_ptr<ImportSettings> settings) :
     parent{parent},
-    executor{std::move(exec)}
+    executor{std::move(exec)},
+    settings{std::move(settings)}
 {
     CreateDialogParam(instance, MAKEINTRESOURCE(IDD_FORMVIEW), main, &dlgProc, reinterpret_cast<LPARAM>(this));
 }
@@ -103,6 +109,29 @@ void ReaperDialogBox::setButtonEnabled(bool enabled) {
     EnableWindow(btn, enabled);
 }
 
+void ReaperDialogBox::initSimplificationOptions() {
+    HWND combo = GetDlgItem(dialog, IDC_SIMPLIFICATION);
+    auto const& options = automationSimplificationOptions();
+    for(std::size_t i = 0; i < options.size(); ++i) {
+        SendMessage(combo, CB_ADDSTRING, 0, reinterpret_cast<LPARAM>(options[i].name.c_str()));
+        if(settings && options[i].simplification == settings->automationSimplification) {
+            SendMessage(combo, CB_SETCURSEL, i, 0);
+        }
+    }
+}
+
+void ReaperDialogBox::onSimplificationChanged() {
+    auto selected = SendMessage(GetDlgItem(dialog, IDC_SIMPLIFICATION), CB_GETCURSEL, 0, 0);
+    auto const& options = automationSimplificationOptions();
+    if(settings && selected >= 0 && static_cast<std::size_t>(selected) < options.size()) {
+        settings->automationSimplification = options[selected].simplification;
+    }
+}
+
+void ReaperDialogBox::setSimplificationEnabled(bool enabled) {
+    EnableWindow(GetDlgItem(dialog, IDC_SIMPLIFICATION), enabled && settings);
+}
+
 std::string ReaperDialogBox::getStatusText() {
     static std::array<char, 1024> textBuffer;
     std::string text;
@@ -145,7 +174,7 @@ INT_PTR ReaperDialogBox::process(HWND window, UINT msg, WPARAM wParam, LPARAM lP
         auto progress = parent.lock();
         if(progress) {
             auto state = progress->status();
-            auto[headerTxt, statusTxt, buttonTxt, cancelAndCloseEnabled] = dialogControlStates.at(state);
+            auto[headerTxt, statusTxt, buttonTxt, cancelAndCloseEnabled, simplificationEnabled] = dialogControlStates.at(state);
             if(cancelAndCloseEnabled) {
                 finish();
             }
@@ -155,6 +184,12 @@ INT_PTR ReaperDialogBox::process(HWND window, UINT msg, WPARAM wParam, LPARAM lP
 #endif
     case WM_COMMAND:
     {
+        if(LOWORD(wParam) == IDC_SIMPLIFICATION) {
+            if(HIWORD(wParam) == CBN_SELCHANGE) {
+                onSimplificationChanged();
+            }
+            return 0;
+        }
         if(HIWORD(wParam) == BN_CLICKED) {
             // Should really check which button was clicked, but theres only one...
             //if ((HWND)lParam == buttonHwnd)...
@@ -231,7 +266,7 @@ void ReaperDialogBox::onStateChanged()
 
 void ReaperDialogBox::update()
 {
-    auto[headerTxt, statusTxt, buttonTxt, buttonEnabled] = dialogControlStates.at(currentState);
+    auto[headerTxt, statusTxt, buttonTxt, buttonEnabled, simplificationEnabled] = dialogControlStates.at(currentState);
     // Text
     if(headerTxt) {
         setHeaderText(*headerTxt);
@@ -242,11 +277,12 @@ void ReaperDialogBox::update()
     // Button
     setButtonEnabled(buttonEnabled);
     setButtonText(buttonTxt);
+    setSimplificationEnabled(simplificationEnabled);
 }
 
 void ReaperDialogBox::reportAudioProgress()
 {
-    auto [headerTxt, statusTxt, buttonTxt, buttonEnabled] = dialogControlStates.at(ImportStatus::EXTRACTING_AUDIO);
+    auto [headerTxt, statusTxt, buttonTxt, buttonEnabled, simplificationEnabled] = dialogControlStates.at(ImportStatus::EXTRACTING_AUDIO);
     std::stringstream ss;
     ss.precision(0);
     ss << std::fixed;
@@ -266,6 +302,7 @@ void ReaperDialogBox::reportAudioProgress()
 
 BOOL ReaperDialogBox::init(HWND dialogHandle) {
     dialog = dialogHandle;
+    initSimplificationOptions();
     SetTimer(dialogHandle, TIMER_ID, TIMER_PERIOD_MS, NULL);
     ShowWindow(dialog, SW_SHOW);
     return TRUE;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "importprogress.h"
+#include "../importsettings.h"
 
 namespace admplug {
 class ImportExecutor;
@@ -9,7 +10,8 @@ public:
     ReaperDialogBox(HWND main,
                     REAPER_PLUGIN_HINSTANCE instance,
                     std::shared_ptr<ImportProgress> parent,
-                    std::shared_ptr<ImportExecutor> executor);
+                    std::shared_ptr<ImportExecutor> executor,
+                    std::shared_ptr<ImportSettings> settings);
     ReaperDialogBox(const ReaperDialogBox& other) = delete;
     ReaperDialogBox& operator=(ReaperDialogBox const& other) = delete;
     ~ReaperDialogBox();
@@ -24,11 +26,15 @@ private:
     void setHeaderText(std::string text);
     void setButtonText(std::string text);
     void setButtonEnabled(bool enabled);
+    void initSimplificationOptions();
+    void onSimplificationChanged();
+    void setSimplificationEnabled(bool enabled);
     void reportAudioProgress();
     ImportStatus currentState {ImportStatus::INIT};
     HWND dialog;
     std::weak_ptr<ImportProgress> parent;
     std::shared_ptr<ImportExecutor> executor;
+    std::shared_ptr<ImportSettings> settings;
     HBRUSH backgroundBrush{ nullptr };
     bool closing{false};
 };
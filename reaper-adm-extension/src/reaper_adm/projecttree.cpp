@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "projecttree.h"
+#include "admreferenceindex.h"
 #include "projectelements.h"
 #include "reaperapi.h"
 #include "nodefactory.h"
@@ -17,63 +18,28 @@ using namespace admplug;
 
 namespace {
 
-bool shouldCreateGroup(adm::AudioProgramme const& programme) {
-    auto doc = programme.getParent().lock();
-    assert(doc);
-    return doc->getElements<adm::AudioProgramme>().size() > 1;
-}
-
-bool shouldCreateGroup(adm::AudioContent const& content) {
-    auto doc = content.getParent().lock();
-    assert(doc);
-
-    auto contentId = content.get<adm::AudioContentId>();
-    auto programmes = doc->getElements<adm::AudioProgramme>();
-
-    for (auto programme : programmes) {
-        auto progContents = programme->getReferences<adm::AudioContent>();
-        for (auto progContent : progContents) {
-            if (contentId == progContent->get<adm::AudioContentId>()) {
-                if (progContents.size() > 1) return true;
-            }
-        }
-    }
-
-    return false;
+bool shouldCreateGroup(adm::AudioProgramme const& programme, AdmReferenceIndex const& index) {
+    return index.programmeCount() > 1;
 }
 
-template<typename ParentT>
-bool objectHasMultipleParents(adm::AudioObject const& object, adm::Document const& doc) {
-    auto targetId = object.get<adm::AudioObjectId>();
-    auto parents = doc.getElements<ParentT>();
-    auto refCount = 0;
-    for(auto element : parents) {
-        auto objectRefs = element->template getReferences<adm::AudioObject>();
-        for(auto ref : objectRefs) {
-            if(ref->template get<adm::AudioObjectId>() == targetId) {
-                refCount++;
-                if(refCount > 1) {
-                    return true;
-                }
-            }
-        }
+bool shouldCreateGroup(adm::AudioContent const& content, AdmReferenceIndex const& index) {
+    for (auto const& programme : index.parentProgrammes(content)) {
+        if (programme->getReferences<adm::AudioContent>().size() > 1) return true;
     }
     return false;
 }
 
-bool objectHasMultipleParents(adm::AudioObject const& object, adm::Document const& doc) {
-    return objectHasMultipleParents<adm::AudioObject>(object, doc) ||
-        objectHasMultipleParents<adm::AudioContent>(object, doc);
+bool objectHasMultipleParents(adm::AudioObject const& object, AdmReferenceIndex const& index) {
+    return index.parentObjects(object).size() > 1 ||
+        index.parentContents(object).size() > 1;
 }
 
-bool shouldCreateGroup(adm::AudioObject const& object) {
+bool shouldCreateGroup(adm::AudioObject const& object, AdmReferenceIndex const& index) {
     // If this object has child that has multiple parents, each parent should create a group to show these associations.
     // Future possiblility/User option?: Whether just having multiple children is also a sufficient reason to create a group.
-    auto doc = object.getParent().lock();
-    assert(doc);
     auto childObjects = object.getReferences<adm::AudioObject>();
     for (auto childObject : childObjects) {
-        if(objectHasMultipleParents(*childObject, *doc)) return true;
+        if(objectHasMultipleParents(*childObject, index)) return true;
     }
 
     return false;
@@ -128,12 +94,26 @@ bool nodeIsTakeWithCompatibleElements(ProjectNode const& node, std::vector<uint3
     return true;
 }
 
-bool isDescendantOf(std::shared_ptr<const adm::AudioChannelFormat> cf, std::shared_ptr<const adm::AudioPackFormat> pf) {
-    if(contains(pf->getReferences<adm::AudioChannelFormat>(), cf)) return true;
-    for(auto childPf : pf->getReferences<adm::AudioPackFormat>()) {
-        if(isDescendantOf(cf, childPf)) return true;
+// Track elements match on the set of ADM elements they were created with, in any order (see ProjectElement::hasAdmElements)
+std::vector<void const*> elementSetKey(std::vector<adm::ElementConstVariant> const& elements) {
+    std::vector<void const*> key;
+    key.reserve(elements.size());
+    for(auto const& element : elements) {
+        key.push_back(boost::apply_visitor([](auto const& admElement) -> void const* { return admElement.get(); }, element));
     }
-    return false;
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+template<typename TimeT>
+std::optional<std::chrono::nanoseconds> optionalTime(adm::AudioObject const& object) {
+    if(!object.has<TimeT>()) return std::nullopt;
+    return object.get<TimeT>().get().asNanoseconds();
+}
+
+// Takes are only compatible when start and duration match (see nodeIsTakeWithCompatibleElements)
+std::pair<std::optional<std::chrono::nanoseconds>, std::optional<std::chrono::nanoseconds>> takeTimingKey(adm::AudioObject const& object) {
+    return { optionalTime<adm::Start>(object), optionalTime<adm::Duration>(object) };
 }
 
 void recursePackFormatsForChannelFormats(std::shared_ptr<const adm::AudioPackFormat> fromPackFormat, std::vector<std::shared_ptr<const adm::AudioChannelFormat>> &cfOrder) {
@@ -175,10 +155,12 @@ void sortToVectorsByChannelFormatOrder(const std::map<std::shared_ptr<const adm:
 ProjectTree::ProjectTree(std::unique_ptr<NodeFactory> nodeFactory,
                          std::shared_ptr<IPCMSourceCreator> sourceCreator,
                          std::shared_ptr<ProjectNode> root,
-                         std::shared_ptr<ImportListener> broadcast) : nodeFactory{ std::move(nodeFactory) },
+                         std::shared_ptr<ImportListener> broadcast,
+                         std::shared_ptr<AdmReferenceIndex const> referenceIndex) : nodeFactory{ std::move(nodeFactory) },
     rootNode{ std::move(root) },
     sourceCreator{ std::move(sourceCreator) },
-    broadcast{ std::move(broadcast) }
+    broadcast{ std::move(broadcast) },
+    referenceIndex{ std::move(referenceIndex) }
 {
     resetRoot();
 }
@@ -202,7 +184,7 @@ void ProjectTree::operator()(std::shared_ptr<const adm::AudioProgramme> programm
     state.currentProgramme = programme;
     //Grouping
     if (!moveToChildWithElement(programme)) {
-        if (shouldCreateGroup(*programme)) {
+        if (shouldCreateGroup(*programme, getReferenceIndex(programme->getParent()))) {
             moveToNewGroupNode(programme);
         }
     }
@@ -213,7 +195,7 @@ void ProjectTree::operator()(std::shared_ptr<const adm::AudioContent> content)
     state.currentContent = content;
     //Grouping
     if (!moveToChildWithElement(content)) {
-        if (shouldCreateGroup(*content)) {
+        if (shouldCreateGroup(*content, getReferenceIndex(content->getParent()))) {
             moveToNewGroupNode(content);
         }
     }
@@ -224,7 +206,7 @@ void ProjectTree::operator()(std::shared_ptr<const adm::AudioObject> object)
     state.currentObject = object;
     //Grouping
     if (!moveToTrackNodeWithElement(object)) {
-        if (shouldCreateGroup(*object)) {
+        if (shouldCreateGroup(*object, getReferenceIndex(object->getParent()))) {
             moveToNewGroupNode(object);
         }
     }
@@ -340,6 +322,7 @@ void ProjectTree::moveToNewTakeNode(std::shared_ptr<const adm::AudioObject> admO
     assert(takeNode);
     broadcast->elementAdded();
     moveToNewChild(takeNode);
+    addToNodeLookup(takeNode, *admObjectElement);
 }
 
 void admplug::ProjectTree::addTake(int specificAtuIndex)
@@ -378,6 +361,7 @@ void ProjectTree::moveToNewObjectTrackNode(std::shared_ptr<const adm::AudioObjec
     auto trackNode = nodeFactory->createObjectTrackNode(representedAudioObject, representedAudioTrackUid, elements, parentTrack);
     broadcast->elementAdded();
     moveToNewChild(trackNode);
+    addToNodeLookup(trackNode, elements);
 }
 
 void ProjectTree::moveToNewDirectTrackNode(std::shared_ptr<const adm::AudioObject> representedAudioObject, std::vector<adm::ElementConstVariant> elements)
@@ -386,6 +370,7 @@ void ProjectTree::moveToNewDirectTrackNode(std::shared_ptr<const adm::AudioObjec
     auto trackNode = nodeFactory->createDirectTrackNode(representedAudioObject, elements, parentTrack);
     broadcast->elementAdded();
     moveToNewChild(trackNode);
+    addToNodeLookup(trackNode, elements);
 }
 
 void ProjectTree::moveToNewHoaTrackNode(std::shared_ptr<const adm::AudioObject> representedAudioObject, std::vector<adm::ElementConstVariant> elements)
@@ -393,6 +378,7 @@ void ProjectTree::moveToNewHoaTrackNode(std::shared_ptr<const adm::AudioObject>
     auto parentTrack = std::dynamic_pointer_cast<TrackElement>(state.currentNode->getProjectElement());
     auto trackNode = nodeFactory->createHoaTrackNode(representedAudioObject, elements, parentTrack);
     moveToNewChild(trackNode);
+    addToNodeLookup(trackNode, elements);
 }
 
 void ProjectTree::moveToNewGroupNode(adm::ElementConstVariant element)
@@ -406,6 +392,7 @@ void ProjectTree::moveToNewGroupNode(std::vector<adm::ElementConstVariant> eleme
     assert(trackNode);
     broadcast->elementAdded();
     moveToNewChild(trackNode);
+    addToNodeLookup(trackNode, elements);
 }
 
 void admplug::ProjectTree::addAutomation(int specificAtuAcfIndex)
@@ -433,44 +420,54 @@ std::shared_ptr<ProjectNode> ProjectTree::getChildWithElement(adm::ElementConstV
     return nullptr;
 }
 
-std::shared_ptr<ProjectNode> admplug::ProjectTree::getTrackNodeWithElements(std::vector<adm::ElementConstVariant> elements, std::shared_ptr<ProjectNode> startingNode)
+std::shared_ptr<ProjectNode> admplug::ProjectTree::getTrackNodeWithElements(std::vector<adm::ElementConstVariant> const& elements)
 {
-    if (!startingNode) {
-        startingNode = rootNode;
-    }
-    if (nodeIsTrackWithElements(*startingNode, elements)) {
-        return startingNode;
-    }
-    auto children = startingNode->children();
-    for (auto child : children) {
-        if (std::dynamic_pointer_cast<TrackElement>(child->getProjectElement())) { // Only process child if track node (i.e, track/group)!
-            auto matchingNode = getTrackNodeWithElements(elements, child);
-            if (matchingNode) {
-                return matchingNode;
-            }
-        }
+    auto it = trackNodesByElements.find(elementSetKey(elements));
+    if (it != trackNodesByElements.end()) {
+        return it->second;
     }
     return nullptr;
 }
 
-std::shared_ptr<ProjectNode> admplug::ProjectTree::getCompatibleTakeNode(std::shared_ptr<const adm::AudioObject> object, std::vector<uint32_t> const& channelsOfOriginal, std::shared_ptr<ProjectNode> startingNode)
+std::shared_ptr<ProjectNode> admplug::ProjectTree::getCompatibleTakeNode(std::shared_ptr<const adm::AudioObject> object, std::vector<uint32_t> const& channelsOfOriginal)
 {
-    if (!startingNode) {
-        startingNode = rootNode;
-    }
-    if (nodeIsTakeWithCompatibleElements(*startingNode, channelsOfOriginal, object)) {
-        return startingNode;
+    auto it = takeNodesByTiming.find(takeTimingKey(*object));
+    if (it == takeNodesByTiming.end()) {
+        return nullptr;
     }
-    auto children = startingNode->children();
-    for (auto child : children) {
-        auto matchingNode = getCompatibleTakeNode(object, channelsOfOriginal, child);
-        if (matchingNode) {
-            return matchingNode;
+    for (auto const& takeNode : it->second) {
+        if (nodeIsTakeWithCompatibleElements(*takeNode, channelsOfOriginal, object)) {
+            return takeNode;
         }
     }
     return nullptr;
 }
 
+void ProjectTree::addToNodeLookup(std::shared_ptr<ProjectNode> node, std::vector<adm::ElementConstVariant> const& elements)
+{
+    // Only nodes a search of the tree would have matched - the first one created for a set of elements is kept
+    if (node && nodeIsTrackWithElements(*node, elements)) {
+        trackNodesByElements.emplace(elementSetKey(elements), std::move(node));
+    }
+}
+
+void ProjectTree::addToNodeLookup(std::shared_ptr<ProjectNode> node, adm::AudioObject const& takeObject)
+{
+    if (node && std::dynamic_pointer_cast<MediaTakeElement>(node->getProjectElement())) {
+        takeNodesByTiming[takeTimingKey(takeObject)].push_back(std::move(node));
+    }
+}
+
+AdmReferenceIndex const& ProjectTree::getReferenceIndex(std::weak_ptr<adm::Document> const& document)
+{
+    auto doc = document.lock();
+    assert(doc);
+    if (!referenceIndex || !referenceIndex->indexes(*doc)) {
+        referenceIndex = std::make_shared<AdmReferenceIndex const>(doc);
+    }
+    return *referenceIndex;
+}
+
 bool ProjectTree::moveToChildWithElement(adm::ElementConstVariant element) {
     auto existingChild = getChildWithElement(element);
     if(existingChild) {
@@ -1,17 +1,24 @@
 #pragma once
+#include <chrono>
+#include <map>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 #include <boost/variant/static_visitor.hpp>
 #include <adm/element_variant.hpp>
 #include "pluginsuite.h"
 #include "projectnode.h"
 
 namespace adm {
+  class Document;
   class AudioObject;
   class AudioChannelFormat;
 }
 
 namespace admplug {
 
+class AdmReferenceIndex;
 class ImportListener;
 class NodeFactory;
 class IPCMSourceCreator;
@@ -42,7 +49,8 @@ public:
     ProjectTree(std::unique_ptr<NodeFactory> nodeFactory,
                 std::shared_ptr<IPCMSourceCreator> sourceCreator,
                 std::shared_ptr<ProjectNode> root,
-                std::shared_ptr<ImportListener> broadcast);
+                std::shared_ptr<ImportListener> broadcast,
+                std::shared_ptr<AdmReferenceIndex const> referenceIndex = nullptr);
     void operator()(std::shared_ptr<adm::AudioProgramme const> programme);
     void operator()(std::shared_ptr<adm::AudioContent const> content);
     void operator()(std::shared_ptr<adm::AudioObject const> object);
@@ -70,14 +78,25 @@ private:
     bool moveToCompatibleTakeNode(std::shared_ptr<const adm::AudioObject> object, std::vector<uint32_t> const& channelsOfOriginal);
     void moveToNewChild(std::shared_ptr<ProjectNode> child);
     std::shared_ptr<ProjectNode> getChildWithElement(adm::ElementConstVariant element);
-    std::shared_ptr<ProjectNode> getTrackNodeWithElements(std::vector<adm::ElementConstVariant> elements, std::shared_ptr<ProjectNode> startingNode = nullptr);
-    std::shared_ptr<ProjectNode> getCompatibleTakeNode(std::shared_ptr<const adm::AudioObject> object, std::vector<uint32_t> const& channelsOfOriginal, std::shared_ptr<ProjectNode> startingNode = nullptr);
+    std::shared_ptr<ProjectNode> getTrackNodeWithElements(std::vector<adm::ElementConstVariant> const& elements);
+    std::shared_ptr<ProjectNode> getCompatibleTakeNode(std::shared_ptr<const adm::AudioObject> object, std::vector<uint32_t> const& channelsOfOriginal);
+    void addToNodeLookup(std::shared_ptr<ProjectNode> node, std::vector<adm::ElementConstVariant> const& elements);
+    void addToNodeLookup(std::shared_ptr<ProjectNode> node, adm::AudioObject const& takeObject);
+    AdmReferenceIndex const& getReferenceIndex(std::weak_ptr<adm::Document> const& document);
+
+    using ElementSetKey = std::vector<void const*>;
+    using TakeTimingKey = std::pair<std::optional<std::chrono::nanoseconds>, std::optional<std::chrono::nanoseconds>>;
 
     std::unique_ptr<NodeFactory> nodeFactory;
     std::shared_ptr<IPCMSourceCreator> sourceCreator;
     std::shared_ptr<ProjectNode> rootNode;
     std::shared_ptr<ImportListener> broadcast;
+    std::shared_ptr<AdmReferenceIndex const> referenceIndex;
     TreeState state;
+
+    // Every track/group and take node this tree has created, so existing nodes are found without walking the tree
+    std::map<ElementSetKey, std::shared_ptr<ProjectNode>> trackNodesByElements;
+    std::map<TakeTimingKey, std::vector<std::shared_ptr<ProjectNode>>> takeNodesByTiming;
 };
 
 }
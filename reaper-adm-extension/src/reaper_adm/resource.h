@@ -6,9 +6,12 @@
 #define TEXT_DESCRIPTION                1001
 #define TEXT_UPDATE                     1002
 #define IDC_CANCELBUTTON                1003
+#define IDC_SIMPLIFICATION              1004
+#define TEXT_SIMPLIFICATION             1005
 #define IDD_EXPORT                      102
 #define IDC_INFOPANE                    1001
 #define IDC_BUTTON_REFRESH              1002
+#define IDC_SERIAL_ADM                  1006
 
 // Next default values for new objects
 // 
@@ -16,7 +19,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NEXT_RESOURCE_VALUE        102
 #define _APS_NEXT_COMMAND_VALUE         40001
-#define _APS_NEXT_CONTROL_VALUE         1004
+#define _APS_NEXT_CONTROL_VALUE         1007
 #define _APS_NEXT_SYMED_VALUE           101
 #endif
 #endif
@@ -0,0 +1,45 @@
+#include <catch2/catch_all.hpp>
+#include <adm/document.hpp>
+#include <adm/elements.hpp>
+#include <admreferenceindex.h>
+
+using namespace admplug;
+
+TEST_CASE("ADM reference index", "[referenceindex]") {
+    auto doc = adm::Document::create();
+    auto programme = adm::AudioProgramme::create(adm::AudioProgrammeName{ "programme" });
+    auto content = adm::AudioContent::create(adm::AudioContentName{ "content" });
+    auto parentObject = adm::AudioObject::create(adm::AudioObjectName{ "parent" });
+    auto childObject = adm::AudioObject::create(adm::AudioObjectName{ "child" });
+    programme->addReference(content);
+    content->addReference(parentObject);
+    content->addReference(childObject);
+    parentObject->addReference(childObject);
+
+    doc->add(programme);
+
+    AdmReferenceIndex index{ doc };
+
+    SECTION("Indexes only the document it was built from") {
+        REQUIRE(index.indexes(*doc));
+        REQUIRE_FALSE(index.indexes(*adm::Document::create()));
+    }
+
+    SECTION("Counts programmes") {
+        REQUIRE(index.programmeCount() == 1);
+    }
+
+    SECTION("Finds the parents of contents and objects") {
+        REQUIRE(index.parentProgrammes(*content).size() == 1);
+        REQUIRE(index.parentProgrammes(*content)[0] == programme);
+        REQUIRE(index.parentContents(*parentObject).size() == 1);
+        REQUIRE(index.parentContents(*childObject).size() == 1);
+        REQUIRE(index.parentObjects(*childObject).size() == 1);
+        REQUIRE(index.parentObjects(*childObject)[0] == parentObject);
+    }
+
+    SECTION("Elements without parents have none") {
+        REQUIRE(index.parentObjects(*parentObject).empty());
+        REQUIRE(index.parentProgrammes(*adm::AudioContent::create(adm::AudioContentName{ "orphan" })).empty());
+    }
+}
@@ -1,5 +1,6 @@
 #include <automationpoint.h>
 #include <admextraction.h>
+#include <algorithm>
 #include <chrono>
 #include <ostream>
 #include <cmath>
@@ -84,3 +85,99 @@ TEST_CASE("Test automation simplification") {
     }
 }
 
+
+namespace {
+std::vector<AutomationPoint> generateRamp(double startValue, double increment, std::size_t numberOfPoints, bool wrap = false) {
+    TimeInc incrementor{};
+    std::vector<AutomationPoint> points;
+    for(std::size_t i = 0; i != numberOfPoints; ++i) {
+        auto[start, duration] = incrementor();
+        auto value = startValue + (increment * i);
+        if(wrap) value = std::fmod(value, 1.0);
+        points.emplace_back(start, duration, value);
+    }
+    return points;
+}
+}
+
+TEST_CASE("Tolerance based automation simplification") {
+    SECTION("Linear ramp is reduced to its end points") {
+        auto input = generateRamp(0.0, 0.005, 100);
+        auto simplified = detail::simplify(input, 0.001, false);
+        REQUIRE(simplified.size() == 2);
+        REQUIRE(simplified.front() == input.front());
+        REQUIRE(simplified.back() == input.back());
+    }
+
+    SECTION("Zero tolerance leaves points untouched") {
+        auto input = generateRamp(0.0, 0.005, 100);
+        REQUIRE(detail::simplify(input, 0.0, false).size() == input.size());
+    }
+
+    SECTION("Corner points are kept") {
+        auto [input, expected] = TestData{{0.f, 0.25f, 0.5f, 0.25f, 0.f}, {0, 2, 4}, ""}.getTestPoints();
+        REQUIRE(detail::simplify(input, 0.001, false) == expected);
+    }
+
+    SECTION("Discontinuities are kept") {
+        using namespace std::chrono_literals;
+        std::vector<AutomationPoint> input{
+            AutomationPoint{0ms, 20ms, 0.1},
+            AutomationPoint{20ms, 0ms, 0.5},
+            AutomationPoint{20ms, 0ms, 0.2},
+            AutomationPoint{20ms, 20ms, 0.2}
+        };
+        auto simplified = detail::simplify(input, 0.001, false);
+        REQUIRE(simplified.size() == 4);
+    }
+
+    SECTION("Skipped points are within tolerance of the simplified curve") {
+        TimeInc incrementor{};
+        std::vector<AutomationPoint> input;
+        for(int i = 0; i != 1000; ++i) {
+            auto[start, duration] = incrementor();
+            input.emplace_back(start, duration, 0.5 + 0.4 * std::sin(i * 0.01));
+        }
+        double const tolerance = 0.001;
+        auto simplified = detail::simplify(input, tolerance, false);
+        REQUIRE(simplified.size() < input.size() / 4);
+
+        std::size_t segment = 0;
+        for(auto const& point : input) {
+            while(segment + 2 < simplified.size() && simplified[segment + 1].effectiveTime() < point.effectiveTime()) {
+                ++segment;
+            }
+            auto const& from = simplified[segment];
+            auto const& to = simplified[segment + 1];
+            auto proportion = (point.effectiveTime() - from.effectiveTime()) / (to.effectiveTime() - from.effectiveTime());
+            auto interpolated = from.value() + ((to.value() - from.value()) * proportion);
+            REQUIRE(std::abs(interpolated - point.value()) <= tolerance + 1e-9);
+        }
+    }
+
+    SECTION("Wrapped ramp is simplified across the wrap point") {
+        auto input = generateRamp(0.9, 0.005, 60, true);
+        auto simplified = detail::simplify(input, 0.001, true);
+        REQUIRE(simplified.size() == 2);
+        REQUIRE(detail::simplify(input, 0.001, false).size() > 2);
+    }
+
+    SECTION("Wrapped segments never span more than half the range") {
+        // Climbs through the range twice; REAPER would take the short way round any longer segment
+        auto input = generateRamp(0.0, 0.01, 200, true);
+        auto simplified = detail::simplify(input, 0.001, true);
+        auto unwrappedValue = [&input](AutomationPoint const& point) {
+            auto inputPoint = std::find_if(input.begin(), input.end(), [&point](AutomationPoint const& candidate) {
+                return candidate.timeNs() == point.timeNs();
+            });
+            REQUIRE(inputPoint != input.end());
+            return 0.01 * std::distance(input.begin(), inputPoint);
+        };
+        for(std::size_t i = 1; i < simplified.size(); ++i) {
+            auto span = unwrappedValue(simplified[i]) - unwrappedValue(simplified[i - 1]);
+            REQUIRE(span > 0.0);
+            REQUIRE(span < 0.5);
+        }
+        REQUIRE(simplified.size() < input.size());
+    }
+}
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include "include_gmock.h"
+#include "mocks/reaperapi.h"
+#include "fakeptr.h"
+#include <automationenvelope.h>
+
+using namespace admplug;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+namespace {
+
+std::string const newEnvelopeChunk{"<PARMENV 1:0 0 1 0.5\nACT 1 -1\nVIS 1 1 1\nARM 0\nDEFSHAPE 0 -1 -1\nPT 0 0.5 0\n>\n"};
+
+struct CallCounts {
+    std::size_t inserts{0};
+    std::size_t sorts{0};
+    std::size_t deletes{0};
+    std::size_t chunkGets{0};
+    std::size_t chunkSets{0};
+    std::size_t total() const { return inserts + sorts + deletes + chunkGets + chunkSets; }
+};
+
+void countCalls(NiceMock<MockReaperAPI>& api, CallCounts& counts, bool provideChunk) {
+    ON_CALL(api, InsertEnvelopePoint(_, _, _, _, _, _, _)).WillByDefault(Invoke([&counts](TrackEnvelope*, double, double, int, double, bool, bool*) {
+        ++counts.inserts;
+        return true;
+    }));
+    ON_CALL(api, Envelope_SortPoints(_)).WillByDefault(Invoke([&counts](TrackEnvelope*) {
+        ++counts.sorts;
+        return true;
+    }));
+    ON_CALL(api, DeleteEnvelopePointRange(_, _, _)).WillByDefault(Invoke([&counts](TrackEnvelope*, double, double) {
+        ++counts.deletes;
+        return true;
+    }));
+    // Without a state chunk the envelope falls back to inserting points individually,
+    //  which is how every envelope was written before batching.
+    ON_CALL(api, GetEnvelopeStateChunk(_, _, _, _)).WillByDefault(Invoke([&counts, provideChunk](TrackEnvelope*, char* buffer, int bufferSize, bool) {
+        ++counts.chunkGets;
+        if(!provideChunk) return false;
+        std::strncpy(buffer, newEnvelopeChunk.c_str(), bufferSize - 1);
+        buffer[bufferSize - 1] = '\0';
+        return true;
+    }));
+    ON_CALL(api, SetEnvelopeStateChunk(_, _, _)).WillByDefault(Invoke([&counts](TrackEnvelope*, const char*, bool) {
+        ++counts.chunkSets;
+        return true;
+    }));
+}
+
+std::vector<AutomationPoint> generateBlockPoints(std::size_t numberOfPoints) {
+    using namespace std::chrono_literals;
+    std::default_random_engine generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<AutomationPoint> points;
+    points.reserve(numberOfPoints);
+    auto start = 1000ms; // Starts after 0 so the auto-inserted point is removed as on import
+    auto duration = 20ms;
+    for(std::size_t i = 0; i != numberOfPoints; ++i) {
+        points.emplace_back(start, duration, distribution(generator));
+        start += duration;
+    }
+    return points;
+}
+
+std::chrono::nanoseconds runOnce(std::vector<AutomationPoint> const& points, bool batched, CallCounts& counts) {
+    FakePtrFactory fake;
+    auto fakeEnvelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    countCalls(api, counts, batched);
+
+    DefinedStartEnvelope envelope{fakeEnvelope, api};
+    for(auto const& point : points) {
+        envelope.addPoint(point);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    envelope.createPoints(0.0);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+}
+
+void printResult(std::string const& benchName, std::size_t numPoints, std::chrono::nanoseconds elapsed, std::size_t numIterations, CallCounts const& counts) {
+    std::cout << elapsed.count() / (numIterations * 1000.0 * 1000.0) << "ms: \t"
+              << "average time taken over " << numIterations << " iterations of " << benchName
+              << " with " << numPoints << " points, "
+              << counts.total() / numIterations << " API calls per envelope ("
+              << counts.inserts / numIterations << " insert, "
+              << counts.sorts / numIterations << " sort, "
+              << counts.deletes / numIterations << " delete, "
+              << counts.chunkGets / numIterations << " get chunk, "
+              << counts.chunkSets / numIterations << " set chunk)" << std::endl;
+}
+
+void runBenchmarks(std::size_t numPoints) {
+    auto const ITERATIONS = 10u;
+    auto points = generateBlockPoints(numPoints);
+
+    CallCounts perPointCounts;
+    auto perPointTime = std::chrono::nanoseconds::zero();
+    for(auto i = 0u; i != ITERATIONS; ++i) {
+        perPointTime += runOnce(points, false, perPointCounts);
+    }
+
+    CallCounts batchedCounts;
+    auto batchedTime = std::chrono::nanoseconds::zero();
+    for(auto i = 0u; i != ITERATIONS; ++i) {
+        batchedTime += runOnce(points, true, batchedCounts);
+    }
+
+    printResult("per-point insertion", numPoints, perPointTime, ITERATIONS, perPointCounts);
+    printResult("batched state chunk", numPoints, batchedTime, ITERATIONS, batchedCounts);
+}
+
+}
+
+int main() {
+    // 180000 points is one hour of 20ms blocks
+    for(auto numPoints : {1000u, 10000u, 180000u}) {
+        runBenchmarks(numPoints);
+    }
+}
@@ -0,0 +1,154 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <adm/document.hpp>
+#include <adm/elements.hpp>
+#include "include_gmock.h"
+#include "mocks/importlistener.h"
+#include "mocks/nodefactory.h"
+#include "mocks/pcmsourcecreator.h"
+#include "mocks/projectelements.h"
+#include "blockbuilders.h"
+#include <projecttree.h>
+
+using namespace admplug;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+// Children of each parent object - the parents are also referenced from the content, as a bed would be
+auto const OBJECTS_PER_GROUP = 100u;
+auto const BLOCKS_PER_CHANNEL = 50u;
+
+struct SyntheticDocument {
+    std::shared_ptr<adm::Document> document;
+    std::shared_ptr<adm::AudioProgramme> programme;
+    std::shared_ptr<adm::AudioContent> content;
+    std::vector<std::shared_ptr<adm::AudioObject>> objects;
+    std::vector<std::shared_ptr<adm::AudioObject>> groupObjects;
+};
+
+std::shared_ptr<adm::AudioObject> createObject(std::size_t index) {
+    auto name = "object_" + std::to_string(index);
+    auto object = adm::AudioObject::create(adm::AudioObjectName(name));
+    auto pack = adm::AudioPackFormat::create(adm::AudioPackFormatName(name), adm::TypeDefinition::OBJECTS);
+    auto channel = adm::AudioChannelFormat::create(adm::AudioChannelFormatName(name), adm::TypeDefinition::OBJECTS);
+    auto streamFormat = adm::AudioStreamFormat::create(adm::AudioStreamFormatName(name), adm::FormatDefinition::PCM);
+    auto trackFormat = adm::AudioTrackFormat::create(adm::AudioTrackFormatName(name), adm::FormatDefinition::PCM);
+    auto trackUid = adm::AudioTrackUid::create();
+
+    for(auto i = 0u; i != BLOCKS_PER_CHANNEL; ++i) {
+        adm::AudioBlockFormatObjects block = admplug::testing::initialSphericalBlock()
+            .withAzimuth(static_cast<double>((index + i) % 360) - 180.0)
+            .withRtime(i * 0.02)
+            .withDuration(0.02);
+        channel->add(block);
+    }
+
+    pack->addReference(channel);
+    streamFormat->setReference(channel);
+    trackFormat->setReference(streamFormat);
+    trackUid->setReference(trackFormat);
+    trackUid->setReference(pack);
+    object->addReference(pack);
+    object->addReference(trackUid);
+    return object;
+}
+
+SyntheticDocument createDocument(std::size_t numObjects) {
+    SyntheticDocument doc;
+    doc.document = adm::Document::create();
+    doc.programme = adm::AudioProgramme::create(adm::AudioProgrammeName("programme"));
+    doc.content = adm::AudioContent::create(adm::AudioContentName("content"));
+    doc.programme->addReference(doc.content);
+
+    for(std::size_t i = 0; i != numObjects; ++i) {
+        if(i % OBJECTS_PER_GROUP == 0) {
+            auto group = adm::AudioObject::create(adm::AudioObjectName("group_" + std::to_string(doc.groupObjects.size())));
+            doc.content->addReference(group);
+            doc.groupObjects.push_back(group);
+        }
+        auto object = createObject(i);
+        doc.content->addReference(object);
+        doc.groupObjects.back()->addReference(object);
+        doc.objects.push_back(object);
+    }
+
+    doc.document->add(doc.programme);
+    return doc;
+}
+
+struct Result {
+    std::chrono::nanoseconds indexing{0};
+    std::chrono::nanoseconds routes{0};
+    std::size_t routeCount{0};
+    std::size_t elementsAdded{0};
+};
+
+void applyRoute(ProjectTree& tree, std::vector<adm::ElementConstVariant> const& route) {
+    tree.resetRoot();
+    for(auto const& element : route) {
+        boost::apply_visitor(tree, element);
+    }
+}
+
+Result runOnce(SyntheticDocument const& doc) {
+    Result result;
+    auto listener = std::make_shared<NiceMock<MockImportListener>>();
+    ON_CALL(*listener, elementAdded()).WillByDefault(Invoke([&result]() { ++result.elementsAdded; }));
+    auto sourceCreator = std::make_shared<NiceMock<MockIPCMSourceCreator>>();
+    ON_CALL(*sourceCreator, channelForTrackUid(_)).WillByDefault(Return(0));
+    auto nodeFactory = std::make_unique<NiceMock<MockNodeFactory>>();
+    nodeFactory->delegateToFake();
+
+    // The importer builds the reference index up front, the tree builds it on first use otherwise - both are timed
+    auto start = std::chrono::high_resolution_clock::now();
+    ProjectTree tree(std::move(nodeFactory),
+                     sourceCreator,
+                     std::make_shared<ProjectNode>(std::make_shared<NiceMock<MockRootElement>>()),
+                     listener);
+    applyRoute(tree, { doc.programme });
+    auto indexed = std::chrono::high_resolution_clock::now();
+    result.indexing = std::chrono::duration_cast<std::chrono::nanoseconds>(indexed - start);
+
+    // The routes the importer's tracer produces - each object through its content, then again through its group
+    for(auto const& object : doc.objects) {
+        auto pack = object->getReferences<adm::AudioPackFormat>().front();
+        applyRoute(tree, { doc.programme, doc.content, object, pack });
+        result.routeCount++;
+    }
+    for(auto const& group : doc.groupObjects) {
+        for(auto const& object : group->getReferences<adm::AudioObject>()) {
+            auto pack = object->getReferences<adm::AudioPackFormat>().front();
+            applyRoute(tree, { doc.programme, doc.content, group, object, pack });
+            result.routeCount++;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.routes = std::chrono::duration_cast<std::chrono::nanoseconds>(end - indexed);
+    return result;
+}
+
+void printResult(std::size_t numObjects, Result const& result) {
+    auto routeMs = result.routes.count() / (1000.0 * 1000.0);
+    std::cout << numObjects << " objects\t"
+              << result.indexing.count() / (1000.0 * 1000.0) << "ms to index\t"
+              << routeMs << "ms to apply " << result.routeCount << " routes\t"
+              << (result.routeCount ? (result.routes.count() / 1000.0) / result.routeCount : 0.0) << "us per route\t"
+              << result.elementsAdded << " project elements" << std::endl;
+}
+
+}
+
+int main() {
+    // Time per route should stay flat as the document grows - lookups were scans of the document and tree
+    for(auto numObjects : {500u, 1000u, 2500u, 5000u}) {
+        auto doc = createDocument(numObjects);
+        printResult(numObjects, runOnce(doc));
+    }
+}
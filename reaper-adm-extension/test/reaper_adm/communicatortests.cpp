@@ -0,0 +1,140 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <communicators.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr int CHANNELS = 2;
+
+class TestCommunicator : public CommunicatorBase {
+public:
+    explicit TestCommunicator(int samplesPort) : CommunicatorBase(samplesPort, 0) {}
+    ~TestCommunicator() { stopReceiving(); }
+    int getReportedChannelCount() override { return CHANNELS; }
+};
+
+struct SamplesSource {
+    SamplesSource() {
+        sender.open();
+        sender.listen();
+    }
+    ~SamplesSource() { sender.close(); }
+
+    void send(int frames) {
+        auto msg = std::make_shared<TypedNngMsg<float>>(frames * CHANNELS);
+        auto samples = static_cast<float*>(msg->getBufferPointer());
+        for(int i = 0; i < frames * CHANNELS; ++i) {
+            samples[i] = static_cast<float>(sent++);
+        }
+        REQUIRE(sender.sendBlock(msg, 1000) == 0);
+    }
+
+    SamplesSender sender;
+    int sent{ 0 };
+};
+
+bool waitForFrames(CommunicatorBase& communicator, int frames) {
+    for(int attempt = 0; attempt < 200; ++attempt) {
+        if(communicator.availableFrames() >= frames) return true;
+        std::this_thread::sleep_for(5ms);
+    }
+    return false;
+}
+}
+
+TEST_CASE("Block ring hands items over in order", "[communicator]") {
+    BlockRing<int> ring(3);
+    int item{ 0 };
+
+    SECTION("Nothing to pop when empty") {
+        CHECK_FALSE(ring.pop(item));
+        CHECK(ring.size() == 0);
+    }
+
+    SECTION("Refuses items when full") {
+        CHECK(ring.push(1));
+        CHECK(ring.push(2));
+        CHECK(ring.push(3));
+        CHECK_FALSE(ring.push(4));
+        CHECK(ring.size() == 3);
+    }
+
+    SECTION("Keeps order as it wraps around") {
+        int next{ 0 };
+        int expected{ 0 };
+        for(int round = 0; round < 10; ++round) {
+            REQUIRE(ring.push(next++));
+            REQUIRE(ring.push(next++));
+            std::vector<int> queued;
+            ring.forEachQueued([&queued](int queuedItem) { queued.push_back(queuedItem); });
+            CHECK(queued == std::vector<int>{ expected, expected + 1 });
+            REQUIRE(ring.pop(item));
+            CHECK(item == expected++);
+            REQUIRE(ring.pop(item));
+            CHECK(item == expected++);
+            CHECK(ring.size() == 0);
+        }
+    }
+
+    SECTION("Runs dry once drained") {
+        REQUIRE(ring.push(1));
+        REQUIRE(ring.pop(item));
+        CHECK_FALSE(ring.pop(item));
+    }
+}
+
+TEST_CASE("Communicators receive sample blocks in the background", "[communicator]") {
+    SamplesSource source;
+    TestCommunicator communicator(source.sender.getPort());
+    communicator.setRenderingState(true);
+    communicator.startReceiving();
+
+    SECTION("Copies frames across blocks") {
+        source.send(3);
+        source.send(3);
+        REQUIRE(waitForFrames(communicator, 6));
+        std::vector<float> frames(6 * CHANNELS);
+        REQUIRE(communicator.copyFrames(frames.data(), 6, CHANNELS));
+        for(int i = 0; i < 6 * CHANNELS; ++i) {
+            CHECK(frames[i] == static_cast<float>(i));
+        }
+        CHECK(communicator.availableFrames() == 0);
+        CHECK(communicator.getReceiveStats().framesReceived == 6);
+    }
+
+    SECTION("Counts each underrun once") {
+        communicator.reportUnderrun();
+        communicator.reportUnderrun();
+        CHECK(communicator.getReceiveStats().underruns == 1);
+
+        source.send(1);
+        REQUIRE(waitForFrames(communicator, 1));
+        std::vector<float> frame(CHANNELS);
+        REQUIRE(communicator.copyFrames(frame.data(), 1, CHANNELS));
+        communicator.reportUnderrun();
+        CHECK(communicator.getReceiveStats().underruns == 2);
+    }
+
+    SECTION("Counts timeouts only between the first block and the end of the render") {
+        // The receive timeout is 100ms
+        std::this_thread::sleep_for(250ms);
+        CHECK(communicator.getReceiveStats().timeouts == 0);
+
+        source.send(1);
+        REQUIRE(waitForFrames(communicator, 1));
+        std::this_thread::sleep_for(250ms);
+        CHECK(communicator.getReceiveStats().timeouts > 0);
+
+        communicator.setRenderingState(false);
+        std::this_thread::sleep_for(20ms); // Any receive in progress has seen the state
+        auto timeoutsAtEnd = communicator.getReceiveStats().timeouts;
+        std::this_thread::sleep_for(250ms);
+        CHECK(communicator.getReceiveStats().timeouts == timeoutsAtEnd);
+    }
+
+    communicator.stopReceiving();
+}
@@ -141,7 +141,7 @@ auto createElementsFromCommonDefinition(std::shared_ptr<adm::Document> doc, cons
     auto cfs = pf->getReferences<adm::AudioChannelFormat>();
     for(auto relCf : pfData->relatedChannelFormats) {
         // Need the doc instance of the CF, not the helpers
-        auto cfId = relCf->channelFormat->get<adm::AudioChannelFormatId>();
+        auto cfId = adm::parseAudioChannelFormatId(relCf->fullId);
         auto cf = doc->lookup(cfId);
         // Need to find the trackformat for the CF
         for(auto checkTf : doc->getElements<adm::AudioTrackFormat>()) {
@@ -0,0 +1,81 @@
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <string>
+#include "include_gmock.h"
+#include "mocks/reaperapi.h"
+#include "fakeptr.h"
+#include <exportaction_parameterprocessing.h>
+
+using namespace admplug;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Invoke;
+using ::testing::Return;
+using Catch::Approx;
+
+namespace {
+std::string const chunkHeader{"<PARMENV 1:0 0 1 0.5\nACT 1 -1\nVIS 1 1 1\nARM 0\nDEFSHAPE 0 -1 -1\n"};
+
+std::shared_ptr<EnvelopeSnapshot> capture(NiceMock<MockReaperAPI>& api, TrackEnvelope* envelope, std::string const& points) {
+    auto chunk = chunkHeader + points + ">\n";
+    ON_CALL(api, GetEnvelopeStateChunk(envelope, _, _, _)).WillByDefault(Invoke([chunk](TrackEnvelope*, char* buffer, int bufferSize, bool) {
+        std::strncpy(buffer, chunk.c_str(), bufferSize - 1);
+        buffer[bufferSize - 1] = '\0';
+        return true;
+    }));
+    return EnvelopeSnapshot::capture(*envelope, api);
+}
+}
+
+TEST_CASE("Envelope snapshots evaluate linear and square points", "[envelopesnapshot]") {
+    FakePtrFactory fake;
+    auto envelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    auto snapshot = capture(api, envelope, "PT 1 0 0\nPT 3 1 1\nPT 4 0.5 0\n");
+    REQUIRE(snapshot);
+
+    SECTION("Holds the first value before the first point") {
+        CHECK(snapshot->evaluate(0.0) == Approx(0.0));
+    }
+    SECTION("Interpolates after linear points") {
+        CHECK(snapshot->evaluate(2.0) == Approx(0.5));
+    }
+    SECTION("Holds after square points") {
+        CHECK(snapshot->evaluate(3.5) == Approx(1.0));
+    }
+    SECTION("Holds the last value after the last point") {
+        CHECK(snapshot->evaluate(10.0) == Approx(0.5));
+    }
+}
+
+TEST_CASE("Envelopes needing REAPER to evaluate them aren't snapshotted", "[envelopesnapshot]") {
+    FakePtrFactory fake;
+    auto envelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+
+    SECTION("Curved points") {
+        CHECK_FALSE(capture(api, envelope, "PT 0 0 0\nPT 1 1 2\n"));
+    }
+    SECTION("Scaled envelopes") {
+        ON_CALL(api, GetEnvelopeScalingMode(envelope)).WillByDefault(Return(1));
+        CHECK_FALSE(capture(api, envelope, "PT 0 0 0\n"));
+    }
+}
+
+TEST_CASE("Envelope snapshots without points hold the envelope's unautomated value", "[envelopesnapshot]") {
+    FakePtrFactory fake;
+    auto envelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    ON_CALL(api, Envelope_Evaluate(envelope, _, _, _, _, _, _, _)).WillByDefault(
+        Invoke([](TrackEnvelope*, double, double, int, double* value, double*, double*, double*) {
+            *value = 0.25;
+            return 0;
+        }));
+    ON_CALL(api, ScaleFromEnvelopeMode(0, _)).WillByDefault(Invoke([](int, double value) { return value; }));
+    auto snapshot = capture(api, envelope, "");
+    REQUIRE(snapshot);
+
+    for(auto time : { 0.0, 1.0, 10.0 }) {
+        CHECK(snapshot->evaluate(time) == Approx(0.25));
+    }
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_all.hpp>
 #include <chrono>
+#include <cstring>
+#include <string>
 #include "include_gmock.h"
 #include "blockbuilders.h"
 #include "mocks/reaperapi.h"
@@ -15,6 +17,7 @@ using ::testing::AnyNumber;
 using ::testing::AtLeast;
 using ::testing::_;
 using ::testing::NiceMock;
+using ::testing::Invoke;
 
 using namespace admplug::testing;
 using namespace std::chrono_literals;
@@ -27,6 +30,8 @@ TEST_CASE("Test creating an envelope with no points does nothing", "[envelope]")
     NiceMock<MockReaperAPI> api;
     EXPECT_CALL(api, InsertEnvelopePoint(fakeEnvelope, _, _, _, _, _, _)).Times(0);
     EXPECT_CALL(api, DeleteEnvelopePointRange(fakeEnvelope,  _, _)).Times(0);
+    EXPECT_CALL(api, SetEnvelopeStateChunk(fakeEnvelope, _, _)).Times(0);
+    EXPECT_CALL(api, Envelope_SortPoints(fakeEnvelope)).Times(1);
 
     DefinedStartEnvelope env{fakeEnvelope, api};
     env.createPoints(0.0);
@@ -123,6 +128,79 @@ TEST_CASE("creating point with an offset offsets all points", "[envelope]") {
     env.createPoints(offset);
 }
 
+namespace {
+std::string const newEnvelopeChunk{"<PARMENV 1:0 0 1 0.5\nACT 1 -1\nVIS 1 1 1\nARM 0\nDEFSHAPE 0 -1 -1\nPT 0 0.5 0\n>\n"};
+
+void provideStateChunk(NiceMock<MockReaperAPI>& api, TrackEnvelope* envelope, std::string const& chunk, std::string& writtenChunk) {
+    ON_CALL(api, GetEnvelopeStateChunk(envelope, _, _, _)).WillByDefault(Invoke([chunk](TrackEnvelope*, char* buffer, int bufferSize, bool) {
+        std::strncpy(buffer, chunk.c_str(), bufferSize - 1);
+        buffer[bufferSize - 1] = '\0';
+        return true;
+    }));
+    ON_CALL(api, SetEnvelopeStateChunk(envelope, _, _)).WillByDefault(Invoke([&writtenChunk](TrackEnvelope*, const char* str, bool) {
+        writtenChunk = str;
+        return true;
+    }));
+}
+}
+
+TEST_CASE("When envelope state chunk is available, points are written in a single call", "[envelope]") {
+    FakePtrFactory fake;
+    auto fakeEnvelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    std::string writtenChunk;
+    provideStateChunk(api, fakeEnvelope, newEnvelopeChunk, writtenChunk);
+
+    DefinedStartEnvelope env{fakeEnvelope, api};
+    env.addPoint(AutomationPoint{0ns, 0ns, 0.1});
+    env.addPoint(AutomationPoint{0ns, 2000ns, 0.2});
+    env.addPoint(AutomationPoint{2000ns, 2000ns, 0.3});
+
+    EXPECT_CALL(api, SetEnvelopeStateChunk(fakeEnvelope, _, _)).Times(1);
+    EXPECT_CALL(api, InsertEnvelopePoint(fakeEnvelope, _, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(api, DeleteEnvelopePointRange(fakeEnvelope, _, _)).Times(0);
+    env.createPoints(0.0);
+
+    std::string expected{"<PARMENV 1:0 0 1 0.5\nACT 1 -1\nVIS 1 1 1\nARM 0\nDEFSHAPE 0 -1 -1\n"
+                         "PT 0 0.5 0\n"
+                         "PT 0.000000000000 0.100000000000 0\n"
+                         "PT 0.000002000000 0.200000000000 0\n"
+                         "PT 0.000004000000 0.300000000000 0\n"
+                         ">\n"};
+    REQUIRE(writtenChunk == expected);
+}
+
+TEST_CASE("When points start after 0, the existing point before them is dropped from the state chunk", "[envelope]") {
+    FakePtrFactory fake;
+    auto fakeEnvelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    std::string writtenChunk;
+    provideStateChunk(api, fakeEnvelope, newEnvelopeChunk, writtenChunk);
+
+    DefinedStartEnvelope env{fakeEnvelope, api};
+    env.addPoint(AutomationPoint{0ns, 0ns, 0.1});
+    env.createPoints(1.5);
+
+    REQUIRE(writtenChunk.find("PT 0 0.5 0\n") == std::string::npos);
+    REQUIRE(writtenChunk.find("PT 1.500000000000 0.100000000000 0\n") != std::string::npos);
+}
+
+TEST_CASE("When envelope state chunk is incomplete, points are inserted individually", "[envelope]") {
+    FakePtrFactory fake;
+    auto fakeEnvelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    std::string writtenChunk;
+    provideStateChunk(api, fakeEnvelope, "<PARMENV 1:0 0 1 0.5\nACT 1 -1\n", writtenChunk);
+
+    DefinedStartEnvelope env{fakeEnvelope, api};
+    env.addPoint(AutomationPoint{0ns, 0ns, 0.1});
+    env.addPoint(AutomationPoint{0ns, 2000ns, 0.2});
+
+    EXPECT_CALL(api, SetEnvelopeStateChunk(fakeEnvelope, _, _)).Times(0);
+    EXPECT_CALL(api, InsertEnvelopePoint(fakeEnvelope, _, _, _, _, _, _)).Times(2);
+    env.createPoints(0.0);
+}
+
 TEST_CASE("Wrapped envelope does not insert extra points when shortest path is positive and direct", "[envelope]") {
 
     FakePtrFactory fake;
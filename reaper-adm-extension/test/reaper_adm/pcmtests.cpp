@@ -227,6 +227,20 @@ TEST_CASE("PCMReader mono file tests") {
     }
 }
 
+TEST_CASE("ADM metadata and PCMReader can share one file reader") {
+    std::shared_ptr<bw64::Bw64Reader> file = bw64::readFile("data/channels_stereo_adm.wav");
+    auto metadata = ADMMetaData(file, "data/channels_stereo_adm.wav");
+    REQUIRE(metadata.adm()->getElements<adm::AudioTrackUid>().size() == 2);
+
+    Bw64PCMReader reader{ file };
+    std::size_t framesRead = 0;
+    for(auto block = reader.read(); block->frameCount() > 0; block = reader.read()) {
+        REQUIRE(block->channelCount() == 2);
+        framesRead += block->frameCount();
+    }
+    REQUIRE(framesRead == reader.totalFrames());
+}
+
 TEST_CASE("PCMReader stereo file tests") {
 
     Bw64PCMReader reader{ "data/channels_stereo_adm.wav" };
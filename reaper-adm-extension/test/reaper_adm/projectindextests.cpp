@@ -0,0 +1,102 @@
+#include <catch2/catch_all.hpp>
+#include <map>
+#include <string>
+#include <vector>
+#include "include_gmock.h"
+#include "mocks/reaperapi.h"
+#include <exportaction_projectindex.h>
+#include <pluginsuite_ear.h>
+
+using namespace admplug;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+// Identities only - never dereferenced
+int trackStorage[2];
+MediaTrack* const firstTrack = reinterpret_cast<MediaTrack*>(&trackStorage[0]);
+MediaTrack* const secondTrack = reinterpret_cast<MediaTrack*>(&trackStorage[1]);
+
+std::vector<GUID> fxGuids{
+    GUID { 1, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}},
+    GUID { 1, 0, 0, {0, 0, 0, 0, 0, 0, 0, 1}},
+    GUID { 1, 0, 0, {0, 0, 0, 0, 0, 0, 0, 2}}
+};
+
+// Object plugin parameter holding its input instance ID
+constexpr int OBJECT_INSTANCE_ID_PARAM_INDEX = 16;
+
+struct FakeProject {
+    std::map<MediaTrack*, std::vector<std::string>> fxNames;
+    std::map<std::pair<MediaTrack*, int>, int> instanceIds;
+};
+
+void setUpProject(NiceMock<MockReaperAPI>& api, FakeProject const& project) {
+    static GUID trackGuid{ 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}};
+    ON_CALL(api, CountTracks(_)).WillByDefault(Return(2));
+    ON_CALL(api, GetTrack(_, 0)).WillByDefault(Return(firstTrack));
+    ON_CALL(api, GetTrack(_, 1)).WillByDefault(Return(secondTrack));
+    ON_CALL(api, GetTrackGUID(_)).WillByDefault(Return(&trackGuid));
+    ON_CALL(api, ValidatePtr(_, _)).WillByDefault(Return(true));
+    ON_CALL(api, TrackFX_GetActualFXNames(_)).WillByDefault([&project](MediaTrack* track) {
+        return project.fxNames.at(track);
+    });
+    ON_CALL(api, TrackFX_GetActualFXName(_, _, _)).WillByDefault([&project](MediaTrack* track, int fx, std::string& name) {
+        name = project.fxNames.at(track).at(fx);
+        return true;
+    });
+    ON_CALL(api, TrackFX_GetCount(_)).WillByDefault([&project](MediaTrack* track) {
+        return static_cast<int>(project.fxNames.at(track).size());
+    });
+    ON_CALL(api, TrackFX_GetFXGUID(_, _)).WillByDefault([](MediaTrack*, int fx) {
+        return &fxGuids[fx];
+    });
+    ON_CALL(api, TrackFX_GetParamNormalized(_, _, OBJECT_INSTANCE_ID_PARAM_INDEX)).WillByDefault([&project](MediaTrack* track, int fx, int) {
+        return project.instanceIds.at({ track, fx }) / static_cast<double>(0xFFFF);
+    });
+}
+}
+
+TEST_CASE("Export project index", "[projectindex]") {
+    NiceMock<MockReaperAPI> api;
+    FakeProject project;
+    project.fxNames[firstTrack] = { EARPluginSuite::OBJECT_METADATA_PLUGIN_NAME, "ReaEQ" };
+    project.fxNames[secondTrack] = { "ReaEQ", EARPluginSuite::SCENEMASTER_PLUGIN_NAME, EARPluginSuite::OBJECT_METADATA_PLUGIN_NAME };
+    project.instanceIds[{ firstTrack, 0 }] = 7;
+    project.instanceIds[{ secondTrack, 2 }] = 7;
+    setUpProject(api, project);
+
+    ExportProjectIndex index(api);
+
+    SECTION("Finds FX by name in project order") {
+        auto const& eqs = index.getFxLocationsFor("ReaEQ");
+        REQUIRE(eqs.size() == 2);
+        CHECK(eqs[0].track == firstTrack);
+        CHECK(eqs[0].fxIndex == 1);
+        CHECK(eqs[1].track == secondTrack);
+        CHECK(eqs[1].fxIndex == 0);
+
+        auto const& scenes = index.getFxLocationsFor(EARPluginSuite::SCENEMASTER_PLUGIN_NAME);
+        REQUIRE(scenes.size() == 1);
+        CHECK(scenes[0].track == secondTrack);
+        CHECK(scenes[0].fxIndex == 1);
+    }
+
+    SECTION("Finds nothing for FX not in the project") {
+        CHECK(index.getFxLocationsFor(EARPluginSuite::HOA_METADATA_PLUGIN_NAME).empty());
+    }
+
+    SECTION("Finds every input plugin sharing an instance ID") {
+        auto plugins = index.getEarInputPluginsWithInputInstanceId(7);
+        REQUIRE(plugins.size() == 2);
+        CHECK(plugins[0]->getTrackInstance().get() == firstTrack);
+        CHECK(plugins[0]->getPluginIndex() == 0);
+        CHECK(plugins[1]->getTrackInstance().get() == secondTrack);
+        CHECK(plugins[1]->getPluginIndex() == 2);
+    }
+
+    SECTION("Finds no input plugins for unused instance IDs") {
+        CHECK(index.getEarInputPluginsWithInputInstanceId(8).empty());
+    }
+}
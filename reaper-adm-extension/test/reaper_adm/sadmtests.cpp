@@ -0,0 +1,147 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "include_gmock.h"
+#include "mocks/reaperapi.h"
+#include "fakeptr.h"
+#include <exportaction_parameterprocessing.h>
+#include <exportaction_sadmwriter.h>
+#include <exportaction_admsourcescontainer.h>
+#include "tempdir.h"
+
+using namespace admplug;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Invoke;
+using Catch::Approx;
+using namespace std::chrono_literals;
+
+namespace {
+std::string const envelopeChunk{"<PARMENV 1:0 0 1 0.5\nACT 1 -1\nVIS 1 1 1\nARM 0\nDEFSHAPE 0 -1 -1\n"
+                                "PT 0 0 0\nPT 2 1 0\nPT 3 0.5 1\nPT 5 0 0\n>\n"};
+
+class FrameSources : public IExportSources {
+public:
+    explicit FrameSources(ReaperAPI const& api) : IExportSources(api) {}
+    bool documentRequiresProgrammeTitles() override { return false; }
+    bool documentRequiresContentTitles() override { return false; }
+    bool validForExport() override { return true; }
+    int getSampleRate() override { return 48000; }
+    int getTotalExportChannels() override { return 0; }
+    void setRenderInProgress(bool) override {}
+    bool isFrameAvailable() override { return false; }
+    bool writeNextFrameTo(float*, bool) override { return false; }
+    std::shared_ptr<bw64::AxmlChunk> getAxmlChunk() override { return nullptr; }
+    std::shared_ptr<bw64::ChnaChunk> getChnaChunk() override { return nullptr; }
+    std::shared_ptr<adm::Document> getAdmDocument() override { return nullptr; }
+    bool supportsSerialAdm() override { return true; }
+    void writeSerialAdmFrameTo(std::ostream& os, std::chrono::nanoseconds, std::chrono::nanoseconds) override {
+        os << "<audioFormatExtended/>";
+    }
+    std::vector<std::string> generateExportInfoStrings() override { return {}; }
+    std::vector<std::string> generateExportErrorStrings() override { return {}; }
+    std::vector<std::string> generateExportWarningStrings() override { return {}; }
+};
+
+std::size_t countOf(std::string const& text, std::string const& part) {
+    std::size_t count = 0;
+    for(auto pos = text.find(part); pos != std::string::npos; pos = text.find(part, pos + part.size())) {
+        count++;
+    }
+    return count;
+}
+
+std::shared_ptr<EnvelopeSnapshot> captureSnapshot(NiceMock<MockReaperAPI>& api, TrackEnvelope* envelope) {
+    ON_CALL(api, GetEnvelopeStateChunk(envelope, _, _, _)).WillByDefault(Invoke([](TrackEnvelope*, char* buffer, int bufferSize, bool) {
+        std::strncpy(buffer, envelopeChunk.c_str(), bufferSize - 1);
+        buffer[bufferSize - 1] = '\0';
+        return true;
+    }));
+    return EnvelopeSnapshot::capture(*envelope, api);
+}
+}
+
+TEST_CASE("Envelope snapshot slices evaluate the same as the whole envelope within their range", "[sadm]") {
+    FakePtrFactory fake;
+    auto fakeEnvelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    auto snapshot = captureSnapshot(api, fakeEnvelope);
+    REQUIRE(snapshot);
+
+    auto slice = snapshot->slice(1.0, 4.0);
+    for(auto time : { 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 3.99 }) {
+        CHECK(slice->evaluate(time) == Approx(snapshot->evaluate(time)));
+    }
+}
+
+TEST_CASE("Envelope snapshot slices only hold points within their range", "[sadm]") {
+    FakePtrFactory fake;
+    auto fakeEnvelope = fake.get<TrackEnvelope>();
+    NiceMock<MockReaperAPI> api;
+    auto snapshot = captureSnapshot(api, fakeEnvelope);
+    REQUIRE(snapshot);
+
+    auto chunk = snapshot->slice(1.0, 4.0)->getStateChunk();
+    REQUIRE(chunk);
+    // Start point, the points at 2 and 3, then the end point holding the square value
+    CHECK(*chunk == "PT 1 0.5 0\nPT 2 1 0\nPT 3 0.5 0\nPT 4 0.5 0\n>\n");
+}
+
+TEST_CASE("S-ADM times are formatted as ADM times", "[sadm]") {
+    CHECK(SerialAdmWriter::formatTime(0ns) == "00:00:00.00000");
+    CHECK(SerialAdmWriter::formatTime(1500ms) == "00:00:01.50000");
+    CHECK(SerialAdmWriter::formatTime(2h + 3min + 4s + 10us) == "02:03:04.00001");
+}
+
+TEST_CASE("S-ADM frame format IDs count from one", "[sadm]") {
+    CHECK(SerialAdmWriter::formatFrameFormatId(0) == "FF_00000000001");
+    CHECK(SerialAdmWriter::formatFrameFormatId(255) == "FF_00000000100");
+}
+
+TEST_CASE("S-ADM file name replaces the BW64 extension", "[sadm]") {
+    CHECK(SerialAdmWriter::fileNameFor("/renders/mix.wav") == "/renders/mix.sadm.xml");
+    CHECK(SerialAdmWriter::fileNameFor("/renders.v2/mix") == "/renders.v2/mix.sadm.xml");
+}
+
+TEST_CASE("S-ADM transport track format lists track UIDs from the CHNA chunk", "[sadm]") {
+    auto chna = std::make_shared<bw64::ChnaChunk>(std::vector<bw64::AudioId>{
+        bw64::AudioId(1, "ATU_00000001", "AT_00031001_01", "AP_00031001"),
+        bw64::AudioId(2, "ATU_00000002", "AT_00031002_01", "AP_00031002")
+    });
+    std::string expected{"<transportTrackFormat transportID=\"TP_0001\" numIDs=\"2\" numTracks=\"2\">\n"
+                         "<audioTrack trackID=\"1\">\n<audioTrackUIDRef>ATU_00000001</audioTrackUIDRef>\n</audioTrack>\n"
+                         "<audioTrack trackID=\"2\">\n<audioTrackUIDRef>ATU_00000002</audioTrackUIDRef>\n</audioTrack>\n"
+                         "</transportTrackFormat>\n"};
+    CHECK(SerialAdmWriter::formatTransportTrackFormat(chna) == expected);
+}
+
+TEST_CASE("S-ADM files hold their frames in one XML document", "[sadm]") {
+    test::TempDir dir;
+    auto fileName = (dir.path() / "mix.sadm.xml").string();
+    NiceMock<MockReaperAPI> api;
+    FrameSources sources(api);
+    {
+        SerialAdmWriter writer(fileName, &sources, nullptr);
+        REQUIRE(writer.isOpen());
+        writer.audioWrittenUntil(2s);
+        writer.finish(2500ms);
+        CHECK(writer.getFramesWritten() == 3);
+    }
+
+    std::ifstream file(fileName);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    auto xml = contents.str();
+
+    CHECK(xml.rfind("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<frameSequence>\n<frame ", 0) == 0);
+    CHECK(countOf(xml, "<?xml") == 1);
+    CHECK(countOf(xml, "<frame ") == 3);
+    CHECK(countOf(xml, "</frame>") == 3);
+    CHECK(xml.find("duration=\"00:00:00.50000\"") != std::string::npos);
+    auto rootEnd = std::string{"</frameSequence>\n"};
+    REQUIRE(xml.size() >= rootEnd.size());
+    CHECK(xml.compare(xml.size() - rootEnd.size(), rootEnd.size(), rootEnd) == 0);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "JuceHeader.h"
+
+#include "look_and_feel/colours.hpp"
+#include "look_and_feel/fonts.hpp"
+#include <processing_stats.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace ear {
+namespace plugin {
+namespace ui {
+
+// Compact readout of the first stage of a plugin's ProcessingStats (which
+// should be processBlock as a whole), with the rest in the tooltip.
+// Clicking starts a Chrome trace; clicking again writes it to the temp
+// directory and reveals the file.
+class ProcessingStatsLabel : public Label, private Timer {
+ public:
+  explicit ProcessingStatsLabel(ProcessingStats* stats) : stats_(stats) {
+    setFont(EarFontsSingleton::instance().Version);
+    setColour(Label::textColourId, EarColours::Version);
+    setJustificationType(Justification::left);
+    setEditable(false);
+    setMouseCursor(MouseCursor::PointingHandCursor);
+    startTimer(500);
+  }
+
+  void mouseUp(const MouseEvent& event) override {
+    if (!stats_ || !event.mouseWasClicked()) return;
+    if (!stats_->traceEnabled()) {
+      stats_->setTraceEnabled(true);
+      // Discard anything left from a previous trace
+      std::ostringstream discard;
+      stats_->writeChromeTrace(discard);
+    } else {
+      stats_->setTraceEnabled(false);
+      auto file =
+          File::getSpecialLocation(File::tempDirectory)
+              .getNonexistentChildFile(
+                  File::createLegalFileName(stats_->pluginName() + " trace"),
+                  ".json");
+      std::ofstream stream(file.getFullPathName().toStdString());
+      stats_->writeChromeTrace(stream);
+      stream.close();
+      file.revealToUser();
+    }
+    timerCallback();
+  }
+
+ private:
+  void timerCallback() override {
+    if (!stats_) return;
+    auto stages = stats_->snapshot();
+    if (stages.empty()) return;
+
+    String text = "DSP " + describe(stages.front());
+    if (stats_->traceEnabled()) {
+      text += " - tracing";
+    }
+    setText(text, dontSendNotification);
+
+    String detail;
+    for (auto const& stage : stages) {
+      detail += String(stage.name) + ": " + describe(stage);
+      if (stage.contentions > 0) {
+        detail += ", " + String(static_cast<int64>(stage.contentions)) +
+                  " contended locks";
+      }
+      if (stage.channelBlocks > 0) {
+        detail += ", " +
+                  String(100.0 * stage.skippedChannelBlocks /
+                             stage.channelBlocks,
+                         0) +
+                  "% of input blocks skipped as silent";
+      }
+      detail += "\n";
+    }
+    detail += stats_->traceEnabled() ? "Click to write the Chrome trace"
+                                     : "Click to start a Chrome trace";
+    setTooltip(detail);
+  }
+
+  static String describe(const ProcessingStats::StageSnapshot& stage) {
+    return String(stage.meanMicroseconds, 1) + " us avg, " +
+           String(stage.peakMicroseconds, 0) + " us peak, p99 < " +
+           String(stage.percentileMicroseconds(0.99), 0) + " us";
+  }
+
+  ProcessingStats* stats_;
+};
+
+}  // namespace ui
+}  // namespace plugin
+}  // namespace ear
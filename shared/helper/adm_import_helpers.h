@@ -0,0 +1,32 @@
+#pragma once
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <adm/document.hpp>
+#include <bw64/bw64.hpp>
+
+/*
+NOTE:
+
+Steps shared by everything that reads ADM from a BW64 file - the REAPER
+extension on import and the offline renderer - so both see the same document.
+*/
+
+namespace admplug {
+
+// Reads directly from the chunk data, so the XML isn't copied in to a stream first
+class ChunkStreamBuf : public std::streambuf {
+public:
+    explicit ChunkStreamBuf(std::string const& data) {
+        auto begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+std::shared_ptr<adm::Document> parseAxml(bw64::AxmlChunk const& axml);
+
+// Completes the track UIDs of the document with the references the CHNA gives them.
+// Throws std::runtime_error (prefixed "CHNA: ") for references which aren't ADM IDs.
+void completeUidReferences(adm::Document& doc, bw64::ChnaChunk const& chna);
+
+}
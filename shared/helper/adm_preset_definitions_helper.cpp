@@ -2,6 +2,7 @@
 #include <adm/common_definitions.hpp>
 #include <adm/parse.hpp>
 #include <algorithm>
+#include <unordered_map>
 #include <string_view>
 #include <sstream>
 #include <cassert>
@@ -46,18 +47,27 @@ namespace {
 		}
 		return false;
 	}
+
+	std::optional<std::string> optionalString(const char* str) {
+		if (!str) return std::nullopt;
+		return std::string(str);
+	}
 }
 
 AdmPresetDefinitionsHelper::AdmPresetDefinitionsHelper()
 {
-	std::istringstream xmlIs{ xmlSupplementaryDefinitions };
-	presetDefinitions = adm::parseXml(xmlIs, adm::xml::ParserOptions::recursive_node_search); // will also add common defs
+#ifdef EPS_PRESET_DEFINITIONS_TABLE_GENERATOR
+	// The generator is what produces the tables, so has to work from the definitions document
+	getPresetDefinitions();
 	populateElementRelationshipsFor(adm::TypeDefinition::UNDEFINED);
 	populateElementRelationshipsFor(adm::TypeDefinition::OBJECTS);
 	populateElementRelationshipsFor(adm::TypeDefinition::MATRIX);
 	populateElementRelationshipsFor(adm::TypeDefinition::DIRECT_SPEAKERS);
 	populateElementRelationshipsFor(adm::TypeDefinition::HOA);
 	populateElementRelationshipsFor(adm::TypeDefinition::BINAURAL);
+#else
+	populateElementRelationshipsFromTable();
+#endif
 }
 
 AdmPresetDefinitionsHelper& AdmPresetDefinitionsHelper::getSingleton()
@@ -66,6 +76,42 @@ AdmPresetDefinitionsHelper& AdmPresetDefinitionsHelper::getSingleton()
 	return *instance;
 }
 
+std::shared_ptr<adm::Document> AdmPresetDefinitionsHelper::getPresetDefinitions()
+{
+	std::call_once(presetDefinitionsParsed, [this]() {
+		std::istringstream xmlIs{ xmlSupplementaryDefinitions };
+		presetDefinitions = adm::parseXml(xmlIs, adm::xml::ParserOptions::recursive_node_search); // will also add common defs
+		resolveDefinitionElements();
+	});
+	return presetDefinitions;
+}
+
+void AdmPresetDefinitionsHelper::resolveDefinitionElements()
+{
+	// One pass over the document rather than a lookup per data (Document::lookup is a linear search)
+	std::unordered_map<std::string, std::shared_ptr<adm::AudioPackFormat>> packFormatsById;
+	for (auto pf : presetDefinitions->getElements<adm::AudioPackFormat>()) {
+		packFormatsById.emplace(adm::formatId(pf->get<adm::AudioPackFormatId>()), pf);
+	}
+	std::unordered_map<std::string, std::shared_ptr<adm::AudioChannelFormat>> channelFormatsById;
+	for (auto cf : presetDefinitions->getElements<adm::AudioChannelFormat>()) {
+		channelFormatsById.emplace(adm::formatId(cf->get<adm::AudioChannelFormatId>()), cf);
+	}
+
+	for (auto& pfData : packFormatDatas) {
+		auto it = packFormatsById.find(pfData->fullId);
+		if (it != packFormatsById.end()) {
+			pfData->packFormat = it->second;
+		}
+	}
+	for (auto& cfData : channelFormatDatas) {
+		auto it = channelFormatsById.find(cfData->fullId);
+		if (it != channelFormatsById.end()) {
+			cfData->channelFormat = it->second;
+		}
+	}
+}
+
 AdmPresetDefinitionsHelper::ObjectHolder AdmPresetDefinitionsHelper::addPresetDefinitionObjectTo(
 	std::shared_ptr<adm::Document> document, const std::string& name, const adm::AudioPackFormatId packFormatId)
 {
@@ -87,7 +133,7 @@ AdmPresetDefinitionsHelper::ObjectHolder AdmPresetDefinitionsHelper::setupPreset
 	if (pfData) {
 		for (auto const& cfData : pfData->relatedChannelFormats) {
 			if (!forSingleCfIdValue || *forSingleCfIdValue == cfData->idValue) {
-				auto cfId = cfData->channelFormat->get<adm::AudioChannelFormatId>();
+				auto cfId = adm::parseAudioChannelFormatId(cfData->fullId);
 				auto cf = document->lookup(cfId);
 				if (!cf) {
 					std::stringstream ss;
@@ -133,7 +179,7 @@ AdmPresetDefinitionsHelper::getDocumentAudioPackFormat(std::shared_ptr<adm::Docu
 		}
 		else {
 			// it's a supplementary definition - add the necessary PF/CF tree
-			audioPackFormat = copyMissingTreeElms(pfData->packFormat, document);
+			audioPackFormat = copyMissingTreeElms(pfData->getPackFormat(), document);
 		}
 	}
 	return std::make_tuple(audioPackFormat, pfData);
@@ -230,7 +276,7 @@ std::shared_ptr<AdmPresetDefinitionsHelper::PackFormatData const> AdmPresetDefin
 			}
 			else {
 				// Custom CF's must be matched by properties, because they won't have consistent ID's
-				return adm::helpers::equality::isEquivalentByProperties(presetData->channelFormat, channelFormatToFind);
+				return adm::helpers::equality::isEquivalentByProperties(presetData->getChannelFormat(), channelFormatToFind);
 			}
 		});
 
@@ -288,6 +334,7 @@ void AdmPresetDefinitionsHelper::populateElementRelationshipsFor(adm::TypeDescri
 			// Find Channel formats
 			recursePackFormatsForChannelFormats(pf, pfData);
 
+			packFormatDatas.push_back(pfData);
 			tdData->relatedPackFormats.emplace_back(std::move(pfData));
 		}
 	}
@@ -309,18 +356,51 @@ void AdmPresetDefinitionsHelper::recursePackFormatsForChannelFormats(std::shared
 	auto channelFormats = fromPackFormat->getReferences<adm::AudioChannelFormat>();
 	for (auto cf : channelFormats) {
 		auto cfData = std::make_shared<ChannelFormatData>(cf, fromPackFormat);
+		channelFormatDatas.push_back(cfData);
 		forPackFormatData->relatedChannelFormats.push_back(cfData);
 	}
 }
 
 
+void AdmPresetDefinitionsHelper::populateElementRelationshipsFromTable()
+{
+	namespace table = adm_preset_definitions_table;
+	packFormatDatas.reserve(table::packFormatCount);
+	channelFormatDatas.reserve(table::channelFormatCount);
+
+	for (std::size_t tdIndex = 0; tdIndex < table::typeDefinitionCount; ++tdIndex) {
+		auto const& tdEntry = table::typeDefinitions[tdIndex];
+		auto tdData = std::make_shared<TypeDefinitionData>();
+		tdData->id = tdEntry.id;
+		tdData->typeDescriptor = adm::TypeDescriptor{ tdEntry.id };
+		tdData->name = tdEntry.name;
+
+		for (std::size_t pfIndex = tdEntry.packFormatsBegin; pfIndex < tdEntry.packFormatsBegin + tdEntry.packFormatsCount; ++pfIndex) {
+			auto const& pfEntry = table::packFormats[pfIndex];
+			auto pfData = std::make_shared<PackFormatData>(pfEntry);
+			for (std::size_t cfIndex = pfEntry.channelFormatsBegin; cfIndex < pfEntry.channelFormatsBegin + pfEntry.channelFormatsCount; ++cfIndex) {
+				auto cfData = std::make_shared<ChannelFormatData>(table::channelFormats[cfIndex]);
+				channelFormatDatas.push_back(cfData);
+				pfData->relatedChannelFormats.push_back(std::move(cfData));
+			}
+			packFormatDatas.push_back(pfData);
+			tdData->relatedPackFormats.emplace_back(std::move(pfData));
+		}
+
+		if (tdData->id >= typeDefinitionDatas.size()) {
+			typeDefinitionDatas.resize(tdData->id + 1, nullptr);
+		}
+		typeDefinitionDatas[tdData->id] = std::move(tdData);
+	}
+}
+
 
 AdmPresetDefinitionsHelper::ChannelFormatData::ChannelFormatData(std::shared_ptr<adm::AudioChannelFormat> cf, std::shared_ptr<adm::AudioPackFormat> fromPackFormat) :
 	idValue{ static_cast<int>(cf->get<adm::AudioChannelFormatId>().get<adm::AudioChannelFormatIdValue>().get()) },
 	fullId{ adm::formatId(cf->get<adm::AudioChannelFormatId>()) },
 	name{ cf->get<adm::AudioChannelFormatName>().get() },
-	channelFormat{ cf },
-	immediatePackFormat{ fromPackFormat }
+	immediatePackFormatId{ adm::formatId(fromPackFormat->get<adm::AudioPackFormatId>()) },
+	channelFormat{ cf }
 {
 	if (cf->has<adm::Frequency>()) {
 		auto freq = cf->get<adm::Frequency>();
@@ -355,6 +435,39 @@ AdmPresetDefinitionsHelper::ChannelFormatData::ChannelFormatData(std::shared_ptr
 		setItuLabels();
 		setLegacySpeakerLabel();
 	}
+	else if (td == adm::TypeDefinition::HOA) {
+		auto bfs = cf->getElements<adm::AudioBlockFormatHoa>();
+		if (bfs.size() > 0) {
+			auto const& bf = bfs[0];
+			hoaOrder = bf.get<adm::Order>().get();
+			hoaDegree = bf.get<adm::Degree>().get();
+			hoaNormalization = bf.get<adm::Normalization>().get();
+		}
+	}
+}
+
+AdmPresetDefinitionsHelper::ChannelFormatData::ChannelFormatData(adm_preset_definitions_table::ChannelFormatEntry const& entry) :
+	idValue{ entry.idValue },
+	fullId{ entry.fullId },
+	name{ entry.name },
+	immediatePackFormatId{ entry.immediatePackFormatId },
+	legacySpeakerLabel{ optionalString(entry.legacySpeakerLabel) },
+	ituLabel{ optionalString(entry.ituLabel) },
+	ituStandard{ optionalString(entry.ituStandard) },
+	isLfe{ entry.isLfe },
+	azimuth{ entry.azimuth },
+	elevation{ entry.elevation },
+	distance{ entry.distance },
+	hoaNormalization{ optionalString(entry.hoaNormalization) }
+{
+	speakerLabels.reserve(entry.speakerLabelsCount);
+	for (std::size_t i = entry.speakerLabelsBegin; i < entry.speakerLabelsBegin + entry.speakerLabelsCount; ++i) {
+		speakerLabels.push_back(adm_preset_definitions_table::speakerLabels[i]);
+	}
+	if (entry.hoaOrder >= 0) {
+		hoaOrder = entry.hoaOrder;
+		hoaDegree = entry.hoaDegree;
+	}
 }
 
 AdmPresetDefinitionsHelper::ChannelFormatData::~ChannelFormatData()
@@ -366,6 +479,12 @@ const bool AdmPresetDefinitionsHelper::ChannelFormatData::isCommonDefinition() c
 	return AdmPresetDefinitionsHelper::isCommonDefinition(idValue);
 }
 
+std::shared_ptr<adm::AudioChannelFormat> AdmPresetDefinitionsHelper::ChannelFormatData::getChannelFormat() const
+{
+	AdmPresetDefinitionsHelper::getSingleton().getPresetDefinitions();
+	return channelFormat;
+}
+
 const std::string AdmPresetDefinitionsHelper::ChannelFormatData::getBestSpeakerLabel() const
 {
 	if (legacySpeakerLabel)
@@ -396,8 +515,7 @@ void AdmPresetDefinitionsHelper::ChannelFormatData::setLegacySpeakerLabel()
 	auto const &labels = itLabels->second;
 	legacySpeakerLabel = labels.defaultLegacySpeakerLabel;
 	if (!labels.specificForPackFormatId.empty()) {
-		auto pfId = adm::formatId(immediatePackFormat->get<adm::AudioPackFormatId>());
-		auto itPfSpecificLabel = labels.specificForPackFormatId.find(pfId);
+		auto itPfSpecificLabel = labels.specificForPackFormatId.find(immediatePackFormatId);
 		if (itPfSpecificLabel != labels.specificForPackFormatId.end()) {
 			legacySpeakerLabel = itPfSpecificLabel->second;
 		}
@@ -413,6 +531,16 @@ AdmPresetDefinitionsHelper::PackFormatData::PackFormatData(std::shared_ptr<adm::
 	setLabels();
 }
 
+AdmPresetDefinitionsHelper::PackFormatData::PackFormatData(adm_preset_definitions_table::PackFormatEntry const& entry) :
+	idValue{ entry.idValue },
+	fullId{ entry.fullId },
+	name{ entry.name },
+	niceName{ entry.niceName },
+	ituLabel{ optionalString(entry.ituLabel) },
+	ituStandard{ optionalString(entry.ituStandard) }
+{
+}
+
 AdmPresetDefinitionsHelper::PackFormatData::~PackFormatData()
 {
 }
@@ -422,6 +550,12 @@ const bool AdmPresetDefinitionsHelper::PackFormatData::isCommonDefinition() cons
 	return AdmPresetDefinitionsHelper::isCommonDefinition(idValue);
 }
 
+std::shared_ptr<adm::AudioPackFormat> AdmPresetDefinitionsHelper::PackFormatData::getPackFormat() const
+{
+	AdmPresetDefinitionsHelper::getSingleton().getPresetDefinitions();
+	return packFormat;
+}
+
 void AdmPresetDefinitionsHelper::PackFormatData::setLabels()
 {
 	const std::string ituLabelType{ "pack" };
@@ -3,10 +3,12 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <optional>
 #include <tuple>
 #include <adm/adm.hpp>
+#include "adm_preset_definitions_table.h"
 
 class AdmPresetDefinitionsHelper {
 public:
@@ -20,29 +22,37 @@ public:
 	class ChannelFormatData {
 	public:
 		ChannelFormatData(std::shared_ptr<adm::AudioChannelFormat> acf, std::shared_ptr<adm::AudioPackFormat> fromPackFormat);
+		ChannelFormatData(adm_preset_definitions_table::ChannelFormatEntry const& entry);
 		~ChannelFormatData();
 
 		int idValue{ 0 };
 		std::string fullId;
 		std::string name;
+		std::string immediatePackFormatId;
 		std::optional<std::string> legacySpeakerLabel;
 		std::optional<std::string> ituLabel;
 		std::optional<std::string> ituStandard;
-		std::shared_ptr<adm::AudioChannelFormat> channelFormat;
-		std::shared_ptr<adm::AudioPackFormat> immediatePackFormat;
 		bool isLfe{ false };
 		std::vector<std::string> speakerLabels;
 		float azimuth{ 0.f };
 		float elevation{ 0.f };
 		float distance{ 1.f	};
+		std::optional<int> hoaOrder;
+		std::optional<int> hoaDegree;
+		std::optional<std::string> hoaNormalization;
 
 		const bool isCommonDefinition() const;
 		const std::string getBestSpeakerLabel() const;
+		// Element in the preset definitions document - parses the document if not already done
+		std::shared_ptr<adm::AudioChannelFormat> getChannelFormat() const;
 
 	private:
+		friend class AdmPresetDefinitionsHelper;
 		void setItuLabels();
 		void setLegacySpeakerLabel();
 
+		std::shared_ptr<adm::AudioChannelFormat> channelFormat;
+
 		struct ChannelFormatNiceName {
 			const std::string defaultLegacySpeakerLabel;
 			const std::map<const std::string, const std::string> specificForPackFormatId = {};
@@ -53,6 +63,7 @@ public:
 	class PackFormatData {
 	public:
 		PackFormatData(std::shared_ptr<adm::AudioPackFormat> apf);
+		PackFormatData(adm_preset_definitions_table::PackFormatEntry const& entry);
 		~PackFormatData();
 
 		int idValue{ 0 };
@@ -61,13 +72,17 @@ public:
 		std::string niceName;
 		std::optional<std::string> ituLabel;
 		std::optional<std::string> ituStandard;
-		std::shared_ptr<adm::AudioPackFormat> packFormat;
 		std::vector<std::shared_ptr<ChannelFormatData const>> relatedChannelFormats;
 
 		const bool isCommonDefinition() const;
+		// Element in the preset definitions document - parses the document if not already done
+		std::shared_ptr<adm::AudioPackFormat> getPackFormat() const;
 
 	private:
+		friend class AdmPresetDefinitionsHelper;
 		void setLabels();
+
+		std::shared_ptr<adm::AudioPackFormat> packFormat;
 	};
 
 	struct TypeDefinitionData {
@@ -106,17 +121,27 @@ public:
 
 	static bool isCommonDefinition(int idValue);
 	static std::shared_ptr<adm::AudioPackFormat> copyMissingTreeElms(std::shared_ptr<adm::AudioPackFormat> srcPf, std::shared_ptr<adm::Document> dstDoc);
+	// The document's pack format for a preset, adding it (and its tree) if not yet there
+	std::tuple<std::shared_ptr<adm::AudioPackFormat>, 
+		std::shared_ptr<AdmPresetDefinitionsHelper::PackFormatData const>> 
+		getDocumentAudioPackFormat(std::shared_ptr<adm::Document> document,
+		const adm::AudioPackFormatId packFormatId);
 
 private:
 	AdmPresetDefinitionsHelper();
 
+	// The full definitions document is only needed to author ADM, so is parsed on first use rather than at startup
+	std::shared_ptr<adm::Document> getPresetDefinitions();
+	void resolveDefinitionElements();
+
+	void populateElementRelationshipsFromTable();
 	void populateElementRelationshipsFor(adm::TypeDescriptor);
 	void recursePackFormatsForChannelFormats(std::shared_ptr<adm::AudioPackFormat> fromPackFormat, std::shared_ptr<PackFormatData> forPackFormatData);
-	std::tuple<std::shared_ptr<adm::AudioPackFormat>, 
-		std::shared_ptr<AdmPresetDefinitionsHelper::PackFormatData const>> 
-		getDocumentAudioPackFormat(std::shared_ptr<adm::Document> document,
-		const adm::AudioPackFormatId packFormatId);
 
+	std::once_flag presetDefinitionsParsed;
 	std::shared_ptr<adm::Document> presetDefinitions;
 	std::vector<std::shared_ptr<TypeDefinitionData const>> typeDefinitionDatas{ 6, nullptr }; // last elm index 5 (highest TD)
+	// Every pack and channel data, so their elements can be filled in once the document is parsed
+	std::vector<std::shared_ptr<PackFormatData>> packFormatDatas;
+	std::vector<std::shared_ptr<ChannelFormatData>> channelFormatDatas;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+Flat tables of the ADM preset definitions (common definitions plus our supplementary definitions).
+The tables are generated at build time by ear-preset-definitions-generator (shared/preset_definitions),
+ which builds AdmPresetDefinitionsHelper from the definitions XML and writes out what it found.
+All data is constant-initialised, so reading it at startup costs no parsing.
+Strings which aren't set are nullptr.
+*/
+
+namespace adm_preset_definitions_table {
+
+	struct ChannelFormatEntry {
+		int idValue;
+		const char* fullId;
+		const char* name;
+		const char* immediatePackFormatId;
+		const char* legacySpeakerLabel;
+		const char* ituLabel;
+		const char* ituStandard;
+		bool isLfe;
+		std::size_t speakerLabelsBegin; // Index in to speakerLabels
+		std::size_t speakerLabelsCount;
+		float azimuth;
+		float elevation;
+		float distance;
+		int hoaOrder; // -1 when not HOA
+		int hoaDegree;
+		const char* hoaNormalization;
+	};
+
+	struct PackFormatEntry {
+		int idValue;
+		const char* fullId;
+		const char* name;
+		const char* niceName;
+		const char* ituLabel;
+		const char* ituStandard;
+		std::size_t channelFormatsBegin; // Index in to channelFormats
+		std::size_t channelFormatsCount;
+	};
+
+	struct TypeDefinitionEntry {
+		int id;
+		const char* name;
+		std::size_t packFormatsBegin; // Index in to packFormats
+		std::size_t packFormatsCount;
+	};
+
+	extern const TypeDefinitionEntry typeDefinitions[];
+	extern const std::size_t typeDefinitionCount;
+	extern const PackFormatEntry packFormats[];
+	extern const std::size_t packFormatCount;
+	extern const ChannelFormatEntry channelFormats[];
+	extern const std::size_t channelFormatCount;
+	extern const char* const speakerLabels[];
+	extern const std::size_t speakerLabelCount;
+
+}
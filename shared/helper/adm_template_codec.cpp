@@ -0,0 +1,588 @@
+#include "adm_template_codec.h"
+#include "adm_preset_definitions_helper.h"
+#include <adm/adm.hpp>
+#include <adm/common_definitions.hpp>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+	const char MAGIC[4] = { 'E', 'P', 'S', 'A' };
+	const uint16_t FORMAT_VERSION = 2;
+
+	// Chunks are decoded in this order, whatever order they arrive in
+	const std::string CHUNK_VERSION{ "vers" };
+	const std::string CHUNK_PACK_FORMATS{ "pack" };
+	const std::string CHUNK_TRACK_UIDS{ "tuid" };
+	const std::string CHUNK_OBJECTS{ "objs" };
+	const std::string CHUNK_CONTENTS{ "cont" };
+	const std::string CHUNK_PROGRAMMES{ "prog" };
+
+	enum ObjectFlags : uint8_t {
+		HAS_IMPORTANCE = 0x01,
+		HAS_INTERACT = 0x02,
+		INTERACT = 0x04,
+		HAS_INTERACTION = 0x08
+	};
+
+	// OnOffInteract is always set, so only has a value flag
+	enum InteractionFlags : uint8_t {
+		ON_OFF_INTERACT = 0x01,
+		HAS_GAIN_INTERACT = 0x02,
+		GAIN_INTERACT = 0x04,
+		HAS_POSITION_INTERACT = 0x08,
+		POSITION_INTERACT = 0x10,
+		HAS_GAIN_RANGE = 0x20,
+		HAS_POSITION_RANGE = 0x40
+	};
+
+	enum GainRangeFlags : uint8_t {
+		HAS_GAIN_MIN = 0x01,
+		HAS_GAIN_MAX = 0x02
+	};
+
+	enum TrackUidFlags : uint8_t {
+		HAS_PACK_FORMAT = 0x01,
+		HAS_CHANNEL_FORMAT = 0x02
+	};
+
+	class Writer {
+	public:
+		template<typename T>
+		void put(T value) {
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written");
+			auto pos = out.size();
+			out.resize(pos + sizeof(T));
+			memcpy(&out[pos], &value, sizeof(T));
+		}
+
+		void putString(std::string const& str) {
+			put<uint32_t>(static_cast<uint32_t>(str.size()));
+			out.append(str);
+		}
+
+		void beginChunk(std::string const& id) {
+			out.append(id);
+			chunkSizePos = out.size();
+			put<uint32_t>(0);
+		}
+
+		void endChunk() {
+			auto chunkSize = static_cast<uint32_t>(out.size() - chunkSizePos - sizeof(uint32_t));
+			memcpy(&out[chunkSizePos], &chunkSize, sizeof(uint32_t));
+		}
+
+		std::string out;
+
+	private:
+		size_t chunkSizePos{ 0 };
+	};
+
+	class Reader {
+	public:
+		Reader(char const* data, size_t size) : data{ data }, size{ size } {}
+
+		template<typename T>
+		T get() {
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read");
+			need(sizeof(T));
+			T value;
+			memcpy(&value, data + pos, sizeof(T));
+			pos += sizeof(T);
+			return value;
+		}
+
+		std::string getString() {
+			return getBytes(get<uint32_t>());
+		}
+
+		std::string getBytes(size_t count) {
+			need(count);
+			std::string bytes(data + pos, count);
+			pos += count;
+			return bytes;
+		}
+
+		Reader getChunk(size_t count) {
+			need(count);
+			Reader chunk(data + pos, count);
+			pos += count;
+			return chunk;
+		}
+
+		bool atEnd() const { return pos == size; }
+
+	private:
+		void need(size_t count) const {
+			if (count > size - pos) {
+				throw std::runtime_error("Encoded ADM template is truncated");
+			}
+		}
+
+		char const* data;
+		size_t size;
+		size_t pos{ 0 };
+	};
+
+	using PackKey = std::pair<int, int>; // type definition, ID value
+
+	PackKey packKey(adm::AudioPackFormatId const& id) {
+		return { id.get<adm::TypeDescriptor>().get(), id.get<adm::AudioPackFormatIdValue>().get() };
+	}
+
+	void putPackFormatId(Writer& writer, adm::AudioPackFormatId const& id) {
+		auto [typeDefinition, idValue] = packKey(id);
+		writer.put<uint8_t>(static_cast<uint8_t>(typeDefinition));
+		writer.put<uint16_t>(static_cast<uint16_t>(idValue));
+	}
+
+	adm::AudioPackFormatId getPackFormatId(Reader& reader) {
+		auto typeDefinition = reader.get<uint8_t>();
+		auto idValue = reader.get<uint16_t>();
+		return adm::AudioPackFormatId(adm::TypeDescriptor(typeDefinition), adm::AudioPackFormatIdValue(idValue));
+	}
+
+	void putChannelFormatId(Writer& writer, adm::AudioChannelFormatId const& id) {
+		writer.put<uint8_t>(static_cast<uint8_t>(id.get<adm::TypeDescriptor>().get()));
+		writer.put<uint16_t>(static_cast<uint16_t>(id.get<adm::AudioChannelFormatIdValue>().get()));
+	}
+
+	adm::AudioChannelFormatId getChannelFormatId(Reader& reader) {
+		auto typeDefinition = reader.get<uint8_t>();
+		auto idValue = reader.get<uint16_t>();
+		return adm::AudioChannelFormatId(adm::TypeDescriptor(typeDefinition), adm::AudioChannelFormatIdValue(idValue));
+	}
+
+	uint16_t objectIdValue(adm::AudioObject const& object) {
+		return static_cast<uint16_t>(object.get<adm::AudioObjectId>().get<adm::AudioObjectIdValue>().get());
+	}
+
+	uint32_t trackUidIdValue(adm::AudioTrackUid const& trackUid) {
+		return static_cast<uint32_t>(trackUid.get<adm::AudioTrackUidId>().get<adm::AudioTrackUidIdValue>().get());
+	}
+
+	template<typename Param>
+	using ValueOf = std::decay_t<decltype(std::declval<Param>().get())>;
+
+	// A flags byte for which of Params are set, then each set value as libadm holds it
+	template<typename... Params, typename Element>
+	void putOptionalValues(Writer& writer, Element const& element) {
+		uint8_t flags = 0;
+		uint8_t bit = 1;
+		((flags |= element.template has<Params>() ? bit : 0, bit <<= 1), ...);
+		writer.put<uint8_t>(flags);
+		((element.template has<Params>() ? writer.put<ValueOf<Params>>(element.template get<Params>().get()) : void()), ...);
+	}
+
+	template<typename... Params, typename Element>
+	void getOptionalValues(Reader& reader, Element& element) {
+		auto flags = reader.get<uint8_t>();
+		uint8_t bit = 1;
+		(((flags & bit) ? element.set(Params(reader.get<ValueOf<Params>>())) : void(), bit <<= 1), ...);
+	}
+
+	// In the unit it was given in, so it's written back out the same way
+	void putGain(Writer& writer, adm::Gain const& gain) {
+		writer.put<uint8_t>(gain.isDb() ? 1 : 0);
+		writer.put<double>(gain.isDb() ? gain.asDb() : gain.asLinear());
+	}
+
+	adm::Gain getGain(Reader& reader) {
+		auto inDb = reader.get<uint8_t>() != 0;
+		auto value = reader.get<double>();
+		return inDb ? adm::Gain::fromDb(value) : adm::Gain::fromLinear(value);
+	}
+
+	// Throws for any of Params given a value on the element, which the binary form has no room for.
+	// Defaults are fine, as the decoded element has them too.
+	template<typename... Params, typename Element>
+	void requireUnset(Element const& element, std::string const& description) {
+		if (((element.template has<Params>() && !element.template isDefault<Params>()) || ...)) {
+			throw AdmTemplateCodec::UnsupportedDocument(description + " are not supported");
+		}
+	}
+
+	void putInteraction(Writer& writer, adm::AudioObjectInteraction const& interaction) {
+		uint8_t flags = 0;
+		if (interaction.get<adm::OnOffInteract>().get()) flags |= ON_OFF_INTERACT;
+		if (interaction.has<adm::GainInteract>()) {
+			flags |= HAS_GAIN_INTERACT;
+			if (interaction.get<adm::GainInteract>().get()) flags |= GAIN_INTERACT;
+		}
+		if (interaction.has<adm::PositionInteract>()) {
+			flags |= HAS_POSITION_INTERACT;
+			if (interaction.get<adm::PositionInteract>().get()) flags |= POSITION_INTERACT;
+		}
+		if (interaction.has<adm::GainInteractionRange>()) flags |= HAS_GAIN_RANGE;
+		if (interaction.has<adm::PositionInteractionRange>()) flags |= HAS_POSITION_RANGE;
+		writer.put<uint8_t>(flags);
+
+		if (flags & HAS_GAIN_RANGE) {
+			auto const& range = interaction.get<adm::GainInteractionRange>();
+			uint8_t rangeFlags = (range.has<adm::GainInteractionMin>() ? HAS_GAIN_MIN : 0) |
+				(range.has<adm::GainInteractionMax>() ? HAS_GAIN_MAX : 0);
+			writer.put<uint8_t>(rangeFlags);
+			if (rangeFlags & HAS_GAIN_MIN) putGain(writer, range.get<adm::GainInteractionMin>().get());
+			if (rangeFlags & HAS_GAIN_MAX) putGain(writer, range.get<adm::GainInteractionMax>().get());
+		}
+		if (flags & HAS_POSITION_RANGE) {
+			putOptionalValues<adm::AzimuthInteractionMin, adm::AzimuthInteractionMax,
+				adm::ElevationInteractionMin, adm::ElevationInteractionMax,
+				adm::DistanceInteractionMin, adm::DistanceInteractionMax>(
+					writer, interaction.get<adm::PositionInteractionRange>());
+		}
+	}
+
+	adm::AudioObjectInteraction getInteraction(Reader& reader) {
+		auto flags = reader.get<uint8_t>();
+		adm::AudioObjectInteraction interaction{ adm::OnOffInteract{ (flags & ON_OFF_INTERACT) != 0 } };
+		if (flags & HAS_GAIN_INTERACT) interaction.set(adm::GainInteract{ (flags & GAIN_INTERACT) != 0 });
+		if (flags & HAS_POSITION_INTERACT) interaction.set(adm::PositionInteract{ (flags & POSITION_INTERACT) != 0 });
+
+		if (flags & HAS_GAIN_RANGE) {
+			adm::GainInteractionRange range;
+			auto rangeFlags = reader.get<uint8_t>();
+			if (rangeFlags & HAS_GAIN_MIN) range.set(adm::GainInteractionMin{ getGain(reader) });
+			if (rangeFlags & HAS_GAIN_MAX) range.set(adm::GainInteractionMax{ getGain(reader) });
+			interaction.set(range);
+		}
+		if (flags & HAS_POSITION_RANGE) {
+			adm::PositionInteractionRange range;
+			getOptionalValues<adm::AzimuthInteractionMin, adm::AzimuthInteractionMax,
+				adm::ElevationInteractionMin, adm::ElevationInteractionMax,
+				adm::DistanceInteractionMin, adm::DistanceInteractionMax>(reader, range);
+			interaction.set(range);
+		}
+		return interaction;
+	}
+}
+
+std::string AdmTemplateCodec::encode(adm::Document const& document)
+{
+	auto& presets = AdmPresetDefinitionsHelper::getSingleton();
+
+	// Preset packs are rebuilt from their ID; anything else travels in full
+	std::vector<std::shared_ptr<const adm::AudioPackFormat>> localPackFormats;
+	std::set<PackKey> seenPackFormats;
+	auto notePackFormat = [&](std::shared_ptr<const adm::AudioPackFormat> const& packFormat) {
+		auto key = packKey(packFormat->get<adm::AudioPackFormatId>());
+		if (seenPackFormats.insert(key).second && !presets.getPackFormatData(key.first, key.second)) {
+			localPackFormats.push_back(packFormat);
+		}
+	};
+
+	auto objects = document.getElements<adm::AudioObject>();
+	auto trackUids = document.getElements<adm::AudioTrackUid>();
+	for (auto const& object : objects) {
+		if (!object->getReferences<adm::AudioObject>().empty()) {
+			throw UnsupportedDocument("Nested audioObjects are not supported");
+		}
+		requireUnset<adm::Start, adm::Duration, adm::DialogueId, adm::DisableDucking, adm::Gain>(
+			*object, "audioObject start, duration, dialogue, disableDucking and gain");
+		for (auto const& packFormat : object->getReferences<adm::AudioPackFormat>()) {
+			notePackFormat(packFormat);
+		}
+	}
+	for (auto const& trackUid : trackUids) {
+		if (trackUid->getReference<adm::AudioTrackFormat>()) {
+			throw UnsupportedDocument("audioTrackUids referencing audioTrackFormats are not supported");
+		}
+		if (auto packFormat = trackUid->getReference<adm::AudioPackFormat>()) {
+			notePackFormat(packFormat);
+		}
+	}
+
+	Writer writer;
+	writer.out.append(MAGIC, sizeof(MAGIC));
+	writer.put<uint16_t>(FORMAT_VERSION);
+
+	if (document.has<adm::Version>()) {
+		writer.beginChunk(CHUNK_VERSION);
+		writer.putString(document.get<adm::Version>().get());
+		writer.endChunk();
+	}
+
+	writer.beginChunk(CHUNK_PACK_FORMATS);
+	writer.put<uint32_t>(static_cast<uint32_t>(localPackFormats.size()));
+	for (auto const& packFormat : localPackFormats) {
+		if (!packFormat->getReferences<adm::AudioPackFormat>().empty()) {
+			throw UnsupportedDocument("Nested non-preset audioPackFormats are not supported");
+		}
+		putPackFormatId(writer, packFormat->get<adm::AudioPackFormatId>());
+		writer.putString(packFormat->get<adm::AudioPackFormatName>().get());
+		auto channelFormats = packFormat->getReferences<adm::AudioChannelFormat>();
+		writer.put<uint32_t>(static_cast<uint32_t>(channelFormats.size()));
+		for (auto const& channelFormat : channelFormats) {
+			// Local channel formats are rebuilt from their ID and name alone
+			if (!channelFormat->getElements<adm::AudioBlockFormatObjects>().empty() ||
+				!channelFormat->getElements<adm::AudioBlockFormatDirectSpeakers>().empty() ||
+				!channelFormat->getElements<adm::AudioBlockFormatHoa>().empty() ||
+				!channelFormat->getElements<adm::AudioBlockFormatMatrix>().empty() ||
+				!channelFormat->getElements<adm::AudioBlockFormatBinaural>().empty()) {
+				throw UnsupportedDocument("audioBlockFormats of non-preset audioChannelFormats are not supported");
+			}
+			putChannelFormatId(writer, channelFormat->get<adm::AudioChannelFormatId>());
+			writer.putString(channelFormat->get<adm::AudioChannelFormatName>().get());
+		}
+	}
+	writer.endChunk();
+
+	writer.beginChunk(CHUNK_TRACK_UIDS);
+	writer.put<uint32_t>(static_cast<uint32_t>(trackUids.size()));
+	for (auto const& trackUid : trackUids) {
+		auto packFormat = trackUid->getReference<adm::AudioPackFormat>();
+		auto channelFormat = trackUid->getReference<adm::AudioChannelFormat>();
+		writer.put<uint32_t>(trackUidIdValue(*trackUid));
+		writer.put<uint8_t>((packFormat ? HAS_PACK_FORMAT : 0) | (channelFormat ? HAS_CHANNEL_FORMAT : 0));
+		if (packFormat) putPackFormatId(writer, packFormat->get<adm::AudioPackFormatId>());
+		if (channelFormat) putChannelFormatId(writer, channelFormat->get<adm::AudioChannelFormatId>());
+	}
+	writer.endChunk();
+
+	writer.beginChunk(CHUNK_OBJECTS);
+	writer.put<uint32_t>(static_cast<uint32_t>(objects.size()));
+	for (auto const& object : objects) {
+		writer.put<uint16_t>(objectIdValue(*object));
+		writer.putString(object->get<adm::AudioObjectName>().get());
+
+		uint8_t flags = 0;
+		if (object->has<adm::Importance>()) flags |= HAS_IMPORTANCE;
+		if (object->has<adm::Interact>()) {
+			flags |= HAS_INTERACT;
+			if (object->get<adm::Interact>().get()) flags |= INTERACT;
+		}
+		if (object->has<adm::AudioObjectInteraction>()) flags |= HAS_INTERACTION;
+		writer.put<uint8_t>(flags);
+		if (flags & HAS_IMPORTANCE) writer.put<int8_t>(static_cast<int8_t>(object->get<adm::Importance>().get()));
+		if (flags & HAS_INTERACTION) putInteraction(writer, object->get<adm::AudioObjectInteraction>());
+
+		auto packFormats = object->getReferences<adm::AudioPackFormat>();
+		writer.put<uint32_t>(static_cast<uint32_t>(packFormats.size()));
+		for (auto const& packFormat : packFormats) {
+			putPackFormatId(writer, packFormat->get<adm::AudioPackFormatId>());
+		}
+		auto objectTrackUids = object->getReferences<adm::AudioTrackUid>();
+		writer.put<uint32_t>(static_cast<uint32_t>(objectTrackUids.size()));
+		for (auto const& trackUid : objectTrackUids) {
+			writer.put<uint32_t>(trackUidIdValue(*trackUid));
+		}
+		auto complementaryObjects = object->getComplementaryObjects();
+		writer.put<uint32_t>(static_cast<uint32_t>(complementaryObjects.size()));
+		for (auto const& complementary : complementaryObjects) {
+			writer.put<uint16_t>(objectIdValue(*complementary));
+		}
+	}
+	writer.endChunk();
+
+	auto contents = document.getElements<adm::AudioContent>();
+	writer.beginChunk(CHUNK_CONTENTS);
+	writer.put<uint32_t>(static_cast<uint32_t>(contents.size()));
+	for (auto const& content : contents) {
+		writer.put<uint16_t>(static_cast<uint16_t>(content->get<adm::AudioContentId>().get<adm::AudioContentIdValue>().get()));
+		writer.putString(content->get<adm::AudioContentName>().get());
+		auto contentObjects = content->getReferences<adm::AudioObject>();
+		writer.put<uint32_t>(static_cast<uint32_t>(contentObjects.size()));
+		for (auto const& object : contentObjects) {
+			writer.put<uint16_t>(objectIdValue(*object));
+		}
+	}
+	writer.endChunk();
+
+	auto programmes = document.getElements<adm::AudioProgramme>();
+	writer.beginChunk(CHUNK_PROGRAMMES);
+	writer.put<uint32_t>(static_cast<uint32_t>(programmes.size()));
+	for (auto const& programme : programmes) {
+		writer.put<uint16_t>(static_cast<uint16_t>(programme->get<adm::AudioProgrammeId>().get<adm::AudioProgrammeIdValue>().get()));
+		writer.putString(programme->get<adm::AudioProgrammeName>().get());
+		auto hasLanguage = programme->has<adm::AudioProgrammeLanguage>();
+		writer.put<uint8_t>(hasLanguage ? 1 : 0);
+		if (hasLanguage) writer.putString(programme->get<adm::AudioProgrammeLanguage>().get());
+		auto programmeContents = programme->getReferences<adm::AudioContent>();
+		writer.put<uint32_t>(static_cast<uint32_t>(programmeContents.size()));
+		for (auto const& content : programmeContents) {
+			writer.put<uint16_t>(static_cast<uint16_t>(content->get<adm::AudioContentId>().get<adm::AudioContentIdValue>().get()));
+		}
+	}
+	writer.endChunk();
+
+	return std::move(writer.out);
+}
+
+std::shared_ptr<adm::Document> AdmTemplateCodec::decode(std::string const& data)
+{
+	if (!isEncoded(data)) {
+		throw std::runtime_error("Data is not an encoded ADM template");
+	}
+	Reader reader(data.data(), data.size());
+	reader.getBytes(sizeof(MAGIC));
+	auto formatVersion = reader.get<uint16_t>();
+	if (formatVersion != FORMAT_VERSION) {
+		throw std::runtime_error("Unsupported encoded ADM template version " + std::to_string(formatVersion));
+	}
+
+	std::map<std::string, Reader> chunks;
+	while (!reader.atEnd()) {
+		auto id = reader.getBytes(4);
+		auto chunkSize = reader.get<uint32_t>();
+		chunks.emplace(id, reader.getChunk(chunkSize)); // Unknown chunks are ignored
+	}
+	auto chunk = [&chunks](std::string const& id) {
+		auto it = chunks.find(id);
+		if (it == chunks.end()) {
+			throw std::runtime_error("Encoded ADM template has no \"" + id + "\" chunk");
+		}
+		return it->second;
+	};
+
+	auto document = adm::Document::create();
+	if (chunks.count(CHUNK_VERSION)) {
+		document->set(adm::Version(chunk(CHUNK_VERSION).getString()));
+	}
+	adm::addCommonDefinitionsTo(document);
+
+	std::map<PackKey, std::shared_ptr<adm::AudioPackFormat>> packFormats;
+	std::map<PackKey, std::shared_ptr<adm::AudioChannelFormat>> localChannelFormats;
+	auto packFormat = [&](adm::AudioPackFormatId const& id) {
+		auto key = packKey(id);
+		auto it = packFormats.find(key);
+		if (it != packFormats.end()) {
+			return it->second;
+		}
+		auto pack = std::get<0>(AdmPresetDefinitionsHelper::getSingleton().getDocumentAudioPackFormat(document, id));
+		packFormats.emplace(key, pack);
+		return pack;
+	};
+	auto channelFormat = [&](adm::AudioChannelFormatId const& id) {
+		PackKey key{ id.get<adm::TypeDescriptor>().get(), id.get<adm::AudioChannelFormatIdValue>().get() };
+		auto it = localChannelFormats.find(key);
+		auto channel = it != localChannelFormats.end() ? it->second : document->lookup(id);
+		if (!channel) {
+			throw std::runtime_error("Encoded ADM template references missing " + adm::formatId(id));
+		}
+		return channel;
+	};
+
+	auto packReader = chunk(CHUNK_PACK_FORMATS);
+	auto packCount = packReader.get<uint32_t>();
+	for (uint32_t i = 0; i < packCount; ++i) {
+		auto id = getPackFormatId(packReader);
+		auto typeDefinition = id.get<adm::TypeDescriptor>();
+		auto pack = adm::AudioPackFormat::create(adm::AudioPackFormatName(packReader.getString()), typeDefinition, id);
+		auto channelCount = packReader.get<uint32_t>();
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			auto channelId = getChannelFormatId(packReader);
+			auto channel = adm::AudioChannelFormat::create(adm::AudioChannelFormatName(packReader.getString()), typeDefinition, channelId);
+			pack->addReference(channel);
+			localChannelFormats.emplace(PackKey{ typeDefinition.get(), channelId.get<adm::AudioChannelFormatIdValue>().get() }, channel);
+		}
+		document->add(pack);
+		packFormats.emplace(packKey(id), pack);
+	}
+
+	std::map<uint32_t, std::shared_ptr<adm::AudioTrackUid>> trackUids;
+	auto uidReader = chunk(CHUNK_TRACK_UIDS);
+	auto uidCount = uidReader.get<uint32_t>();
+	for (uint32_t i = 0; i < uidCount; ++i) {
+		auto idValue = uidReader.get<uint32_t>();
+		auto trackUid = adm::AudioTrackUid::create(adm::AudioTrackUidId(adm::AudioTrackUidIdValue(idValue)));
+		auto flags = uidReader.get<uint8_t>();
+		// The pack first, so that any preset channel formats are in the document
+		if (flags & HAS_PACK_FORMAT) trackUid->setReference(packFormat(getPackFormatId(uidReader)));
+		if (flags & HAS_CHANNEL_FORMAT) trackUid->setReference(channelFormat(getChannelFormatId(uidReader)));
+		document->add(trackUid);
+		trackUids.emplace(idValue, trackUid);
+	}
+
+	std::map<uint16_t, std::shared_ptr<adm::AudioObject>> objects;
+	std::vector<std::pair<std::shared_ptr<adm::AudioObject>, std::vector<uint16_t>>> complementaries;
+	auto objectReader = chunk(CHUNK_OBJECTS);
+	auto objectCount = objectReader.get<uint32_t>();
+	for (uint32_t i = 0; i < objectCount; ++i) {
+		auto idValue = objectReader.get<uint16_t>();
+		auto object = adm::AudioObject::create(adm::AudioObjectName(objectReader.getString()),
+			adm::AudioObjectId(adm::AudioObjectIdValue(idValue)));
+		auto flags = objectReader.get<uint8_t>();
+		if (flags & HAS_IMPORTANCE) object->set(adm::Importance(objectReader.get<int8_t>()));
+		if (flags & HAS_INTERACT) object->set(adm::Interact((flags & INTERACT) != 0));
+		if (flags & HAS_INTERACTION) object->set(getInteraction(objectReader));
+
+		auto objectPackCount = objectReader.get<uint32_t>();
+		for (uint32_t p = 0; p < objectPackCount; ++p) {
+			object->addReference(packFormat(getPackFormatId(objectReader)));
+		}
+		auto objectUidCount = objectReader.get<uint32_t>();
+		for (uint32_t u = 0; u < objectUidCount; ++u) {
+			auto uid = trackUids.find(objectReader.get<uint32_t>());
+			if (uid == trackUids.end()) {
+				throw std::runtime_error("Encoded ADM template references a missing audioTrackUid");
+			}
+			object->addReference(uid->second);
+		}
+		// Linked once every object exists, as they can refer forwards
+		std::vector<uint16_t> complementaryIds(objectReader.get<uint32_t>());
+		for (auto& complementaryId : complementaryIds) {
+			complementaryId = objectReader.get<uint16_t>();
+		}
+		complementaries.emplace_back(object, std::move(complementaryIds));
+		document->add(object);
+		objects.emplace(idValue, object);
+	}
+	auto lookupObject = [&objects](uint16_t idValue) {
+		auto it = objects.find(idValue);
+		if (it == objects.end()) {
+			throw std::runtime_error("Encoded ADM template references a missing audioObject");
+		}
+		return it->second;
+	};
+	for (auto const& [object, complementaryIds] : complementaries) {
+		for (auto complementaryId : complementaryIds) {
+			object->addComplementary(lookupObject(complementaryId));
+		}
+	}
+
+	std::map<uint16_t, std::shared_ptr<adm::AudioContent>> contents;
+	auto contentReader = chunk(CHUNK_CONTENTS);
+	auto contentCount = contentReader.get<uint32_t>();
+	for (uint32_t i = 0; i < contentCount; ++i) {
+		auto idValue = contentReader.get<uint16_t>();
+		auto content = adm::AudioContent::create(adm::AudioContentName(contentReader.getString()),
+			adm::AudioContentId(adm::AudioContentIdValue(idValue)));
+		auto contentObjectCount = contentReader.get<uint32_t>();
+		for (uint32_t o = 0; o < contentObjectCount; ++o) {
+			content->addReference(lookupObject(contentReader.get<uint16_t>()));
+		}
+		document->add(content);
+		contents.emplace(idValue, content);
+	}
+
+	auto programmeReader = chunk(CHUNK_PROGRAMMES);
+	auto programmeCount = programmeReader.get<uint32_t>();
+	for (uint32_t i = 0; i < programmeCount; ++i) {
+		auto idValue = programmeReader.get<uint16_t>();
+		auto programme = adm::AudioProgramme::create(adm::AudioProgrammeName(programmeReader.getString()),
+			adm::AudioProgrammeId(adm::AudioProgrammeIdValue(idValue)));
+		if (programmeReader.get<uint8_t>()) {
+			programme->set(adm::AudioProgrammeLanguage(programmeReader.getString()));
+		}
+		auto programmeContentCount = programmeReader.get<uint32_t>();
+		for (uint32_t c = 0; c < programmeContentCount; ++c) {
+			auto content = contents.find(programmeReader.get<uint16_t>());
+			if (content == contents.end()) {
+				throw std::runtime_error("Encoded ADM template references a missing audioContent");
+			}
+			programme->addReference(content->second);
+		}
+		document->add(programme);
+	}
+
+	return document;
+}
+
+bool AdmTemplateCodec::isEncoded(std::string const& data)
+{
+	return data.size() >= sizeof(MAGIC) && memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
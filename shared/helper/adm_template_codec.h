@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <adm/document.hpp>
+
+/*
+NOTE:
+
+A compact binary form of the ADM template the Scene plugin hands to the
+REAPER extension at export, so the extension can rebuild the document
+without writing and re-parsing XML.
+
+It carries the elements and parameters ProgrammeStoreAdmSerializer
+produces: programmes, contents, objects (with interaction and importance),
+locally defined pack/channel formats and track UIDs. Preset (common or
+supplementary) definitions are sent by ID only and rebuilt from
+AdmPresetDefinitionsHelper. All element IDs are kept, so PluginToAdmMap
+entries still match after decoding. Documents using anything else, such
+as object timing or gain, or block formats in local channel formats, throw
+UnsupportedDocument.
+
+The data is a small header followed by tagged, length-prefixed chunks
+(one per element type). Values are in host byte order, as for the rest of
+the Scene <-> extension messages, which never leave the machine.
+*/
+
+namespace AdmTemplateCodec {
+
+	// The document uses something the binary form doesn't carry - send it as XML instead
+	class UnsupportedDocument : public std::runtime_error {
+	public:
+		using std::runtime_error::runtime_error;
+	};
+
+	std::string encode(adm::Document const& document);
+
+	// Throws std::runtime_error if the data is not an encoded template, or is truncated
+	std::shared_ptr<adm::Document> decode(std::string const& data);
+
+	// Whether data starts like an encoded template (rather than, say, XML)
+	bool isEncoded(std::string const& data);
+
+}
@@ -186,6 +186,8 @@ public:
 
     bool atSeqReadEnd() { return (!buf) || (seqReadPos >= getDataCount()); }
 
+    size_t getRemainingDataCount() { return atSeqReadEnd() ? 0 : getDataCount() - seqReadPos; }
+
     T* getSeqReadPointer() {
         if (atSeqReadEnd()) return nullptr;
         T* ret = (T*)buf + seqReadPos;
@@ -297,7 +299,9 @@ protected:
 
 class CommandCommon {
 public:
-    enum Command { GetConfig, StartRender, StopRender, GetAdmAndMappings, GetAdmAndMappingsResp, SetAdmAndMappings, SetAdmAndMappingsResp };
+    // New commands go on the end, so older plugins and extensions still agree on the rest
+    enum Command { GetConfig, StartRender, StopRender, GetAdmAndMappings, GetAdmAndMappingsResp, SetAdmAndMappings, SetAdmAndMappingsResp,
+                   GetBinaryAdmAndMappings, GetBinaryAdmAndMappingsResp };
 
     nng_msg* encodeAdmAndMappingsMessage(Command cmd, std::string& admStr, std::vector<PluginToAdmMap>& pluginToAdmMaps) {
         nng_msg* msg;
@@ -370,6 +374,12 @@ public:
         nng_aio_set_msg(aio, msg);
     }
 
+    // admBin is from AdmTemplateCodec::encode
+    void sendBinaryAdmAndMappings(std::string admBin, std::vector<PluginToAdmMap> pluginToAdmMaps) {
+        auto msg = encodeAdmAndMappingsMessage(Command::GetBinaryAdmAndMappingsResp, admBin, pluginToAdmMaps);
+        nng_aio_set_msg(aio, msg);
+    }
+
     void sendInfo(uint8_t channels, uint32_t sampleRate,
                   uint16_t admTypeDefinition = 0, uint16_t admPackFormatId = 0,
                   uint16_t admChannelFormatId = 0) {
@@ -0,0 +1,122 @@
+// Writes adm_preset_definitions_table.cpp - see helper/adm_preset_definitions_table.h
+// Built with EPS_PRESET_DEFINITIONS_TABLE_GENERATOR, so the helper parses the definitions XML as it would have at startup.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <helper/adm_preset_definitions_helper.h>
+
+namespace {
+	std::string quoted(const std::string& str) {
+		std::ostringstream os;
+		os << '"';
+		for (unsigned char c : str) {
+			if (c == '"' || c == '\\') {
+				os << '\\' << c;
+			}
+			else if (c < 0x20 || c > 0x7E) {
+				// Octal escapes are always three digits, so can't run in to the next character
+				char escaped[5];
+				std::snprintf(escaped, sizeof(escaped), "\\%03o", c);
+				os << escaped;
+			}
+			else {
+				os << c;
+			}
+		}
+		os << '"';
+		return os.str();
+	}
+
+	std::string quoted(const std::optional<std::string>& str) {
+		return str ? quoted(*str) : "nullptr";
+	}
+
+	std::string floatLiteral(float value) {
+		std::ostringstream os;
+		os.precision(9); // Enough to round-trip a float exactly
+		os << value << "f";
+		auto literal = os.str();
+		if (literal.find_first_of(".e") == std::string::npos) {
+			literal.insert(literal.size() - 1, ".0");
+		}
+		return literal;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <output file>" << std::endl;
+		return 1;
+	}
+
+	std::ostringstream typeDefinitions;
+	std::ostringstream packFormats;
+	std::ostringstream channelFormats;
+	std::ostringstream speakerLabels;
+	std::size_t typeDefinitionCount = 0, packFormatCount = 0, channelFormatCount = 0, speakerLabelCount = 0;
+
+	for (auto const& tdData : AdmPresetDefinitionsHelper::getSingleton().getElementRelationships()) {
+		if (!tdData) continue;
+		typeDefinitions << "\t{ " << tdData->id << ", " << quoted(tdData->name) << ", "
+			<< packFormatCount << ", " << tdData->relatedPackFormats.size() << " },\n";
+		++typeDefinitionCount;
+
+		for (auto const& pfData : tdData->relatedPackFormats) {
+			packFormats << "\t{ " << pfData->idValue << ", " << quoted(pfData->fullId) << ", "
+				<< quoted(pfData->name) << ", " << quoted(pfData->niceName) << ", "
+				<< quoted(pfData->ituLabel) << ", " << quoted(pfData->ituStandard) << ", "
+				<< channelFormatCount << ", " << pfData->relatedChannelFormats.size() << " },\n";
+			++packFormatCount;
+
+			for (auto const& cfData : pfData->relatedChannelFormats) {
+				channelFormats << "\t{ " << cfData->idValue << ", " << quoted(cfData->fullId) << ", "
+					<< quoted(cfData->name) << ", " << quoted(cfData->immediatePackFormatId) << ", "
+					<< quoted(cfData->legacySpeakerLabel) << ", " << quoted(cfData->ituLabel) << ", "
+					<< quoted(cfData->ituStandard) << ", " << (cfData->isLfe ? "true" : "false") << ", "
+					<< speakerLabelCount << ", " << cfData->speakerLabels.size() << ", "
+					<< floatLiteral(cfData->azimuth) << ", " << floatLiteral(cfData->elevation) << ", "
+					<< floatLiteral(cfData->distance) << ", "
+					<< cfData->hoaOrder.value_or(-1) << ", " << cfData->hoaDegree.value_or(0) << ", "
+					<< quoted(cfData->hoaNormalization) << " },\n";
+				++channelFormatCount;
+
+				for (auto const& label : cfData->speakerLabels) {
+					speakerLabels << "\t" << quoted(label) << ",\n";
+					++speakerLabelCount;
+				}
+			}
+		}
+	}
+
+	// Zero length arrays aren't allowed - counts still say there's nothing there
+	if (speakerLabelCount == 0) {
+		speakerLabels << "\tnullptr,\n";
+	}
+
+	std::ofstream file{ argv[1], std::ios::out | std::ios::trunc };
+	if (!file) {
+		std::cerr << "Could not open " << argv[1] << " for writing" << std::endl;
+		return 1;
+	}
+
+	file << "// Generated by ear-preset-definitions-generator - do not edit\n"
+		<< "#include <helper/adm_preset_definitions_table.h>\n\n"
+		<< "namespace adm_preset_definitions_table {\n\n"
+		<< "const TypeDefinitionEntry typeDefinitions[] = {\n" << typeDefinitions.str() << "};\n"
+		<< "const std::size_t typeDefinitionCount = " << typeDefinitionCount << ";\n\n"
+		<< "const PackFormatEntry packFormats[] = {\n" << packFormats.str() << "};\n"
+		<< "const std::size_t packFormatCount = " << packFormatCount << ";\n\n"
+		<< "const ChannelFormatEntry channelFormats[] = {\n" << channelFormats.str() << "};\n"
+		<< "const std::size_t channelFormatCount = " << channelFormatCount << ";\n\n"
+		<< "const char* const speakerLabels[] = {\n" << speakerLabels.str() << "};\n"
+		<< "const std::size_t speakerLabelCount = " << speakerLabelCount << ";\n\n"
+		<< "}\n";
+
+	return file.good() ? 0 : 1;
+}
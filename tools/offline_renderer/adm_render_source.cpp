@@ -0,0 +1,217 @@
+#include "adm_render_source.hpp"
+#include "communication/common_types.hpp"
+#include "helper/protobuf_utilities.hpp"
+#include "programme_store_adm_populator.hpp"
+#include <adm/parse.hpp>
+#include <daw_channel_count.h>
+#include <helper/adm_import_helpers.h>
+#include <helper/adm_preset_definitions_helper.h>
+#include <stdexcept>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+namespace {
+
+std::shared_ptr<const adm::AudioChannelFormat> channelFormatOf(
+    std::shared_ptr<const adm::AudioTrackUid> const& uid) {
+  if (auto tf = uid->getReference<adm::AudioTrackFormat>()) {
+    if (auto sf = tf->getReference<adm::AudioStreamFormat>()) {
+      return sf->getReference<adm::AudioChannelFormat>();
+    }
+  }
+  return nullptr;
+}
+
+int channelFormatIdValue(adm::AudioChannelFormat const& channelFormat) {
+  return static_cast<int>(channelFormat.get<adm::AudioChannelFormatId>()
+                              .get<adm::AudioChannelFormatIdValue>()
+                              .get());
+}
+
+std::string nameOf(adm::AudioObject const& object) {
+  if (object.has<adm::AudioObjectName>()) {
+    return object.get<adm::AudioObjectName>().get();
+  }
+  return adm::formatId(object.get<adm::AudioObjectId>());
+}
+
+}  // namespace
+
+AdmRenderSource::AdmRenderSource(const std::string& fileName,
+                                 const std::string& programmeName)
+    : reader_{bw64::readFile(fileName)} {
+  auto chna = reader_->chnaChunk();
+  auto axml = reader_->axmlChunk();
+  if (!chna || !axml) {
+    throw std::runtime_error(fileName +
+                             " has no ADM metadata (axml and chna chunks)");
+  }
+
+  document_ = admplug::parseAxml(*axml);
+  completeUidReferences();
+  addItems(programmeName);
+}
+
+void AdmRenderSource::completeUidReferences() {
+  // As the extension does on import
+  admplug::completeUidReferences(*document_, *reader_->chnaChunk());
+  for (auto const& id : reader_->chnaChunk()->audioIds()) {
+    uidFileChannels_[id.uid()] = id.trackIndex() - 1;
+  }
+}
+
+void AdmRenderSource::addItems(const std::string& programmeName) {
+  // The populator gives the programmes just as the Scene would import them
+  proto::ProgrammeStore programmes;
+  auto importedIds = populateStoreFromAdm(*document_, programmes);
+
+  std::vector<std::pair<adm::AudioObjectId, adm::AudioTrackUidId>> ids;
+  if (programmes.programme_size() > 0) {
+    const proto::Programme* selected{nullptr};
+    for (auto const& programme : programmes.programme()) {
+      if (programmeName.empty()
+              ? programme.programme_internal_id() ==
+                    programmes.selected_programme_internal_id()
+              : programme.name() == programmeName) {
+        selected = &programme;
+        break;
+      }
+    }
+    if (!selected) {
+      throw std::runtime_error("No programme named \"" + programmeName + "\"");
+    }
+    for (auto const& [objectAndUid, element] : importedIds) {
+      for (auto const& programmeElement : selected->element()) {
+        if (&programmeElement == element) {
+          ids.push_back(objectAndUid);
+        }
+      }
+    }
+  } else {
+    if (!programmeName.empty()) {
+      throw std::runtime_error("File has no programmes to select from");
+    }
+    // Without programmes the Scene stays in auto mode, monitoring everything
+    for (auto const& object : document_->getElements<adm::AudioObject>()) {
+      auto packFormats = object->getReferences<adm::AudioPackFormat>();
+      if (packFormats.empty()) continue;
+      auto objectId = object->get<adm::AudioObjectId>();
+      if (packFormats.front()->get<adm::TypeDescriptor>() ==
+          adm::TypeDefinition::OBJECTS) {
+        for (auto const& uid : object->getReferences<adm::AudioTrackUid>()) {
+          ids.emplace_back(objectId, uid->get<adm::AudioTrackUidId>());
+        }
+      } else {
+        ids.emplace_back(objectId,
+                         adm::AudioTrackUidId(adm::AudioTrackUidIdValue(0)));
+      }
+    }
+  }
+
+  for (auto const& [objectId, uidId] : ids) {
+    auto object = document_->lookup(objectId);
+    auto uid = uidId.get<adm::AudioTrackUidIdValue>().get() == 0
+                   ? nullptr
+                   : document_->lookup(uidId);
+    if (object) {
+      addItem(object, uid);
+    }
+  }
+}
+
+void AdmRenderSource::addItem(std::shared_ptr<const adm::AudioObject> object,
+                              std::shared_ptr<const adm::AudioTrackUid> uid) {
+  auto fileChannelOf = [this](adm::AudioTrackUid const& trackUid) {
+    auto it = uidFileChannels_.find(
+        adm::formatId(trackUid.get<adm::AudioTrackUidId>()));
+    return it == uidFileChannels_.end() ? -1 : it->second;
+  };
+
+  RenderItem item;
+  item.name = nameOf(*object);
+  item.connectionId = communication::ConnectionId::generate().string();
+
+  auto packFormat = object->getReferences<adm::AudioPackFormat>().front();
+  auto typeDescriptor = packFormat->get<adm::TypeDescriptor>();
+  if (typeDescriptor == adm::TypeDefinition::OBJECTS) {
+    auto channelFormat = uid ? channelFormatOf(uid) : nullptr;
+    if (!channelFormat) {
+      warnings_.push_back(item.name + ": audioTrackUID has no channel format");
+      return;
+    }
+    auto blocks = channelFormat->getElements<adm::AudioBlockFormatObjects>();
+    if (blocks.empty()) {
+      warnings_.push_back(item.name + ": no audioBlockFormats");
+      return;
+    }
+    item.type = RenderItem::Type::OBJECTS;
+    item.fileChannels.push_back(fileChannelOf(*uid));
+    item.objectBlocks.assign(blocks.begin(), blocks.end());
+
+  } else if (typeDescriptor == adm::TypeDefinition::DIRECT_SPEAKERS ||
+             typeDescriptor == adm::TypeDefinition::HOA) {
+    auto packFormatIdValue =
+        static_cast<int>(packFormat->get<adm::AudioPackFormatId>()
+                             .get<adm::AudioPackFormatIdValue>()
+                             .get());
+    auto pfData = AdmPresetDefinitionsHelper::getSingleton().getPackFormatData(
+        typeDescriptor.get(), packFormatIdValue);
+    if (!pfData) {
+      warnings_.push_back(item.name +
+                          ": custom pack formats aren't supported by the "
+                          "plugins");
+      return;
+    }
+    // The plugin's channels are in pack format order, whatever order the
+    // file has them in
+    auto objectUids = object->getReferences<adm::AudioTrackUid>();
+    for (auto const& cfData : pfData->relatedChannelFormats) {
+      int fileChannel = -1;
+      for (auto const& objectUid : objectUids) {
+        auto channelFormat = channelFormatOf(objectUid);
+        if (channelFormat &&
+            channelFormatIdValue(*channelFormat) == cfData->idValue) {
+          fileChannel = fileChannelOf(*objectUid);
+          break;
+        }
+      }
+      item.fileChannels.push_back(fileChannel);
+    }
+
+    if (typeDescriptor == adm::TypeDefinition::DIRECT_SPEAKERS) {
+      item.type = RenderItem::Type::DIRECT_SPEAKERS;
+      item.staticMetadata.set_allocated_ds_metadata(
+          proto::convertPackFormatToEpsMetadata(packFormatIdValue));
+    } else {
+      item.type = RenderItem::Type::HOA;
+      item.staticMetadata.mutable_hoa_metadata()->set_packformatidvalue(
+          packFormatIdValue);
+    }
+
+  } else {
+    warnings_.push_back(item.name + ": typeDefinition " +
+                        std::to_string(typeDescriptor.get()) +
+                        " isn't supported by the plugins");
+    return;
+  }
+
+  // SceneGainsCalculator ignores anything routed to the last bus channel
+  auto channelCount = static_cast<int>(item.fileChannels.size());
+  if (busChannelCount_ + channelCount > MAX_DAW_CHANNELS - 1) {
+    throw std::runtime_error("Programme needs more than " +
+                             std::to_string(MAX_DAW_CHANNELS - 1) +
+                             " channels");
+  }
+  item.routing = busChannelCount_;
+  busChannelCount_ += channelCount;
+
+  item.staticMetadata.set_connection_id(item.connectionId);
+  item.staticMetadata.set_routing(item.routing);
+  items_.push_back(std::move(item));
+}
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <adm/document.hpp>
+#include <adm/elements.hpp>
+#include <bw64/bw64.hpp>
+#include "monitoring_item_metadata.pb.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+// One input plugin's worth of a file, as the REAPER extension would set it
+// up on import: an Object per audioTrackUID, or a DirectSpeakers/HOA plugin
+// per audioObject with its channels in pack format order.
+struct RenderItem {
+  enum class Type { OBJECTS, DIRECT_SPEAKERS, HOA };
+
+  Type type;
+  std::string connectionId;
+  std::string name;
+  // First channel on the virtual DAW bus
+  int routing{0};
+  // File channel feeding each of the item's channels, -1 where missing
+  std::vector<int> fileChannels;
+  // Objects only, in time order
+  std::vector<adm::AudioBlockFormatObjects> objectBlocks;
+  // DirectSpeakers and HOA metadata doesn't vary over time
+  proto::MonitoringItemMetadata staticMetadata;
+};
+
+// Opens a BW64/ADM file and lays its selected programme out as the plugins
+// would see it - one bus of up to MAX_DAW_CHANNELS - 1 channels.
+class AdmRenderSource {
+ public:
+  // With an empty programme name, the first programme is used (as the Scene
+  // selects on import)
+  AdmRenderSource(const std::string& fileName,
+                  const std::string& programmeName = {});
+
+  bw64::Bw64Reader& reader() { return *reader_; }
+  unsigned int sampleRate() const { return reader_->sampleRate(); }
+  std::uint64_t frameCount() const { return reader_->numberOfFrames(); }
+
+  const std::vector<RenderItem>& items() const { return items_; }
+  // Channels used on the virtual bus
+  int busChannelCount() const { return busChannelCount_; }
+  // Parts of the file that the plugins can't render
+  const std::vector<std::string>& warnings() const { return warnings_; }
+
+ private:
+  // Also indexes the file channel of each audioTrackUID
+  void completeUidReferences();
+  void addItems(const std::string& programmeName);
+  void addItem(std::shared_ptr<const adm::AudioObject> object,
+               std::shared_ptr<const adm::AudioTrackUid> uid);
+
+  std::unique_ptr<bw64::Bw64Reader> reader_;
+  std::shared_ptr<adm::Document> document_;
+  // audioTrackUID ID to file channel, from the CHNA
+  std::map<std::string, int> uidFileChannels_;
+  std::vector<RenderItem> items_;
+  int busChannelCount_{0};
+  std::vector<std::string> warnings_;
+};
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
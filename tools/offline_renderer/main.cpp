@@ -0,0 +1,118 @@
+#include "offline_renderer.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* program) {
+  std::cerr
+      << "Usage: " << program << " <input.wav> [options]\n"
+      << "Renders a BW64/ADM file as the EAR Production Suite monitoring "
+         "plugins would.\n"
+      << "  --layout <name>           loudspeaker layout to render, e.g. "
+         "4+5+0 (repeatable)\n"
+      << "  --binaural <file>         also render binaurally with this BEAR "
+         ".tf data file\n"
+      << "  --output-dir <dir>        where to write <input>_<target>.wav "
+         "(default: input's)\n"
+      << "  --programme <name>        audioProgramme to render (default: "
+         "first)\n"
+      << "  --block-size <frames>     plugin block size (default: 512)\n"
+      << "  --bit-depth <bits>        output bit depth (default: 24)\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using namespace ear::plugin::offline;
+  namespace fs = std::filesystem;
+
+  std::string inputFile;
+  std::vector<std::string> layouts;
+  std::string bearDataFile;
+  std::string outputDir;
+  std::string programmeName;
+  RenderOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto next = [&]() -> std::string {
+      if (i + 1 == argc) {
+        printUsage(argv[0]);
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--layout") {
+      layouts.push_back(next());
+    } else if (arg == "--binaural") {
+      bearDataFile = next();
+    } else if (arg == "--output-dir") {
+      outputDir = next();
+    } else if (arg == "--programme") {
+      programmeName = next();
+    } else if (arg == "--block-size") {
+      options.blockSize = std::stoul(next());
+    } else if (arg == "--bit-depth") {
+      options.bitDepth = std::stoi(next());
+    } else if (arg.rfind("--", 0) != 0 && inputFile.empty()) {
+      inputFile = arg;
+    } else {
+      printUsage(argv[0]);
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+  if (inputFile.empty() || (layouts.empty() && bearDataFile.empty())) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  try {
+    AdmRenderSource source(inputFile, programmeName);
+    for (auto const& warning : source.warnings()) {
+      std::cerr << "warning: " << warning << std::endl;
+    }
+    if (source.items().empty()) {
+      std::cerr << "Nothing in " << inputFile << " to render" << std::endl;
+      return 1;
+    }
+
+    OfflineRenderer renderer(source, options);
+    auto inputPath = fs::path(inputFile);
+    auto outputPath = [&](std::string const& targetName) {
+      auto dir = outputDir.empty() ? inputPath.parent_path() : fs::path(outputDir);
+      return (dir / (inputPath.stem().string() + "_" + targetName + ".wav"))
+          .string();
+    };
+    for (auto const& layout : layouts) {
+      auto target = std::make_unique<SpeakerRenderTarget>(
+          layout, source.busChannelCount(), options.blockSize);
+      auto fileName = outputPath(target->name());
+      renderer.addTarget(std::move(target), fileName);
+    }
+    if (!bearDataFile.empty()) {
+      auto target = std::make_unique<BinauralRenderTarget>(
+          bearDataFile, source.busChannelCount(), source.sampleRate(),
+          options.blockSize);
+      auto fileName = outputPath(target->name());
+      renderer.addTarget(std::move(target), fileName);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    renderer.run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    auto duration =
+        static_cast<double>(source.frameCount()) / source.sampleRate();
+    std::cout << "Rendered " << source.items().size() << " items, "
+              << duration << " s of audio in " << elapsed.count() << " s ("
+              << duration / elapsed.count() << "x realtime)" << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "render failed: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
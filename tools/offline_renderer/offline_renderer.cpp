@@ -0,0 +1,197 @@
+#include "offline_renderer.hpp"
+#include "scene_metadata_cursor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+namespace {
+
+// A run of bus blocks, shared read-only by every target
+struct Chunk {
+  std::uint64_t startFrame;
+  // Frames of file audio; the last block may be padded with silence
+  std::size_t frameCount;
+  std::vector<Eigen::MatrixXf> blocks;
+};
+
+using ChunkPtr = std::shared_ptr<const Chunk>;
+
+// Single producer, single consumer. A null chunk marks the end of the file.
+class ChunkQueue {
+ public:
+  explicit ChunkQueue(std::size_t capacity) : capacity_{capacity} {}
+
+  void push(ChunkPtr chunk) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this]() { return chunks_.size() < capacity_; });
+    chunks_.push_back(std::move(chunk));
+    notEmpty_.notify_one();
+  }
+
+  ChunkPtr pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this]() { return !chunks_.empty(); });
+    auto chunk = std::move(chunks_.front());
+    chunks_.pop_front();
+    notFull_.notify_one();
+    return chunk;
+  }
+
+ private:
+  std::size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable notEmpty_;
+  std::condition_variable notFull_;
+  std::deque<ChunkPtr> chunks_;
+};
+
+struct BusRoute {
+  int fileChannel;
+  int busChannel;
+};
+
+std::vector<BusRoute> busRoutes(const std::vector<RenderItem>& items) {
+  std::vector<BusRoute> routes;
+  for (auto const& item : items) {
+    for (std::size_t i = 0; i < item.fileChannels.size(); ++i) {
+      if (item.fileChannels[i] >= 0) {
+        routes.push_back({item.fileChannels[i],
+                          item.routing + static_cast<int>(i)});
+      }
+    }
+  }
+  return routes;
+}
+
+}  // namespace
+
+OfflineRenderer::OfflineRenderer(AdmRenderSource& source,
+                                 RenderOptions options)
+    : source_{source}, options_{options} {}
+
+void OfflineRenderer::addTarget(std::unique_ptr<RenderTarget> target,
+                                const std::string& outputFile) {
+  outputs_.push_back({std::move(target), outputFile});
+}
+
+void OfflineRenderer::run() {
+  if (outputs_.empty()) {
+    throw std::runtime_error("Nothing to render to");
+  }
+
+  auto const blockSize = options_.blockSize;
+  auto const sampleRate = source_.sampleRate();
+  std::vector<std::unique_ptr<ChunkQueue>> queues;
+  std::vector<std::exception_ptr> errors(outputs_.size());
+  std::vector<std::thread> workers;
+
+  for (std::size_t n = 0; n < outputs_.size(); ++n) {
+    queues.push_back(std::make_unique<ChunkQueue>(options_.queueDepth));
+    workers.emplace_back([this, n, blockSize, sampleRate, &queues, &errors]() {
+      auto& output = outputs_[n];
+      auto& queue = *queues[n];
+      try {
+        auto channels = output.target->outputChannelCount();
+        auto writer = bw64::writeFile(output.fileName, channels, sampleRate,
+                                      options_.bitDepth);
+        // Each target follows the scene on its own, so no state is shared
+        // between workers but the audio
+        SceneMetadataCursor cursor(source_.items());
+        Eigen::MatrixXf out(blockSize, channels);
+        Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+            interleaved;
+
+        while (auto chunk = queue.pop()) {
+          for (std::size_t b = 0; b < chunk->blocks.size(); ++b) {
+            auto startFrame = chunk->startFrame + b * blockSize;
+            std::chrono::nanoseconds time(startFrame * 1000000000ull /
+                                          sampleRate);
+            output.target->process(cursor.at(time), chunk->blocks[b], out);
+
+            auto frames = std::min(blockSize, chunk->frameCount - b * blockSize);
+            interleaved = out.topRows(frames);
+            writer->write(interleaved.data(), frames);
+          }
+        }
+      } catch (...) {
+        errors[n] = std::current_exception();
+        // Keep taking chunks so the reader never waits on this target
+        while (queue.pop()) {
+        }
+      }
+    });
+  }
+
+  auto finish = [&]() {
+    for (auto& queue : queues) {
+      queue->push(nullptr);
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  };
+
+  try {
+    auto& reader = source_.reader();
+    auto const fileChannels = reader.channels();
+    auto const busChannels = source_.busChannelCount() + 1;
+    auto const routes = busRoutes(source_.items());
+    auto const chunkFrames = blockSize * options_.blocksPerChunk;
+    std::vector<float> fileSamples(chunkFrames * fileChannels);
+
+    std::uint64_t startFrame = 0;
+    while (startFrame < source_.frameCount()) {
+      auto frameCount = static_cast<std::size_t>(
+          reader.read(fileSamples.data(), chunkFrames));
+      if (frameCount == 0) {
+        break;
+      }
+
+      auto chunk = std::make_shared<Chunk>();
+      chunk->startFrame = startFrame;
+      chunk->frameCount = frameCount;
+      auto blockCount = (frameCount + blockSize - 1) / blockSize;
+      for (std::size_t b = 0; b < blockCount; ++b) {
+        auto block = Eigen::MatrixXf::Zero(blockSize, busChannels).eval();
+        auto frames = std::min(blockSize, frameCount - b * blockSize);
+        for (auto const& route : routes) {
+          auto source = fileSamples.data() +
+                        b * blockSize * fileChannels + route.fileChannel;
+          for (std::size_t frame = 0; frame < frames; ++frame) {
+            block(frame, route.busChannel) = source[frame * fileChannels];
+          }
+        }
+        chunk->blocks.push_back(std::move(block));
+      }
+
+      for (auto& queue : queues) {
+        queue->push(chunk);
+      }
+      startFrame += frameCount;
+    }
+  } catch (...) {
+    finish();
+    throw;
+  }
+
+  finish();
+  for (auto const& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
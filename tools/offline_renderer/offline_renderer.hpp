@@ -0,0 +1,53 @@
+#pragma once
+
+#include "adm_render_source.hpp"
+#include "render_targets.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+struct RenderOptions {
+  // The plugins' processing block size; metadata is sampled once per block
+  std::size_t blockSize{512};
+  int bitDepth{24};
+  // Blocks read from the file in one go
+  std::size_t blocksPerChunk{32};
+  // Chunks a target may fall behind the reader before the reader waits
+  std::size_t queueDepth{4};
+};
+
+// Renders a file to any number of targets in one pass over its audio.
+//
+// A reader thread decodes the file on to the virtual bus, and each target
+// renders and writes its own output on a worker thread, so render time is
+// bounded by the slowest target rather than the sum of them.
+class OfflineRenderer {
+ public:
+  OfflineRenderer(AdmRenderSource& source, RenderOptions options);
+
+  void addTarget(std::unique_ptr<RenderTarget> target,
+                 const std::string& outputFile);
+
+  // Returns once every output has been written; rethrows the first error
+  // from any thread
+  void run();
+
+ private:
+  struct Output {
+    std::unique_ptr<RenderTarget> target;
+    std::string fileName;
+  };
+
+  AdmRenderSource& source_;
+  RenderOptions options_;
+  std::vector<Output> outputs_;
+};
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
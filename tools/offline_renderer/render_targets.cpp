@@ -0,0 +1,156 @@
+#include "render_targets.hpp"
+#include "helper/eps_to_ear_metadata_converter.hpp"
+#include <daw_channel_count.h>
+#include <ear/bs2051.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+
+template <>
+struct BufferTraits<Eigen::MatrixXf> {
+  using Buffer = Eigen::MatrixXf;
+  using SampleType = float;
+  static Eigen::Index channelCount(const Buffer& b) { return b.cols(); }
+  static Eigen::Index size(const Buffer& b) { return b.rows(); }
+  static const SampleType* getChannel(const Buffer& b, std::size_t n) {
+    return b.col(n).data();
+  }
+  static SampleType* getChannel(Buffer& b, std::size_t n) {
+    return b.col(n).data();
+  }
+};
+
+namespace offline {
+
+// The per-channel pointers BEAR works on, over the columns of a matrix
+struct ChannelPointers {
+  explicit ChannelPointers(Eigen::MatrixXf& samples)
+      : frames{samples.rows()} {
+    for (Eigen::Index n = 0; n < samples.cols(); ++n) {
+      pointers.push_back(samples.col(n).data());
+    }
+  }
+  Eigen::Index frames;
+  std::vector<float*> pointers;
+};
+
+}  // namespace offline
+
+template <>
+struct BufferTraits<offline::ChannelPointers> {
+  using Buffer = offline::ChannelPointers;
+  using SampleType = float;
+  static Eigen::Index channelCount(const Buffer& b) {
+    return static_cast<Eigen::Index>(b.pointers.size());
+  }
+  static Eigen::Index size(const Buffer& b) { return b.frames; }
+  static SampleType* getChannel(Buffer& b, std::size_t n) {
+    return b.pointers[n];
+  }
+  static const SampleType* getChannel(const Buffer& b, std::size_t n) {
+    return b.pointers[n];
+  }
+  static SampleType** getChannels(Buffer& b) { return b.pointers.data(); }
+  static SampleType* const* getChannels(const Buffer& b) {
+    return b.pointers.data();
+  }
+};
+
+namespace offline {
+
+// The bus has a spare channel at the end, as the DAW's would: the gains
+// calculator doesn't route anything to the last input channel.
+SpeakerRenderTarget::SpeakerRenderTarget(const std::string& layoutName,
+                                         int busChannelCount,
+                                         std::size_t blockSize)
+    : layoutName_{layoutName},
+      outputChannelCount_{
+          static_cast<int>(getLayout(layoutName).channels().size())},
+      gainsCalculator_{getLayout(layoutName), busChannelCount + 1},
+      processor_{static_cast<std::size_t>(busChannelCount + 1),
+                 getLayout(layoutName), blockSize} {}
+
+void SpeakerRenderTarget::process(const proto::SceneStore& scene,
+                                  const Eigen::MatrixXf& in,
+                                  Eigen::MatrixXf& out) {
+  // As the monitoring plugin does for each block it's given
+  gainsCalculator_.update(scene);
+  processor_.process(in, out, gainsCalculator_.directGains(),
+                     gainsCalculator_.diffuseGains(),
+                     gainsCalculator_.hoaDecodes());
+}
+
+BinauralRenderTarget::BinauralRenderTarget(const std::string& bearDataFile,
+                                           int busChannelCount,
+                                           std::size_t sampleRate,
+                                           std::size_t blockSize)
+    : processor_{MAX_DAW_CHANNELS, MAX_DAW_CHANNELS, MAX_DAW_CHANNELS,
+                 sampleRate,       blockSize,        bearDataFile},
+      scratch_(blockSize, std::max(busChannelCount + 1, 2)) {
+  if (!processor_.rendererStarted()) {
+    auto status = processor_.getBearStatus();
+    throw std::runtime_error("BEAR failed to start: " +
+                             status.startupErrorDesc +
+                             status.listenerDataSetErrorDesc);
+  }
+  processor_.setIsPlaying(true);
+}
+
+void BinauralRenderTarget::process(const proto::SceneStore& scene,
+                                   const Eigen::MatrixXf& in,
+                                   Eigen::MatrixXf& out) {
+  std::size_t objChannels{0};
+  std::size_t dsChannels{0};
+  std::size_t hoaChannels{0};
+  for (auto const& item : scene.monitoring_items()) {
+    if (item.has_obj_metadata()) {
+      ++objChannels;
+    } else if (item.has_ds_metadata()) {
+      dsChannels += item.ds_metadata().speakers_size();
+    } else if (item.has_hoa_metadata()) {
+      auto pfData =
+          AdmPresetDefinitionsHelper::getSingleton().getPackFormatData(
+              adm::TypeDefinition::HOA.get(),
+              item.hoa_metadata().packformatidvalue());
+      hoaChannels += pfData ? pfData->relatedChannelFormats.size() : 0;
+    }
+  }
+  if (!processor_.updateChannelCounts(objChannels, dsChannels, hoaChannels)) {
+    throw std::runtime_error("BEAR can't take " +
+                             std::to_string(objChannels + dsChannels +
+                                            hoaChannels) +
+                             " channels");
+  }
+
+  // Metadata is pushed every block, as the binaural monitoring plugin does
+  scratch_.leftCols(in.cols()) = in;
+  processor_.checkSilence(scratch_);
+  std::size_t streamIdentifier = 0;
+  for (auto const& item : scene.monitoring_items()) {
+    if (item.has_obj_metadata()) {
+      auto metadata = EpsToEarMetadataConverter::convert(item.obj_metadata());
+      processor_.pushBearMetadata(item.routing(), &metadata);
+    } else if (item.has_ds_metadata()) {
+      auto metadata = EpsToEarMetadataConverter::convert(item.ds_metadata());
+      for (std::size_t index = 0; index < metadata.size(); ++index) {
+        processor_.pushBearMetadata(item.routing() + index, &metadata[index]);
+      }
+    } else if (item.has_hoa_metadata()) {
+      auto metadata = EpsToEarMetadataConverter::convert(item.hoa_metadata());
+      processor_.pushBearMetadata(item.routing(), &metadata,
+                                  streamIdentifier++);
+    }
+  }
+
+  ChannelPointers channels(scratch_);
+  processor_.process(channels, channels);
+  out = scratch_.leftCols(2);
+}
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
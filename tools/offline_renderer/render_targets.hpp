@@ -0,0 +1,67 @@
+#pragma once
+
+#include "binaural_monitoring_audio_processor.hpp"
+#include "monitoring_audio_processor.hpp"
+#include "scene_gains_calculator.hpp"
+#include "scene_store.pb.h"
+#include <Eigen/Core>
+#include <ear/layout.hpp>
+#include <string>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+// One rendering of the virtual bus, written to its own file. Each target is
+// driven from a single thread, one fixed size block at a time.
+class RenderTarget {
+ public:
+  virtual ~RenderTarget() = default;
+
+  // Used to name the output file
+  virtual std::string name() const = 0;
+  virtual int outputChannelCount() const = 0;
+
+  // in is blockSize x bus channels, out is blockSize x outputChannelCount()
+  virtual void process(const proto::SceneStore& scene,
+                       const Eigen::MatrixXf& in, Eigen::MatrixXf& out) = 0;
+};
+
+// The monitoring plugin, for a given loudspeaker layout
+class SpeakerRenderTarget : public RenderTarget {
+ public:
+  SpeakerRenderTarget(const std::string& layoutName, int busChannelCount,
+                      std::size_t blockSize);
+
+  std::string name() const override { return layoutName_; }
+  int outputChannelCount() const override { return outputChannelCount_; }
+  void process(const proto::SceneStore& scene, const Eigen::MatrixXf& in,
+               Eigen::MatrixXf& out) override;
+
+ private:
+  std::string layoutName_;
+  int outputChannelCount_;
+  SceneGainsCalculator gainsCalculator_;
+  MonitoringAudioProcessor processor_;
+};
+
+// The binaural monitoring plugin, with the listener facing forwards
+class BinauralRenderTarget : public RenderTarget {
+ public:
+  BinauralRenderTarget(const std::string& bearDataFile, int busChannelCount,
+                       std::size_t sampleRate, std::size_t blockSize);
+
+  std::string name() const override { return "binaural"; }
+  int outputChannelCount() const override { return 2; }
+  void process(const proto::SceneStore& scene, const Eigen::MatrixXf& in,
+               Eigen::MatrixXf& out) override;
+
+ private:
+  BinauralMonitoringAudioProcessor processor_;
+  // BEAR renders over the first two channels of its input
+  Eigen::MatrixXf scratch_;
+};
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
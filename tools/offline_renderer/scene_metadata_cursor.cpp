@@ -0,0 +1,204 @@
+#include "scene_metadata_cursor.hpp"
+#include <adm_coord_conv/adm_coord_conv.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+namespace {
+
+using ns = std::chrono::nanoseconds;
+
+struct ObjectValues {
+  double azimuth{0.0};
+  double elevation{0.0};
+  double distance{1.0};
+  double gain{1.0};
+  double width{0.0};
+  double height{0.0};
+  double depth{0.0};
+  double diffuse{0.0};
+  double factor{0.0};
+  double range{0.0};
+};
+
+template <typename T, typename Block>
+double valueOr(Block const& block, double defaultValue) {
+  return block.template has<T>() ? block.template get<T>().get() : defaultValue;
+}
+
+ObjectValues valuesOf(adm::AudioBlockFormatObjects const& block) {
+  ObjectValues values;
+  values.width = valueOr<adm::Width>(block, 0.0);
+  values.height = valueOr<adm::Height>(block, 0.0);
+  values.depth = valueOr<adm::Depth>(block, 0.0);
+  values.diffuse = valueOr<adm::Diffuse>(block, 0.0);
+  if (block.has<adm::Gain>()) {
+    values.gain = block.get<adm::Gain>().asLinear();
+  }
+  if (block.has<adm::ObjectDivergence>()) {
+    auto divergence = block.get<adm::ObjectDivergence>();
+    values.factor = valueOr<adm::Divergence>(divergence, 0.0);
+    values.range = valueOr<adm::AzimuthRange>(divergence, 0.0);
+  }
+
+  if (block.has<adm::SphericalPosition>()) {
+    auto position = block.get<adm::SphericalPosition>();
+    values.azimuth = position.get<adm::Azimuth>().get();
+    values.elevation = position.get<adm::Elevation>().get();
+    values.distance = valueOr<adm::Distance>(position, 1.0);
+  } else if (block.has<adm::CartesianPosition>()) {
+    // Converted as the extension does on import, extent included
+    auto position = block.get<adm::CartesianPosition>();
+    adm::coords::CartesianSource source{{position.get<adm::X>().get(),
+                                         position.get<adm::Y>().get(),
+                                         position.get<adm::Z>().get()}};
+    if (block.has<adm::Width>() || block.has<adm::Height>() ||
+        block.has<adm::Depth>()) {
+      source.extent =
+          adm::coords::CartesianExtent{values.width, values.height,
+                                       values.depth};
+    }
+    auto converted = adm::coords::convert(source);
+    values.azimuth = converted.position.azimuth;
+    values.elevation = converted.position.elevation;
+    values.distance = converted.position.distance;
+    if (converted.extent) {
+      values.width = converted.extent->width;
+      values.height = converted.extent->height;
+      values.depth = converted.extent->depth;
+    }
+  }
+  return values;
+}
+
+template <typename T, typename Block>
+ns timeOr(Block const& block, ns defaultValue) {
+  return block.template has<T>()
+             ? block.template get<T>().get().asNanoseconds()
+             : defaultValue;
+}
+
+ns interpolationLength(adm::AudioBlockFormatObjects const& block) {
+  if (block.has<adm::JumpPosition>() &&
+      adm::isEnabled(block.get<adm::JumpPosition>())) {
+    auto jumpPosition = block.get<adm::JumpPosition>();
+    return jumpPosition.has<adm::InterpolationLength>()
+               ? ns(jumpPosition.get<adm::InterpolationLength>().get())
+               : ns::zero();
+  }
+  return timeOr<adm::Duration>(block, ns::zero());
+}
+
+double lerp(double from, double to, double proportion) {
+  return from + (to - from) * proportion;
+}
+
+double lerpAzimuth(double from, double to, double proportion) {
+  auto difference = std::remainder(to - from, 360.0);
+  auto azimuth = std::remainder(from + difference * proportion, 360.0);
+  // remainder gives [-180, 180]; keep +180 where the block says so
+  return proportion >= 1.0 ? to : azimuth;
+}
+
+proto::ObjectsTypeMetadata toProto(ObjectValues const& values) {
+  auto toFloat = [](double value) {
+    return static_cast<double>(static_cast<float>(value));
+  };
+  proto::ObjectsTypeMetadata metadata;
+  metadata.mutable_position()->set_azimuth(toFloat(values.azimuth));
+  metadata.mutable_position()->set_elevation(toFloat(values.elevation));
+  metadata.mutable_position()->set_distance(toFloat(values.distance));
+  metadata.set_gain(toFloat(values.gain));
+  metadata.set_width(toFloat(values.width));
+  metadata.set_height(toFloat(values.height));
+  metadata.set_depth(toFloat(values.depth));
+  metadata.set_diffuse(toFloat(values.diffuse));
+  metadata.set_factor(toFloat(values.factor));
+  metadata.set_range(toFloat(values.range));
+  return metadata;
+}
+
+}  // namespace
+
+proto::ObjectsTypeMetadata objectMetadataAt(
+    const std::vector<adm::AudioBlockFormatObjects>& blocks, ns time,
+    std::size_t& blockIndex) {
+  if (blocks.empty()) {
+    return toProto(ObjectValues{});
+  }
+  blockIndex = std::min(blockIndex, blocks.size() - 1);
+  while (blockIndex + 1 < blocks.size() &&
+         timeOr<adm::Rtime>(blocks[blockIndex + 1], ns::zero()) <= time) {
+    ++blockIndex;
+  }
+
+  auto& block = blocks[blockIndex];
+  auto target = valuesOf(block);
+  if (blockIndex == 0) {
+    return toProto(target);
+  }
+
+  auto length = interpolationLength(block);
+  auto elapsed = time - timeOr<adm::Rtime>(block, ns::zero());
+  auto proportion =
+      length.count() > 0
+          ? std::clamp(static_cast<double>(elapsed.count()) / length.count(),
+                       0.0, 1.0)
+          : 1.0;
+  if (proportion >= 1.0) {
+    return toProto(target);
+  }
+
+  auto from = valuesOf(blocks[blockIndex - 1]);
+  ObjectValues values;
+  values.azimuth = lerpAzimuth(from.azimuth, target.azimuth, proportion);
+  values.elevation = lerp(from.elevation, target.elevation, proportion);
+  values.distance = lerp(from.distance, target.distance, proportion);
+  values.gain = lerp(from.gain, target.gain, proportion);
+  values.width = lerp(from.width, target.width, proportion);
+  values.height = lerp(from.height, target.height, proportion);
+  values.depth = lerp(from.depth, target.depth, proportion);
+  values.diffuse = lerp(from.diffuse, target.diffuse, proportion);
+  values.factor = lerp(from.factor, target.factor, proportion);
+  values.range = lerp(from.range, target.range, proportion);
+  return toProto(values);
+}
+
+SceneMetadataCursor::SceneMetadataCursor(const std::vector<RenderItem>& items)
+    : items_{items},
+      blockIndices_(items.size(), 0),
+      previousMetadata_(items.size()) {
+  for (auto const& item : items_) {
+    auto monitoringItem = store_.add_monitoring_items();
+    *monitoringItem = item.staticMetadata;
+    monitoringItem->set_connection_id(item.connectionId);
+    monitoringItem->set_routing(item.routing);
+
+    auto available = store_.add_all_available_items();
+    available->set_connection_id(item.connectionId);
+    available->set_routing(item.routing);
+    available->set_name(item.name);
+  }
+}
+
+const proto::SceneStore& SceneMetadataCursor::at(ns time) {
+  for (std::size_t i = 0; i < items_.size(); ++i) {
+    auto& monitoringItem = *store_.mutable_monitoring_items(i);
+    if (items_[i].type == RenderItem::Type::OBJECTS) {
+      *monitoringItem.mutable_obj_metadata() =
+          objectMetadataAt(items_[i].objectBlocks, time, blockIndices_[i]);
+    }
+    monitoringItem.set_changed(false);
+    auto serialized = monitoringItem.SerializeAsString();
+    monitoringItem.set_changed(serialized != previousMetadata_[i]);
+    previousMetadata_[i] = std::move(serialized);
+  }
+  return store_;
+}
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "adm_render_source.hpp"
+#include "scene_store.pb.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ear {
+namespace plugin {
+namespace offline {
+
+// Object parameters at a point in time, following the automation the
+// extension creates on import: each audioBlockFormat ramps linearly from the
+// previous one's values over its interpolation length (the whole block unless
+// jumpPosition says otherwise), with azimuth taking the shorter way round.
+// Values are rounded to float, as they pass through plugin parameters.
+//
+// Searching starts from blockIndex, which is updated, so times should not go
+// backwards between calls sharing an index.
+proto::ObjectsTypeMetadata objectMetadataAt(
+    const std::vector<adm::AudioBlockFormatObjects>& blocks,
+    std::chrono::nanoseconds time, std::size_t& blockIndex);
+
+// The Scene's view of the items over time, as sent to the monitoring plugins.
+class SceneMetadataCursor {
+ public:
+  explicit SceneMetadataCursor(const std::vector<RenderItem>& items);
+
+  // Times must not go backwards. Items are marked changed when their
+  // metadata differs from the previous call.
+  const proto::SceneStore& at(std::chrono::nanoseconds time);
+
+ private:
+  const std::vector<RenderItem>& items_;
+  std::vector<std::size_t> blockIndices_;
+  std::vector<std::string> previousMetadata_;
+  proto::SceneStore store_;
+};
+
+}  // namespace offline
+}  // namespace plugin
+}  // namespace ear
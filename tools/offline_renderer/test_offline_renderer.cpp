@@ -0,0 +1,106 @@
+#include "render_targets.hpp"
+#include "scene_metadata_cursor.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+
+using namespace ear::plugin;
+using namespace ear::plugin::offline;
+using namespace std::chrono_literals;
+
+namespace {
+
+adm::AudioBlockFormatObjects block(double azimuth, std::chrono::nanoseconds rtime,
+                                   std::chrono::nanoseconds duration) {
+  return adm::AudioBlockFormatObjects(
+      adm::SphericalPosition(adm::Azimuth(azimuth), adm::Elevation(0.0)),
+      adm::Rtime(rtime), adm::Duration(duration));
+}
+
+double azimuthAt(std::vector<adm::AudioBlockFormatObjects> const& blocks,
+                 std::chrono::nanoseconds time) {
+  std::size_t index = 0;
+  return objectMetadataAt(blocks, time, index).position().azimuth();
+}
+
+}  // namespace
+
+TEST_CASE("first block holds its values") {
+  std::vector<adm::AudioBlockFormatObjects> blocks{block(30.0, 0s, 1s)};
+  REQUIRE(azimuthAt(blocks, 0s) == Catch::Approx(30.0));
+  REQUIRE(azimuthAt(blocks, 500ms) == Catch::Approx(30.0));
+}
+
+TEST_CASE("later blocks ramp over their duration") {
+  std::vector<adm::AudioBlockFormatObjects> blocks{block(0.0, 0s, 1s),
+                                                   block(40.0, 1s, 1s)};
+  REQUIRE(azimuthAt(blocks, 1s) == Catch::Approx(0.0));
+  REQUIRE(azimuthAt(blocks, 1500ms) == Catch::Approx(20.0));
+  REQUIRE(azimuthAt(blocks, 2s) == Catch::Approx(40.0));
+}
+
+TEST_CASE("azimuth ramps the shorter way round") {
+  std::vector<adm::AudioBlockFormatObjects> blocks{block(170.0, 0s, 1s),
+                                                   block(-170.0, 1s, 1s)};
+  REQUIRE(azimuthAt(blocks, 1500ms) == Catch::Approx(180.0).margin(1e-4));
+  REQUIRE(azimuthAt(blocks, 1750ms) == Catch::Approx(-175.0));
+}
+
+TEST_CASE("jumpPosition shortens the ramp") {
+  std::vector<adm::AudioBlockFormatObjects> blocks{block(0.0, 0s, 1s),
+                                                   block(40.0, 1s, 1s)};
+  blocks[1].set(adm::JumpPosition(adm::JumpPositionFlag(true),
+                                  adm::InterpolationLength(250ms)));
+  REQUIRE(azimuthAt(blocks, 1125ms) == Catch::Approx(20.0));
+  REQUIRE(azimuthAt(blocks, 1250ms) == Catch::Approx(40.0));
+
+  blocks[1].set(adm::JumpPosition(adm::JumpPositionFlag(true)));
+  REQUIRE(azimuthAt(blocks, 1s) == Catch::Approx(40.0));
+}
+
+TEST_CASE("cursor marks items changed only when their metadata changes") {
+  RenderItem item;
+  item.type = RenderItem::Type::OBJECTS;
+  item.connectionId = "00000000-0000-0000-0000-000000000001";
+  item.fileChannels = {0};
+  item.objectBlocks = {block(0.0, 0s, 1s), block(40.0, 1s, 1s),
+                       block(40.0, 2s, 1s)};
+  std::vector<RenderItem> items{item};
+  SceneMetadataCursor cursor(items);
+
+  REQUIRE(cursor.at(0s).monitoring_items(0).changed());
+  REQUIRE_FALSE(cursor.at(500ms).monitoring_items(0).changed());
+  REQUIRE(cursor.at(1500ms).monitoring_items(0).changed());
+  REQUIRE(cursor.at(2s).monitoring_items(0).changed());
+  REQUIRE_FALSE(cursor.at(2500ms).monitoring_items(0).changed());
+}
+
+TEST_CASE("speaker target renders objects to their loudspeaker") {
+  constexpr std::size_t blockSize = 128;
+  // One bus channel, plus the spare the renderer always adds
+  SpeakerRenderTarget target("0+2+0", 1, blockSize);
+  REQUIRE(target.outputChannelCount() == 2);
+
+  proto::SceneStore scene;
+  auto item = scene.add_monitoring_items();
+  item->set_connection_id("00000000-0000-0000-0000-000000000001");
+  item->set_routing(0);
+  auto position = item->mutable_obj_metadata()->mutable_position();
+  position->set_azimuth(30.0);
+  position->set_elevation(0.0);
+  position->set_distance(1.0);
+
+  Eigen::MatrixXf in = Eigen::MatrixXf::Zero(blockSize, 2);
+  in.col(0).setOnes();
+  Eigen::MatrixXf out(blockSize, 2);
+  // Well past the gains ramping in and the direct path delay, which keeps
+  // it aligned with the decorrelated diffuse path
+  for (int block = 0; block < 16; ++block) {
+    target.process(scene, in, out);
+    item->set_changed(false);
+  }
+
+  for (Eigen::Index frame = 0; frame < out.rows(); ++frame) {
+    REQUIRE(out(frame, 0) == Catch::Approx(1.0).margin(1e-4));
+    REQUIRE(out(frame, 1) == Catch::Approx(0.0).margin(1e-4));
+  }
+}
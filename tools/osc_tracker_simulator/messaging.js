@@ -97,6 +97,35 @@ function msg_float(f){
 	process();
 }
 
+// For measuring head tracking latency and smoothness: send "sweep <degrees
+// per second>" to turn the head steadily in yaw, updating 100 times a second,
+// and "sweep 0" to stop. The binaural monitoring plugin's DSP readout tooltip
+// shows the "OSC to output" time of each orientation, and the sweep should
+// sound continuous rather than stepped.
+var sweepRate = 0;
+var sweepIntervalMs = 10;
+var sweepTask = new Task(sweepTick, this);
+sweepTask.interval = sweepIntervalMs;
+
+function sweep(degreesPerSecond){
+	sweepRate = degreesPerSecond;
+	if(sweepRate === 0){
+		sweepTask.cancel();
+		return;
+	}
+	if(yaw === null) yaw = 0;
+	if(pitch === null) pitch = 0;
+	if(roll === null) roll = 0;
+	sweepTask.repeat();
+}
+
+function sweepTick(){
+	yaw += sweepRate * sweepIntervalMs / 1000.0;
+	if(yaw > 180) yaw -= 360;
+	if(yaw < -180) yaw += 360;
+	process();
+}
+
 function process()
 {
 